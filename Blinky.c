@@ -21,6 +21,11 @@
 
 #include "cmsis_os2.h"                  // ARM::CMSIS:RTOS:Keil RTX5
 #include "cmsis_vio.h"                  // CMSIS:VIO
+#include "boot_time.h"
+#include "clk_governor.h"
+#include "logger.h"
+#include "lowpower.h"
+#include "supervisor.h"
 
 static osThreadId_t tid_thrLED;         // Thread id of thread: LED
 
@@ -31,15 +36,19 @@ volatile     uint32_t g_ledSet = 0;     // Variable to store virtual LED value:
                                         // 3 = LED3 on
                                         
 // Create thread attributes to show thread names in the XRTOS viewer:
-const osThreadAttr_t app_main_attr = {.name = "MainThread", .stack_size = 128U};   // Requires less stack
+const osThreadAttr_t app_main_attr = {.name = "MainThread"};   // Init calls need the default stack
 const osThreadAttr_t thrLED_attr   = {.name = "LEDThread"};
 
 /*------------------------------------------------------------------------------
   thrLED: blink LED
  *----------------------------------------------------------------------------*/
 __NO_RETURN void thrLED (void *argument) {
+  int32_t sup_id = supRegister(2500U);        // Loop takes 2 s
+
+  (void)argument;
 
   for (;;) {
+      supCheckIn(sup_id);                     // Report progress to supervisor
       vioSetSignal(vioLED3, vioLEDoff);       // Switch LED off
       vioSetSignal(vioLED0, vioLEDon);        // Switch LED on
       g_ledSet = 0;
@@ -65,10 +74,16 @@ __NO_RETURN void thrLED (void *argument) {
 static void app_main_thread (void *argument) {
   (void)argument;
 
+  bootDone();                                                   // Reset to first thread
+  supInit();                                                    // Start watchdog supervisor
+  lgInit();                                                     // Start UART0 logger
+  lpInit();                                                     // Deep sleep when idle
+  govInit();                                                    // Core clock follows the load
+  LG_LOG(LG_LEVEL_INFO, "boot done, cclk %u Hz", SystemCoreClock);
   tid_thrLED = osThreadNew(thrLED, NULL, &thrLED_attr);         // Create LED thread
   if (tid_thrLED == NULL) { /* add error handling */ }
 
-  for (;;) { /* loop forever */ }
+  osThreadExit();                                               // Nothing left to do
 }
 
 /*-----------------------------------------------------------------------------
@@ -77,6 +92,7 @@ static void app_main_thread (void *argument) {
 int app_main (void) {
   osKernelInitialize();                         // Initialize CMSIS-RTOS2
   osThreadNew(app_main_thread, NULL, &app_main_attr);  // Create application main thread
+  bootMark(BOOT_KERNEL_START, SystemCoreClock);         // Boot timestamp
   osKernelStart();                              // Start thread execution
   return 0;
 }
@@ -44,7 +44,7 @@
 //   <i> Defines the combined global dynamic memory size.
 //   <i> Default: 32768
 #ifndef OS_DYNAMIC_MEM_SIZE
-#define OS_DYNAMIC_MEM_SIZE         1024
+#define OS_DYNAMIC_MEM_SIZE         4096
 #endif
  
 //   <o>Kernel Tick Frequency [Hz] <1-1000000>
@@ -76,7 +76,7 @@
 //   <i>  - selected features from this group
 //   <i>  - Thread functions: osThreadProtectPrivileged
 #ifndef OS_SAFETY_FEATURES
-#define OS_SAFETY_FEATURES          0
+#define OS_SAFETY_FEATURES          1
 #endif
  
 //     <q>Safety Class
@@ -86,7 +86,7 @@
 //     <i>  - Kernel functions: osKernelProtect, osKernelDestroyClass
 //     <i>  - Thread functions: osThreadGetClass, osThreadSuspendClass, osThreadResumeClass
 #ifndef OS_SAFETY_CLASS
-#define OS_SAFETY_CLASS             1
+#define OS_SAFETY_CLASS             0
 #endif
  
 //     <q>MPU Protected Zone
@@ -96,7 +96,7 @@
 //     <i>  - Thread functions: osThreadGetZone, osThreadTerminateZone
 //     <i>  - Zone Management: osZoneSetup_Callback
 #ifndef OS_EXECUTION_ZONE
-#define OS_EXECUTION_ZONE           1
+#define OS_EXECUTION_ZONE           0
 #endif
  
 //     <q>Thread Watchdog
@@ -34,6 +34,8 @@
 
 #include <stdint.h>
 #include "LPC17xx.h"
+#include "clock_tree.h"
+#include "boot_time.h"
 
 /*
 //-------- <<< Use Configuration Wizard in Context Menu >>> ------------------
@@ -303,7 +305,7 @@
 #define USBCLKCFG_Val         0x00000000
 #define PCLKSEL0_Val          0x00000000
 #define PCLKSEL1_Val          0x00000000
-#define PCONP_Val             0x042887DE
+#define PCONP_Val             0x00008000
 #define CLKOUTCFG_Val         0x00000000
 
 
@@ -384,6 +386,14 @@
    #error "FLASHCFG: Invalid values of reserved bits!"
 #endif
 
+/* Clock tree model (clock_tree.h) must describe this configuration ----------*/
+#if ((PLL0CFG_Val   != CLK_BOOT_PLL0CFG)  || (PLL1CFG_Val   != CLK_BOOT_PLL1CFG)  || \
+     (CCLKCFG_Val   != CLK_BOOT_CCLKCFG)  || (PCLKSEL0_Val  != CLK_BOOT_PCLKSEL0) || \
+     (PCLKSEL1_Val  != CLK_BOOT_PCLKSEL1) || ((FLASHCFG_Val >> 12) != CLK_BOOT_FLASHTIM) || \
+     (CLKSRCSEL_Val != 1) || (PLL0_SETUP != 1) || (PLL1_SETUP != 1) || (CLOCK_SETUP != 1))
+   #error "Clock configuration differs from clock_tree.h!"
+#endif
+
 
 /*----------------------------------------------------------------------------
   DEFINES
@@ -430,12 +440,24 @@
  *----------------------------------------------------------------------------*/
 uint32_t SystemCoreClock = __CORE_CLK;
 
+#if (__CORE_CLK != CLK_BOOT_CCLK_HZ)
+   #error "__CORE_CLK differs from clock_tree.h!"
+#endif
+
 
 /*----------------------------------------------------------------------------
   SystemCoreClockUpdate
  *----------------------------------------------------------------------------*/
 void SystemCoreClockUpdate (void)               /* Get Core Clock Frequency   */
 {
+  /* Boot configuration still active: use the constant from clock_tree.h      */
+  if (((LPC_SC->PLL0STAT & 0x03FFFFFF) == (CLK_BOOT_PLL0CFG | (3UL << 24))) &&
+      ((LPC_SC->CCLKCFG  & 0xFF)       ==  CLK_BOOT_CCLKCFG)                &&
+      ((LPC_SC->CLKSRCSEL & 0x03)      ==  1)) {
+    SystemCoreClock = (uint32_t)CLK_BOOT_CCLK_HZ;
+    return;
+  }
+
   /* Determine clock frequency according to clock register values             */
   if (((LPC_SC->PLL0STAT >> 24) & 3) == 3) { /* If PLL0 enabled and connected */
     switch (LPC_SC->CLKSRCSEL & 0x03) {
@@ -481,51 +503,107 @@ void SystemCoreClockUpdate (void)               /* Get Core Clock Frequency   */
  *----------------------------------------------------------------------------*/
 void SystemInit (void)
 {
-#if (CLOCK_SETUP)                       /* Clock Setup                        */
-  LPC_SC->SCS       = SCS_Val;
-  if (LPC_SC->SCS & (1 << 5)) {             /* If Main Oscillator is enabled  */
-    while ((LPC_SC->SCS & (1<<6)) == 0);/* Wait for Oscillator to be ready    */
-  }
+  bootCycleInit();                      /* Start boot timestamps (DWT)        */
 
-  LPC_SC->CCLKCFG   = CCLKCFG_Val;      /* Setup Clock Divider                */
-  /* Periphral clock must be selected before PLL0 enabling and connecting
-   * - according errata.lpc1768-16.March.2010 -
+#if (CLOCK_SETUP)                       /* Clock Setup                        */
+  /* Warm restart: a reset that did not reach the clock block (core or
+   * software reset) leaves PLL0 running with the boot configuration.
+   * PCLKSEL is not part of the decision: drivers change it in every run,
+   * it is set back to the boot dividers below.
    */
-  LPC_SC->PCLKSEL0  = PCLKSEL0_Val;     /* Peripheral Clock Selection         */
-  LPC_SC->PCLKSEL1  = PCLKSEL1_Val;
+  bootWarmClock = ((LPC_SC->PLL0STAT & 0x03FFFFFF) == (PLL0CFG_Val | (3UL << 24))) &&
+                  ((LPC_SC->CCLKCFG   & 0xFF)       ==  CCLKCFG_Val)                &&
+                  ((LPC_SC->CLKSRCSEL & 0x03)       ==  CLKSRCSEL_Val);
+#else
+  bootWarmClock = 0U;
+#endif
+  /* The warm path keeps running at the boot clock, a cold one on the IRC     */
+  bootMark(BOOT_RESET, (bootWarmClock != 0U) ? (uint32_t)__CORE_CLK : IRC_OSC);
+
+#if (FLASH_SETUP == 1)                  /* Flash Accelerator Setup            */
+  /* Set before any clock change: valid for every frequency on the way up     */
+  LPC_SC->FLASHCFG  = (LPC_SC->FLASHCFG & ~0x0000F000) | FLASHCFG_Val;
+#endif
 
-  LPC_SC->CLKSRCSEL = CLKSRCSEL_Val;    /* Select Clock Source sysclk / PLL0  */
+#if (CLOCK_SETUP)                       /* Clock Setup                        */
+  if (bootWarmClock == 0U) {
+    /* PLL0 may still run with another configuration: stop it first          */
+    if (LPC_SC->PLL0STAT & (1<<25)) {
+      LPC_SC->PLL0CON   = 0x01;         /* PLL0 Disconnect                    */
+      LPC_SC->PLL0FEED  = 0xAA;
+      LPC_SC->PLL0FEED  = 0x55;
+    }
+    LPC_SC->PLL0CON   = 0x00;           /* PLL0 Disable                       */
+    LPC_SC->PLL0FEED  = 0xAA;
+    LPC_SC->PLL0FEED  = 0x55;
+
+    LPC_SC->SCS       = SCS_Val;
+    if (LPC_SC->SCS & (1 << 5)) {           /* If Main Oscillator is enabled  */
+      while ((LPC_SC->SCS & (1<<6)) == 0);/* Wait for Oscillator to be ready  */
+    }
+
+    /* Run undivided from the oscillator while the PLLs lock, CCLKCFG_Val is
+     * applied right before PLL0 is connected
+     */
+    LPC_SC->CCLKCFG   = 0;
+    /* Periphral clock must be selected before PLL0 enabling and connecting
+     * - according errata.lpc1768-16.March.2010 -
+     */
+    LPC_SC->PCLKSEL0  = PCLKSEL0_Val;   /* Peripheral Clock Selection         */
+    LPC_SC->PCLKSEL1  = PCLKSEL1_Val;
+
+    LPC_SC->CLKSRCSEL = CLKSRCSEL_Val;  /* Select Clock Source sysclk / PLL0  */
+    bootMark(BOOT_OSC_READY, OSC_CLK);
 
 #if (PLL0_SETUP)
-  LPC_SC->PLL0CFG   = PLL0CFG_Val;      /* configure PLL0                     */
-  LPC_SC->PLL0FEED  = 0xAA;
-  LPC_SC->PLL0FEED  = 0x55;
-
-  LPC_SC->PLL0CON   = 0x01;             /* PLL0 Enable                        */
-  LPC_SC->PLL0FEED  = 0xAA;
-  LPC_SC->PLL0FEED  = 0x55;
-  while (!(LPC_SC->PLL0STAT & (1<<26)));/* Wait for PLOCK0                    */
-
-  LPC_SC->PLL0CON   = 0x03;             /* PLL0 Enable & Connect              */
-  LPC_SC->PLL0FEED  = 0xAA;
-  LPC_SC->PLL0FEED  = 0x55;
-  while ((LPC_SC->PLL0STAT & ((1<<25) | (1<<24))) != ((1<<25) | (1<<24)));  /* Wait for PLLC0_STAT & PLLE0_STAT */
+    LPC_SC->PLL0CFG   = PLL0CFG_Val;    /* configure PLL0                     */
+    LPC_SC->PLL0FEED  = 0xAA;
+    LPC_SC->PLL0FEED  = 0x55;
+
+    LPC_SC->PLL0CON   = 0x01;           /* PLL0 Enable, locks in parallel with PLL1 */
+    LPC_SC->PLL0FEED  = 0xAA;
+    LPC_SC->PLL0FEED  = 0x55;
 #endif
+  } else {
+    /* Boot dividers with PLL0 connected; only if the write did not take
+     * effect (erratum PCLKSELx.1) is PLL0 disconnected for it, it stays
+     * locked and is reconnected right after (as clkPclkSelect does)
+     */
+    LPC_SC->PCLKSEL0  = PCLKSEL0_Val;
+    LPC_SC->PCLKSEL1  = PCLKSEL1_Val;
+    if ((LPC_SC->PCLKSEL0 != PCLKSEL0_Val) || (LPC_SC->PCLKSEL1 != PCLKSEL1_Val)) {
+      LPC_SC->PLL0CON   = 0x01;         /* PLL0 Disconnect                    */
+      LPC_SC->PLL0FEED  = 0xAA;
+      LPC_SC->PLL0FEED  = 0x55;
+      LPC_SC->PCLKSEL0  = PCLKSEL0_Val;
+      LPC_SC->PCLKSEL1  = PCLKSEL1_Val;
+      LPC_SC->PLL0CON   = 0x03;         /* PLL0 Enable & Connect              */
+      LPC_SC->PLL0FEED  = 0xAA;
+      LPC_SC->PLL0FEED  = 0x55;
+      while ((LPC_SC->PLL0STAT & ((1<<25) | (1<<24))) != ((1<<25) | (1<<24)));
+    }
+    bootMark(BOOT_OSC_READY, (uint32_t)__CORE_CLK);
+  }
 
 #if (PLL1_SETUP)
-  LPC_SC->PLL1CFG   = PLL1CFG_Val;
-  LPC_SC->PLL1FEED  = 0xAA;
-  LPC_SC->PLL1FEED  = 0x55;
-
-  LPC_SC->PLL1CON   = 0x01;             /* PLL1 Enable                        */
-  LPC_SC->PLL1FEED  = 0xAA;
-  LPC_SC->PLL1FEED  = 0x55;
-  while (!(LPC_SC->PLL1STAT & (1<<10)));/* Wait for PLOCK1                    */
-
-  LPC_SC->PLL1CON   = 0x03;             /* PLL1 Enable & Connect              */
-  LPC_SC->PLL1FEED  = 0xAA;
-  LPC_SC->PLL1FEED  = 0x55;
-  while ((LPC_SC->PLL1STAT & ((1<< 9) | (1<< 8))) != ((1<< 9) | (1<< 8)));  /* Wait for PLLC1_STAT & PLLE1_STAT */
+  if ((LPC_SC->PLL1STAT & 0x37F) != (PLL1CFG_Val | (3 << 8))) {
+    if (LPC_SC->PLL1STAT & (1<<9)) {
+      LPC_SC->PLL1CON   = 0x01;         /* PLL1 Disconnect                    */
+      LPC_SC->PLL1FEED  = 0xAA;
+      LPC_SC->PLL1FEED  = 0x55;
+    }
+    LPC_SC->PLL1CON   = 0x00;           /* PLL1 Disable                       */
+    LPC_SC->PLL1FEED  = 0xAA;
+    LPC_SC->PLL1FEED  = 0x55;
+
+    LPC_SC->PLL1CFG   = PLL1CFG_Val;
+    LPC_SC->PLL1FEED  = 0xAA;
+    LPC_SC->PLL1FEED  = 0x55;
+
+    LPC_SC->PLL1CON   = 0x01;           /* PLL1 Enable, connected by bootPll1Connect */
+    LPC_SC->PLL1FEED  = 0xAA;
+    LPC_SC->PLL1FEED  = 0x55;
+  }
 #else
   LPC_SC->USBCLKCFG = USBCLKCFG_Val;    /* Setup USB Clock Divider            */
 #endif
@@ -533,9 +611,20 @@ void SystemInit (void)
   LPC_SC->PCONP     = PCONP_Val;        /* Power Control for Peripherals      */
 
   LPC_SC->CLKOUTCFG = CLKOUTCFG_Val;    /* Clock Output Configuration         */
-#endif
 
-#if (FLASH_SETUP == 1)                  /* Flash Accelerator Setup            */
-  LPC_SC->FLASHCFG  = (LPC_SC->FLASHCFG & ~0x0000F000) | FLASHCFG_Val;
+  if (bootWarmClock == 0U) {
+#if (PLL0_SETUP)
+    while (!(LPC_SC->PLL0STAT & (1<<26)));/* Wait for PLOCK0                  */
+
+    LPC_SC->CCLKCFG   = CCLKCFG_Val;    /* Setup Clock Divider                */
+    LPC_SC->PLL0CON   = 0x03;           /* PLL0 Enable & Connect              */
+    LPC_SC->PLL0FEED  = 0xAA;
+    LPC_SC->PLL0FEED  = 0x55;
+    while ((LPC_SC->PLL0STAT & ((1<<25) | (1<<24))) != ((1<<25) | (1<<24)));  /* Wait for PLLC0_STAT & PLLE0_STAT */
+#else
+    LPC_SC->CCLKCFG   = CCLKCFG_Val;    /* Setup Clock Divider                */
+#endif
+  }
+  bootMark(BOOT_PLL0_READY, (uint32_t)__CORE_CLK);
 #endif
 }
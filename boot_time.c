@@ -0,0 +1,64 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    boot_time.c
+ * Purpose: Boot phase timestamps and deferred USB PLL connect
+ *----------------------------------------------------------------------------*/
+
+
+#include "boot_time.h"
+#include "clock_tree.h"
+#include "mem_sections.h"
+
+bootStamp_t        bootStamp[BOOT_PHASE_NUM] __NOINIT;  // Written before C init
+uint32_t           bootWarmClock             __NOINIT;  // Written before C init
+__USED uint32_t    bootPhaseUs[BOOT_PHASE_NUM];         // Reset to phase in us
+
+/*-----------------------------------------------------------------------------
+  bootPll1Connect: connect the USB PLL started by SystemInit
+  PLL1 locks while the C runtime and the early drivers initialize.
+ *----------------------------------------------------------------------------*/
+void bootPll1Connect (void) {
+  // PLLE1 set and PLLC1 clear: enabled by SystemInit, not yet connected
+  if ((LPC_SC->PLL1STAT & ((1UL << 9) | (1UL << 8))) == (1UL << 8)) {
+    while ((LPC_SC->PLL1STAT & (1UL << 10)) == 0U);     // Wait for PLOCK1
+
+    LPC_SC->PLL1CON  = 0x03U;           // PLL1 Enable & Connect
+    LPC_SC->PLL1FEED = 0xAAU;
+    LPC_SC->PLL1FEED = 0x55U;
+    while ((LPC_SC->PLL1STAT & ((1UL << 9) | (1UL << 8))) != ((1UL << 9) | (1UL << 8)));
+  }
+  bootMark(BOOT_PLL1_READY, SystemCoreClock);
+}
+
+/*-----------------------------------------------------------------------------
+  bootDone: mark the first application thread and convert the timestamps
+  Each interval is converted with the CPU clock that was active during it.
+ *----------------------------------------------------------------------------*/
+void bootDone (void) {
+  uint64_t us = 0U;
+  uint32_t n;
+
+  bootMark(BOOT_FIRST_THREAD, SystemCoreClock);
+
+  bootPhaseUs[BOOT_RESET] = 0U;
+  for (n = 1U; n < BOOT_PHASE_NUM; n++) {
+    us += ((uint64_t)(bootStamp[n].cycles - bootStamp[n - 1U].cycles) * 1000000U) /
+          bootStamp[n - 1U].cclk;
+    bootPhaseUs[n] = (uint32_t)us;
+  }
+}
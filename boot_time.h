@@ -0,0 +1,80 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    boot_time.h
+ * Purpose: Boot phase timestamps and deferred USB PLL connect
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef BOOT_TIME_H__
+#define BOOT_TIME_H__
+
+#include <stdint.h>
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+/*
+  Boot phases in order of occurrence. Timestamps are taken with the DWT cycle
+  counter, which SystemInit starts as its first action; the boot ROM and the
+  few instructions of Reset_Handler before that are not covered.
+*/
+#define BOOT_RESET              0U      // SystemInit entry (internal RC oscillator)
+#define BOOT_OSC_READY          1U      // Main oscillator selected, PLLs locking
+#define BOOT_PLL0_READY         2U      // PLL0 connected, CPU at full speed
+#define BOOT_CRT_DONE           3U      // C runtime initialized, main entered
+#define BOOT_PLL1_READY         4U      // USB PLL connected
+#define BOOT_KERNEL_START       5U      // osKernelStart called
+#define BOOT_FIRST_THREAD       6U      // First application thread running
+#define BOOT_PHASE_NUM          7U
+
+// Timestamp of one boot phase (kept in a no-init section, written before C init)
+typedef struct {
+  uint32_t cycles;                      // DWT CYCCNT at phase entry
+  uint32_t cclk;                        // CPU clock until the next phase in Hz
+} bootStamp_t;
+
+extern bootStamp_t bootStamp[BOOT_PHASE_NUM];
+
+// Set by SystemInit: PLL0 was found running with the boot configuration
+extern uint32_t    bootWarmClock;
+
+// Microseconds from SystemInit entry to each phase (valid after bootDone)
+extern uint32_t    bootPhaseUs[BOOT_PHASE_NUM];
+
+/* Prototypes */
+extern void     bootPll1Connect (void);
+extern void     bootDone        (void);
+
+/*-----------------------------------------------------------------------------
+  Start the cycle counter (called first in SystemInit)
+ *----------------------------------------------------------------------------*/
+__STATIC_INLINE void bootCycleInit (void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT       = 0U;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*-----------------------------------------------------------------------------
+  Record entry of a boot phase and the CPU clock it runs at
+ *----------------------------------------------------------------------------*/
+__STATIC_INLINE void bootMark (uint32_t phase, uint32_t cclk) {
+  bootStamp[phase].cycles = DWT->CYCCNT;
+  bootStamp[phase].cclk   = cclk;
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    brownout.c
+ * Purpose: Brown-out early warning: shed load and save a state snapshot
+ *----------------------------------------------------------------------------*/
+
+
+#define IRQ_ZERO_LATENCY                // BOD_IRQHandler is zero-latency
+#include "irq_prio.h"
+#include "brownout.h"
+
+#include "clk_profile.h"
+#include "retained.h"
+#include "mem_sections.h"
+
+#define BOD_MAGIC               0x424F4421U     // "BOD!"
+
+#if ((BOD_SNAPSHOT_SIZE % 4U) != 0U)
+#error "BOD_SNAPSHOT_SIZE must be a multiple of 4"
+#endif
+
+// Snapshot region
+typedef struct {
+  const uint32_t *addr;
+  uint32_t        words;
+} bodRegion_t;
+
+static bodRegion_t     bodRegion[BOD_REGION_MAX];
+static uint32_t        bodRegionNum;
+static uint32_t        bodWords;                // Total registered words
+static uint32_t        bodPconp;                // PCONP before the brown-out
+static volatile uint32_t bodTripped;
+
+static bodRecord_t     bodRecord __NOINIT;      // Written by BOD_IRQHandler
+static bodRecord_t     bodLast;                 // Record of the previous run
+
+__USED uint32_t        bodBudgetMisses;         // Handler exceeded budget
+__USED uint32_t        bodClkDeferred;          // Clock drop left to a PLL sequence
+
+/*-----------------------------------------------------------------------------
+  BOD interrupt: shed load first, then commit the snapshot
+ *----------------------------------------------------------------------------*/
+__RAMFUNC void BOD_IRQHandler (void) {
+  uint32_t        start = DWT->CYCCNT;
+  const uint32_t *src;
+  uint32_t       *dst;
+  uint32_t        n;
+  uint32_t        r;
+
+  // Level triggered while the supply is low: handle once until bodRecover.
+  // Direct register write, NVIC_DisableIRQ may be an out-of-line flash call.
+  NVIC->ICER[0] = 1UL << BOD_IRQn;
+
+  // PLLs off, core on the IRC (RAM code). A preempted profile switch or
+  // clkResume is left to finish its PLL sequence and stops the clocks then.
+  if (clkSuspend() != 0) {
+    bodClkDeferred++;
+  }
+  bodPconp      = LPC_SC->PCONP;
+  LPC_SC->PCONP = bodPconp & BOD_KEEP_PCONP;
+
+  bodRecord.magic = 0U;
+  dst = bodRecord.data;
+  for (r = 0U; r < bodRegionNum; r++) {
+    src = bodRegion[r].addr;
+    for (n = bodRegion[r].words; n != 0U; n--) {
+      *dst++ = *src++;
+    }
+  }
+  bodRecord.size   = bodWords * 4U;
+  bodRecord.seq++;
+  bodRecord.cycles = DWT->CYCCNT - start;
+  __DMB();
+  bodRecord.magic  = BOD_MAGIC;
+
+  if (bodRecord.cycles > BOD_BUDGET_CYCLES) {
+    bodBudgetMisses++;
+  }
+  bodTripped = 1U;
+}
+
+/*-----------------------------------------------------------------------------
+  bodInit: publish the record of the previous run and enable the interrupt
+  Call once from main after retInit.
+ *----------------------------------------------------------------------------*/
+int32_t bodInit (void) {
+  uint32_t seq = 0U;
+
+  // After power-on the record content is random, even a matching magic
+  if (((retGetResetCause() & RET_RESET_POR) == 0U) && (bodRecord.magic == BOD_MAGIC)) {
+    bodLast = bodRecord;
+    seq     = bodRecord.seq;
+  }
+  bodRecord.magic = 0U;
+  bodRecord.seq   = seq;
+
+  // Handler time is measured with the cycle counter
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  LPC_SC->PCON &= ~((1UL << 3) | (1UL << 4));   // BOD and BOD reset enabled
+  NVIC_ClearPendingIRQ(BOD_IRQn);
+  NVIC_EnableIRQ(BOD_IRQn);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  bodRegister: add a region to the snapshot (call before bodInit)
+  addr and size must be word aligned.
+ *----------------------------------------------------------------------------*/
+int32_t bodRegister (const void *addr, uint32_t size) {
+  if ((addr == NULL) || ((((uint32_t)addr) | size) & 3U) != 0U) {
+    return -1;
+  }
+  if ((bodRegionNum >= BOD_REGION_MAX) || ((bodWords * 4U) + size) > BOD_SNAPSHOT_SIZE) {
+    return -1;
+  }
+  bodRegion[bodRegionNum].addr  = (const uint32_t *)addr;
+  bodRegion[bodRegionNum].words = size / 4U;
+  bodRegionNum++;
+  bodWords += size / 4U;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  bodRecover: restore clocks and peripherals after the supply came back
+  Thread context. If the supply is still low the interrupt trips again.
+ *----------------------------------------------------------------------------*/
+int32_t bodRecover (void) {
+  if (bodTripped == 0U) {
+    return -1;
+  }
+  __disable_irq();
+  LPC_SC->PCONP = bodPconp;
+  clkResume();
+  bodTripped = 0U;
+  __enable_irq();
+
+  NVIC_ClearPendingIRQ(BOD_IRQn);
+  NVIC_EnableIRQ(BOD_IRQn);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  bodIsTripped: brown-out handled, system runs in reduced mode
+ *----------------------------------------------------------------------------*/
+uint32_t bodIsTripped (void) {
+  return bodTripped;
+}
+
+/*-----------------------------------------------------------------------------
+  bodGetLast: snapshot saved by the previous run (NULL if none)
+ *----------------------------------------------------------------------------*/
+const bodRecord_t *bodGetLast (void) {
+  if (bodLast.magic != BOD_MAGIC) {
+    return NULL;
+  }
+  return &bodLast;
+}
@@ -0,0 +1,83 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    brownout.h
+ * Purpose: Brown-out early warning: shed load and save a state snapshot
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef BROWNOUT_H__
+#define BROWNOUT_H__
+
+#include <stdint.h>
+
+/*
+  BOD_IRQHandler is a zero-latency interrupt. It stops the PLLs and runs the
+  core from the internal RC oscillator, powers down all peripherals except
+  BOD_KEEP_PCONP and copies the registered regions into a no-init record.
+  The record is published by bodInit on the next boot.
+
+  Registered regions are the precomputed snapshot: keep them small and up to
+  date, the handler only copies words. The handler and everything it calls
+  run from RAM.
+
+  The handler measures itself with the DWT cycle counter: bodRecord.cycles
+  holds the cycles from entry to the committed snapshot and bodBudgetMisses
+  counts handler runs above BOD_BUDGET_CYCLES.
+
+  A brown-out during a PLL sequence (clkProfileSet, clkResume) does not stop
+  the PLLs under it: the snapshot is taken at once, the clocks are stopped
+  when the sequence ends (counted in bodClkDeferred).
+*/
+
+// Snapshot size limit in bytes (multiple of 4)
+#ifndef BOD_SNAPSHOT_SIZE
+#define BOD_SNAPSHOT_SIZE       128U
+#endif
+
+// Maximum number of snapshot regions
+#ifndef BOD_REGION_MAX
+#define BOD_REGION_MAX          4U
+#endif
+
+// Cycle budget from handler entry to committed snapshot
+#ifndef BOD_BUDGET_CYCLES
+#define BOD_BUDGET_CYCLES       600U
+#endif
+
+// Peripherals kept powered during brown-out (PCONP bits: GPIO, RTC)
+#ifndef BOD_KEEP_PCONP
+#define BOD_KEEP_PCONP          ((1UL << 15) | (1UL << 9))
+#endif
+
+// Brown-out record (no-init RAM, valid when magic is set)
+typedef struct {
+  uint32_t magic;                       // Written last: snapshot complete
+  uint32_t seq;                         // Brown-out events since power-on
+  uint32_t cycles;                      // Handler entry to snapshot committed
+  uint32_t size;                        // Snapshot size in bytes
+  uint32_t data[BOD_SNAPSHOT_SIZE / 4U];
+} bodRecord_t;
+
+/* Prototypes */
+extern int32_t            bodInit      (void);
+extern int32_t            bodRegister  (const void *addr, uint32_t size);
+extern int32_t            bodRecover   (void);
+extern uint32_t           bodIsTripped (void);
+extern const bodRecord_t *bodGetLast   (void);
+
+#endif
@@ -0,0 +1,479 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    can.c
+ * Purpose: CAN driver with acceptance filter and zero-copy receive ring
+ *----------------------------------------------------------------------------*/
+
+
+#include "can.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "PIN_LPC17xx.h"
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+
+#include "clk_governor.h"
+#include "clk_profile.h"
+#include "irq_prio.h"
+#include "mem_sections.h"
+#include "pwr_periph.h"
+#include "timebase.h"
+
+#if   (CAN_CTRL == 1)
+#define CAN_REG                 LPC_CAN1
+#define CAN_PM                  PM_CAN1
+#elif (CAN_CTRL == 2)
+#define CAN_REG                 LPC_CAN2
+#define CAN_PM                  PM_CAN2
+#else
+#error "CAN_CTRL must be 1 or 2"
+#endif
+
+#if ((CAN_RX_RING & (CAN_RX_RING - 1U)) != 0U) || ((CAN_ID_STATS & (CAN_ID_STATS - 1U)) != 0U)
+#error "CAN_RX_RING and CAN_ID_STATS must be powers of 2"
+#endif
+
+#define CAN_PCLK_DIV            PM_PCLK_DIV2    // Also used for the acceptance filter
+#define CAN_PCLKSEL(code)       (((code) << 26) | ((code) << 28) | ((code) << 30))  // CAN1, CAN2, ACF
+#define CAN_EVENT_RX            0x0001U
+#define CAN_ID_PROBE            4U              // Statistics table probes per frame
+#define CAN_ID_VALID            0x20000000U     // Statistics table entry in use
+
+// MOD bits
+#define CAN_MOD_RM              0x01U   // Reset mode
+
+// CMR bits
+#define CAN_CMR_TR              0x01U   // Transmission request
+#define CAN_CMR_RRB             0x04U   // Release receive buffer
+#define CAN_CMR_CDO             0x08U   // Clear data overrun
+#define CAN_CMR_STB1            0x20U   // Select transmit buffer 1
+
+// GSR bits
+#define CAN_GSR_RBS             0x01U   // Receive buffer status
+#define CAN_GSR_DOS             0x02U   // Data overrun status
+#define CAN_GSR_BS              0x80U   // Bus off
+
+// ICR / IER bits
+#define CAN_INT_RI              0x001U
+#define CAN_INT_TI1             0x002U
+#define CAN_INT_EI              0x004U
+#define CAN_INT_DOI             0x008U
+#define CAN_INT_BEI             0x080U
+#define CAN_INT_TI2             0x200U
+#define CAN_INT_TI3             0x400U
+
+// RFS / TFI bits
+#define CAN_FS_FF               0x80000000U     // Extended frame format
+#define CAN_FS_RTR              0x40000000U     // Remote frame
+
+// AFMR modes
+#define CAN_AFMR_ON             0x00U
+#define CAN_AFMR_OFF            0x01U   // No frames accepted
+#define CAN_AFMR_BYPASS         0x02U   // All frames accepted
+
+static canFrame_t       canRx[CAN_RX_RING];
+static volatile uint32_t canRxHead;     // Written by the CAN interrupt
+static volatile uint32_t canRxTail;     // Written by the consumer
+static osEventFlagsId_t canEvents;
+static canRxHook_t      canRxHook;      // Frames handled in the interrupt
+
+static canTxCallback_t  canTxCb[3];     // Per transmit buffer
+static void            *canTxArg[3];
+static uint32_t         canTxBusy;      // Transmit buffers in use (bit mask)
+
+static canIdStats_t     canIdTab[CAN_ID_STATS];
+static uint32_t         canGovProfile;  // Lowest clock profile reaching CAN_BITRATE
+
+__USED canStats_t       canStats;
+
+// Transmit complete interrupt per transmit buffer
+static const uint32_t canTiBit[3] = { CAN_INT_TI1, CAN_INT_TI2, CAN_INT_TI3 };
+
+/*-----------------------------------------------------------------------------
+  canBitTiming: BTR value for bitrate (sample point near 80 %, -1: none)
+ *----------------------------------------------------------------------------*/
+int32_t canBitTiming (uint32_t pclk, uint32_t bitrate) {
+  uint32_t best     = 0xFFFFFFFFU;
+  uint32_t best_err = 0xFFFFFFFFU;
+  uint32_t tq;
+  uint32_t brp;
+  uint32_t tseg1;
+  uint32_t tseg2;
+  uint32_t err;
+
+  if (bitrate == 0U) {
+    return -1;
+  }
+  for (tq = 25U; tq >= 8U; tq--) {
+    if ((pclk % (bitrate * tq)) != 0U) {
+      continue;
+    }
+    brp = pclk / (bitrate * tq);
+    if ((brp == 0U) || (brp > 1024U)) {
+      continue;
+    }
+    tseg1 = (((tq * 4U) + 2U) / 5U) - 1U;       // Sync segment + tseg1 = 80 %
+    if (tseg1 > 16U) {
+      tseg1 = 16U;
+    }
+    tseg2 = tq - 1U - tseg1;
+    if ((tseg2 < 1U) || (tseg2 > 8U)) {
+      continue;
+    }
+    err = (((tseg1 + 1U) * 1000U) / tq);
+    err = (err > 800U) ? (err - 800U) : (800U - err);
+    if (err < best_err) {
+      best_err = err;
+      best     = (brp - 1U) |
+                 ((((tseg2 < 4U) ? tseg2 : 4U) - 1U) << 14) |
+                 ((tseg1 - 1U) << 16) |
+                 ((tseg2 - 1U) << 20);
+    }
+  }
+  return (best_err == 0xFFFFFFFFU) ? -1 : (int32_t)best;
+}
+
+/*-----------------------------------------------------------------------------
+  Per identifier statistics (bounded probing, CAN interrupt context)
+ *----------------------------------------------------------------------------*/
+static void canIdCount (uint32_t id, uint32_t ts) {
+  canIdStats_t *s;
+  uint32_t key = (id & ~CAN_ID_RTR) | CAN_ID_VALID;
+  uint32_t idx = (key ^ (key >> 11) ^ (key >> 22)) & (CAN_ID_STATS - 1U);
+  uint32_t n;
+
+  for (n = 0U; n < CAN_ID_PROBE; n++) {
+    s = &canIdTab[(idx + n) & (CAN_ID_STATS - 1U)];
+    if (s->id == 0U) {
+      s->id = key;                      // New identifier
+    }
+    if (s->id == key) {
+      if ((s->frames != 0U) && ((ts - s->last) > s->period_max)) {
+        s->period_max = ts - s->last;
+      }
+      s->frames++;
+      s->last = ts;
+      return;
+    }
+  }
+  canStats.id_drops++;
+}
+
+/*-----------------------------------------------------------------------------
+  CAN interrupt: receive, transmit completion and errors
+ *----------------------------------------------------------------------------*/
+__RAMFUNC void CAN_IRQHandler (void) {
+  canFrame_t  drop;                     // Frame read while the ring is full
+  canFrame_t *f;
+  uint32_t ts = tbGetUs();
+  uint32_t icr;
+  uint32_t rfs;
+  uint32_t head;
+  uint32_t used;
+  uint32_t wake = 0U;
+  uint32_t n;
+
+  icr = CAN_REG->ICR;                   // Clears all flags except RI
+
+  while ((CAN_REG->GSR & CAN_GSR_RBS) != 0U) {
+    rfs  = CAN_REG->RFS;
+    head = canRxHead;
+    used = head - canRxTail;
+    f    = (used < CAN_RX_RING) ? &canRx[head & (CAN_RX_RING - 1U)] : &drop;
+    f->id = CAN_REG->RID;
+    if ((rfs & CAN_FS_FF) != 0U) {
+      f->id |= CAN_ID_EXT;
+    }
+    if ((rfs & CAN_FS_RTR) != 0U) {
+      f->id |= CAN_ID_RTR;
+    }
+    f->ts        = ts;
+    f->dlc       = (uint8_t)((rfs >> 16) & 0x0FU);
+    if (f->dlc > 8U) {
+      f->dlc = 8U;
+    }
+    f->filter    = (uint16_t)(rfs & 0x3FFU);
+    f->data.w[0] = CAN_REG->RDA;
+    f->data.w[1] = CAN_REG->RDB;
+    CAN_REG->CMR = CAN_CMR_RRB;
+    canIdCount(f->id, ts);
+    canStats.rx_frames++;
+
+    if ((canRxHook != NULL) && (canRxHook(f) != 0U)) {
+      continue;                         // Consumed by the hook
+    }
+    if (f == &drop) {
+      canStats.ring_drops++;
+      continue;
+    }
+    __DMB();
+    canRxHead = head + 1U;
+    if (used == 0U) {
+      wake = 1U;                        // Consumer may be waiting
+    }
+    if ((used + 1U) > canStats.ring_max) {
+      canStats.ring_max = used + 1U;
+    }
+  }
+
+  for (n = 0U; n < 3U; n++) {
+    if (((icr & canTiBit[n]) != 0U) && ((canTxBusy & (1U << n)) != 0U)) {
+      canTxBusy &= ~(1U << n);
+      canStats.tx_frames++;
+      if (canTxCb[n] != NULL) {
+        canTxCb[n](ts, canTxArg[n]);
+      }
+    }
+  }
+
+  if ((icr & CAN_INT_DOI) != 0U) {
+    CAN_REG->CMR = CAN_CMR_CDO;
+    canStats.overruns++;
+  }
+  if ((icr & CAN_INT_BEI) != 0U) {
+    canStats.bus_errors++;
+  }
+  if (((icr & CAN_INT_EI) != 0U) && ((CAN_REG->GSR & CAN_GSR_BS) != 0U)) {
+    canStats.bus_off++;
+    canTxBusy     = 0U;                 // Pending transmissions are aborted
+    CAN_REG->MOD &= ~CAN_MOD_RM;        // Rejoin after 128 x 11 recessive bits
+  }
+
+  if (wake != 0U) {
+    osEventFlagsSet(canEvents, CAN_EVENT_RX);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Bit timing follows clock profile changes (controller stays in reset
+  mode while the bit rate cannot be reached with the current PCLK)
+ *----------------------------------------------------------------------------*/
+static void canClockNotify (uint32_t event, uint32_t cclk) {
+  int32_t btr;
+  (void)cclk;
+
+  if (event == CLK_EVENT_POST) {
+    btr = canBitTiming(pmGetPclk(CAN_PM), CAN_BITRATE);
+    CAN_REG->MOD |= CAN_MOD_RM;
+    if (btr >= 0) {
+      CAN_REG->BTR  = (uint32_t)btr;
+      CAN_REG->MOD &= ~CAN_MOD_RM;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Lowest clock profile at which CAN_BITRATE can be reached (CLK_PROFILE_NUM: none)
+ *----------------------------------------------------------------------------*/
+static uint32_t canGovMin (void) {
+  uint32_t profile;
+
+  for (profile = 0U; profile < CLK_PROFILE_NUM; profile++) {
+    if (canBitTiming(pmGetPclkAt(CAN_PM, clkProfileGetFreq(profile)), CAN_BITRATE) >= 0) {
+      break;
+    }
+  }
+  return profile;
+}
+
+/*-----------------------------------------------------------------------------
+  canInit: set up the controller (acceptance filter bypassed)
+  The controller is on the bus all the time, so the clock governor is held at
+  the lowest profile reaching the bit rate until then. Below it the controller
+  waits in reset mode for the switch (canClockNotify).
+ *----------------------------------------------------------------------------*/
+int32_t canInit (void) {
+  int32_t btr;
+
+  if (pmAcquire(CAN_PM, CAN_PCLK_DIV) != 0) {
+    return -1;
+  }
+  canGovProfile = canGovMin();
+  canEvents     = osEventFlagsNew(NULL);
+  if ((canGovProfile >= CLK_PROFILE_NUM) || (canEvents == NULL)) {
+    if (canEvents != NULL) {
+      (void)osEventFlagsDelete(canEvents);
+      canEvents = NULL;
+    }
+    pmRelease(CAN_PM);
+    return -1;
+  }
+  btr = canBitTiming(pmGetPclk(CAN_PM), CAN_BITRATE);
+  // CAN1, CAN2 and the acceptance filter must use the same PCLK (UM10360 4.7.3)
+  clkPclkSelect(0U, CAN_PCLKSEL(0x03UL), CAN_PCLKSEL((uint32_t)CAN_PCLK_DIV));
+
+#if (CAN_CTRL == 1)
+  PIN_Configure(0U, 21U, PIN_FUNC_3, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // RD1
+  PIN_Configure(0U, 22U, PIN_FUNC_3, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // TD1
+#else
+  PIN_Configure(0U,  4U, PIN_FUNC_2, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // RD2
+  PIN_Configure(0U,  5U, PIN_FUNC_2, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // TD2
+#endif
+
+  CAN_REG->MOD = CAN_MOD_RM;
+  CAN_REG->IER = 0U;
+  CAN_REG->GSR = 0U;                    // Clear error counters
+  LPC_CANAF->AFMR = CAN_AFMR_BYPASS;
+  if (clkNotifyRegister(canClockNotify) != 0) {
+    (void)osEventFlagsDelete(canEvents);
+    canEvents = NULL;
+    pmRelease(CAN_PM);
+    return -1;
+  }
+
+  CAN_REG->IER = CAN_INT_RI | CAN_INT_TI1 | CAN_INT_TI2 | CAN_INT_TI3 |
+                 CAN_INT_EI | CAN_INT_DOI | CAN_INT_BEI;
+  if (btr >= 0) {
+    CAN_REG->BTR = (uint32_t)btr;
+    CAN_REG->MOD = 0U;
+  }
+  govHoldMin(canGovProfile);
+  NVIC_ClearPendingIRQ(CAN_IRQn);
+  NVIC_EnableIRQ(CAN_IRQn);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  canFilterSet: load the acceptance filter (num = 0: accept all frames)
+  The table is compiled in place; on error no frames are accepted.
+ *----------------------------------------------------------------------------*/
+int32_t canFilterSet (const canFilterRule_t *rule, uint32_t num) {
+  canFilterTable_t tab;
+
+  if (num == 0U) {
+    LPC_CANAF->AFMR = CAN_AFMR_BYPASS;
+    return 0;
+  }
+
+  LPC_CANAF->AFMR = CAN_AFMR_OFF;
+  if (canFilterCompile(rule, num, (uint32_t *)&LPC_CANAF_RAM->mask[0], &tab) < 0) {
+    return -1;
+  }
+  LPC_CANAF->SFF_sa     = tab.sff_sa;
+  LPC_CANAF->SFF_GRP_sa = tab.sff_grp_sa;
+  LPC_CANAF->EFF_sa     = tab.eff_sa;
+  LPC_CANAF->EFF_GRP_sa = tab.eff_grp_sa;
+  LPC_CANAF->ENDofTable = tab.end;
+  LPC_CANAF->AFMR = CAN_AFMR_ON;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  canRxPeek: oldest received frame, valid until canRxRelease (NULL: timeout)
+  Only one consumer thread may read the ring.
+ *----------------------------------------------------------------------------*/
+const canFrame_t *canRxPeek (uint32_t timeout) {
+  uint32_t flags;
+
+  for (;;) {
+    if (canRxHead != canRxTail) {
+      __DMB();
+      return &canRx[canRxTail & (CAN_RX_RING - 1U)];
+    }
+    flags = osEventFlagsWait(canEvents, CAN_EVENT_RX, osFlagsWaitAny, timeout);
+    if ((flags & osFlagsError) != 0U) {
+      return NULL;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  canRxRelease: return the frame from canRxPeek to the ring
+ *----------------------------------------------------------------------------*/
+void canRxRelease (void) {
+  if (canRxHead != canRxTail) {
+    __DMB();
+    canRxTail = canRxTail + 1U;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  canSend: queue a frame in a free transmit buffer (-1: all busy)
+  cb is called from the CAN interrupt when the frame has been sent.
+ *----------------------------------------------------------------------------*/
+int32_t canSend (const canFrame_t *frame, canTxCallback_t cb, void *arg) {
+  volatile uint32_t *buf;
+  uint32_t basepri;
+  uint32_t tfi;
+  uint32_t n;
+
+  if ((frame == NULL) || (frame->dlc > 8U)) {
+    return -1;
+  }
+  tfi = ((uint32_t)frame->dlc << 16);
+  if ((frame->id & CAN_ID_EXT) != 0U) {
+    tfi |= CAN_FS_FF;
+  }
+  if ((frame->id & CAN_ID_RTR) != 0U) {
+    tfi |= CAN_FS_RTR;
+  }
+
+  basepri = irqKernelLock();
+  for (n = 0U; n < 3U; n++) {
+    if ((canTxBusy & (1U << n)) == 0U) {
+      break;
+    }
+  }
+  if (n == 3U) {
+    irqKernelUnlock(basepri);
+    return -1;
+  }
+  canTxBusy  |= (1U << n);
+  canTxCb[n]  = cb;
+  canTxArg[n] = arg;
+
+  buf    = &CAN_REG->TFI1 + (n * 4U);   // TFIx, TIDx, TDAx, TDBx
+  buf[0] = tfi;
+  buf[1] = frame->id & CAN_ID_MASK;
+  buf[2] = frame->data.w[0];
+  buf[3] = frame->data.w[1];
+  CAN_REG->CMR = CAN_CMR_TR | (CAN_CMR_STB1 << n);
+  irqKernelUnlock(basepri);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  canSetRxHook: handle frames in the CAN interrupt before they are queued
+ *----------------------------------------------------------------------------*/
+void canSetRxHook (canRxHook_t hook) {
+  canRxHook = hook;
+}
+
+/*-----------------------------------------------------------------------------
+  canGetStats: get driver statistics
+ *----------------------------------------------------------------------------*/
+void canGetStats (canStats_t *stats) {
+  *stats = canStats;
+}
+
+/*-----------------------------------------------------------------------------
+  canGetIdStats: copy up to max per identifier entries, returns the count
+ *----------------------------------------------------------------------------*/
+uint32_t canGetIdStats (canIdStats_t *stats, uint32_t max) {
+  uint32_t count = 0U;
+  uint32_t n;
+
+  for (n = 0U; (n < CAN_ID_STATS) && (count < max); n++) {
+    if (canIdTab[n].id != 0U) {
+      stats[count]     = canIdTab[n];
+      stats[count].id &= ~CAN_ID_VALID;
+      count++;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,130 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    can.h
+ * Purpose: CAN driver with acceptance filter and zero-copy receive ring
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef CAN_H__
+#define CAN_H__
+
+#include <stdint.h>
+
+#include "can_filter.h"
+
+/*
+  The CAN interrupt copies each accepted frame into a single producer,
+  single consumer ring together with its reception time and releases the
+  hardware buffer at once; the consumer thread reads the frames in place:
+
+    const canFrame_t *f;
+    while ((f = canRxPeek(osWaitForever)) != NULL) {
+      handle(f);
+      canRxRelease();
+    }
+
+  The acceptance filter is built by canFilterCompile (can_filter.h) from
+  identifiers and ranges, so unwanted traffic never raises an interrupt.
+  Frames are counted per identifier in a small table (canGetIdStats). A
+  receive hook (canSetRxHook) sees every frame in the interrupt first and
+  may consume it, for example time synchronization frames.
+
+  At 1 Mbit/s a frame takes at least 47 us: the interrupt must be served
+  within one frame time (two with the second receive buffer), see
+  IRQ_PRIO_TABLE in irq_prio.h.
+
+  Wiring (mbed): CAN_CTRL 2: p30 RD2 P0.4, p29 TD2 P0.5
+                 CAN_CTRL 1: P0.21 RD1, P0.22 TD1 (p9/p10 are used by I2C1)
+*/
+
+// Controller (1 or 2)
+#ifndef CAN_CTRL
+#define CAN_CTRL                2
+#endif
+
+// Bit rate in bit/s
+#ifndef CAN_BITRATE
+#define CAN_BITRATE             1000000U
+#endif
+
+// Receive ring size in frames (power of 2)
+#ifndef CAN_RX_RING
+#define CAN_RX_RING             64U
+#endif
+
+// Identifiers tracked by the statistics table (power of 2)
+#ifndef CAN_ID_STATS
+#define CAN_ID_STATS            32U
+#endif
+
+// Identifier flags
+#define CAN_ID_EXT              0x80000000U     // 29-bit identifier
+#define CAN_ID_RTR              0x40000000U     // Remote frame
+#define CAN_ID_MASK             0x1FFFFFFFU
+
+// Frame
+typedef struct {
+  uint32_t id;                          // Identifier and CAN_ID_xxx flags
+  uint32_t ts;                          // Reception or transmission time (us)
+  uint8_t  dlc;                         // Data length code (0 .. 8)
+  uint8_t  rsvd;
+  uint16_t filter;                      // Acceptance filter entry index
+  union {
+    uint8_t  b[8];
+    uint32_t w[2];
+  } data;
+} canFrame_t;
+
+// Receive hook (CAN interrupt context, return 1: frame consumed, not queued)
+typedef uint32_t (*canRxHook_t) (const canFrame_t *frame);
+
+// Transmit completion callback (CAN interrupt context, ts: end of frame in us)
+typedef void (*canTxCallback_t) (uint32_t ts, void *arg);
+
+// Per identifier statistics
+typedef struct {
+  uint32_t id;                          // Identifier and CAN_ID_EXT
+  uint32_t frames;
+  uint32_t last;                        // Time of the last frame (us)
+  uint32_t period_max;                  // Longest gap between frames (us)
+} canIdStats_t;
+
+// Statistics
+typedef struct {
+  uint32_t rx_frames;
+  uint32_t tx_frames;
+  uint32_t ring_drops;                  // Receive ring full
+  uint32_t overruns;                    // Hardware data overrun
+  uint32_t bus_errors;
+  uint32_t bus_off;
+  uint32_t id_drops;                    // Identifiers not tracked (table full)
+  uint32_t ring_max;                    // Most frames waiting
+} canStats_t;
+
+/* Prototypes */
+extern int32_t           canInit        (void);
+extern int32_t           canFilterSet   (const canFilterRule_t *rule, uint32_t num);
+extern const canFrame_t *canRxPeek      (uint32_t timeout);
+extern void              canRxRelease   (void);
+extern int32_t           canSend        (const canFrame_t *frame, canTxCallback_t cb, void *arg);
+extern void              canSetRxHook   (canRxHook_t hook);
+extern void              canGetStats    (canStats_t *stats);
+extern uint32_t          canGetIdStats  (canIdStats_t *stats, uint32_t max);
+extern int32_t           canBitTiming   (uint32_t pclk, uint32_t bitrate);
+
+#endif
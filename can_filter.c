@@ -0,0 +1,184 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    can_filter.c
+ * Purpose: CAN acceptance filter table compiler
+ *----------------------------------------------------------------------------*/
+
+
+#include <stddef.h>
+
+#include "can_filter.h"
+
+#define CAN_SFF_DISABLE         0x1000U // Entry disabled (padding)
+
+/*-----------------------------------------------------------------------------
+  Sort ascending (insertion sort: tables are short and built once)
+ *----------------------------------------------------------------------------*/
+static void canSort (uint32_t *tab, uint32_t num, uint32_t stride) {
+  uint32_t key[2];
+  uint32_t i;
+  uint32_t j;
+  uint32_t k;
+
+  for (i = 1U; i < num; i++) {
+    for (k = 0U; k < stride; k++) {
+      key[k] = tab[(i * stride) + k];
+    }
+    for (j = i; (j > 0U) && (tab[(j - 1U) * stride] > key[0]); j--) {
+      for (k = 0U; k < stride; k++) {
+        tab[(j * stride) + k] = tab[((j - 1U) * stride) + k];
+      }
+    }
+    for (k = 0U; k < stride; k++) {
+      tab[(j * stride) + k] = key[k];
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Single identifier covered by a range rule of the same kind
+ *----------------------------------------------------------------------------*/
+static uint32_t canCovered (const canFilterRule_t *rule, uint32_t num, const canFilterRule_t *r) {
+  uint32_t n;
+
+  for (n = 0U; n < num; n++) {
+    if ((rule[n].lo != rule[n].hi) && (rule[n].ext == r->ext) && (rule[n].ctrl == r->ctrl) &&
+        (rule[n].lo <= r->lo) && (rule[n].hi >= r->lo)) {
+      return 1U;
+    }
+  }
+  return 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  Collect the rules of one table into tab (stride 1 or 2 words)
+  Returns the number of entries or -1 (invalid rule or no room).
+ *----------------------------------------------------------------------------*/
+static int32_t canCollect (const canFilterRule_t *rule, uint32_t num, uint32_t ext, uint32_t group,
+                           uint32_t *tab, uint32_t room) {
+  const canFilterRule_t *r;
+  uint32_t id_max = (ext != 0U) ? 0x1FFFFFFFU : 0x7FFU;
+  uint32_t shift  = (ext != 0U) ? 29U : 13U;
+  uint32_t count  = 0U;
+  uint32_t n;
+
+  for (n = 0U; n < num; n++) {
+    r = &rule[n];
+    if (((r->ext != 0U) != (ext != 0U)) || ((r->lo != r->hi) != (group != 0U))) {
+      continue;
+    }
+    if ((r->lo > r->hi) || (r->hi > id_max) || (r->ctrl > 1U)) {
+      return -1;
+    }
+    if ((group == 0U) && (canCovered(rule, num, r) != 0U)) {
+      continue;
+    }
+    if (group == 0U) {
+      if (count >= room) {
+        return -1;
+      }
+      tab[count] = ((uint32_t)r->ctrl << shift) | r->lo;
+    } else if (ext == 0U) {
+      if (count >= room) {
+        return -1;
+      }
+      tab[count] = (((uint32_t)r->ctrl << shift) | r->lo) << 16 |
+                   (((uint32_t)r->ctrl << shift) | r->hi);
+    } else {
+      if (((count + 1U) * 2U) > room) {
+        return -1;
+      }
+      tab[(count * 2U)]      = ((uint32_t)r->ctrl << shift) | r->lo;
+      tab[(count * 2U) + 1U] = ((uint32_t)r->ctrl << shift) | r->hi;
+    }
+    count++;
+  }
+  canSort(tab, count, ((ext != 0U) && (group != 0U)) ? 2U : 1U);
+  return (int32_t)count;
+}
+
+/*-----------------------------------------------------------------------------
+  Remove duplicates from a sorted table of single entries
+ *----------------------------------------------------------------------------*/
+static uint32_t canUnique (uint32_t *tab, uint32_t num) {
+  uint32_t out = 0U;
+  uint32_t n;
+
+  for (n = 0U; n < num; n++) {
+    if ((out == 0U) || (tab[out - 1U] != tab[n])) {
+      tab[out++] = tab[n];
+    }
+  }
+  return out;
+}
+
+/*-----------------------------------------------------------------------------
+  canFilterCompile: build the acceptance filter RAM image
+  ram: CAN_FILTER_RAM_WORDS words. Returns the number of words used or -1.
+ *----------------------------------------------------------------------------*/
+int32_t canFilterCompile (const canFilterRule_t *rule, uint32_t num,
+                          uint32_t *ram, canFilterTable_t *tab) {
+  uint32_t used;
+  uint32_t sff;
+  uint32_t n;
+  int32_t  count;
+
+  if ((rule == NULL) && (num != 0U)) {
+    return -1;
+  }
+
+  // Standard individual: one entry per word first, then packed in place
+  count = canCollect(rule, num, 0U, 0U, ram, CAN_FILTER_RAM_WORDS);
+  if (count < 0) {
+    return -1;
+  }
+  sff = canUnique(ram, (uint32_t)count);
+  for (n = 0U; n < sff; n += 2U) {
+    ram[n / 2U] = (ram[n] << 16) |
+                  (((n + 1U) < sff) ? ram[n + 1U] : (ram[n] | CAN_SFF_DISABLE));
+  }
+  used        = (sff + 1U) / 2U;
+  tab->sff_sa = 0U;
+
+  // Standard group
+  tab->sff_grp_sa = used * 4U;
+  count = canCollect(rule, num, 0U, 1U, &ram[used], CAN_FILTER_RAM_WORDS - used);
+  if (count < 0) {
+    return -1;
+  }
+  used += (uint32_t)count;
+
+  // Extended individual
+  tab->eff_sa = used * 4U;
+  count = canCollect(rule, num, 1U, 0U, &ram[used], CAN_FILTER_RAM_WORDS - used);
+  if (count < 0) {
+    return -1;
+  }
+  used += canUnique(&ram[used], (uint32_t)count);
+
+  // Extended group
+  tab->eff_grp_sa = used * 4U;
+  count = canCollect(rule, num, 1U, 1U, &ram[used], CAN_FILTER_RAM_WORDS - used);
+  if (count < 0) {
+    return -1;
+  }
+  used    += (uint32_t)count * 2U;
+  tab->end = used * 4U;
+
+  return (int32_t)used;
+}
@@ -0,0 +1,66 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    can_filter.h
+ * Purpose: CAN acceptance filter table compiler
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef CAN_FILTER_H__
+#define CAN_FILTER_H__
+
+#include <stdint.h>
+
+/*
+  Compiles a list of identifiers and identifier ranges into the layout of
+  the LPC17xx acceptance filter RAM. The four tables are sorted as the
+  hardware search requires:
+
+    Standard individual   two 16-bit entries per word (SCC:3, disable:1, 0, id:11)
+    Standard group        lower bound (bits 31:16), upper bound (bits 15:0)
+    Extended individual   one word per entry (SCC:3, id:29)
+    Extended group        two words: lower bound, upper bound
+
+  SCC selects the controller (0 = CAN1, 1 = CAN2). Single identifiers that a
+  range of the same controller already covers are dropped, as are duplicates.
+  The compiler has no device dependencies and can be tested on a host.
+*/
+
+#define CAN_FILTER_RAM_WORDS    512U
+
+// Filter rule (single identifier: lo == hi)
+typedef struct {
+  uint32_t lo;                          // First identifier
+  uint32_t hi;                          // Last identifier
+  uint8_t  ctrl;                        // Controller: 0 = CAN1, 1 = CAN2
+  uint8_t  ext;                         // 0 = 11-bit, 1 = 29-bit identifier
+} canFilterRule_t;
+
+// Table start addresses (byte offsets for the CANAF registers)
+typedef struct {
+  uint32_t sff_sa;
+  uint32_t sff_grp_sa;
+  uint32_t eff_sa;
+  uint32_t eff_grp_sa;
+  uint32_t end;                         // ENDofTable
+} canFilterTable_t;
+
+/* Prototypes */
+extern int32_t canFilterCompile (const canFilterRule_t *rule, uint32_t num,
+                                 uint32_t *ram, canFilterTable_t *tab);
+
+#endif
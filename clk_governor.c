@@ -0,0 +1,220 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    clk_governor.c
+ * Purpose: Load driven core clock governor
+ *----------------------------------------------------------------------------*/
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "clk_governor.h"
+#include "clk_profile.h"
+#include "timebase.h"
+#include "irq_prio.h"
+#include "lowpower.h"
+
+#define GOV_FLAG_CONSTRAINT     0x0001U // Thread flag: minimum profile changed
+
+static volatile uint32_t govIdleUs;     // Idle time accumulated by idle thread
+static uint8_t           govMinCount[CLK_PROFILE_NUM];
+static govPolicy_t       govState;
+static osThreadId_t      govThreadId;
+
+__USED govStatus_t       govStatus;
+
+const osThreadAttr_t governor_attr = {.name = "Governor", .priority = osPriorityAboveNormal};
+
+/*-----------------------------------------------------------------------------
+  govIdleAdd: account idle time (called by the idle thread, see lowpower.c)
+  The governor thread takes the sum at any time, so both sides are exclusive.
+ *----------------------------------------------------------------------------*/
+void govIdleAdd (uint32_t us) {
+  uint32_t idle;
+
+  do {
+    idle = __LDREXW(&govIdleUs);
+  } while (__STREXW(idle + us, &govIdleUs) != 0U);
+}
+
+/*-----------------------------------------------------------------------------
+  govPolicy: select profile for the next window
+  load:        load of the last window in percent
+  min_profile: lowest profile allowed by driver constraints
+ *----------------------------------------------------------------------------*/
+uint32_t govPolicy (govPolicy_t *policy, uint32_t load, uint32_t min_profile) {
+  uint32_t avg = 0U;
+  uint32_t n;
+
+  policy->load[policy->index] = (uint8_t)load;
+  policy->index = (uint8_t)((policy->index + 1U) % GOV_WINDOW_NUM);
+  for (n = 0U; n < GOV_WINDOW_NUM; n++) {
+    avg += policy->load[n];
+  }
+  avg /= GOV_WINDOW_NUM;
+
+  // React to load peaks immediately, step down only after a quiet period
+  if (((avg > GOV_UP_LOAD) || (load > GOV_UP_LOAD)) &&
+      ((policy->profile + 1U) < CLK_PROFILE_NUM)) {
+    policy->profile++;
+    policy->low_count = 0U;
+  } else if (avg < GOV_DOWN_LOAD) {
+    if (++policy->low_count >= GOV_DOWN_HOLD) {
+      policy->low_count = 0U;
+      // Only step down if the same work stays below GOV_UP_LOAD at the lower clock
+      if ((policy->profile > 0U) &&
+          (((uint64_t)avg * clkProfileGetFreq(policy->profile)) <
+           ((uint64_t)GOV_UP_LOAD * clkProfileGetFreq(policy->profile - 1U)))) {
+        policy->profile--;
+      }
+    }
+  } else {
+    policy->low_count = 0U;
+  }
+
+  if (policy->profile < min_profile) {
+    policy->profile = (uint8_t)min_profile;
+  }
+  return policy->profile;
+}
+
+/*-----------------------------------------------------------------------------
+  Lowest profile satisfying all driver constraints
+ *----------------------------------------------------------------------------*/
+static uint32_t govMinProfile (void) {
+  uint32_t profile = CLK_PROFILE_NUM;
+
+  while (profile > 0U) {
+    profile--;
+    if (govMinCount[profile] != 0U) {
+      return profile;
+    }
+  }
+  return 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  govThread: evaluate load once per window
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void govThread (void *argument) {
+  uint32_t deadline;
+  uint32_t delay;
+  uint32_t flags;
+  uint32_t start;
+  uint32_t elapsed;
+  uint32_t idle;
+  uint32_t load;
+  uint32_t profile;
+  (void)argument;
+
+  deadline = osKernelGetTickCount() + GOV_WINDOW_MS;
+  start    = tbGetUs();
+
+  for (;;) {
+    delay = deadline - osKernelGetTickCount();
+    if ((int32_t)delay < 0) {
+      delay    = 0U;                    // Woken late from deep sleep
+      deadline = osKernelGetTickCount();
+    }
+    flags = osThreadFlagsWait(GOV_FLAG_CONSTRAINT, osFlagsWaitAny, delay);
+
+    if ((flags & osFlagsError) != 0U) {
+      // Window complete: load = busy share of elapsed time
+      elapsed   = tbGetUs() - start;
+      start    += elapsed;
+      do {
+        idle = __LDREXW(&govIdleUs);
+      } while (__STREXW(0U, &govIdleUs) != 0U);
+      if ((elapsed == 0U) || (idle >= elapsed)) {
+        load = 0U;
+      } else {
+        load = 100U - (uint32_t)(((uint64_t)idle * 100U) / elapsed);
+      }
+      deadline += GOV_WINDOW_MS;
+      profile = govPolicy(&govState, load, govMinProfile());
+      govStatus.load = load;
+    } else {
+      // Constraint changed: apply immediately
+      profile = govState.profile;
+      if (profile < govMinProfile()) {
+        profile = govMinProfile();
+        govState.profile = (uint8_t)profile;
+      }
+    }
+
+    govStatus.min_profile = govMinProfile();
+    if (profile != clkProfileGet()) {
+      if (clkProfileSet(profile) == 0) {
+        govStatus.switches++;
+      }
+    }
+    govStatus.profile = clkProfileGet();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  govInit: start the governor
+ *----------------------------------------------------------------------------*/
+int32_t govInit (void) {
+  govState.profile = (uint8_t)clkProfileGet();
+
+  govThreadId = osThreadNew(govThread, NULL, &governor_attr);
+  if (govThreadId == NULL) {
+    return -1;
+  }
+  (void)lpDefer(govThreadId);           // Window counts running time only
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  govHoldMin: request at least profile until govReleaseMin (e.g. transfer)
+ *----------------------------------------------------------------------------*/
+void govHoldMin (uint32_t profile) {
+  uint32_t lock;
+
+  if (profile >= CLK_PROFILE_NUM) {
+    return;
+  }
+  lock = irqKernelLock();
+  govMinCount[profile]++;
+  irqKernelUnlock(lock);
+
+  if ((profile > clkProfileGet()) && (govThreadId != NULL)) {
+    osThreadFlagsSet(govThreadId, GOV_FLAG_CONSTRAINT);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  govReleaseMin: release a minimum profile request
+ *----------------------------------------------------------------------------*/
+void govReleaseMin (uint32_t profile) {
+  uint32_t lock;
+
+  if (profile >= CLK_PROFILE_NUM) {
+    return;
+  }
+  lock = irqKernelLock();
+  if (govMinCount[profile] != 0U) {
+    govMinCount[profile]--;
+  }
+  irqKernelUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  govGetStatus: get governor status
+ *----------------------------------------------------------------------------*/
+void govGetStatus (govStatus_t *status) {
+  *status = govStatus;
+}
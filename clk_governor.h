@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    clk_governor.h
+ * Purpose: Load driven core clock governor
+ *----------------------------------------------------------------------------*/
+
+#ifndef CLK_GOVERNOR_H__
+#define CLK_GOVERNOR_H__
+
+#include <stdint.h>
+
+// Measurement window in ms
+#ifndef GOV_WINDOW_MS
+#define GOV_WINDOW_MS           100U
+#endif
+
+// Number of windows averaged (sliding window)
+#ifndef GOV_WINDOW_NUM
+#define GOV_WINDOW_NUM          4U
+#endif
+
+// Load thresholds in percent
+#ifndef GOV_UP_LOAD
+#define GOV_UP_LOAD             80U     // Step up when average load is above
+#endif
+#ifndef GOV_DOWN_LOAD
+#define GOV_DOWN_LOAD           30U     // Step down when average load is below ...
+#endif
+#ifndef GOV_DOWN_HOLD
+#define GOV_DOWN_HOLD           5U      // ... for this many consecutive windows
+#endif
+
+// Policy state (independent of hardware)
+typedef struct {
+  uint8_t  load[GOV_WINDOW_NUM];        // Load history in percent
+  uint8_t  index;                       // Next history entry
+  uint8_t  low_count;                   // Consecutive windows below GOV_DOWN_LOAD
+  uint8_t  profile;                     // Current profile
+} govPolicy_t;
+
+// Governor status
+typedef struct {
+  uint32_t load;                        // Average load in percent
+  uint32_t profile;                     // Active clock profile
+  uint32_t min_profile;                 // Minimum requested by drivers
+  uint32_t switches;                    // Number of profile changes
+} govStatus_t;
+
+/* Prototypes */
+extern int32_t  govInit     (void);
+extern uint32_t govPolicy   (govPolicy_t *policy, uint32_t load, uint32_t min_profile);
+extern void     govHoldMin  (uint32_t profile);
+extern void     govReleaseMin (uint32_t profile);
+extern void     govGetStatus (govStatus_t *status);
+extern void     govIdleAdd  (uint32_t us);
+
+#endif
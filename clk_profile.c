@@ -0,0 +1,338 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    clk_profile.c
+ * Purpose: Runtime core clock profile switching
+ *----------------------------------------------------------------------------*/
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "clk_profile.h"
+#include "clock_tree.h"
+#include "irq_prio.h"
+#include "mem_sections.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+// Profile description
+typedef struct {
+  uint32_t cclk;                        // Resulting core clock in Hz
+  uint32_t pll0cfg;                     // PLL0CFG value (0 = PLL0 not used)
+  uint8_t  cclkcfg;                     // CCLKCFG value (divider - 1)
+  uint8_t  flashtim;                    // FLASHCFG.FLASHTIM (wait states)
+} clkProfileDef_t;
+
+/*
+  All profiles use the 12 MHz main oscillator selected by SystemInit.
+  Frequencies are derived and checked at compile time (clock_tree.h).
+*/
+#define CLK_P12_CCLKCFG         0x00U
+#define CLK_P12_FLASHTIM        0U
+#define CLK_P12_HZ              CLK_CCLK_DIRECT(CLK_XTAL_HZ, CLK_P12_CCLKCFG)
+
+#define CLK_P48_PLL0CFG         0x0000000BU     // M = 12, N = 1: F_cco0 = 288 MHz
+#define CLK_P48_CCLKCFG         0x05U
+#define CLK_P48_FLASHTIM        2U
+#define CLK_P48_HZ              CLK_CCLK_PLL0(CLK_XTAL_HZ, CLK_P48_PLL0CFG, CLK_P48_CCLKCFG)
+
+#define CLK_P100_PLL0CFG        CLK_BOOT_PLL0CFG
+#define CLK_P100_CCLKCFG        CLK_BOOT_CCLKCFG
+#define CLK_P100_FLASHTIM       CLK_BOOT_FLASHTIM
+#define CLK_P100_HZ             CLK_BOOT_CCLK_HZ
+
+#if (!CLK_FLASHTIM_VALID(CLK_P12_HZ, CLK_P12_FLASHTIM))
+  #error "Clock profile 12 MHz: invalid flash timing!"
+#endif
+#if (!CLK_PLL0_VALID(CLK_XTAL_HZ, CLK_P48_PLL0CFG) || !CLK_FLASHTIM_VALID(CLK_P48_HZ, CLK_P48_FLASHTIM))
+  #error "Clock profile 48 MHz: invalid PLL0 or flash timing!"
+#endif
+#if ((CLK_P48_HZ != 48000000UL) || (CLK_P100_HZ != 100000000UL))
+  #error "Clock profiles do not match their names!"
+#endif
+
+static const clkProfileDef_t clkProfileDef[CLK_PROFILE_NUM] = {
+  { CLK_P12_HZ,  0U,               CLK_P12_CCLKCFG,  CLK_P12_FLASHTIM  },
+  { CLK_P48_HZ,  CLK_P48_PLL0CFG,  CLK_P48_CCLKCFG,  CLK_P48_FLASHTIM  },
+  { CLK_P100_HZ, CLK_P100_PLL0CFG, CLK_P100_CCLKCFG, CLK_P100_FLASHTIM }
+};
+
+static uint32_t    clkProfile = CLK_PROFILE_100MHZ;     // Set by SystemInit
+static uint32_t    clkPll1Used;                         // PLL1 connected at suspend
+static uint32_t    clkBusy;                             // Profile switch in progress
+static volatile uint32_t clkPllSeq;                     // PLL feed/lock sequence running
+static volatile uint32_t clkSuspendReq;                 // clkSuspend deferred to its end
+static clkNotify_t clkNotify[CLK_NOTIFY_MAX];
+static uint32_t    clkNotifyNum;
+
+/*-----------------------------------------------------------------------------
+  PLL0 register access
+ *----------------------------------------------------------------------------*/
+__STATIC_FORCEINLINE void clkPll0Feed (uint32_t con) {
+  LPC_SC->PLL0CON  = con;
+  LPC_SC->PLL0FEED = 0xAAU;
+  LPC_SC->PLL0FEED = 0x55U;
+}
+
+__STATIC_FORCEINLINE void clkPll1Feed (uint32_t con) {
+  LPC_SC->PLL1CON  = con;
+  LPC_SC->PLL1FEED = 0xAAU;
+  LPC_SC->PLL1FEED = 0x55U;
+}
+
+static void clkFlashTime (uint32_t flashtim) {
+  LPC_SC->FLASHCFG = (LPC_SC->FLASHCFG & ~0x0000F000U) | (flashtim << 12);
+}
+
+/*-----------------------------------------------------------------------------
+  PLL sequence bracket: a zero-latency interrupt calling clkSuspend between
+  a feed and the matching lock wait would leave the sequence on a stopped
+  PLL. clkSuspend is deferred to clkPllSeqEnd instead.
+ *----------------------------------------------------------------------------*/
+__STATIC_FORCEINLINE void clkPllSeqStart (void) {
+  clkPllSeq = 1U;
+}
+
+static void clkPllSeqEnd (void) {
+  clkPllSeq = 0U;
+  if (clkSuspendReq != 0U) {
+    clkSuspendReq = 0U;
+    (void)clkSuspend();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Switch clock tree (kernel-aware interrupts masked)
+  Zero-latency interrupts stay enabled while PLL0 locks: every intermediate
+  step is a valid clock with matching flash timing.
+ *----------------------------------------------------------------------------*/
+static void clkSwitch (const clkProfileDef_t *from, const clkProfileDef_t *to) {
+
+  // Slow down flash access before speeding up the core
+  if (to->flashtim > from->flashtim) {
+    clkFlashTime(to->flashtim);
+  }
+
+  // Run from the oscillator while PLL0 is reconfigured
+  clkPllSeqStart();
+  if ((LPC_SC->PLL0STAT & (1UL << 25)) != 0U) {
+    clkPll0Feed(0x01U);                 // Disconnect
+  }
+  if ((LPC_SC->PLL0STAT & (1UL << 24)) != 0U) {
+    clkPll0Feed(0x00U);                 // Disable
+  }
+
+  if (to->pll0cfg == 0U) {
+    LPC_SC->CCLKCFG = to->cclkcfg;
+  } else {
+    LPC_SC->PLL0CFG  = to->pll0cfg;
+    LPC_SC->PLL0FEED = 0xAAU;
+    LPC_SC->PLL0FEED = 0x55U;
+    clkPll0Feed(0x01U);                 // Enable
+    LPC_SC->CCLKCFG = to->cclkcfg;
+    while ((LPC_SC->PLL0STAT & (1UL << 26)) == 0U);     // Wait for PLOCK0
+    clkPll0Feed(0x03U);                 // Enable and connect
+    while ((LPC_SC->PLL0STAT & ((1UL << 25) | (1UL << 24))) != ((1UL << 25) | (1UL << 24)));
+  }
+  clkPllSeqEnd();
+
+  // Speed up flash access after slowing down the core
+  if (to->flashtim < from->flashtim) {
+    clkFlashTime(to->flashtim);
+  }
+
+  SystemCoreClock = to->cclk;
+}
+
+/*-----------------------------------------------------------------------------
+  clkProfileSet: switch core clock to profile (thread context)
+  Callers are serialized: a call made while another thread is switching
+  fails with -1 and leaves the clock alone, retry later.
+ *----------------------------------------------------------------------------*/
+int32_t clkProfileSet (uint32_t profile) {
+  const clkProfileDef_t *to;
+  uint32_t basepri;
+  uint32_t tick_freq;
+  uint32_t n;
+
+  if (profile >= CLK_PROFILE_NUM) {
+    return -1;
+  }
+
+  do {
+    if (__LDREXW(&clkBusy) != 0U) {
+      __CLREX();
+      return -1;
+    }
+  } while (__STREXW(1U, &clkBusy) != 0U);
+
+  if (profile == clkProfile) {
+    clkBusy = 0U;
+    return 0;
+  }
+  to        = &clkProfileDef[profile];
+  tick_freq = osKernelGetTickFreq();
+
+  for (n = 0U; n < clkNotifyNum; n++) {
+    clkNotify[n](CLK_EVENT_PRE, to->cclk);
+  }
+
+  basepri = irqKernelLock();
+
+  clkSwitch(&clkProfileDef[clkProfile], to);
+  clkProfile = profile;
+
+  // Keep the kernel tick period (SysTick runs from the core clock)
+  SysTick->LOAD = (to->cclk / tick_freq) - 1U;
+  SysTick->VAL  = 0U;
+
+  for (n = 0U; n < clkNotifyNum; n++) {
+    clkNotify[n](CLK_EVENT_POST, to->cclk);
+  }
+
+  irqKernelUnlock(basepri);
+
+  clkBusy = 0U;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  clkProfileGet: get active profile
+ *----------------------------------------------------------------------------*/
+uint32_t clkProfileGet (void) {
+  return clkProfile;
+}
+
+/*-----------------------------------------------------------------------------
+  clkProfileGetFreq: get core clock of profile in Hz
+ *----------------------------------------------------------------------------*/
+uint32_t clkProfileGetFreq (uint32_t profile) {
+  if (profile >= CLK_PROFILE_NUM) {
+    return 0U;
+  }
+  return clkProfileDef[profile].cclk;
+}
+
+/*-----------------------------------------------------------------------------
+  clkNotifyRegister: register driver callback for clock changes
+ *----------------------------------------------------------------------------*/
+int32_t clkNotifyRegister (clkNotify_t func) {
+  if ((func == NULL) || (clkNotifyNum >= CLK_NOTIFY_MAX)) {
+    return -1;
+  }
+  clkNotify[clkNotifyNum++] = func;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  clkPclkSelect: modify PCLKSEL0 (reg = 0) or PCLKSEL1 (reg = 1)
+  The register is written with PLL0 connected: a disconnect would run TIMER1,
+  the UARTs and SSP from the oscillator for the duration. Only if the write
+  did not take effect (erratum PCLKSELx.1) is PLL0 disconnected; it stays
+  locked and is reconnected right after the write.
+ *----------------------------------------------------------------------------*/
+void clkPclkSelect (uint32_t reg, uint32_t mask, uint32_t value) {
+  volatile uint32_t *pclksel = (reg == 0U) ? &LPC_SC->PCLKSEL0 : &LPC_SC->PCLKSEL1;
+  uint32_t basepri;
+
+  basepri = irqKernelLock();
+
+  if ((*pclksel & mask) == value) {
+    irqKernelUnlock(basepri);
+    return;                             // Divider unchanged
+  }
+  *pclksel = (*pclksel & ~mask) | value;
+
+  if (((*pclksel & mask) != value) && ((LPC_SC->PLL0STAT & (1UL << 25)) != 0U)) {
+    clkPllSeqStart();
+    clkPll0Feed(0x01U);                 // Disconnect
+    *pclksel = (*pclksel & ~mask) | value;
+    clkPll0Feed(0x03U);                 // Enable and connect
+    while ((LPC_SC->PLL0STAT & ((1UL << 25) | (1UL << 24))) != ((1UL << 25) | (1UL << 24)));
+    clkPllSeqEnd();
+  }
+
+  irqKernelUnlock(basepri);
+}
+
+/*-----------------------------------------------------------------------------
+  clkSuspend: stop the PLLs and run from the internal RC oscillator
+  Called with interrupts disabled right before deep sleep or power-down,
+  which stop the main oscillator. The active profile is kept.
+  Runs from RAM: BOD_IRQHandler calls it when flash reads are no longer safe.
+  Returns -1 when it preempted a PLL sequence (profile switch, PCLKSEL
+  erratum, clkResume): the clocks are stopped when that sequence ends.
+ *----------------------------------------------------------------------------*/
+__RAMFUNC int32_t clkSuspend (void) {
+  if (clkPllSeq != 0U) {
+    clkSuspendReq = 1U;
+    return -1;
+  }
+  clkPll1Used = ((LPC_SC->PLL1STAT & (1UL << 9)) != 0U) ? 1U : 0U;
+  if (clkPll1Used != 0U) {
+    clkPll1Feed(0x01U);                 // Disconnect
+    clkPll1Feed(0x00U);                 // Disable
+  }
+  if ((LPC_SC->PLL0STAT & (1UL << 25)) != 0U) {
+    clkPll0Feed(0x01U);                 // Disconnect
+  }
+  if ((LPC_SC->PLL0STAT & (1UL << 24)) != 0U) {
+    clkPll0Feed(0x00U);                 // Disable
+  }
+  LPC_SC->CCLKCFG   = 0U;
+  LPC_SC->CLKSRCSEL = 0U;               // Internal RC oscillator
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  clkResume: restart the main oscillator and restore the active profile
+  Called with interrupts disabled after wake-up. PLL1 is restarted with the
+  SystemInit configuration when it was connected before clkSuspend.
+ *----------------------------------------------------------------------------*/
+void clkResume (void) {
+  const clkProfileDef_t *def = &clkProfileDef[clkProfile];
+
+  clkPllSeqStart();
+  LPC_SC->SCS |= (1UL << 5);            // OSCEN
+  while ((LPC_SC->SCS & (1UL << 6)) == 0U);     // Wait for OSCSTAT
+  LPC_SC->CLKSRCSEL = 1U;               // Main oscillator
+
+  if (def->pll0cfg != 0U) {
+    LPC_SC->PLL0CFG  = def->pll0cfg;
+    LPC_SC->PLL0FEED = 0xAAU;
+    LPC_SC->PLL0FEED = 0x55U;
+    clkPll0Feed(0x01U);                 // Enable
+  }
+  if (clkPll1Used != 0U) {
+    LPC_SC->PLL1CFG  = CLK_BOOT_PLL1CFG;
+    LPC_SC->PLL1FEED = 0xAAU;
+    LPC_SC->PLL1FEED = 0x55U;
+    clkPll1Feed(0x01U);                 // Enable, locks in parallel with PLL0
+  }
+
+  LPC_SC->CCLKCFG = def->cclkcfg;
+  if (def->pll0cfg != 0U) {
+    while ((LPC_SC->PLL0STAT & (1UL << 26)) == 0U);     // Wait for PLOCK0
+    clkPll0Feed(0x03U);                 // Enable and connect
+    while ((LPC_SC->PLL0STAT & ((1UL << 25) | (1UL << 24))) != ((1UL << 25) | (1UL << 24)));
+  }
+  if (clkPll1Used != 0U) {
+    while ((LPC_SC->PLL1STAT & (1UL << 10)) == 0U);     // Wait for PLOCK1
+    clkPll1Feed(0x03U);                 // Enable and connect
+    while ((LPC_SC->PLL1STAT & ((1UL << 9) | (1UL << 8))) != ((1UL << 9) | (1UL << 8)));
+  }
+  clkPllSeqEnd();
+}
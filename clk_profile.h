@@ -0,0 +1,64 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    clk_profile.h
+ * Purpose: Runtime core clock profile switching
+ *----------------------------------------------------------------------------*/
+
+#ifndef CLK_PROFILE_H__
+#define CLK_PROFILE_H__
+
+#include <stdint.h>
+
+// Clock profiles (ordered by frequency)
+#define CLK_PROFILE_12MHZ       0U      // Main oscillator, PLL0 off
+#define CLK_PROFILE_48MHZ       1U      // PLL0 288 MHz / 6
+#define CLK_PROFILE_100MHZ      2U      // PLL0 400 MHz / 4 (SystemInit default)
+#define CLK_PROFILE_NUM         3U
+
+// Notification events
+#define CLK_EVENT_PRE           0U      // Before switch (thread context)
+#define CLK_EVENT_POST          1U      // After switch (kernel interrupts masked)
+
+// Maximum number of registered notification callbacks (9 drivers use one:
+// timebase, twheel, logger, uart_rx, spiflash, i2c_engine, can, timesync_can,
+// emac)
+#ifndef CLK_NOTIFY_MAX
+#define CLK_NOTIFY_MAX          16U
+#endif
+
+/*
+  Notification callback. CLK_EVENT_POST is called with kernel-aware
+  interrupts masked (irqKernelLock) right after the new clock is active:
+  only reprogram dividers there. Zero-latency interrupts keep running
+  across the switch.
+
+  clkProfileSet is called from threads only. Concurrent calls do not
+  interleave: the second one returns -1 without touching the clock.
+*/
+typedef void (*clkNotify_t) (uint32_t event, uint32_t cclk);
+
+/* Prototypes */
+extern int32_t  clkProfileSet     (uint32_t profile);
+extern uint32_t clkProfileGet     (void);
+extern uint32_t clkProfileGetFreq (uint32_t profile);
+extern int32_t  clkNotifyRegister (clkNotify_t func);
+extern void     clkPclkSelect     (uint32_t reg, uint32_t mask, uint32_t value);
+extern int32_t  clkSuspend        (void);
+extern void     clkResume         (void);
+
+#endif
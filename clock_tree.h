@@ -0,0 +1,139 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    clock_tree.h
+ * Purpose: Compile-time model of the LPC1768 clock tree
+ *----------------------------------------------------------------------------*/
+
+#ifndef CLOCK_TREE_H__
+#define CLOCK_TREE_H__
+
+/*
+  All macros are constant expressions usable in #if and in initializers.
+  Register arguments take the raw register values (as in system_LPC17xx.c).
+*/
+
+/* Clock sources ------------------------------------------------------------*/
+#define CLK_XTAL_HZ             12000000UL      // Main oscillator
+#define CLK_IRC_HZ               4000000UL      // Internal RC oscillator
+#define CLK_RTC_HZ                 32768UL      // RTC oscillator
+
+/* PLL0 (main PLL): F_cco0 = (2 * M * F_in) / N ------------------------------*/
+#define CLK_PLL0_M(cfg)         ((((cfg)      ) & 0x7FFFUL) + 1UL)
+#define CLK_PLL0_N(cfg)         ((((cfg) >> 16) & 0x00FFUL) + 1UL)
+#define CLK_PLL0_FCCO(fin, cfg) ((2ULL * CLK_PLL0_M(cfg) * (fin)) / CLK_PLL0_N(cfg))
+#define CLK_PLL0_VALID(fin, cfg)                                                \
+  ((CLK_PLL0_FCCO(fin, cfg) >= 275000000ULL) && (CLK_PLL0_FCCO(fin, cfg) <= 550000000ULL))
+
+/* PLL1 (USB PLL): F_usb = M * F_osc, F_cco1 = F_usb * 2 * P ----------------*/
+#define CLK_PLL1_M(cfg)         ((((cfg)      ) & 0x1FUL) + 1UL)
+#define CLK_PLL1_P(cfg)         (1UL << (((cfg) >> 5) & 0x03UL))
+#define CLK_PLL1_OUT(fin, cfg)  ((fin) * CLK_PLL1_M(cfg))
+#define CLK_PLL1_FCCO(fin, cfg) (CLK_PLL1_OUT(fin, cfg) * 2UL * CLK_PLL1_P(cfg))
+#define CLK_PLL1_VALID(fin, cfg)                                                \
+  ((CLK_PLL1_FCCO(fin, cfg) >= 156000000UL) && (CLK_PLL1_FCCO(fin, cfg) <= 320000000UL) && \
+   (CLK_PLL1_OUT(fin, cfg) == 48000000UL))
+
+/* CPU clock -----------------------------------------------------------------*/
+#define CLK_CCLK_DIV(cclkcfg)   ((((cclkcfg)) & 0xFFUL) + 1UL)
+#define CLK_CCLK_PLL0(fin, pll0cfg, cclkcfg)                                    \
+  (CLK_PLL0_FCCO(fin, pll0cfg) / CLK_CCLK_DIV(cclkcfg))
+#define CLK_CCLK_DIRECT(fin, cclkcfg)                                           \
+  ((fin) / CLK_CCLK_DIV(cclkcfg))
+
+/* Flash accelerator: minimum FLASHTIM for a CPU clock -----------------------*/
+#define CLK_FLASHTIM_MIN(cclk)                                                  \
+  (((cclk) <=  20000000UL) ? 0UL : ((cclk) <=  40000000UL) ? 1UL :              \
+   ((cclk) <=  60000000UL) ? 2UL : ((cclk) <=  80000000UL) ? 3UL :              \
+   ((cclk) <= 100000000UL) ? 4UL : 5UL)
+#define CLK_FLASHTIM_VALID(cclk, flashtim)                                      \
+  (((flashtim) >= CLK_FLASHTIM_MIN(cclk)) && ((flashtim) <= 5UL))
+
+/* Peripheral clocks: code = 2-bit PCLKSEL field -----------------------------*/
+#define CLK_PCLK(cclk, code)                                                    \
+  (((code) == 1UL) ? (cclk) : ((code) == 2UL) ? ((cclk) / 2UL) :                \
+   ((code) == 3UL) ? ((cclk) / 8UL) : ((cclk) / 4UL))
+#define CLK_PCLK_CAN(cclk, code)                                                \
+  (((code) == 3UL) ? ((cclk) / 6UL) : CLK_PCLK(cclk, code))
+#define CLK_PCLKSEL_CODE(reg, shift)    (((reg) >> (shift)) & 0x03UL)
+
+/* Boot configuration (SystemInit in system_LPC17xx.c) -----------------------*/
+#define CLK_BOOT_PLL0CFG        0x00050063UL
+#define CLK_BOOT_PLL1CFG        0x00000023UL
+#define CLK_BOOT_CCLKCFG        0x00000003UL
+#define CLK_BOOT_PCLKSEL0       0x00000000UL
+#define CLK_BOOT_PCLKSEL1       0x00000000UL
+#define CLK_BOOT_FLASHTIM       4UL
+
+#define CLK_BOOT_FCCO0_HZ       CLK_PLL0_FCCO(CLK_XTAL_HZ, CLK_BOOT_PLL0CFG)
+#define CLK_BOOT_CCLK_HZ        CLK_CCLK_PLL0(CLK_XTAL_HZ, CLK_BOOT_PLL0CFG, CLK_BOOT_CCLKCFG)
+#define CLK_BOOT_USBCLK_HZ      CLK_PLL1_OUT(CLK_XTAL_HZ, CLK_BOOT_PLL1CFG)
+
+#define CLK_BOOT_PCLK0(shift)   CLK_PCLK(CLK_BOOT_CCLK_HZ, CLK_PCLKSEL_CODE(CLK_BOOT_PCLKSEL0, shift))
+#define CLK_BOOT_PCLK1(shift)   CLK_PCLK(CLK_BOOT_CCLK_HZ, CLK_PCLKSEL_CODE(CLK_BOOT_PCLKSEL1, shift))
+
+#define CLK_BOOT_PCLK_WDT_HZ    CLK_BOOT_PCLK0( 0U)
+#define CLK_BOOT_PCLK_TIMER0_HZ CLK_BOOT_PCLK0( 2U)
+#define CLK_BOOT_PCLK_TIMER1_HZ CLK_BOOT_PCLK0( 4U)
+#define CLK_BOOT_PCLK_UART0_HZ  CLK_BOOT_PCLK0( 6U)
+#define CLK_BOOT_PCLK_UART1_HZ  CLK_BOOT_PCLK0( 8U)
+#define CLK_BOOT_PCLK_PWM1_HZ   CLK_BOOT_PCLK0(12U)
+#define CLK_BOOT_PCLK_I2C0_HZ   CLK_BOOT_PCLK0(14U)
+#define CLK_BOOT_PCLK_SPI_HZ    CLK_BOOT_PCLK0(16U)
+#define CLK_BOOT_PCLK_SSP1_HZ   CLK_BOOT_PCLK0(20U)
+#define CLK_BOOT_PCLK_DAC_HZ    CLK_BOOT_PCLK0(22U)
+#define CLK_BOOT_PCLK_ADC_HZ    CLK_BOOT_PCLK0(24U)
+#define CLK_BOOT_PCLK_CAN1_HZ   CLK_PCLK_CAN(CLK_BOOT_CCLK_HZ, CLK_PCLKSEL_CODE(CLK_BOOT_PCLKSEL0, 26U))
+#define CLK_BOOT_PCLK_CAN2_HZ   CLK_PCLK_CAN(CLK_BOOT_CCLK_HZ, CLK_PCLKSEL_CODE(CLK_BOOT_PCLKSEL0, 28U))
+#define CLK_BOOT_PCLK_ACF_HZ    CLK_PCLK_CAN(CLK_BOOT_CCLK_HZ, CLK_PCLKSEL_CODE(CLK_BOOT_PCLKSEL0, 30U))
+#define CLK_BOOT_PCLK_QEI_HZ    CLK_BOOT_PCLK1( 0U)
+#define CLK_BOOT_PCLK_GPIO_HZ   CLK_BOOT_PCLK1( 2U)
+#define CLK_BOOT_PCLK_PCB_HZ    CLK_BOOT_PCLK1( 4U)
+#define CLK_BOOT_PCLK_I2C1_HZ   CLK_BOOT_PCLK1( 6U)
+#define CLK_BOOT_PCLK_SSP0_HZ   CLK_BOOT_PCLK1(10U)
+#define CLK_BOOT_PCLK_TIMER2_HZ CLK_BOOT_PCLK1(12U)
+#define CLK_BOOT_PCLK_TIMER3_HZ CLK_BOOT_PCLK1(14U)
+#define CLK_BOOT_PCLK_UART2_HZ  CLK_BOOT_PCLK1(16U)
+#define CLK_BOOT_PCLK_UART3_HZ  CLK_BOOT_PCLK1(18U)
+#define CLK_BOOT_PCLK_I2C2_HZ   CLK_BOOT_PCLK1(20U)
+#define CLK_BOOT_PCLK_I2S_HZ    CLK_BOOT_PCLK1(22U)
+#define CLK_BOOT_PCLK_RIT_HZ    CLK_BOOT_PCLK1(26U)
+#define CLK_BOOT_PCLK_SYSCON_HZ CLK_BOOT_PCLK1(28U)
+#define CLK_BOOT_PCLK_MC_HZ     CLK_BOOT_PCLK1(30U)
+
+/* Validation ----------------------------------------------------------------*/
+#if (!CLK_PLL0_VALID(CLK_XTAL_HZ, CLK_BOOT_PLL0CFG))
+  #error "Clock tree: PLL0 F_cco0 out of range (275 .. 550 MHz)!"
+#endif
+
+#if (!CLK_PLL1_VALID(CLK_XTAL_HZ, CLK_BOOT_PLL1CFG))
+  #error "Clock tree: PLL1 must produce 48 MHz with F_cco1 within 156 .. 320 MHz!"
+#endif
+
+#if (CLK_CCLK_DIV(CLK_BOOT_CCLKCFG) < 3UL)
+  #error "Clock tree: CCLKSEL must be greater than 1 when PLL0 is used!"
+#endif
+
+#if (CLK_BOOT_CCLK_HZ > 100000000UL)
+  #error "Clock tree: CPU clock exceeds 100 MHz!"
+#endif
+
+#if (!CLK_FLASHTIM_VALID(CLK_BOOT_CCLK_HZ, CLK_BOOT_FLASHTIM))
+  #error "Clock tree: too few flash wait states for the CPU clock!"
+#endif
+
+#endif
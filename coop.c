@@ -0,0 +1,320 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    coop.c
+ * Purpose: Stackless cooperative task scheduler
+ *----------------------------------------------------------------------------*/
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "coop.h"
+
+#include "timebase.h"
+
+#define COOP_FLAG_START         0x0001U // Thread flag: start request pending
+#define COOP_FLAG_BENCH         0x0001U // Thread flag: benchmark ping-pong
+
+// Task states
+#define COOP_STATE_IDLE         0U
+#define COOP_STATE_PENDING      1U
+#define COOP_STATE_READY        2U
+
+static coopTask_t  *coopHeap[COOP_TASK_MAX];    // Min-heap ordered by wake time
+static uint32_t     coopCount;                  // Number of tasks in heap
+static coopTask_t  *coopPending;                // Start requests (lock-free list)
+static osThreadId_t coopThreadId;
+
+__USED coopStats_t  coopStats;                  // Switch cost statistics
+
+const osThreadAttr_t coop_attr = {.name = "CoopThread"};
+
+/*-----------------------------------------------------------------------------
+  Wake-up heap (wrap-around safe ordering of tick values)
+ *----------------------------------------------------------------------------*/
+static inline int32_t coopBefore (const coopTask_t *a, const coopTask_t *b) {
+  return ((int32_t)(a->wake - b->wake) < 0);
+}
+
+static inline void coopHeapSet (uint32_t idx, coopTask_t *task) {
+  coopHeap[idx] = task;
+  task->slot    = (uint8_t)idx;
+}
+
+static void coopHeapPush (coopTask_t *task) {
+  uint32_t idx = coopCount++;
+  uint32_t parent;
+
+  while (idx > 0U) {
+    parent = (idx - 1U) / 2U;
+    if (!coopBefore(task, coopHeap[parent])) {
+      break;
+    }
+    coopHeapSet(idx, coopHeap[parent]);
+    idx = parent;
+  }
+  coopHeapSet(idx, task);
+}
+
+static coopTask_t *coopHeapPop (void) {
+  coopTask_t *top  = coopHeap[0];
+  coopTask_t *last = coopHeap[--coopCount];
+  uint32_t    idx  = 0U;
+  uint32_t    child;
+
+  while ((child = (2U * idx) + 1U) < coopCount) {
+    if (((child + 1U) < coopCount) && coopBefore(coopHeap[child + 1U], coopHeap[child])) {
+      child++;
+    }
+    if (!coopBefore(coopHeap[child], last)) {
+      break;
+    }
+    coopHeapSet(idx, coopHeap[child]);
+    idx = child;
+  }
+  if (coopCount != 0U) {
+    coopHeapSet(idx, last);
+  }
+  return top;
+}
+
+/*-----------------------------------------------------------------------------
+  Move start requests from the pending list into the heap
+ *----------------------------------------------------------------------------*/
+static void coopAdmit (void) {
+  coopTask_t *list;
+  coopTask_t *task;
+
+  do {
+    list = (coopTask_t *)__LDREXW((uint32_t *)&coopPending);
+  } while (__STREXW(0U, (uint32_t *)&coopPending) != 0U);
+
+  while (list != NULL) {
+    task  = list;
+    list  = task->next;
+    task->next  = NULL;
+    if (coopCount < COOP_TASK_MAX) {
+      task->state = COOP_STATE_READY;
+      coopHeapPush(task);
+    } else {
+      task->state = COOP_STATE_IDLE;    // Heap full: request is dropped
+      coopStats.rejected++;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  coopThread: runs all cooperative tasks in order of their wake time
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void coopThread (void *argument) {
+  coopTask_t *task;
+  uint32_t    now;
+  uint32_t    delay;
+  uint32_t    cycles;
+  uint32_t    start;
+  uint8_t     result;
+  (void)argument;
+
+  for (;;) {
+    coopAdmit();
+
+    if (coopCount == 0U) {
+      osThreadFlagsWait(COOP_FLAG_START, osFlagsWaitAny, osWaitForever);
+      continue;
+    }
+
+    now = osKernelGetTickCount();
+    if ((int32_t)(coopHeap[0]->wake - now) > 0) {
+      delay = coopHeap[0]->wake - now;
+      osThreadFlagsWait(COOP_FLAG_START, osFlagsWaitAny, delay);
+      continue;
+    }
+
+    // Switch cost covers the scheduler work around the task body
+    cycles = tbGetCycles();
+    task   = coopHeapPop();
+    cycles = tbGetCycles() - cycles;
+    result = task->func(task);
+    start  = tbGetCycles();
+    if (result == COOP_WAITING) {
+      coopHeapPush(task);
+    } else {
+      task->state = COOP_STATE_IDLE;
+    }
+    cycles += tbGetCycles() - start;
+
+    coopStats.switches++;
+    coopStats.cycles_sum += cycles;
+    if (cycles > coopStats.cycles_max) {
+      coopStats.cycles_max = cycles;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  coopInit: create the scheduler thread
+ *----------------------------------------------------------------------------*/
+int32_t coopInit (void) {
+  coopThreadId = osThreadNew(coopThread, NULL, &coop_attr);
+  if (coopThreadId == NULL) {
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  coopStart: schedule a task to run as soon as possible
+  May be called from any thread, from a task or from an ISR.
+ *----------------------------------------------------------------------------*/
+int32_t coopStart (coopTask_t *task, coopFunc_t func) {
+  coopTask_t *head;
+
+  if ((task == NULL) || (func == NULL)) {
+    return -1;
+  }
+
+  // Claim the task: only one of several concurrent callers may move it out of idle
+  do {
+    if (__LDREXB(&task->state) != COOP_STATE_IDLE) {
+      __CLREX();
+      return -1;
+    }
+  } while (__STREXB(COOP_STATE_PENDING, &task->state) != 0U);
+
+  task->func  = func;
+  task->lc    = 0U;
+  task->wake  = osKernelGetTickCount();
+
+  do {
+    head       = (coopTask_t *)__LDREXW((uint32_t *)&coopPending);
+    task->next = head;
+  } while (__STREXW((uint32_t)task, (uint32_t *)&coopPending) != 0U);
+
+  if (coopThreadId != NULL) {
+    osThreadFlagsSet(coopThreadId, COOP_FLAG_START);
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  coopGetTick: time base used for COOP_SLEEP and COOP_WAIT_UNTIL
+ *----------------------------------------------------------------------------*/
+uint32_t coopGetTick (void) {
+  return osKernelGetTickCount();
+}
+
+/*-----------------------------------------------------------------------------
+  coopGetStats: get task switch cost statistics
+ *----------------------------------------------------------------------------*/
+void coopGetStats (coopStats_t *stats) {
+  *stats = coopStats;
+}
+
+/*-----------------------------------------------------------------------------
+  Benchmark: cooperative task switch against RTX thread switch
+ *----------------------------------------------------------------------------*/
+static coopTask_t   coopBenchTask[2];
+static uint32_t     coopBenchLeft[2];
+static osThreadId_t coopBenchThread[2];
+static osThreadId_t coopBenchCaller;
+static uint32_t     coopBenchRounds;
+static uint32_t     coopBenchCycles;
+
+static uint8_t coopBenchYield (coopTask_t *t) {
+  uint32_t *left = &coopBenchLeft[t - coopBenchTask];
+
+  COOP_BEGIN(t);
+  while (*left != 0U) {
+    (*left)--;
+    COOP_YIELD(t);
+  }
+  COOP_END(t);
+}
+
+static __NO_RETURN void coopBenchPing (void *argument) {
+  uint32_t idx = (uint32_t)argument;
+  uint32_t start;
+  uint32_t n;
+
+  start = tbGetCycles();
+  for (n = 0U; n < coopBenchRounds; n++) {
+    if (idx == 0U) {
+      osThreadFlagsSet(coopBenchThread[1], COOP_FLAG_BENCH);
+      osThreadFlagsWait(COOP_FLAG_BENCH, osFlagsWaitAny, osWaitForever);
+    } else {
+      osThreadFlagsWait(COOP_FLAG_BENCH, osFlagsWaitAny, osWaitForever);
+      osThreadFlagsSet(coopBenchThread[0], COOP_FLAG_BENCH);
+    }
+  }
+  if (idx == 0U) {
+    coopBenchCycles = tbGetCycles() - start;
+    osThreadFlagsSet(coopBenchCaller, COOP_FLAG_BENCH);
+  }
+  osThreadExit();
+}
+
+/*-----------------------------------------------------------------------------
+  coopBench: measure average cycles per switch
+  Two cooperative tasks yield to each other, then two RTX threads ping-pong
+  with thread flags. Call from a thread below osPriorityAboveNormal after
+  coopInit; the RTX figure includes the flag set/wait service calls, which
+  is the minimum a thread-based design pays for the same hand-over.
+ *----------------------------------------------------------------------------*/
+int32_t coopBench (uint32_t rounds, coopBench_t *result) {
+  const osThreadAttr_t attr = {.name = "CoopBench", .priority = osPriorityAboveNormal};
+  coopStats_t before;
+  uint32_t    n;
+
+  if ((result == NULL) || (rounds == 0U) || (coopThreadId == NULL)) {
+    return -1;
+  }
+
+  // Cooperative tasks
+  before = coopStats;
+  for (n = 0U; n < 2U; n++) {
+    coopBenchLeft[n] = rounds;
+    if (coopStart(&coopBenchTask[n], coopBenchYield) != 0) {
+      return -1;
+    }
+  }
+  while ((coopBenchTask[0].state != COOP_STATE_IDLE) ||
+         (coopBenchTask[1].state != COOP_STATE_IDLE)) {
+    osDelay(1U);
+  }
+  n = coopStats.switches - before.switches;
+  result->coop_cycles = (n != 0U) ? ((coopStats.cycles_sum - before.cycles_sum) / n) : 0U;
+
+  // RTX threads (created with the kernel locked so both IDs are valid)
+  coopBenchRounds = rounds;
+  coopBenchCaller = osThreadGetId();
+  osThreadFlagsClear(COOP_FLAG_BENCH);
+  osKernelLock();
+  coopBenchThread[0] = osThreadNew(coopBenchPing, (void *)0U, &attr);
+  coopBenchThread[1] = osThreadNew(coopBenchPing, (void *)1U, &attr);
+  osKernelUnlock();
+  if ((coopBenchThread[0] == NULL) || (coopBenchThread[1] == NULL)) {
+    if (coopBenchThread[0] != NULL) {
+      osThreadTerminate(coopBenchThread[0]);
+    }
+    if (coopBenchThread[1] != NULL) {
+      osThreadTerminate(coopBenchThread[1]);
+    }
+    return -1;
+  }
+  osThreadFlagsWait(COOP_FLAG_BENCH, osFlagsWaitAny, osWaitForever);
+  result->rtx_cycles = coopBenchCycles / (2U * rounds);
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    coop.h
+ * Purpose: Stackless cooperative tasks sharing one RTX thread
+ *----------------------------------------------------------------------------*/
+
+#ifndef COOP_H__
+#define COOP_H__
+
+#include <stdint.h>
+
+/*
+  A cooperative task is a function that is re-entered from the top every time
+  it is scheduled and resumes at the line where it last blocked (protothread
+  style). Local variables do not survive a blocking call: keep state in a
+  structure that embeds coopTask_t as its first member.
+
+    typedef struct {
+      coopTask_t task;
+      uint32_t   count;
+    } myTask_t;
+
+    static uint8_t myTask (coopTask_t *t) {
+      myTask_t *my = (myTask_t *)t;
+      COOP_BEGIN(t);
+      for (;;) {
+        my->count++;
+        COOP_SLEEP(t, 500U);
+      }
+      COOP_END(t);
+    }
+*/
+
+// Maximum number of tasks that can be scheduled at the same time
+#ifndef COOP_TASK_MAX
+#define COOP_TASK_MAX           32U
+#endif
+
+// Poll interval of COOP_WAIT_UNTIL in kernel ticks
+#ifndef COOP_POLL_TICKS
+#define COOP_POLL_TICKS         1U
+#endif
+
+// Task function return values
+#define COOP_WAITING            0U      // Task blocked: reschedule at task->wake
+#define COOP_EXITED             1U      // Task finished: remove from scheduler
+
+typedef struct coopTask_s coopTask_t;
+typedef uint8_t (*coopFunc_t) (coopTask_t *task);
+
+// Task control block (state of one stackless task)
+struct coopTask_s {
+  coopFunc_t   func;                    // Task function
+  coopTask_t  *next;                    // Link in start request list
+  uint32_t     wake;                    // Wake-up time in kernel ticks
+  uint16_t     lc;                      // Local continuation (resume point)
+  uint8_t      slot;                    // Index in wake-up heap
+  uint8_t      state;                   // Task state (internal)
+};
+
+// Scheduler statistics (switch cost in CPU cycles)
+typedef struct {
+  uint32_t switches;                    // Number of task switches
+  uint32_t cycles_sum;                  // Accumulated scheduler cycles
+  uint32_t cycles_max;                  // Worst case scheduler cycles
+  uint32_t rejected;                    // Start requests dropped (heap full)
+} coopStats_t;
+
+// Benchmark result (average CPU cycles per switch)
+typedef struct {
+  uint32_t coop_cycles;                 // Cooperative task switch
+  uint32_t rtx_cycles;                  // RTX thread switch (thread flags)
+} coopBench_t;
+
+/* Task body helpers */
+#define COOP_BEGIN(t)           switch ((t)->lc) { case 0U:
+#define COOP_END(t)             } (t)->lc = 0U; return COOP_EXITED
+
+#define COOP_BLOCK(t, ticks)                                        \
+  do {                                                              \
+    (t)->lc   = (uint16_t)__LINE__;                                 \
+    (t)->wake = coopGetTick() + (uint32_t)(ticks);                  \
+    return COOP_WAITING;                                            \
+    case __LINE__:;                                                 \
+  } while (0)
+
+#define COOP_YIELD(t)           COOP_BLOCK(t, 0U)
+#define COOP_SLEEP(t, ticks)    COOP_BLOCK(t, ticks)
+
+#define COOP_WAIT_UNTIL(t, cond)                                    \
+  do {                                                              \
+    (t)->lc = (uint16_t)__LINE__;                                   \
+    case __LINE__:                                                  \
+    if (!(cond)) {                                                  \
+      (t)->wake = coopGetTick() + COOP_POLL_TICKS;                  \
+      return COOP_WAITING;                                          \
+    }                                                               \
+  } while (0)
+
+#define COOP_EXIT(t)            do { (t)->lc = 0U; return COOP_EXITED; } while (0)
+
+/* Prototypes */
+extern int32_t  coopInit     (void);
+extern int32_t  coopStart    (coopTask_t *task, coopFunc_t func);
+extern uint32_t coopGetTick  (void);
+extern void     coopGetStats (coopStats_t *stats);
+extern int32_t  coopBench    (uint32_t rounds, coopBench_t *result);
+
+#endif
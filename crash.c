@@ -0,0 +1,156 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    crash.c
+ * Purpose: Fault capture into retained RAM and immediate reset
+ *----------------------------------------------------------------------------*/
+
+
+#include "rtx_os.h"                     // osRtxInfo (running thread)
+#include "crash.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "mem_sections.h"
+#include "retained.h"
+
+#define CRASH_MAGIC             0x43525348U     // "CRSH"
+
+static crashRecord_t crashRecord __NOINIT;      // Written by the fault handlers
+__USED crashRecord_t crashLast;                 // Record of the previous run
+
+/*-----------------------------------------------------------------------------
+  Address range is readable SRAM (stack may be corrupt)
+ *----------------------------------------------------------------------------*/
+static uint32_t crashInRam (uint32_t addr, uint32_t size) {
+  if ((addr & 3U) != 0U) {
+    return 0U;
+  }
+  return (((addr >= 0x10000000U) && ((addr + size) <= 0x10008000U)) ||
+          ((addr >= 0x2007C000U) && ((addr + size) <= 0x20084000U))) ? 1U : 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  crashSave: fill the crash record and reset (called by the fault handlers)
+  frame:      exception frame on the active stack
+  exc_return: EXC_RETURN value of the fault
+ *----------------------------------------------------------------------------*/
+__USED __NO_RETURN void crashSave (const uint32_t *frame, uint32_t exc_return) {
+  const osRtxThread_t *thread = osRtxInfo.thread.run.curr;
+  const char          *name;
+  uint32_t             sp;
+  uint32_t             n;
+
+  crashRecord.magic      = 0U;
+  crashRecord.exception  = __get_IPSR();
+  crashRecord.exc_return = exc_return;
+  crashRecord.cfsr       = SCB->CFSR;
+  crashRecord.hfsr       = SCB->HFSR;
+  crashRecord.mmfar      = SCB->MMFAR;
+  crashRecord.bfar       = SCB->BFAR;
+  crashRecord.thread     = (uint32_t)thread;
+
+  crashRecord.thread_name[0] = '\0';
+  if ((thread != NULL) && (thread->name != NULL)) {
+    name = thread->name;
+    for (n = 0U; (n < (sizeof(crashRecord.thread_name) - 1U)) && (name[n] != '\0'); n++) {
+      crashRecord.thread_name[n] = name[n];
+    }
+    crashRecord.thread_name[n] = '\0';
+  }
+
+  crashRecord.stack_words = 0U;
+  if (crashInRam((uint32_t)frame, 8U * 4U) != 0U) {
+    crashRecord.r0   = frame[0];
+    crashRecord.r1   = frame[1];
+    crashRecord.r2   = frame[2];
+    crashRecord.r3   = frame[3];
+    crashRecord.r12  = frame[4];
+    crashRecord.lr   = frame[5];
+    crashRecord.pc   = frame[6];
+    crashRecord.xpsr = frame[7];
+
+    // Frame is padded to 8 bytes when xPSR bit 9 is set
+    sp = (uint32_t)&frame[8] + (((frame[7] & (1UL << 9)) != 0U) ? 4U : 0U);
+    crashRecord.sp = sp;
+    for (n = 0U; (n < CRASH_STACK_WORDS) && (crashInRam(sp, 4U) != 0U); n++, sp += 4U) {
+      crashRecord.stack[n] = *(const uint32_t *)sp;
+    }
+    crashRecord.stack_words = n;
+  } else {
+    crashRecord.sp = (uint32_t)frame;
+    crashRecord.pc = 0U;
+    crashRecord.lr = 0U;
+  }
+
+  crashRecord.count++;
+  __DMB();
+  crashRecord.magic = CRASH_MAGIC;
+
+  NVIC_SystemReset();
+}
+
+/*-----------------------------------------------------------------------------
+  Fault handlers: pass the active stack pointer and EXC_RETURN to crashSave
+ *----------------------------------------------------------------------------*/
+#define CRASH_HANDLER(name)                                                     \
+  __attribute__((naked)) void name (void) {                                     \
+    __ASM volatile (                                                            \
+      "tst   lr, #4      \n"                                                    \
+      "ite   eq          \n"                                                    \
+      "mrseq r0, msp     \n"                                                    \
+      "mrsne r0, psp     \n"                                                    \
+      "mov   r1, lr      \n"                                                    \
+      "b     crashSave   \n"                                                    \
+    );                                                                          \
+  }
+
+CRASH_HANDLER(HardFault_Handler)
+CRASH_HANDLER(MemManage_Handler)
+CRASH_HANDLER(BusFault_Handler)
+CRASH_HANDLER(UsageFault_Handler)
+
+/*-----------------------------------------------------------------------------
+  crashInit: publish the record of the previous run, enable fault handlers
+  Call once from main after retInit.
+ *----------------------------------------------------------------------------*/
+void crashInit (void) {
+  uint32_t count = 0U;
+
+  // After power-on the record content is random, even a matching magic
+  if (((retGetResetCause() & RET_RESET_POR) == 0U) && (crashRecord.magic == CRASH_MAGIC)) {
+    crashLast = crashRecord;
+    count     = crashRecord.count;
+  }
+  crashRecord.magic = 0U;
+  crashRecord.count = count;
+
+  // Separate handlers for MemManage, BusFault and UsageFault
+  SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk |
+                SCB_SHCSR_USGFAULTENA_Msk;
+}
+
+/*-----------------------------------------------------------------------------
+  crashGetLast: crash record of the previous run (NULL if none)
+ *----------------------------------------------------------------------------*/
+const crashRecord_t *crashGetLast (void) {
+  if (crashLast.magic != CRASH_MAGIC) {
+    return NULL;
+  }
+  return &crashLast;
+}
@@ -0,0 +1,70 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    crash.h
+ * Purpose: Fault capture into retained RAM and immediate reset
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef CRASH_H__
+#define CRASH_H__
+
+#include <stdint.h>
+
+/*
+  HardFault, MemManage, BusFault and UsageFault save a crash record into
+  no-init AHB SRAM and reset the system. crashInit publishes the record on
+  the next boot (crashGetLast, or crashLast in the debugger).
+
+  To symbolize the record with the ELF file, dump crashLast from the
+  debugger and run the host decoder (tools/crash_decode.c), which passes pc,
+  lr and the return addresses found on the stack to addr2line:
+    (gdb) dump binary value crash.bin crashLast
+    tools/crash_decode crash.bin Blinky.axf
+*/
+
+// Number of stack words saved above the exception frame
+#ifndef CRASH_STACK_WORDS
+#define CRASH_STACK_WORDS       32U
+#endif
+
+// Crash record (valid when magic is set)
+typedef struct {
+  uint32_t magic;                       // Written last: record complete
+  uint32_t count;                       // Crashes since power-on
+  uint32_t exception;                   // IPSR: 3 = HardFault .. 6 = UsageFault
+  uint32_t exc_return;                  // EXC_RETURN (bit 2: PSP = thread stack)
+  uint32_t r0, r1, r2, r3, r12;         // Stacked registers
+  uint32_t lr;                          // Stacked LR (caller of faulting function)
+  uint32_t pc;                          // Stacked PC (faulting instruction)
+  uint32_t xpsr;                        // Stacked xPSR
+  uint32_t sp;                          // SP before exception entry
+  uint32_t cfsr;                        // Configurable Fault Status
+  uint32_t hfsr;                        // HardFault Status
+  uint32_t mmfar;                       // MemManage Fault Address
+  uint32_t bfar;                        // BusFault Address
+  uint32_t thread;                      // Running RTX thread (osThreadId_t)
+  char     thread_name[16];             // Name of that thread
+  uint32_t stack_words;                 // Valid words in stack
+  uint32_t stack[CRASH_STACK_WORDS];    // Stack above the exception frame
+} crashRecord_t;
+
+/* Prototypes */
+extern void                 crashInit    (void);
+extern const crashRecord_t *crashGetLast (void);
+
+#endif
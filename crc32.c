@@ -0,0 +1,45 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    crc32.c
+ * Purpose: CRC-32 (IEEE 802.3)
+ *----------------------------------------------------------------------------*/
+
+
+#include "crc32.h"
+
+/*-----------------------------------------------------------------------------
+  CRC-32 (IEEE 802.3, reflected) with a 16 entry table
+ *----------------------------------------------------------------------------*/
+static const uint32_t crc32Table[16] = {
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+  0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+  0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+uint32_t crc32Calc (const void *data, uint32_t len) {
+  const uint8_t *p   = (const uint8_t *)data;
+  uint32_t       crc = 0xFFFFFFFFU;
+
+  while (len-- != 0U) {
+    crc ^= *p++;
+    crc  = (crc >> 4) ^ crc32Table[crc & 0x0FU];
+    crc  = (crc >> 4) ^ crc32Table[crc & 0x0FU];
+  }
+  return ~crc;
+}
@@ -0,0 +1,31 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    crc32.h
+ * Purpose: CRC-32 (IEEE 802.3)
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef CRC32_H__
+#define CRC32_H__
+
+#include <stdint.h>
+
+/* Prototypes */
+extern uint32_t crc32Calc (const void *data, uint32_t len);
+
+#endif
@@ -0,0 +1,483 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    emac.c
+ * Purpose: Ethernet MAC driver with descriptor rings in AHB SRAM
+ *----------------------------------------------------------------------------*/
+
+
+#include "emac.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "PIN_LPC17xx.h"
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+
+#include "clk_governor.h"
+#include "clk_profile.h"
+#include "irq_prio.h"
+#include "mem_sections.h"
+#include "pwr_periph.h"
+#include "timebase.h"
+
+#define EMAC_EVENT_RX           0x0001U
+
+// Clock profile held while the link is up: frames keep arriving at wire speed
+// and the receive thread has to keep up
+#ifndef EMAC_GOV_MIN
+#define EMAC_GOV_MIN            CLK_PROFILE_48MHZ
+#endif
+
+// MAC1 bits
+#define EMAC_MAC1_RX_EN         0x0001U
+#define EMAC_MAC1_RESET_ALL     0xCF00U // Resets of TX, MCS/TX, RX, MCS/RX, simulation, soft
+
+// MAC2 bits
+#define EMAC_MAC2_FULL_DUPLEX   0x0001U
+#define EMAC_MAC2_CRC_EN        0x0010U
+#define EMAC_MAC2_PAD_EN        0x0020U
+
+// Command bits
+#define EMAC_CMD_RX_EN          0x0001U
+#define EMAC_CMD_TX_EN          0x0002U
+#define EMAC_CMD_REG_RESET      0x0008U
+#define EMAC_CMD_TX_RESET       0x0010U
+#define EMAC_CMD_RX_RESET       0x0020U
+#define EMAC_CMD_RMII           0x0200U
+#define EMAC_CMD_FULL_DUPLEX    0x0400U
+
+// MII management
+#define EMAC_MCFG_RESET         0x8000U
+#define EMAC_MCMD_READ          0x0001U
+#define EMAC_MIND_BUSY          0x0001U
+#define EMAC_MII_TIMEOUT        100000U // Busy polls
+#define EMAC_MDC_MAX            2500000U
+
+// Interrupt bits
+#define EMAC_INT_RX_OVERRUN     0x0001U
+#define EMAC_INT_RX_DONE        0x0008U
+#define EMAC_INT_TX_UNDERRUN    0x0010U
+
+// Receive filter
+#define EMAC_RF_BROADCAST       0x0002U
+#define EMAC_RF_PERFECT         0x0020U
+
+// Descriptor control and status
+#define EMAC_DESC_SIZE          0x000007FFU     // Size - 1
+#define EMAC_DESC_INT           0x80000000U     // Interrupt when done
+#define EMAC_TX_LAST            0x40000000U
+#define EMAC_RX_LAST            0x40000000U
+#define EMAC_RX_ERRORS          0x3B800000U     // NoDesc, Overrun, Align, Length, Symbol, CRC
+                                                // (RangeError is set for every type field)
+#define EMAC_FCS_SIZE           4U
+
+// PHY registers (DP83848)
+#define PHY_BMCR                0x00U
+#define PHY_ID1                 0x02U
+#define PHY_STS                 0x10U
+#define PHY_BMCR_RESET          0x8000U
+#define PHY_BMCR_AUTONEG        0x1000U
+#define PHY_BMCR_RESTART        0x0200U
+#define PHY_ID1_DP83848         0x2000U
+#define PHY_STS_LINK            0x0001U
+#define PHY_STS_10M             0x0002U
+#define PHY_STS_FULL            0x0004U
+
+// Descriptor and status layouts (hardware)
+typedef struct {
+  uint32_t packet;
+  uint32_t ctrl;
+} emacDesc_t;
+
+typedef struct {
+  uint32_t info;
+  uint32_t hash_crc;
+} emacRxStat_t;
+
+static emacDesc_t       emacRxDesc[EMAC_RX_NUM]                 __DMA_RAM;
+static emacRxStat_t     emacRxStat[EMAC_RX_NUM]                 __DMA_RAM __ALIGNED(8);
+static emacDesc_t       emacTxDesc[EMAC_TX_NUM]                 __DMA_RAM;
+static uint32_t         emacTxStat[EMAC_TX_NUM]                 __DMA_RAM;
+static uint8_t          emacRxBuf[EMAC_RX_NUM][EMAC_BUF_SIZE]   __DMA_RAM __ALIGNED(4);
+static uint8_t          emacTxBuf[EMAC_TX_NUM][EMAC_BUF_SIZE]   __DMA_RAM __ALIGNED(4);
+
+static osEventFlagsId_t emacEvents;
+static volatile uint32_t emacRxStamp;   // Time of the receive interrupt
+static volatile uint32_t emacRxReset;   // Receive overrun: restart receive path
+static uint32_t         emacBatch;      // Frames since the receive interrupt
+static uint32_t         emacLink;
+
+__USED emacStats_t      emacStats;
+
+/*-----------------------------------------------------------------------------
+  MII management
+ *----------------------------------------------------------------------------*/
+static int32_t emacMiiWait (void) {
+  uint32_t n;
+
+  for (n = 0U; n < EMAC_MII_TIMEOUT; n++) {
+    if ((LPC_EMAC->MIND & EMAC_MIND_BUSY) == 0U) {
+      return 0;
+    }
+  }
+  return -1;
+}
+
+static int32_t emacPhyRead (uint32_t reg) {
+  int32_t status;
+
+  LPC_EMAC->MADR = (EMAC_PHY_ADDR << 8) | reg;
+  LPC_EMAC->MCMD = EMAC_MCMD_READ;
+  status = emacMiiWait();
+  LPC_EMAC->MCMD = 0U;
+  return (status == 0) ? (int32_t)(LPC_EMAC->MRDD & 0xFFFFU) : -1;
+}
+
+static int32_t emacPhyWrite (uint32_t reg, uint32_t val) {
+  LPC_EMAC->MCMD = 0U;
+  LPC_EMAC->MADR = (EMAC_PHY_ADDR << 8) | reg;
+  LPC_EMAC->MWTD = val;
+  return emacMiiWait();
+}
+
+// MDC divider for the core clock (MCFG clock select codes 1 .. 15)
+static void emacMdcSet (uint32_t cclk) {
+  static const uint8_t div[16] = { 4U, 4U, 6U, 8U, 10U, 14U, 20U, 28U,
+                                   36U, 40U, 44U, 48U, 52U, 56U, 60U, 64U };
+  uint32_t code;
+
+  for (code = 1U; code < 15U; code++) {
+    if ((cclk / div[code]) <= EMAC_MDC_MAX) {
+      break;
+    }
+  }
+  LPC_EMAC->MCFG = code << 2;
+}
+
+static void emacClockNotify (uint32_t event, uint32_t cclk) {
+  if (event == CLK_EVENT_POST) {
+    emacMdcSet(cclk);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Descriptor rings
+ *----------------------------------------------------------------------------*/
+static void emacRxRingInit (void) {
+  uint32_t n;
+
+  for (n = 0U; n < EMAC_RX_NUM; n++) {
+    emacRxDesc[n].packet   = (uint32_t)emacRxBuf[n];
+    emacRxDesc[n].ctrl     = (EMAC_BUF_SIZE - 1U) | EMAC_DESC_INT;
+    emacRxStat[n].info     = 0U;
+    emacRxStat[n].hash_crc = 0U;
+  }
+  LPC_EMAC->RxDescriptor       = (uint32_t)emacRxDesc;
+  LPC_EMAC->RxStatus           = (uint32_t)emacRxStat;
+  LPC_EMAC->RxDescriptorNumber = EMAC_RX_NUM - 1U;
+  LPC_EMAC->RxConsumeIndex     = 0U;
+}
+
+static void emacTxRingInit (void) {
+  uint32_t n;
+
+  for (n = 0U; n < EMAC_TX_NUM; n++) {
+    emacTxDesc[n].packet = (uint32_t)emacTxBuf[n];
+    emacTxDesc[n].ctrl   = 0U;
+    emacTxStat[n]        = 0U;
+  }
+  LPC_EMAC->TxDescriptor       = (uint32_t)emacTxDesc;
+  LPC_EMAC->TxStatus           = (uint32_t)emacTxStat;
+  LPC_EMAC->TxDescriptorNumber = EMAC_TX_NUM - 1U;
+  LPC_EMAC->TxProduceIndex     = 0U;
+}
+
+// Receive overrun is fatal for the receive path (UM10360): reset it
+static void emacRxRestart (void) {
+  emacRxReset      = 0U;
+  LPC_EMAC->MAC1  &= ~EMAC_MAC1_RX_EN;
+  LPC_EMAC->Command = (LPC_EMAC->Command & ~EMAC_CMD_RX_EN) | EMAC_CMD_RX_RESET;
+  emacRxRingInit();
+  LPC_EMAC->Command |= EMAC_CMD_RX_EN;
+  LPC_EMAC->MAC1    |= EMAC_MAC1_RX_EN;
+}
+
+/*-----------------------------------------------------------------------------
+  Ethernet interrupt: start of a receive batch
+ *----------------------------------------------------------------------------*/
+void ENET_IRQHandler (void) {
+  uint32_t status = LPC_EMAC->IntStatus & LPC_EMAC->IntEnable;
+
+  LPC_EMAC->IntClear = status;
+
+  if ((status & EMAC_INT_RX_OVERRUN) != 0U) {
+    emacStats.rx_overruns++;
+    emacRxReset = 1U;
+  }
+  if ((status & EMAC_INT_TX_UNDERRUN) != 0U) {
+    emacStats.tx_underruns++;
+  }
+  if ((status & (EMAC_INT_RX_DONE | EMAC_INT_RX_OVERRUN)) != 0U) {
+    LPC_EMAC->IntEnable &= ~EMAC_INT_RX_DONE;   // Until the ring is drained
+    emacRxStamp = tbGetUs();
+    emacStats.irqs++;
+    osEventFlagsSet(emacEvents, EMAC_EVENT_RX);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  emacInit failure: release the event flags and the peripheral
+ *----------------------------------------------------------------------------*/
+static int32_t emacInitFail (void) {
+  (void)osEventFlagsDelete(emacEvents);
+  emacEvents = NULL;
+  pmRelease(PM_ENET);
+  return -1;
+}
+
+/*-----------------------------------------------------------------------------
+  emacInit: set up MAC, PHY and descriptor rings (mac: 6 bytes)
+ *----------------------------------------------------------------------------*/
+int32_t emacInit (const uint8_t *mac) {
+  uint32_t n;
+  int32_t  id;
+
+  if (pmAcquire(PM_ENET, PM_PCLK_ANY) != 0) {
+    return -1;
+  }
+  emacEvents = osEventFlagsNew(NULL);
+  if (emacEvents == NULL) {
+    pmRelease(PM_ENET);
+    return -1;
+  }
+
+  // RMII: TXD0/1, TX_EN, CRS_DV, RXD0/1, RX_ER, REF_CLK, MDC, MDIO
+  PIN_Configure(1U,  0U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U,  1U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U,  4U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U,  8U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U,  9U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U, 10U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U, 14U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U, 15U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U, 16U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+  PIN_Configure(1U, 17U, PIN_FUNC_1, PIN_PINMODE_TRISTATE, PIN_PINMODE_NORMAL);
+
+  LPC_EMAC->MAC1    = EMAC_MAC1_RESET_ALL;
+  LPC_EMAC->Command = EMAC_CMD_REG_RESET | EMAC_CMD_TX_RESET | EMAC_CMD_RX_RESET;
+  tbDelayUs(10U);
+  LPC_EMAC->MAC1    = 0U;
+  LPC_EMAC->MAC2    = EMAC_MAC2_CRC_EN | EMAC_MAC2_PAD_EN;
+  LPC_EMAC->MAXF    = EMAC_BUF_SIZE;
+  LPC_EMAC->CLRT    = 0x370FU;          // Reset values: 15 retries, 55 byte window
+  LPC_EMAC->IPGR    = 0x0012U;
+  LPC_EMAC->IPGT    = 0x0012U;          // Half duplex until the link is known
+  LPC_EMAC->Command = EMAC_CMD_RMII;
+  LPC_EMAC->SUPP    = 0U;
+
+  LPC_EMAC->MCFG    = EMAC_MCFG_RESET;
+  emacMdcSet(clkProfileGetFreq(clkProfileGet()));
+
+  // PHY: reset, check identity, start auto-negotiation
+  if (emacPhyWrite(PHY_BMCR, PHY_BMCR_RESET) != 0) {
+    return emacInitFail();
+  }
+  for (n = 0U; n < 100U; n++) {
+    osDelay(1U);
+    if ((emacPhyRead(PHY_BMCR) & PHY_BMCR_RESET) == 0) {
+      break;
+    }
+  }
+  id = emacPhyRead(PHY_ID1);
+  if (id != (int32_t)PHY_ID1_DP83848) {
+    return emacInitFail();
+  }
+  (void)emacPhyWrite(PHY_BMCR, PHY_BMCR_AUTONEG | PHY_BMCR_RESTART);
+
+  LPC_EMAC->SA0 = ((uint32_t)mac[5] << 8) | mac[4];
+  LPC_EMAC->SA1 = ((uint32_t)mac[3] << 8) | mac[2];
+  LPC_EMAC->SA2 = ((uint32_t)mac[1] << 8) | mac[0];
+
+  emacRxRingInit();
+  emacTxRingInit();
+  LPC_EMAC->RxFilterCtrl = EMAC_RF_BROADCAST | EMAC_RF_PERFECT;
+
+  // Only once nothing else can fail: a clock callback cannot be removed
+  if (clkNotifyRegister(emacClockNotify) != 0) {
+    return emacInitFail();
+  }
+
+  LPC_EMAC->IntClear  = 0xFFFFU;
+  LPC_EMAC->IntEnable = EMAC_INT_RX_DONE | EMAC_INT_RX_OVERRUN | EMAC_INT_TX_UNDERRUN;
+  NVIC_ClearPendingIRQ(ENET_IRQn);
+  NVIC_EnableIRQ(ENET_IRQn);
+
+  LPC_EMAC->Command |= EMAC_CMD_RX_EN | EMAC_CMD_TX_EN;
+  LPC_EMAC->MAC1    |= EMAC_MAC1_RX_EN;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  emacLinkPoll: read the PHY status and set speed and duplex (thread)
+ *----------------------------------------------------------------------------*/
+uint32_t emacLinkPoll (void) {
+  int32_t  sts = emacPhyRead(PHY_STS);
+  uint32_t link;
+
+  if ((sts < 0) || (((uint32_t)sts & PHY_STS_LINK) == 0U)) {
+    if (emacLink != EMAC_LINK_DOWN) {
+      govReleaseMin(EMAC_GOV_MIN);
+    }
+    emacLink = EMAC_LINK_DOWN;
+    return emacLink;
+  }
+  link = EMAC_LINK_UP;
+  if (((uint32_t)sts & PHY_STS_10M) == 0U) {
+    link |= EMAC_LINK_100M;
+  }
+  if (((uint32_t)sts & PHY_STS_FULL) != 0U) {
+    link |= EMAC_LINK_FULL;
+  }
+  if (link != emacLink) {
+    if (emacLink == EMAC_LINK_DOWN) {
+      govHoldMin(EMAC_GOV_MIN);
+    }
+    emacLink = link;
+    if ((link & EMAC_LINK_FULL) != 0U) {
+      LPC_EMAC->MAC2    |= EMAC_MAC2_FULL_DUPLEX;
+      LPC_EMAC->Command |= EMAC_CMD_FULL_DUPLEX;
+      LPC_EMAC->IPGT     = 0x0015U;
+    } else {
+      LPC_EMAC->MAC2    &= ~EMAC_MAC2_FULL_DUPLEX;
+      LPC_EMAC->Command &= ~EMAC_CMD_FULL_DUPLEX;
+      LPC_EMAC->IPGT     = 0x0012U;
+    }
+    LPC_EMAC->SUPP = ((link & EMAC_LINK_100M) != 0U) ? 0x0100U : 0U;
+  }
+  return link;
+}
+
+/*-----------------------------------------------------------------------------
+  emacRxGet: oldest received frame, valid until emacRxRelease (NULL: timeout)
+  Only one thread may receive.
+ *----------------------------------------------------------------------------*/
+uint8_t *emacRxGet (uint32_t *len, uint32_t timeout) {
+  uint32_t basepri;
+  uint32_t latency;
+  uint32_t flags;
+  uint32_t info;
+  uint32_t idx;
+
+  for (;;) {
+    if (emacRxReset != 0U) {
+      emacRxRestart();
+    }
+    idx = LPC_EMAC->RxConsumeIndex;
+    if (idx != LPC_EMAC->RxProduceIndex) {
+      info = emacRxStat[idx].info;
+      if (((info & EMAC_RX_ERRORS) != 0U) || ((info & EMAC_RX_LAST) == 0U) ||
+          (((info & EMAC_DESC_SIZE) + 1U) <= EMAC_FCS_SIZE)) {
+        emacStats.rx_errors++;
+        LPC_EMAC->RxConsumeIndex = (idx + 1U) % EMAC_RX_NUM;
+        continue;
+      }
+      if (emacBatch++ == 0U) {
+        latency = tbGetUs() - emacRxStamp;
+        if (latency > emacStats.latency_max) {
+          emacStats.latency_max = latency;
+        }
+      }
+      *len = (info & EMAC_DESC_SIZE) + 1U - EMAC_FCS_SIZE;
+      emacStats.rx_frames++;
+      emacStats.rx_bytes += *len;
+      return emacRxBuf[idx];
+    }
+
+    // Ring drained: clear the RX_DONE status of the frames just read before
+    // enabling it, or the interrupt fires at once for an empty ring. A frame
+    // received before the clear is picked up here, a later one interrupts.
+    basepri = irqKernelLock();
+    LPC_EMAC->IntClear = EMAC_INT_RX_DONE;
+    if (idx != LPC_EMAC->RxProduceIndex) {
+      irqKernelUnlock(basepri);
+      continue;
+    }
+    LPC_EMAC->IntEnable |= EMAC_INT_RX_DONE;
+    irqKernelUnlock(basepri);
+
+    // End of batch, wait for the next receive interrupt
+    if (emacBatch > emacStats.batch_max) {
+      emacStats.batch_max = emacBatch;
+    }
+    emacBatch = 0U;
+
+    flags = osEventFlagsWait(emacEvents, EMAC_EVENT_RX, osFlagsWaitAny, timeout);
+    if ((flags & osFlagsError) != 0U) {
+      return NULL;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  emacRxRelease: return the frame from emacRxGet to the hardware
+ *----------------------------------------------------------------------------*/
+void emacRxRelease (void) {
+  uint32_t idx = LPC_EMAC->RxConsumeIndex;
+
+  if (idx != LPC_EMAC->RxProduceIndex) {
+    LPC_EMAC->RxConsumeIndex = (idx + 1U) % EMAC_RX_NUM;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  emacTxAlloc: next free transmit buffer (EMAC_BUF_SIZE bytes, NULL: full)
+  The buffer is sent by emacTxSend; sent buffers are reclaimed here.
+ *----------------------------------------------------------------------------*/
+uint8_t *emacTxAlloc (void) {
+  uint32_t idx = LPC_EMAC->TxProduceIndex;
+
+  if (((idx + 1U) % EMAC_TX_NUM) == LPC_EMAC->TxConsumeIndex) {
+    emacStats.tx_full++;
+    return NULL;
+  }
+  return emacTxBuf[idx];
+}
+
+/*-----------------------------------------------------------------------------
+  emacTxSend: send the buffer from emacTxAlloc (len without FCS)
+ *----------------------------------------------------------------------------*/
+int32_t emacTxSend (uint32_t len) {
+  uint32_t idx  = LPC_EMAC->TxProduceIndex;
+  uint32_t next = (idx + 1U) % EMAC_TX_NUM;
+
+  if ((len == 0U) || (len > (EMAC_BUF_SIZE - EMAC_FCS_SIZE)) || (next == LPC_EMAC->TxConsumeIndex)) {
+    return -1;
+  }
+  emacTxDesc[idx].ctrl = (len - 1U) | EMAC_TX_LAST;
+  __DMB();
+  LPC_EMAC->TxProduceIndex = next;
+  emacStats.tx_frames++;
+  emacStats.tx_bytes += len;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  emacGetStats: get driver statistics
+ *----------------------------------------------------------------------------*/
+void emacGetStats (emacStats_t *stats) {
+  *stats = emacStats;
+}
@@ -0,0 +1,98 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    emac.h
+ * Purpose: Ethernet MAC driver with descriptor rings in AHB SRAM
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef EMAC_H__
+#define EMAC_H__
+
+#include <stdint.h>
+
+/*
+  Descriptors, status arrays and packet buffers are in AHB SRAM (__DMA_RAM),
+  one buffer per frame. Frames are never copied by the driver: a received
+  frame is read in place until emacRxRelease, a frame to send is written
+  directly into the transmit buffer returned by emacTxAlloc.
+
+    uint8_t *frame;
+    uint32_t len;
+    while ((frame = emacRxGet(&len, osWaitForever)) != NULL) {
+      handle(frame, len);
+      emacRxRelease();
+    }
+
+  Receive interrupts are coalesced: the first frame disables the receive
+  interrupt and wakes the consumer, which drains the ring and enables the
+  interrupt again only once the ring is empty. Under load the ring is served
+  without any interrupt. Sent buffers are reclaimed by emacTxAlloc, so there
+  is no transmit interrupt either.
+
+  One thread receives; transmit (emacTxAlloc, emacTxSend) must be serialized
+  by the caller. Link changes are picked up by emacLinkPoll.
+
+  Wiring (mbed): on-board DP83848 PHY, RMII on P1.0/1/4/8/9/10/14/15,
+  MDC P1.16, MDIO P1.17.
+*/
+
+// Buffer counts and size (frame up to 1518 bytes plus VLAN tag)
+#ifndef EMAC_RX_NUM
+#define EMAC_RX_NUM             6U
+#endif
+#ifndef EMAC_TX_NUM
+#define EMAC_TX_NUM             3U
+#endif
+#define EMAC_BUF_SIZE           1536U
+
+// PHY address on the MDIO bus
+#ifndef EMAC_PHY_ADDR
+#define EMAC_PHY_ADDR           1U
+#endif
+
+// Link state (emacLinkPoll)
+#define EMAC_LINK_DOWN          0x00U
+#define EMAC_LINK_UP            0x01U
+#define EMAC_LINK_100M          0x02U
+#define EMAC_LINK_FULL          0x04U
+
+// Statistics
+typedef struct {
+  uint32_t rx_frames;
+  uint32_t rx_bytes;
+  uint32_t rx_errors;                   // CRC, symbol, length or alignment error
+  uint32_t rx_overruns;                 // Ring full or receive overrun
+  uint32_t tx_frames;
+  uint32_t tx_bytes;
+  uint32_t tx_full;                     // emacTxAlloc without free buffer
+  uint32_t tx_underruns;
+  uint32_t irqs;                        // Receive interrupts (one per batch)
+  uint32_t batch_max;                   // Most frames received per interrupt
+  uint32_t latency_max;                 // Interrupt to emacRxGet (us)
+} emacStats_t;
+
+/* Prototypes */
+extern int32_t  emacInit     (const uint8_t *mac);
+extern uint32_t emacLinkPoll (void);
+extern uint8_t *emacRxGet    (uint32_t *len, uint32_t timeout);
+extern void     emacRxRelease(void);
+extern uint8_t *emacTxAlloc  (void);
+extern int32_t  emacTxSend   (uint32_t len);
+extern void     emacGetStats (emacStats_t *stats);
+
+#endif
@@ -0,0 +1,459 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    flashlog.c
+ * Purpose: Append-only segmented record log on NOR flash
+ *----------------------------------------------------------------------------*/
+
+
+#include <stddef.h>
+#include <string.h>
+
+#include "flashlog.h"
+
+#include "crc32.h"
+
+#if ((FL_SEG_SIZE % FL_PAGE_SIZE) != 0U) || (FL_PAGE_SIZE < 64U)
+#error "FL_SEG_SIZE must be a multiple of FL_PAGE_SIZE (at least 64 bytes)"
+#endif
+
+#define FL_MAGIC                0x474F4C46U     // "FLOG"
+#define FL_NONE                 0xFFFFFFFFU
+
+// Page buffer states
+#define FL_BUF_FREE             0U
+#define FL_BUF_FILL             1U      // Receiving records
+#define FL_BUF_FULL             2U      // Waiting for flFlush
+
+// Record scan results
+#define FL_SCAN_OK              0
+#define FL_SCAN_END             1       // Erased: no more records
+#define FL_SCAN_BAD             2       // Invalid or torn record
+
+typedef struct {
+  uint32_t magic;
+  uint32_t seq;                         // Increments with every segment
+  uint32_t erases;                      // Erase count of this block
+  uint32_t crc;                         // CRC-32 of the fields above
+} flSegHdr_t;
+
+typedef struct {
+  uint16_t len;
+  uint16_t len_inv;                     // ~len (0xFFFF/0xFFFF: erased)
+  uint32_t crc;                         // CRC-32 of the data
+} flRecHdr_t;
+
+static const flOps_t *flOps;
+static uint32_t       flBase;           // First segment
+static uint32_t       flEnd;            // End of the log area
+static uint32_t       flSegNum;
+static uint32_t       flSegSeq;         // Sequence number of the newest segment
+
+// Page buffers (double buffered staging)
+static uint8_t        flBuf[2][FL_PAGE_SIZE];
+static uint32_t       flBufAddr[2];
+static uint32_t       flBufState[2];
+static uint32_t       flBufOrder[2];
+static uint32_t       flOrder;
+static uint32_t       flActive = FL_NONE;   // Buffer receiving records
+static uint32_t       flPos;                // Flash address of the next byte
+
+static flStats_t      flStats;
+
+/*-----------------------------------------------------------------------------
+  Helpers
+ *----------------------------------------------------------------------------*/
+static inline uint32_t flLock (void) {
+  return (flOps->lock != NULL) ? flOps->lock() : 0U;
+}
+
+static inline void flUnlock (uint32_t key) {
+  if (flOps->unlock != NULL) {
+    flOps->unlock(key);
+  }
+}
+
+static inline uint32_t flSegStart (uint32_t addr) {
+  return (addr - ((addr - flBase) % FL_SEG_SIZE));
+}
+
+static uint32_t flHdrValid (const flSegHdr_t *hdr) {
+  return ((hdr->magic == FL_MAGIC) &&
+          (hdr->crc == crc32Calc(hdr, offsetof(flSegHdr_t, crc)))) ? 1U : 0U;
+}
+
+static int32_t flReadHdr (uint32_t seg, flSegHdr_t *hdr) {
+  if ((flOps->read(flBase + (seg * FL_SEG_SIZE), hdr, sizeof(*hdr)) != 0) ||
+      (flHdrValid(hdr) == 0U)) {
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  Page buffer handling (called with the lock held)
+ *----------------------------------------------------------------------------*/
+static void flOpen (void) {
+  uint32_t idx = (flBufState[0] == FL_BUF_FREE) ? 0U : 1U;
+
+  memset(flBuf[idx], 0xFF, FL_PAGE_SIZE);
+  flBufAddr[idx]  = flPos;
+  flBufState[idx] = FL_BUF_FILL;
+  flBufOrder[idx] = flOrder++;
+  flActive        = idx;
+  if (((flPos - flBase) % FL_SEG_SIZE) == 0U) {
+    flPos += FL_SEG_HDR;                // Header is added by flFlush
+  }
+}
+
+static void flClose (void) {
+  uint32_t end = flBufAddr[flActive] + FL_PAGE_SIZE;
+
+  if (flPos < end) {
+    flStats.padding += end - flPos;
+  }
+  flBufState[flActive] = FL_BUF_FULL;
+  flActive             = FL_NONE;
+  flPos                = (end >= flEnd) ? flBase : end;
+}
+
+static void flPut (const uint8_t *src, uint32_t len) {
+  uint32_t off;
+  uint32_t n;
+
+  while (len != 0U) {
+    if (flActive == FL_NONE) {
+      flOpen();
+    }
+    off = flPos - flBufAddr[flActive];
+    n   = FL_PAGE_SIZE - off;
+    if (n > len) {
+      n = len;
+    }
+    memcpy(&flBuf[flActive][off], src, n);
+    flPos += n;
+    src   += n;
+    len   -= n;
+    if ((flPos - flBufAddr[flActive]) == FL_PAGE_SIZE) {
+      flClose();
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  flAppend: add one record (any thread, never waits for the flash)
+  Returns -1 if the record is too long or both page buffers are full.
+ *----------------------------------------------------------------------------*/
+int32_t flAppend (const void *data, uint32_t len) {
+  flRecHdr_t hdr;
+  uint32_t   need = FL_REC_HDR + len;
+  uint32_t   room = 0U;
+  uint32_t   seg_end;
+  uint32_t   key;
+  int32_t    status = 0;
+
+  if ((flOps == NULL) || (len == 0U) || (len > FL_RECORD_MAX)) {
+    return -1;
+  }
+  hdr.len     = (uint16_t)len;
+  hdr.len_inv = (uint16_t)~len;
+  hdr.crc     = crc32Calc(data, len);
+
+  key = flLock();
+
+  if (flActive != FL_NONE) {
+    seg_end = flSegStart(flBufAddr[flActive]) + FL_SEG_SIZE;
+    if ((flPos + need) > seg_end) {
+      flClose();                        // Continue in the next segment
+      flPos = (seg_end >= flEnd) ? flBase : seg_end;
+    }
+  }
+  if (flActive != FL_NONE) {
+    room = FL_PAGE_SIZE - (flPos - flBufAddr[flActive]);
+  }
+  if ((room < need) &&
+      (flBufState[0] != FL_BUF_FREE) && (flBufState[1] != FL_BUF_FREE)) {
+    flStats.dropped++;
+    status = -1;
+  } else {
+    flPut((const uint8_t *)&hdr, FL_REC_HDR);
+    flPut((const uint8_t *)data, len);
+    flStats.appended++;
+    flStats.bytes += need;
+  }
+
+  flUnlock(key);
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  Program one page; the first page of a segment erases the block first
+ *----------------------------------------------------------------------------*/
+static int32_t flWrite (uint32_t idx) {
+  flSegHdr_t hdr;
+  uint32_t   addr = flBufAddr[idx];
+  uint32_t   erases = 1U;
+
+  if (((addr - flBase) % FL_SEG_SIZE) == 0U) {
+    if (flReadHdr((addr - flBase) / FL_SEG_SIZE, &hdr) == 0) {
+      erases = hdr.erases + 1U;
+    }
+    if (flOps->erase(addr, FL_SEG_SIZE) != 0) {
+      return -1;
+    }
+    hdr.magic  = FL_MAGIC;
+    hdr.seq    = ++flSegSeq;
+    hdr.erases = erases;
+    hdr.crc    = crc32Calc(&hdr, offsetof(flSegHdr_t, crc));
+    memcpy(flBuf[idx], &hdr, FL_SEG_HDR);
+
+    flStats.erases++;
+    if (erases > flStats.erase_max) {
+      flStats.erase_max = erases;
+    }
+  }
+  if (flOps->program(addr, flBuf[idx], FL_PAGE_SIZE) != 0) {
+    return -1;
+  }
+  flStats.pages++;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  flFlush: program all full page buffers, oldest first (writer thread)
+ *----------------------------------------------------------------------------*/
+int32_t flFlush (void) {
+  uint32_t idx;
+  uint32_t key;
+  int32_t  status = 0;
+
+  if (flOps == NULL) {
+    return -1;
+  }
+  for (;;) {
+    key = flLock();
+    idx = FL_NONE;
+    if (flBufState[0] == FL_BUF_FULL) {
+      idx = 0U;
+    }
+    if ((flBufState[1] == FL_BUF_FULL) &&
+        ((idx == FL_NONE) || ((int32_t)(flBufOrder[1] - flBufOrder[0]) < 0))) {
+      idx = 1U;
+    }
+    flUnlock(key);
+    if (idx == FL_NONE) {
+      break;
+    }
+
+    if (flWrite(idx) != 0) {
+      flStats.errors++;
+      status = -1;
+    }
+    key = flLock();
+    flBufState[idx] = FL_BUF_FREE;
+    flUnlock(key);
+  }
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  flSync: pad the current page and program everything appended so far
+ *----------------------------------------------------------------------------*/
+int32_t flSync (void) {
+  uint32_t key;
+
+  if (flOps == NULL) {
+    return -1;
+  }
+  key = flLock();
+  if (flActive != FL_NONE) {
+    flClose();
+  }
+  flUnlock(key);
+  return flFlush();
+}
+
+/*-----------------------------------------------------------------------------
+  Read and check the record at *addr of a segment
+  Padding at the end of a page is skipped. len receives the data length.
+ *----------------------------------------------------------------------------*/
+static int32_t flScan (uint32_t seg_start, uint32_t *addr, uint8_t *data, uint32_t *len) {
+  flRecHdr_t hdr;
+  uint32_t   seg_end = seg_start + FL_SEG_SIZE;
+  uint32_t   page_off;
+
+  for (;;) {
+    if ((*addr + FL_REC_HDR) > seg_end) {
+      return FL_SCAN_END;
+    }
+    if (flOps->read(*addr, &hdr, FL_REC_HDR) != 0) {
+      return FL_SCAN_BAD;
+    }
+    if ((hdr.len == 0xFFFFU) && (hdr.len_inv == 0xFFFFU)) {
+      page_off = (*addr - flBase) % FL_PAGE_SIZE;
+      if ((page_off == 0U) || (*addr == (seg_start + FL_SEG_HDR))) {
+        return FL_SCAN_END;             // Erased page: end of data
+      }
+      *addr += FL_PAGE_SIZE - page_off; // Padding
+      continue;
+    }
+    if ((((uint32_t)hdr.len + hdr.len_inv) != 0xFFFFU) || (hdr.len == 0U) ||
+        (hdr.len > FL_RECORD_MAX) || ((*addr + FL_REC_HDR + hdr.len) > seg_end)) {
+      return FL_SCAN_BAD;
+    }
+    if ((flOps->read(*addr + FL_REC_HDR, data, hdr.len) != 0) ||
+        (crc32Calc(data, hdr.len) != hdr.crc)) {
+      return FL_SCAN_BAD;
+    }
+    *len   = hdr.len;
+    *addr += FL_REC_HDR + hdr.len;
+    return FL_SCAN_OK;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  flMount: find the end of the log from the segment headers
+  seg_num segments of FL_SEG_SIZE bytes start at base. A blank area is used
+  as an empty log. Returns 0 or -1.
+ *----------------------------------------------------------------------------*/
+int32_t flMount (const flOps_t *ops, uint32_t base, uint32_t seg_num) {
+  uint8_t    data[FL_RECORD_MAX];
+  flSegHdr_t hdr;
+  uint32_t   head = FL_NONE;
+  uint32_t   addr;
+  uint32_t   len;
+  uint32_t   seg;
+  int32_t    result;
+
+  if ((ops == NULL) || (ops->read == NULL) || (ops->program == NULL) ||
+      (ops->erase == NULL) || (seg_num < 2U) || ((base % FL_SEG_SIZE) != 0U)) {
+    return -1;
+  }
+  flOps         = ops;
+  flBase        = base;
+  flSegNum      = seg_num;
+  flEnd         = base + (seg_num * FL_SEG_SIZE);
+  flSegSeq      = 0U;
+  flActive      = FL_NONE;
+  flBufState[0] = FL_BUF_FREE;
+  flBufState[1] = FL_BUF_FREE;
+  memset(&flStats, 0, sizeof(flStats));
+
+  // Newest segment from the headers
+  for (seg = 0U; seg < seg_num; seg++) {
+    if (flReadHdr(seg, &hdr) != 0) {
+      continue;
+    }
+    if ((head == FL_NONE) || ((int32_t)(hdr.seq - flSegSeq) > 0)) {
+      head     = seg;
+      flSegSeq = hdr.seq;
+    }
+    if (hdr.erases > flStats.erase_max) {
+      flStats.erase_max = hdr.erases;
+    }
+  }
+  if (head == FL_NONE) {
+    flPos = base;                       // Blank: start with the first segment
+    return 0;
+  }
+
+  // End of the newest segment
+  addr = base + (head * FL_SEG_SIZE) + FL_SEG_HDR;
+  do {
+    result = flScan(base + (head * FL_SEG_SIZE), &addr, data, &len);
+    if (result == FL_SCAN_OK) {
+      flStats.recovered++;
+    }
+  } while (result == FL_SCAN_OK);
+
+  if (result == FL_SCAN_END) {
+    flPos = base + ((addr - base + FL_PAGE_SIZE - 1U) / FL_PAGE_SIZE) * FL_PAGE_SIZE;
+  } else {
+    flPos = base + ((head + 1U) * FL_SEG_SIZE);     // Torn write: skip the rest
+  }
+  if (flPos >= (base + ((head + 1U) * FL_SEG_SIZE))) {
+    flPos = base + ((head + 1U) * FL_SEG_SIZE);
+  }
+  if (flPos >= flEnd) {
+    flPos = base;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  flCursorInit: position a cursor at the oldest record
+ *----------------------------------------------------------------------------*/
+void flCursorInit (flCursor_t *cur) {
+  flSegHdr_t hdr;
+  uint32_t   seg;
+
+  cur->seg = FL_NONE;
+  for (seg = 0U; seg < flSegNum; seg++) {
+    if (flReadHdr(seg, &hdr) != 0) {
+      continue;
+    }
+    if ((cur->seg == FL_NONE) || ((int32_t)(hdr.seq - cur->seq) < 0)) {
+      cur->seg = seg;
+      cur->seq = hdr.seq;
+    }
+  }
+  if (cur->seg != FL_NONE) {
+    cur->addr = flBase + (cur->seg * FL_SEG_SIZE) + FL_SEG_HDR;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  flRead: read the next record (oldest to newest)
+  Returns the record length (data beyond size is not copied), 0 at the end
+  of the log (call again later for new records) or -1 if the segment under
+  the cursor was reused: restart with flCursorInit.
+ *----------------------------------------------------------------------------*/
+int32_t flRead (flCursor_t *cur, void *buf, uint32_t size) {
+  uint8_t    data[FL_RECORD_MAX];
+  flSegHdr_t hdr;
+  uint32_t   next;
+  uint32_t   len;
+
+  if ((flOps == NULL) || (cur->seg == FL_NONE)) {
+    return 0;
+  }
+  for (;;) {
+    if ((flReadHdr(cur->seg, &hdr) != 0) || (hdr.seq != cur->seq)) {
+      return -1;
+    }
+    if (flScan(flBase + (cur->seg * FL_SEG_SIZE), &cur->addr, data, &len) == FL_SCAN_OK) {
+      memcpy(buf, data, (len < size) ? len : size);
+      return (int32_t)len;
+    }
+
+    // End of this segment: continue if the next one follows in sequence
+    next = (cur->seg + 1U) % flSegNum;
+    if ((flReadHdr(next, &hdr) != 0) || (hdr.seq != (cur->seq + 1U))) {
+      return 0;
+    }
+    cur->seg  = next;
+    cur->seq  = hdr.seq;
+    cur->addr = flBase + (next * FL_SEG_SIZE) + FL_SEG_HDR;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  flGetStats: get log statistics
+ *----------------------------------------------------------------------------*/
+void flGetStats (flStats_t *stats) {
+  *stats = flStats;
+}
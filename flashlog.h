@@ -0,0 +1,107 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    flashlog.h
+ * Purpose: Append-only segmented record log on NOR flash
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef FLASHLOG_H__
+#define FLASHLOG_H__
+
+#include <stdint.h>
+
+/*
+  The log area is a ring of segments (one erase block each) used in turn,
+  so every block sees the same number of erase cycles. When the ring is
+  full the oldest segment is erased and reused.
+
+  Segment:  header (FL_SEG_HDR bytes) followed by records
+  Header:   magic, sequence number, erase count, CRC-32 of the first 12 bytes
+  Record:   length (16 bit), inverted length (16 bit), CRC-32 of the data, data
+
+  Records are collected in two page buffers. flAppend fills one buffer while
+  flFlush programs the other, always as whole pages. flSync pads the current
+  page with 0xFF so that everything appended so far is on flash.
+
+  Recovery reads only the segment headers to find the newest segment, then
+  scans that one segment for the end of the log. A record that fails its
+  check ends the segment; writing continues in the next segment.
+
+  The engine does not depend on the RTOS or the device: the flash and the
+  lock are supplied by flOps_t, so it also runs against a RAM model on a
+  host. On the target:
+
+    static uint32_t lock   (void)       { return irqKernelLock(); }
+    static void     unlock (uint32_t k) { irqKernelUnlock(k); }
+    static const flOps_t ops = { sfRead, sfProgram, sfErase, lock, unlock };
+
+    flMount(&ops, 0x100000U, 64U);      // 64 segments at 1 MiB
+    flAppend(&sample, sizeof(sample));  // any thread, does not block
+    flFlush();                          // writer thread, repeatedly
+*/
+
+#ifndef FL_PAGE_SIZE
+#define FL_PAGE_SIZE            256U    // Program unit
+#endif
+#ifndef FL_SEG_SIZE
+#define FL_SEG_SIZE             4096U   // Erase unit
+#endif
+
+#define FL_SEG_HDR              16U
+#define FL_REC_HDR              8U
+#define FL_RECORD_MAX           (FL_PAGE_SIZE - FL_SEG_HDR - FL_REC_HDR)
+
+// Flash access and locking (lock/unlock may be NULL for single context use)
+typedef struct {
+  int32_t  (*read)    (uint32_t addr, void *buf, uint32_t len);
+  int32_t  (*program) (uint32_t addr, const void *buf, uint32_t len);
+  int32_t  (*erase)   (uint32_t addr, uint32_t len);
+  uint32_t (*lock)    (void);
+  void     (*unlock)  (uint32_t key);
+} flOps_t;
+
+// Read position (see flCursorInit)
+typedef struct {
+  uint32_t seg;                         // Segment index
+  uint32_t seq;                         // Its sequence number
+  uint32_t addr;                        // Next record
+} flCursor_t;
+
+// Statistics
+typedef struct {
+  uint32_t appended;                    // Records accepted
+  uint32_t dropped;                     // Records lost (both buffers full)
+  uint32_t bytes;                       // Record bytes accepted (with header)
+  uint32_t pages;                       // Pages programmed
+  uint32_t padding;                     // Bytes of 0xFF padding programmed
+  uint32_t erases;                      // Segments erased
+  uint32_t erase_max;                   // Highest segment erase count
+  uint32_t errors;                      // Failed flash operations
+  uint32_t recovered;                   // Records found by flMount
+} flStats_t;
+
+/* Prototypes */
+extern int32_t flMount      (const flOps_t *ops, uint32_t base, uint32_t seg_num);
+extern int32_t flAppend     (const void *data, uint32_t len);
+extern int32_t flFlush      (void);
+extern int32_t flSync       (void);
+extern void    flCursorInit (flCursor_t *cur);
+extern int32_t flRead       (flCursor_t *cur, void *buf, uint32_t size);
+extern void    flGetStats   (flStats_t *stats);
+
+#endif
@@ -0,0 +1,368 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    gpdma.c
+ * Purpose: GPDMA channel manager with linked-list transfers
+ *----------------------------------------------------------------------------*/
+
+
+#include "gpdma.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "irq_prio.h"
+#include "mem_sections.h"
+#include "pwr_periph.h"
+#include "timebase.h"
+
+#define DMA_CHANNEL(ch)         ((LPC_GPDMACH_TypeDef *)(LPC_GPDMACH0_BASE + ((uint32_t)(ch) * 0x20U)))
+
+// Address in the local SRAM (not reachable by the GPDMA)
+#define DMA_IS_LOCAL(addr)      (((addr) >> 20) == 0x100U)
+
+// DMACCConfig bits
+#define DMA_CFG_E               (1UL << 0)
+#define DMA_CFG_SRC_PER(line)   ((uint32_t)(line) << 1)
+#define DMA_CFG_DST_PER(line)   ((uint32_t)(line) << 6)
+#define DMA_CFG_TYPE(type)      ((uint32_t)(type) << 11)
+#define DMA_CFG_IE              (1UL << 14)
+#define DMA_CFG_ITC             (1UL << 15)
+
+// Channel state
+typedef struct {
+  dmaCallback_t cb;
+  void         *arg;
+  uint32_t      req;                    // DMA_REQ_xxx
+  uint32_t      start;                  // tbGetUs at dmaStart
+} dmaChannel_t;
+
+static dmaChannel_t dmaChannel[DMA_CH_NUM];
+static uint32_t     dmaUsed;            // Allocated channels (bit mask)
+static uint32_t     dmaLines;           // Owned request lines (bit mask)
+
+__USED dmaStats_t   dmaStats;
+
+/*-----------------------------------------------------------------------------
+  dmaAllocCore: pick a free channel for prio (no hardware access)
+  used: allocated channels (bit mask)
+  Returns the channel or -1 if all channels are in use.
+ *----------------------------------------------------------------------------*/
+int32_t dmaAllocCore (uint32_t used, uint32_t prio) {
+  uint32_t n;
+  uint32_t ch;
+
+  for (n = 0U; n < DMA_CH_NUM; n++) {
+    ch = (prio == DMA_PRIO_HIGH) ? n : ((DMA_CH_NUM - 1U) - n);
+    if ((used & (1UL << ch)) == 0U) {
+      return (int32_t)ch;
+    }
+  }
+  return -1;
+}
+
+/*-----------------------------------------------------------------------------
+  dmaLliCheck: every item of a list is reachable by the GPDMA (no hardware)
+  Checks the buffers of all items and the placement of the items the
+  hardware fetches (all but the first). Only checked items are followed. A
+  list linking back to an earlier item ends when the walk returns to a
+  saved item (saved at doubling distances, so one lap is enough).
+  Returns 0 if the list is usable or -1.
+ *----------------------------------------------------------------------------*/
+int32_t dmaLliCheck (const dmaLli_t *lli) {
+  const dmaLli_t *item  = lli;
+  const dmaLli_t *saved = lli;
+  uint32_t        steps = 0U;
+  uint32_t        limit = 1U;
+
+  while (item != NULL) {
+    if (DMA_IS_LOCAL(item->src) || DMA_IS_LOCAL(item->dst)) {
+      return -1;
+    }
+    if ((item != lli) && (DMA_IS_LOCAL((uintptr_t)item) || (((uintptr_t)item & 3U) != 0U))) {
+      return -1;
+    }
+    item = item->next;
+    if (item == saved) {
+      break;                            // Loop completed
+    }
+    if (++steps == limit) {
+      saved  = item;
+      steps  = 0U;
+      limit <<= 1;
+    }
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  Account the running time of a channel that stopped (lock held)
+ *----------------------------------------------------------------------------*/
+static void dmaBusyEnd (uint32_t ch) {
+  if (dmaChannel[ch].start != 0U) {
+    dmaStats.busy_us[ch] += tbGetUs() - dmaChannel[ch].start;
+    dmaChannel[ch].start  = 0U;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Dispatch completion and error events (body of the DMA interrupt)
+ *----------------------------------------------------------------------------*/
+__STATIC_FORCEINLINE void dmaIrqDispatch (void) {
+  uint32_t tc  = LPC_GPDMA->DMACIntTCStat;
+  uint32_t err = LPC_GPDMA->DMACIntErrStat;
+  uint32_t pending;
+  uint32_t event;
+  uint32_t ch;
+
+  LPC_GPDMA->DMACIntTCClear = tc;
+  LPC_GPDMA->DMACIntErrClr  = err;
+
+  pending = tc | err;
+  while (pending != 0U) {
+    ch       = __CLZ(__RBIT(pending));
+    pending &= ~(1UL << ch);
+
+    event = 0U;
+    if ((tc & (1UL << ch)) != 0U) {
+      event |= DMA_EVENT_DONE;
+      dmaStats.done[ch]++;
+    }
+    if ((err & (1UL << ch)) != 0U) {
+      event |= DMA_EVENT_ERROR;
+      dmaStats.errors[ch]++;
+    }
+    if ((LPC_GPDMA->DMACEnbldChns & (1UL << ch)) == 0U) {
+      dmaBusyEnd(ch);
+    }
+    if (dmaChannel[ch].cb != NULL) {
+      dmaChannel[ch].cb(event, dmaChannel[ch].arg);
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  DMA interrupt: dispatch completion and error events
+ *----------------------------------------------------------------------------*/
+__RAMFUNC void DMA_IRQHandler (void) {
+  dmaIrqDispatch();
+}
+
+/*-----------------------------------------------------------------------------
+  dmaIrqFlash: the same handler body executed from flash (mem_bench only)
+ *----------------------------------------------------------------------------*/
+void dmaIrqFlash (void) {
+  dmaIrqDispatch();
+}
+
+/*-----------------------------------------------------------------------------
+  dmaAlloc: allocate a channel (thread or ISR context)
+  prio: DMA_PRIO_xxx
+  req:  DMA_REQ_xxx request line (DMA_REQ_MEM for memory to memory)
+  cb:   event callback (may be NULL), arg: callback argument
+  Returns the channel or -1 (no free channel or request line in use).
+ *----------------------------------------------------------------------------*/
+int32_t dmaAlloc (uint32_t prio, uint32_t req, dmaCallback_t cb, void *arg) {
+  uint32_t lock;
+  uint32_t line = 0U;
+  int32_t  ch;
+
+  if (req != DMA_REQ_MEM) {
+    // Timer match alternative exists for lines 8..15 only
+    if ((req > DMA_REQ_MAT(15U)) || (((req & 0x10U) != 0U) && ((req & 0x0FU) < 8U))) {
+      return -1;
+    }
+    line = 1UL << (req & 0x0FU);
+  }
+
+  lock = irqKernelLock();
+  ch   = dmaAllocCore(dmaUsed, prio);
+  if ((ch < 0) || ((dmaLines & line) != 0U)) {
+    dmaStats.contention++;
+    irqKernelUnlock(lock);
+    return -1;
+  }
+
+  if (dmaUsed == 0U) {
+    pmAcquire(PM_GPDMA, PM_PCLK_ANY);
+    LPC_GPDMA->DMACIntTCClear = 0xFFU;
+    LPC_GPDMA->DMACIntErrClr  = 0xFFU;
+    LPC_GPDMA->DMACConfig     = 0x01U;  // Enable, little endian
+    NVIC_EnableIRQ(DMA_IRQn);
+  }
+  dmaUsed  |= 1UL << ch;
+  dmaLines |= line;
+
+  // Lines 8..15: select UART (0) or timer match (1)
+  if ((req != DMA_REQ_MEM) && ((req & 0x0FU) >= 8U)) {
+    if ((req & 0x10U) != 0U) {
+      LPC_SC->DMAREQSEL |=  (1UL << ((req & 0x0FU) - 8U));
+    } else {
+      LPC_SC->DMAREQSEL &= ~(1UL << ((req & 0x0FU) - 8U));
+    }
+  }
+
+  dmaChannel[ch].cb    = cb;
+  dmaChannel[ch].arg   = arg;
+  dmaChannel[ch].req   = req;
+  dmaChannel[ch].start = 0U;
+
+  dmaStats.allocs++;
+  dmaStats.in_use++;
+  if (dmaStats.in_use > dmaStats.in_use_max) {
+    dmaStats.in_use_max = dmaStats.in_use;
+  }
+  irqKernelUnlock(lock);
+
+  return ch;
+}
+
+/*-----------------------------------------------------------------------------
+  dmaFree: stop and release a channel
+ *----------------------------------------------------------------------------*/
+void dmaFree (int32_t ch) {
+  uint32_t lock;
+
+  if ((ch < 0) || ((uint32_t)ch >= DMA_CH_NUM)) {
+    return;
+  }
+  dmaStop(ch);
+
+  lock = irqKernelLock();
+  if ((dmaUsed & (1UL << ch)) != 0U) {
+    dmaUsed &= ~(1UL << ch);
+    if (dmaChannel[ch].req != DMA_REQ_MEM) {
+      dmaLines &= ~(1UL << (dmaChannel[ch].req & 0x0FU));
+    }
+    dmaChannel[ch].cb = NULL;
+    dmaStats.in_use--;
+
+    if (dmaUsed == 0U) {
+      NVIC_DisableIRQ(DMA_IRQn);
+      LPC_GPDMA->DMACConfig = 0U;
+      pmRelease(PM_GPDMA);
+    }
+  }
+  irqKernelUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  dmaStart: start a transfer described by a linked list
+  The first item is loaded into the channel, following items are fetched by
+  the hardware. A list that links back to an earlier item runs until dmaStop.
+  type: DMA_M2M, DMA_M2P or DMA_P2M
+ *----------------------------------------------------------------------------*/
+int32_t dmaStart (int32_t ch, const dmaLli_t *lli, uint32_t type) {
+  LPC_GPDMACH_TypeDef *reg;
+  uint32_t             line;
+  uint32_t             cfg;
+  uint32_t             lock;
+
+  if ((ch < 0) || ((uint32_t)ch >= DMA_CH_NUM) || (lli == NULL) || (type > DMA_P2M)) {
+    return -1;
+  }
+  if ((dmaUsed & (1UL << ch)) == 0U) {
+    return -1;
+  }
+  // Local SRAM is not reachable by the GPDMA
+  if (dmaLliCheck(lli) != 0) {
+    return -1;
+  }
+
+  reg = DMA_CHANNEL(ch);
+  if ((reg->DMACCConfig & DMA_CFG_E) != 0U) {
+    return -1;                          // Busy
+  }
+
+  line = dmaChannel[ch].req & 0x0FU;
+  cfg  = DMA_CFG_TYPE(type) | DMA_CFG_IE | DMA_CFG_ITC | DMA_CFG_E;
+  if (type == DMA_M2P) {
+    cfg |= DMA_CFG_DST_PER(line);
+  } else if (type == DMA_P2M) {
+    cfg |= DMA_CFG_SRC_PER(line);
+  }
+
+  LPC_GPDMA->DMACIntTCClear = 1UL << ch;
+  LPC_GPDMA->DMACIntErrClr  = 1UL << ch;
+  reg->DMACCSrcAddr  = lli->src;
+  reg->DMACCDestAddr = lli->dst;
+  reg->DMACCLLI      = (uint32_t)lli->next;
+  reg->DMACCControl  = lli->ctrl;
+
+  lock = irqKernelLock();
+  dmaChannel[ch].start = tbGetUs() | 1U;    // Non-zero: transfer running
+  irqKernelUnlock(lock);
+
+  reg->DMACCConfig = cfg;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  dmaStop: abort a running transfer (data in the channel FIFO is lost)
+ *----------------------------------------------------------------------------*/
+void dmaStop (int32_t ch) {
+  LPC_GPDMACH_TypeDef *reg;
+  uint32_t             lock;
+
+  if ((ch < 0) || ((uint32_t)ch >= DMA_CH_NUM)) {
+    return;
+  }
+  reg = DMA_CHANNEL(ch);
+  reg->DMACCConfig &= ~DMA_CFG_E;
+
+  lock = irqKernelLock();
+  dmaBusyEnd((uint32_t)ch);
+  irqKernelUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  dmaIsBusy: channel has a transfer running
+ *----------------------------------------------------------------------------*/
+uint32_t dmaIsBusy (int32_t ch) {
+  if ((ch < 0) || ((uint32_t)ch >= DMA_CH_NUM)) {
+    return 0U;
+  }
+  return ((LPC_GPDMA->DMACEnbldChns & (1UL << ch)) != 0U) ? 1U : 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  dmaGetDst: current destination address (progress of a running transfer)
+ *----------------------------------------------------------------------------*/
+uint32_t dmaGetDst (int32_t ch) {
+  if ((ch < 0) || ((uint32_t)ch >= DMA_CH_NUM)) {
+    return 0U;
+  }
+  return DMA_CHANNEL(ch)->DMACCDestAddr;
+}
+
+/*-----------------------------------------------------------------------------
+  dmaGetStats: get allocation and utilization statistics
+  busy_us of running channels includes the current transfer.
+ *----------------------------------------------------------------------------*/
+void dmaGetStats (dmaStats_t *stats) {
+  uint32_t lock = irqKernelLock();
+  uint32_t now  = tbGetUs();
+  uint32_t ch;
+
+  *stats = dmaStats;
+  for (ch = 0U; ch < DMA_CH_NUM; ch++) {
+    if (dmaChannel[ch].start != 0U) {
+      stats->busy_us[ch] += now - dmaChannel[ch].start;
+    }
+  }
+  irqKernelUnlock(lock);
+}
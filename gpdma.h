@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    gpdma.h
+ * Purpose: GPDMA channel manager with linked-list transfers
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef GPDMA_H__
+#define GPDMA_H__
+
+#include <stdint.h>
+
+/*
+  Channels are assigned on demand. The hardware serves channel 0 first:
+  DMA_PRIO_HIGH allocates from channel 0 upwards, DMA_PRIO_LOW from channel
+  7 downwards. Request lines 8..15 are shared between UART and timer match
+  (DMAREQSEL); a line is owned by one channel at a time.
+
+  The GPDMA cannot access the local SRAM at 0x10000000: buffers and linked
+  list items must be placed in AHB SRAM (__DMA_RAM, see mem_sections.h).
+*/
+
+#define DMA_CH_NUM              8U
+
+// Channel priority
+#define DMA_PRIO_HIGH           0U      // Latency critical (low channel number)
+#define DMA_PRIO_LOW            1U      // Bulk transfers (high channel number)
+
+// Request lines (DMA_REQ_MATx_y select the timer match alternative)
+#define DMA_REQ_SSP0_TX         0U
+#define DMA_REQ_SSP0_RX         1U
+#define DMA_REQ_SSP1_TX         2U
+#define DMA_REQ_SSP1_RX         3U
+#define DMA_REQ_ADC             4U
+#define DMA_REQ_I2S0            5U
+#define DMA_REQ_I2S1            6U
+#define DMA_REQ_DAC             7U
+#define DMA_REQ_UART0_TX        8U
+#define DMA_REQ_UART0_RX        9U
+#define DMA_REQ_UART1_TX        10U
+#define DMA_REQ_UART1_RX        11U
+#define DMA_REQ_UART2_TX        12U
+#define DMA_REQ_UART2_RX        13U
+#define DMA_REQ_UART3_TX        14U
+#define DMA_REQ_UART3_RX        15U
+#define DMA_REQ_MAT(line)       (0x10U | (line))    // Timer match on line 8..15
+#define DMA_REQ_MEM             0xFFU   // Memory to memory (no request line)
+
+// Transfer type
+#define DMA_M2M                 0U      // Memory to memory
+#define DMA_M2P                 1U      // Memory to peripheral
+#define DMA_P2M                 2U      // Peripheral to memory
+
+// Channel control word (DMACCControl)
+#define DMA_WIDTH_8             0U
+#define DMA_WIDTH_16            1U
+#define DMA_WIDTH_32            2U
+#define DMA_BURST_1             0U
+#define DMA_BURST_4             1U
+#define DMA_BURST_8             2U
+#define DMA_BURST_16            3U
+
+#define DMA_CTRL_SIZE(n)        ((uint32_t)(n) & 0xFFFU)    // Transfers (source width)
+#define DMA_CTRL_SBSIZE(b)      ((uint32_t)(b) << 12)
+#define DMA_CTRL_DBSIZE(b)      ((uint32_t)(b) << 15)
+#define DMA_CTRL_SWIDTH(w)      ((uint32_t)(w) << 18)
+#define DMA_CTRL_DWIDTH(w)      ((uint32_t)(w) << 21)
+#define DMA_CTRL_SI             (1UL << 26)     // Source increment
+#define DMA_CTRL_DI             (1UL << 27)     // Destination increment
+#define DMA_CTRL_I              (1UL << 31)     // DMA_EVENT_DONE after this item
+
+#define DMA_SIZE_MAX            4095U   // Transfers per linked list item
+
+// Callback events
+#define DMA_EVENT_DONE          0x01U   // Item with DMA_CTRL_I completed
+#define DMA_EVENT_ERROR         0x02U   // Bus error, channel stopped
+
+// Linked list item (hardware layout, word aligned, in AHB SRAM)
+typedef struct dmaLli_s {
+  uint32_t               src;           // Source address
+  uint32_t               dst;           // Destination address
+  const struct dmaLli_s *next;          // Next item (NULL = last)
+  uint32_t               ctrl;          // DMA_CTRL_xxx
+} dmaLli_t;
+
+// Event callback (DMA interrupt context, kernel-aware)
+typedef void (*dmaCallback_t) (uint32_t event, void *arg);
+
+// Statistics
+typedef struct {
+  uint32_t allocs;                      // Successful allocations
+  uint32_t contention;                  // Rejected: no channel or request line busy
+  uint32_t in_use;                      // Channels currently allocated
+  uint32_t in_use_max;                  // Most channels allocated at once
+  uint32_t done[DMA_CH_NUM];            // DMA_EVENT_DONE per channel
+  uint32_t errors[DMA_CH_NUM];          // DMA_EVENT_ERROR per channel
+  uint32_t busy_us[DMA_CH_NUM];         // Time with a transfer running
+} dmaStats_t;
+
+/* Prototypes */
+extern int32_t  dmaAlloc     (uint32_t prio, uint32_t req, dmaCallback_t cb, void *arg);
+extern void     dmaFree      (int32_t ch);
+extern int32_t  dmaStart     (int32_t ch, const dmaLli_t *lli, uint32_t type);
+extern void     dmaStop      (int32_t ch);
+extern uint32_t dmaIsBusy    (int32_t ch);
+extern uint32_t dmaGetDst    (int32_t ch);
+extern void     dmaGetStats  (dmaStats_t *stats);
+extern int32_t  dmaAllocCore (uint32_t used, uint32_t prio);
+extern int32_t  dmaLliCheck  (const dmaLli_t *lli);
+extern void     dmaIrqFlash  (void);
+
+#endif
@@ -0,0 +1,350 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    i2c_engine.c
+ * Purpose: Interrupt driven I2C transaction queue with periodic batches
+ *----------------------------------------------------------------------------*/
+
+
+#include "i2c_engine.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "PIN_LPC17xx.h"
+
+#include "clk_profile.h"
+#include "irq_prio.h"
+#include "pwr_periph.h"
+
+#ifndef I2C_REG
+#define I2C_REG                 LPC_I2C1        // Host test: bus model
+#endif
+
+// I2CONSET / I2CONCLR bits
+#define I2C_CON_AA              0x04U
+#define I2C_CON_SI              0x08U
+#define I2C_CON_STO             0x10U
+#define I2C_CON_STA             0x20U
+#define I2C_CON_EN              0x40U
+
+// Master status codes (I2STAT)
+#define I2C_ST_BUS_ERROR        0x00U
+#define I2C_ST_START            0x08U
+#define I2C_ST_RESTART          0x10U
+#define I2C_ST_SLAW_ACK         0x18U
+#define I2C_ST_SLAW_NACK        0x20U
+#define I2C_ST_TX_ACK           0x28U
+#define I2C_ST_TX_NACK          0x30U
+#define I2C_ST_ARB_LOST         0x38U
+#define I2C_ST_SLAR_ACK         0x40U
+#define I2C_ST_SLAR_NACK        0x48U
+#define I2C_ST_RX_ACK           0x50U
+#define I2C_ST_RX_NACK          0x58U
+
+static i2cXfer_t  *i2cHead;             // Queue
+static i2cXfer_t  *i2cTail;
+static uint32_t    i2cQueued;
+static i2cXfer_t  *i2cCur;              // Running transaction
+static uint32_t    i2cSeg;              // Current segment
+static uint32_t    i2cPos;              // Byte within segment
+static twTimer_t   i2cTimer;            // Transaction timeout
+
+__USED i2cStats_t  i2cStats;            // Engine statistics
+
+/*-----------------------------------------------------------------------------
+  Queue (called with interrupts of the kernel tier masked)
+ *----------------------------------------------------------------------------*/
+static void i2cEnqueue (i2cXfer_t *xfer) {
+  xfer->next   = NULL;
+  xfer->status = I2C_PENDING;
+  if (i2cTail != NULL) {
+    i2cTail->next = xfer;
+  } else {
+    i2cHead = xfer;
+  }
+  i2cTail = xfer;
+  if (++i2cQueued > i2cStats.queue_max) {
+    i2cStats.queue_max = i2cQueued;
+  }
+}
+
+static i2cXfer_t *i2cDequeue (void) {
+  i2cXfer_t *xfer = i2cHead;
+
+  if (xfer != NULL) {
+    i2cHead = xfer->next;
+    if (i2cHead == NULL) {
+      i2cTail = NULL;
+    }
+    i2cQueued--;
+  }
+  return xfer;
+}
+
+/*-----------------------------------------------------------------------------
+  Start the next transaction (con: STA, or STO | STA after a transaction)
+ *----------------------------------------------------------------------------*/
+static void i2cNext (uint32_t con) {
+  i2cCur = i2cDequeue();
+  i2cSeg = 0U;
+  i2cPos = 0U;
+  if (i2cCur != NULL) {
+    I2C_REG->I2CONSET = con | I2C_CON_STA;
+    twStart(&i2cTimer, I2C_TIMEOUT_TICKS, 0U);
+  } else {
+    if (con != 0U) {
+      I2C_REG->I2CONSET = con;
+    }
+    twStop(&i2cTimer);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Complete the running transaction and continue with the queue
+ *----------------------------------------------------------------------------*/
+static void i2cFinish (int32_t status, uint32_t con) {
+  i2cXfer_t *xfer = i2cCur;
+
+  i2cNext(con);
+  I2C_REG->I2CONCLR = I2C_CON_SI | I2C_CON_AA;
+
+  switch (status) {
+    case I2C_ERR_NACK:    i2cStats.nacks++;      break;
+    case I2C_ERR_BUS:     i2cStats.bus_errors++; break;
+    case I2C_ERR_TIMEOUT: i2cStats.timeouts++;   break;
+    default:                                     break;
+  }
+  i2cStats.xfers++;
+
+  xfer->status = status;
+  if (xfer->cb != NULL) {
+    xfer->cb(xfer);
+  }
+  if (xfer->ef != NULL) {
+    osEventFlagsSet(xfer->ef, xfer->ef_mask);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  I2C interrupt: master state machine
+ *----------------------------------------------------------------------------*/
+void I2C1_IRQHandler (void) {
+  const i2cSeg_t *seg;
+  uint32_t        stat = I2C_REG->I2STAT;
+
+  if (i2cCur == NULL) {
+    I2C_REG->I2CONCLR = I2C_CON_SI | I2C_CON_STA;
+    return;
+  }
+  seg = &i2cCur->seg[i2cSeg];
+
+  switch (stat) {
+    case I2C_ST_START:
+    case I2C_ST_RESTART:
+      I2C_REG->I2DAT    = ((uint32_t)seg->addr << 1) | seg->dir;
+      I2C_REG->I2CONCLR = I2C_CON_SI | I2C_CON_STA;
+      i2cPos = 0U;
+      return;
+
+    case I2C_ST_SLAW_ACK:
+    case I2C_ST_TX_ACK:
+      if (i2cPos < seg->len) {
+        I2C_REG->I2DAT    = seg->buf[i2cPos++];
+        I2C_REG->I2CONCLR = I2C_CON_SI;
+        return;
+      }
+      break;                            // Segment done
+
+    case I2C_ST_SLAR_ACK:
+      if (seg->len > 1U) {
+        I2C_REG->I2CONSET = I2C_CON_AA;
+      } else {
+        I2C_REG->I2CONCLR = I2C_CON_AA;
+      }
+      I2C_REG->I2CONCLR = I2C_CON_SI;
+      return;
+
+    case I2C_ST_RX_ACK:
+      seg->buf[i2cPos++] = (uint8_t)I2C_REG->I2DAT;
+      if ((seg->len - i2cPos) > 1U) {
+        I2C_REG->I2CONSET = I2C_CON_AA;
+      } else {
+        I2C_REG->I2CONCLR = I2C_CON_AA; // NACK the last byte
+      }
+      I2C_REG->I2CONCLR = I2C_CON_SI;
+      return;
+
+    case I2C_ST_RX_NACK:
+      seg->buf[i2cPos++] = (uint8_t)I2C_REG->I2DAT;
+      break;                            // Segment done
+
+    case I2C_ST_SLAW_NACK:
+    case I2C_ST_TX_NACK:
+    case I2C_ST_SLAR_NACK:
+      i2cFinish(I2C_ERR_NACK, I2C_CON_STO);
+      return;
+
+    case I2C_ST_ARB_LOST:
+      i2cFinish(I2C_ERR_BUS, 0U);       // Bus already released
+      return;
+
+    default:                            // Bus error
+      i2cFinish(I2C_ERR_BUS, I2C_CON_STO);
+      return;
+  }
+
+  // Segment done: repeated start or stop
+  if (++i2cSeg < i2cCur->seg_num) {
+    I2C_REG->I2CONSET = I2C_CON_STA;
+    I2C_REG->I2CONCLR = I2C_CON_SI;
+  } else {
+    i2cFinish(I2C_OK, I2C_CON_STO);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Transaction timeout (timer wheel interrupt): reset the interface
+ *----------------------------------------------------------------------------*/
+static void i2cTimeout (void *arg) {
+  uint32_t lock = irqKernelLock();
+  (void)arg;
+
+  if (i2cCur != NULL) {
+    I2C_REG->I2CONCLR = I2C_CON_EN | I2C_CON_STA | I2C_CON_SI | I2C_CON_AA;
+    I2C_REG->I2CONSET = I2C_CON_EN;
+    i2cFinish(I2C_ERR_TIMEOUT, 0U);
+  }
+  irqKernelUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  i2cSubmit: queue a transaction (thread or ISR context)
+ *----------------------------------------------------------------------------*/
+int32_t i2cSubmit (i2cXfer_t *xfer) {
+  uint32_t lock;
+
+  if ((xfer == NULL) || (xfer->seg == NULL) || (xfer->seg_num == 0U) ||
+      (xfer->status == I2C_PENDING)) {
+    return -1;
+  }
+
+  lock = irqKernelLock();
+  i2cEnqueue(xfer);
+  if (i2cCur == NULL) {
+    i2cNext(0U);
+  }
+  irqKernelUnlock(lock);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  Batch timer (timer wheel interrupt): submit all transactions at once
+ *----------------------------------------------------------------------------*/
+static void i2cBatchRun (void *arg) {
+  i2cBatch_t *batch = (i2cBatch_t *)arg;
+  uint32_t    lock;
+  uint32_t    n;
+
+  for (n = 0U; n < batch->num; n++) {
+    if (batch->xfer[n]->status == I2C_PENDING) {
+      batch->overruns++;
+      return;
+    }
+  }
+
+  lock = irqKernelLock();
+  for (n = 0U; n < batch->num; n++) {
+    i2cEnqueue(batch->xfer[n]);
+  }
+  if (i2cCur == NULL) {
+    i2cNext(0U);
+  }
+  irqKernelUnlock(lock);
+  batch->runs++;
+}
+
+/*-----------------------------------------------------------------------------
+  i2cBatchStart: submit a batch every period timer wheel ticks
+ *----------------------------------------------------------------------------*/
+int32_t i2cBatchStart (i2cBatch_t *batch, uint32_t period) {
+  if ((batch == NULL) || (batch->xfer == NULL) || (batch->num == 0U) || (period == 0U)) {
+    return -1;
+  }
+  twTimerInit(&batch->timer, i2cBatchRun, batch, TW_CONTEXT_ISR);
+  return twStart(&batch->timer, period, period);
+}
+
+/*-----------------------------------------------------------------------------
+  i2cBatchStop: stop submitting a batch (pending transactions still run)
+ *----------------------------------------------------------------------------*/
+void i2cBatchStop (i2cBatch_t *batch) {
+  twStop(&batch->timer);
+}
+
+/*-----------------------------------------------------------------------------
+  Bus clock (50 % duty cycle) for the current PCLK
+ *----------------------------------------------------------------------------*/
+static void i2cSetClock (void) {
+  uint32_t half = (pmGetPclk(PM_I2C1) + (2U * I2C_RATE_HZ) - 1U) / (2U * I2C_RATE_HZ);
+
+  if (half < 4U) {
+    half = 4U;                          // Minimum of SCLH and SCLL
+  }
+  I2C_REG->I2SCLH = half;
+  I2C_REG->I2SCLL = half;
+}
+
+static void i2cClockNotify (uint32_t event, uint32_t cclk) {
+  (void)cclk;
+  if (event == CLK_EVENT_POST) {
+    i2cSetClock();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  i2cInit: set up I2C1 as master (twInit must have been called)
+ *----------------------------------------------------------------------------*/
+int32_t i2cInit (void) {
+  if (twIsRunning() == 0U) {
+    return -1;                          // Timeouts and batches need the wheel
+  }
+  if (pmAcquire(PM_I2C1, PM_PCLK_DIV4) != 0) {
+    return -1;
+  }
+  PIN_Configure(0U, 0U, PIN_FUNC_3, PIN_PINMODE_TRISTATE, PIN_PINMODE_OPENDRAIN);  // SDA1
+  PIN_Configure(0U, 1U, PIN_FUNC_3, PIN_PINMODE_TRISTATE, PIN_PINMODE_OPENDRAIN);  // SCL1
+
+  I2C_REG->I2CONCLR = I2C_CON_EN | I2C_CON_STA | I2C_CON_SI | I2C_CON_AA;
+  i2cSetClock();
+  if (clkNotifyRegister(i2cClockNotify) != 0) {
+    pmRelease(PM_I2C1);
+    return -1;
+  }
+  twTimerInit(&i2cTimer, i2cTimeout, NULL, TW_CONTEXT_ISR);
+
+  I2C_REG->I2CONSET = I2C_CON_EN;
+  NVIC_ClearPendingIRQ(I2C1_IRQn);
+  NVIC_EnableIRQ(I2C1_IRQn);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  i2cGetStats: get engine statistics
+ *----------------------------------------------------------------------------*/
+void i2cGetStats (i2cStats_t *stats) {
+  *stats = i2cStats;
+}
@@ -0,0 +1,123 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    i2c_engine.h
+ * Purpose: Interrupt driven I2C transaction queue with periodic batches
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef I2C_ENGINE_H__
+#define I2C_ENGINE_H__
+
+#include <stdint.h>
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "twheel.h"
+
+/*
+  A transaction is a chain of segments joined by repeated starts and ended
+  by a stop. Transactions are queued and run back to back by the I2C
+  interrupt; no thread is involved until completion. Example (register read):
+
+    static uint8_t    reg = 0x0FU;
+    static uint8_t    val[6];
+    static i2cSeg_t   seg[2] = {
+      { &reg, 1U, 0x1DU, I2C_WRITE },
+      { val,  6U, 0x1DU, I2C_READ  }
+    };
+    static i2cXfer_t  xfer = { .seg = seg, .seg_num = 2U };
+
+  Completion is reported by callback (I2C interrupt context) and/or by event
+  flags. A batch submits a set of transactions every period from the timer
+  wheel, so several sensors are read in one burst.
+
+  The transaction timeout and the batches run on the timer wheel: call
+  twInit before i2cInit, which fails while the wheel is not running.
+
+  Wiring (mbed): p9 SDA1 P0.0, p10 SCL1 P0.1 (open-drain, external pull-ups).
+*/
+
+// Bus clock in Hz
+#ifndef I2C_RATE_HZ
+#define I2C_RATE_HZ             400000U
+#endif
+
+// Transaction timeout in timer wheel ticks
+#ifndef I2C_TIMEOUT_TICKS
+#define I2C_TIMEOUT_TICKS       10U
+#endif
+
+// Segment direction
+#define I2C_WRITE               0x00U
+#define I2C_READ                0x01U
+
+// Transaction status
+#define I2C_PENDING             1       // Queued or running
+#define I2C_OK                  0
+#define I2C_ERR_NACK            (-1)    // Address or data not acknowledged
+#define I2C_ERR_BUS             (-2)    // Bus error or arbitration lost
+#define I2C_ERR_TIMEOUT         (-3)    // Not finished in I2C_TIMEOUT_TICKS
+
+typedef struct i2cXfer_s i2cXfer_t;
+typedef void (*i2cCallback_t) (i2cXfer_t *xfer);
+
+// Segment: one address phase and its data
+typedef struct {
+  uint8_t  *buf;
+  uint16_t  len;                        // Bytes (read: at least 1)
+  uint8_t   addr;                       // 7-bit slave address
+  uint8_t   dir;                        // I2C_WRITE or I2C_READ
+} i2cSeg_t;
+
+// Transaction (owned by the client, not modified while pending)
+struct i2cXfer_s {
+  i2cXfer_t        *next;               // Queue link (internal)
+  const i2cSeg_t   *seg;                // Segments
+  uint8_t           seg_num;
+  volatile int32_t  status;             // I2C_xxx
+  i2cCallback_t     cb;                 // Completion callback (may be NULL)
+  osEventFlagsId_t  ef;                 // Event flags to set (may be NULL)
+  uint32_t          ef_mask;
+  void             *arg;                // Client data
+};
+
+// Periodic batch
+typedef struct {
+  twTimer_t    timer;                   // Internal
+  i2cXfer_t  **xfer;                    // Transactions of the batch
+  uint32_t     num;
+  uint32_t     runs;                    // Batches submitted
+  uint32_t     overruns;                // Skipped: previous run still pending
+} i2cBatch_t;
+
+// Statistics
+typedef struct {
+  uint32_t xfers;                       // Completed transactions
+  uint32_t nacks;
+  uint32_t bus_errors;
+  uint32_t timeouts;
+  uint32_t queue_max;                   // Most transactions waiting
+} i2cStats_t;
+
+/* Prototypes */
+extern int32_t i2cInit       (void);
+extern int32_t i2cSubmit     (i2cXfer_t *xfer);
+extern int32_t i2cBatchStart (i2cBatch_t *batch, uint32_t period);
+extern void    i2cBatchStop  (i2cBatch_t *batch);
+extern void    i2cGetStats   (i2cStats_t *stats);
+
+#endif
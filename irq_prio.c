@@ -0,0 +1,100 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    irq_prio.c
+ * Purpose: Interrupt priority plan and entry latency measurement
+ *----------------------------------------------------------------------------*/
+
+#define IRQ_ZERO_LATENCY                // TIMER2_IRQHandler is zero-latency
+#include "irq_prio.h"
+#include "pwr_periph.h"
+
+/*-----------------------------------------------------------------------------
+  irqPrioInit: apply priority plan (call before osKernelStart)
+ *----------------------------------------------------------------------------*/
+void irqPrioInit (void) {
+  uint32_t n;
+
+  // All priority bits are preemption priority
+  NVIC_SetPriorityGrouping(0U);
+
+  for (n = 0U; n <= (uint32_t)CANActivity_IRQn; n++) {
+    NVIC_SetPriority((IRQn_Type)n, IRQ_PRIO_DEFAULT);
+  }
+
+#define IRQ_PRIO(irqn, prio)    NVIC_SetPriority(irqn, prio);
+  IRQ_PRIO_TABLE
+#undef IRQ_PRIO
+}
+
+/*-----------------------------------------------------------------------------
+  Interrupt entry latency measurement
+
+  TIMER2 counts PCLK (CCLK / 4) and resets on MR0. The counter value read
+  first thing in the ISR is the time since the interrupt was requested.
+ *----------------------------------------------------------------------------*/
+__USED irqLatency_t irqLatency;
+
+void TIMER2_IRQHandler (void) {
+  uint32_t ticks = LPC_TIM2->TC;
+
+  LPC_TIM2->IR = 0x01U;                 // Clear MR0 interrupt
+
+  irqLatency.count++;
+  irqLatency.sum += ticks;
+  if (ticks > irqLatency.max) {
+    irqLatency.max = ticks;
+  }
+  if ((ticks < irqLatency.min) || (irqLatency.count == 1U)) {
+    irqLatency.min = ticks;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  irqLatencyStart: sample interrupt entry latency every period_us
+ *----------------------------------------------------------------------------*/
+void irqLatencyStart (uint32_t period_us) {
+  uint32_t pclk;
+
+  pmAcquire(PM_TIMER2, PM_PCLK_DIV4);   // Power on TIMER2, PCLK = CCLK / 4
+  pclk = pmGetPclk(PM_TIMER2);
+
+  irqLatency.count = 0U;
+  irqLatency.sum   = 0U;
+  irqLatency.max   = 0U;
+  irqLatency.min   = 0U;
+  irqLatency.cycles_per_tick = 4U;
+
+  LPC_TIM2->TCR = 0x02U;                // Reset and hold counter
+  LPC_TIM2->PR  = 0U;
+  LPC_TIM2->MR0 = ((pclk / 1000000U) * period_us) - 1U;
+  LPC_TIM2->MCR = 0x03U;                // Interrupt and reset on MR0
+  LPC_TIM2->IR  = 0x3FU;
+  LPC_TIM2->TCR = 0x01U;
+
+  NVIC_ClearPendingIRQ(TIMER2_IRQn);
+  NVIC_EnableIRQ(TIMER2_IRQn);
+}
+
+/*-----------------------------------------------------------------------------
+  irqLatencyStop: stop sampling
+ *----------------------------------------------------------------------------*/
+void irqLatencyStop (void) {
+  NVIC_DisableIRQ(TIMER2_IRQn);
+  LPC_TIM2->TCR = 0x00U;
+  pmRelease(PM_TIMER2);
+}
@@ -0,0 +1,116 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    irq_prio.h
+ * Purpose: Interrupt priority plan
+ *----------------------------------------------------------------------------*/
+
+#ifndef IRQ_PRIO_H__
+#define IRQ_PRIO_H__
+
+#include <stdint.h>
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+/*
+  The LPC1768 implements 5 priority bits (0 = highest, 31 = lowest), all of
+  them used as preemption priority.
+
+  Priority  Tier           Rules
+  --------  -------------  ------------------------------------------------
+   0 ..  3  Zero-latency   Never call RTX, never masked by irqKernelLock()
+   4 .. 29  Kernel-aware   May call RTX ISR functions
+  30 .. 31  Kernel         SVC, PendSV and SysTick (set by RTX)
+
+  Sources containing zero-latency ISRs define IRQ_ZERO_LATENCY before
+  including this header. Any use of the CMSIS-RTOS2 API in such a file is
+  then rejected by the compiler.
+*/
+#define IRQ_PRIO_ZLI_MAX        0U      // Highest zero-latency priority
+#define IRQ_PRIO_KERNEL_MAX     4U      // Highest priority allowed to call RTX
+#define IRQ_PRIO_DEFAULT        16U     // Interrupts not listed in the table
+
+/*
+  Priority table: IRQ_PRIO(<IRQn>, <priority>)
+*/
+#define IRQ_PRIO_TABLE                                                          \
+  IRQ_PRIO(BOD_IRQn,     0U)            /* Brown-out snapshot (zero-latency)  */\
+  IRQ_PRIO(TIMER2_IRQn,  1U)            /* Latency measurement (zero-latency) */\
+  IRQ_PRIO(TIMER1_IRQn,  4U)            /* Timebase wrap                      */\
+  IRQ_PRIO(CAN_IRQn,     5U)            /* CAN receive (one frame time)       */\
+  IRQ_PRIO(I2C1_IRQn,    5U)            /* I2C engine (above timer wheel)     */\
+  IRQ_PRIO(DMA_IRQn,     6U)            /* GPDMA completion                   */\
+  IRQ_PRIO(UART2_IRQn,   7U)            /* UART RX frame end (URX_UART)       */\
+  IRQ_PRIO(RIT_IRQn,     8U)            /* Timer wheel tick                   */\
+  IRQ_PRIO(ENET_IRQn,    9U)            /* Ethernet receive batch start       */\
+  IRQ_PRIO(RTC_IRQn,    12U)            /* Low-power second sync and alarm    */
+
+/* Compile time check of the table */
+#define IRQ_PRIO(irqn, prio)                                                    \
+  typedef char irq_prio_check_##irqn[((prio) < (1UL << __NVIC_PRIO_BITS)) ? 1 : -1];
+IRQ_PRIO_TABLE
+#undef IRQ_PRIO
+
+/*-----------------------------------------------------------------------------
+  Kernel tier critical section: masks kernel-aware interrupts only
+ *----------------------------------------------------------------------------*/
+__STATIC_INLINE uint32_t irqKernelLock (void) {
+  uint32_t basepri = __get_BASEPRI();
+  __set_BASEPRI(IRQ_PRIO_KERNEL_MAX << (8U - __NVIC_PRIO_BITS));
+  return basepri;
+}
+
+__STATIC_INLINE void irqKernelUnlock (uint32_t basepri) {
+  __set_BASEPRI(basepri);
+}
+
+// Interrupt entry latency statistics (TIMER2 ticks)
+typedef struct {
+  uint32_t count;                       // Number of samples
+  uint32_t sum;                         // Sum of latencies
+  uint32_t min;                         // Best case latency
+  uint32_t max;                         // Worst case latency
+  uint32_t cycles_per_tick;             // CPU cycles per TIMER2 tick
+} irqLatency_t;
+
+extern irqLatency_t irqLatency;
+
+/* Prototypes */
+extern void irqPrioInit     (void);
+extern void irqLatencyStart (uint32_t period_us);
+extern void irqLatencyStop  (void);
+
+/*-----------------------------------------------------------------------------
+  Zero-latency sources: forbid the RTOS API
+ *----------------------------------------------------------------------------*/
+#ifdef IRQ_ZERO_LATENCY
+#if defined(CMSIS_OS2_H_) || defined(RTX_OS_H_)
+#error "Zero-latency interrupt source must not include the RTOS API"
+#endif
+#pragma GCC poison osKernelLock osKernelUnlock osKernelRestoreLock
+#pragma GCC poison osKernelGetTickCount osKernelGetSysTimerCount
+#pragma GCC poison osThreadGetId osThreadFlagsSet osThreadFlagsClear
+#pragma GCC poison osEventFlagsSet osEventFlagsClear osEventFlagsGet osEventFlagsWait
+#pragma GCC poison osSemaphoreAcquire osSemaphoreRelease osSemaphoreGetCount
+#pragma GCC poison osMutexAcquire osMutexRelease
+#pragma GCC poison osMemoryPoolAlloc osMemoryPoolFree
+#pragma GCC poison osMessageQueuePut osMessageQueueGet osMessageQueueGetCount
+#pragma GCC poison osTimerStart osTimerStop osDelay osDelayUntil
+#endif
+
+#endif
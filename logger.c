@@ -0,0 +1,322 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    logger.c
+ * Purpose: Binary logger with deferred formatting over UART0 DMA
+ *----------------------------------------------------------------------------*/
+
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "logger.h"
+
+#include "PIN_LPC17xx.h"
+
+#include "clk_governor.h"
+#include "clk_profile.h"
+#include "gpdma.h"
+#include "lowpower.h"
+#include "mem_sections.h"
+#include "pwr_periph.h"
+#include "timebase.h"
+#include "uart_baud.h"
+
+#if ((LG_RING_SIZE & (LG_RING_SIZE - 1U)) != 0U)
+#error "LG_RING_SIZE must be a power of 2"
+#endif
+
+// UART0 has its own register type; the common UART layout is used here
+#define LG_UART                 ((LPC_UART_TypeDef *)LPC_UART0)
+
+#define LG_FLAG_TX_DONE         0x0001U // Thread flag: DMA transfer finished
+#define LG_FLAG_DATA            0x0002U // Thread flag: record written to an empty ring
+
+#define LG_SYNC                 0xA5U   // First byte of each frame
+#define LG_FRAME_MAX            (11U + (4U * 4U))   // Sync, header, seq, ts, fmt, args
+#define LG_TX_SIZE              512U    // Bytes per DMA transfer
+#define LG_BAUD_TOL             2U      // Baud rate error accepted in percent
+
+// Ring slot (seq implements the bounded MPSC handshake)
+typedef struct {
+  volatile uint32_t seq;                // pos: free, pos + 1: written
+  uint32_t          ts;                 // Time stamp in us
+  const char       *fmt;                // Format string (.logstr)
+  uint32_t          info;               // Level | (nargs << 4)
+  uint32_t          args[4];
+} lgSlot_t;
+
+static lgSlot_t          lgRing[LG_RING_SIZE];
+static volatile uint32_t lgHead;        // Next position to claim (producers)
+static uint32_t          lgTail;        // Next position to send (worker)
+static uint32_t          lgDropSent;    // Lost records already reported
+static uint8_t           lgSeq;         // Frame counter
+static int32_t           lgDmaCh = -1;
+static osThreadId_t      lgThreadId;
+static volatile uint32_t lgWaiting;     // Worker waits for LG_FLAG_DATA
+static uint32_t          lgGovProfile;  // Lowest clock profile reaching LG_BAUDRATE
+
+// Transmit buffers (one is filled while the other is sent)
+static uint8_t           lgTx[2][LG_TX_SIZE] __DMA_RAM;
+
+volatile uint32_t        lgLevel = LG_LEVEL_INFO;
+__USED lgStats_t         lgStats;       // Logger statistics
+
+const osThreadAttr_t logger_attr = {.name = "Logger", .priority = osPriorityLow};
+
+/*-----------------------------------------------------------------------------
+  lgWrite: store one record (any context but zero-latency ISRs, lock-free)
+ *----------------------------------------------------------------------------*/
+void lgWrite (uint32_t level, const char *fmt, uint32_t nargs,
+              uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+  lgSlot_t *slot;
+  uint32_t  pos;
+  uint32_t  cnt;
+
+  do {
+    pos  = __LDREXW(&lgHead);
+    slot = &lgRing[pos & (LG_RING_SIZE - 1U)];
+    if (slot->seq != pos) {
+      __CLREX();                        // Ring full: count and discard
+      do {
+        cnt = __LDREXW(&lgStats.dropped);
+      } while (__STREXW(cnt + 1U, &lgStats.dropped) != 0U);
+      return;
+    }
+  } while (__STREXW(pos + 1U, &lgHead) != 0U);
+
+  slot->ts      = tbGetUs();
+  slot->fmt     = fmt;
+  slot->info    = level | (nargs << 4);
+  slot->args[0] = a0;
+  slot->args[1] = a1;
+  slot->args[2] = a2;
+  slot->args[3] = a3;
+  __DMB();
+  slot->seq     = pos + 1U;             // Publish
+  __DMB();
+  if (lgWaiting != 0U) {
+    lgWaiting = 0U;                     // Concurrent writers may both signal
+    osThreadFlagsSet(lgThreadId, LG_FLAG_DATA);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Append one frame to a transmit buffer
+ *----------------------------------------------------------------------------*/
+static uint32_t lgPut32 (uint8_t *buf, uint32_t len, uint32_t val) {
+  buf[len]      = (uint8_t)(val);
+  buf[len + 1U] = (uint8_t)(val >> 8);
+  buf[len + 2U] = (uint8_t)(val >> 16);
+  buf[len + 3U] = (uint8_t)(val >> 24);
+  return (len + 4U);
+}
+
+static uint32_t lgFrame (uint8_t *buf, uint32_t len, uint32_t info, uint32_t ts,
+                         uint32_t fmt, const uint32_t *args) {
+  uint32_t n;
+
+  buf[len++] = LG_SYNC;
+  buf[len++] = (uint8_t)info;
+  buf[len++] = lgSeq++;
+  len = lgPut32(buf, len, ts);
+  len = lgPut32(buf, len, fmt);
+  for (n = 0U; n < (info >> 4); n++) {
+    len = lgPut32(buf, len, args[n]);
+  }
+  return len;
+}
+
+/*-----------------------------------------------------------------------------
+  Move written records from the ring into a transmit buffer
+ *----------------------------------------------------------------------------*/
+static uint32_t lgPack (uint8_t *buf) {
+  lgSlot_t *slot;
+  uint32_t  len = 0U;
+  uint32_t  fill;
+  uint32_t  lost;
+
+  fill = lgHead - lgTail;
+  if (fill > lgStats.ring_max) {
+    lgStats.ring_max = fill;
+  }
+
+  lost = lgStats.dropped - lgDropSent;
+  if (lost != 0U) {
+    lgDropSent += lost;
+    len = lgFrame(buf, len, LG_LEVEL_WARN | (1U << 4), tbGetUs(), 0U, &lost);
+  }
+
+  while ((len + LG_FRAME_MAX) <= LG_TX_SIZE) {
+    slot = &lgRing[lgTail & (LG_RING_SIZE - 1U)];
+    if (slot->seq != (lgTail + 1U)) {
+      break;                            // Empty or still being written
+    }
+    __DMB();
+    len = lgFrame(buf, len, slot->info, slot->ts, (uint32_t)slot->fmt, slot->args);
+    __DMB();
+    slot->seq = lgTail + LG_RING_SIZE;  // Free for the next lap
+    lgTail++;
+    lgStats.sent++;
+  }
+  return len;
+}
+
+/*-----------------------------------------------------------------------------
+  DMA transfer finished (DMA interrupt context)
+ *----------------------------------------------------------------------------*/
+static void lgDmaDone (uint32_t event, void *arg) {
+  (void)event;
+  (void)arg;
+  osThreadFlagsSet(lgThreadId, LG_FLAG_TX_DONE);
+}
+
+/*-----------------------------------------------------------------------------
+  lgThread: send packed records, filling one buffer while the other is sent
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void lgThread (void *argument) {
+  dmaLli_t lli;
+  uint32_t buf = 0U;
+  uint32_t len = 0U;
+  (void)argument;
+
+  for (;;) {
+    if (len == 0U) {
+      // Announce the wait before the last look so no record is missed
+      lgWaiting = 1U;
+      __DMB();
+      len = lgPack(lgTx[buf]);
+      if (len == 0U) {
+        osThreadFlagsWait(LG_FLAG_DATA, osFlagsWaitAny, osWaitForever);
+        continue;
+      }
+      lgWaiting = 0U;
+    }
+
+    lli.src  = (uint32_t)lgTx[buf];
+    lli.dst  = (uint32_t)&LG_UART->THR;
+    lli.next = NULL;
+    lli.ctrl = DMA_CTRL_SIZE(len) | DMA_CTRL_SBSIZE(DMA_BURST_1) | DMA_CTRL_DBSIZE(DMA_BURST_1) |
+               DMA_CTRL_SWIDTH(DMA_WIDTH_8) | DMA_CTRL_DWIDTH(DMA_WIDTH_8) |
+               DMA_CTRL_SI | DMA_CTRL_I;
+    govHoldMin(lgGovProfile);           // Governor (higher priority) switches first
+    lpHold();                           // UART0 stops in deep sleep
+    if (dmaStart(lgDmaCh, &lli, DMA_M2P) != 0) {
+      lpRelease();
+      govReleaseMin(lgGovProfile);
+      len = 0U;                         // Records of this buffer are lost
+      continue;
+    }
+    lgStats.tx_bytes += len;
+
+    buf ^= 1U;
+    len  = lgPack(lgTx[buf]);
+    osThreadFlagsWait(LG_FLAG_TX_DONE, osFlagsWaitAny, osWaitForever);
+    lpRelease();
+    govReleaseMin(lgGovProfile);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Keep the baud rate across clock profile changes
+ *----------------------------------------------------------------------------*/
+static void lgClockNotify (uint32_t event, uint32_t cclk) {
+  (void)cclk;
+  if (event == CLK_EVENT_POST) {
+    uartBaudSet(LG_UART, pmGetPclk(PM_UART0), LG_BAUDRATE);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Lowest clock profile at which LG_BAUDRATE is met within LG_BAUD_TOL
+ *----------------------------------------------------------------------------*/
+static uint32_t lgGovMin (void) {
+  uartBaud_t div;
+  uint32_t   profile;
+  uint32_t   actual;
+  uint32_t   err;
+
+  for (profile = 0U; profile < (CLK_PROFILE_NUM - 1U); profile++) {
+    actual = uartBaudCalc(pmGetPclkAt(PM_UART0, clkProfileGetFreq(profile)), LG_BAUDRATE, &div);
+    err    = (actual > LG_BAUDRATE) ? (actual - LG_BAUDRATE) : (LG_BAUDRATE - actual);
+    if ((actual != 0U) && ((err * 100U) <= (LG_BAUDRATE * LG_BAUD_TOL))) {
+      break;
+    }
+  }
+  return profile;
+}
+
+/*-----------------------------------------------------------------------------
+  lgInit: set up UART0 (8N1, DMA mode), the DMA channel and the worker
+ *----------------------------------------------------------------------------*/
+int32_t lgInit (void) {
+  uint32_t n;
+
+  for (n = 0U; n < LG_RING_SIZE; n++) {
+    lgRing[n].seq = n;
+  }
+
+  if (pmAcquire(PM_UART0, pmUartPclkDiv(LG_BAUDRATE)) != 0) {
+    return -1;
+  }
+  PIN_Configure(0U, 2U, PIN_FUNC_1, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // TXD0
+  lgGovProfile = lgGovMin();            // Held by the worker while a transfer runs
+
+  LG_UART->LCR = 0x03U;                 // 8 data bits, no parity, 1 stop bit
+  if (uartBaudSet(LG_UART, pmGetPclk(PM_UART0), LG_BAUDRATE) == 0U) {
+    pmRelease(PM_UART0);
+    return -1;
+  }
+  LG_UART->FCR = 0x0FU;                 // FIFO enable and reset, DMA mode
+  LG_UART->TER = 0x80U;                 // Transmitter enable
+
+  lgDmaCh = dmaAlloc(DMA_PRIO_LOW, DMA_REQ_UART0_TX, lgDmaDone, NULL);
+  if (lgDmaCh < 0) {
+    pmRelease(PM_UART0);
+    return -1;
+  }
+
+  lgThreadId = osThreadNew(lgThread, NULL, &logger_attr);
+  if (lgThreadId == NULL) {
+    dmaFree(lgDmaCh);
+    lgDmaCh = -1;
+    pmRelease(PM_UART0);
+    return -1;
+  }
+  if (clkNotifyRegister(lgClockNotify) != 0) {
+    (void)osThreadTerminate(lgThreadId);
+    lgThreadId = NULL;
+    dmaFree(lgDmaCh);
+    lgDmaCh = -1;
+    pmRelease(PM_UART0);
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  lgSetLevel: set the runtime filter (LG_LEVEL_OFF: no records)
+ *----------------------------------------------------------------------------*/
+void lgSetLevel (uint32_t level) {
+  lgLevel = (level > LG_LEVEL_OFF) ? LG_LEVEL_OFF : level;
+}
+
+/*-----------------------------------------------------------------------------
+  lgGetStats: get logger statistics
+ *----------------------------------------------------------------------------*/
+void lgGetStats (lgStats_t *stats) {
+  *stats         = lgStats;
+  stats->written = lgHead;
+}
@@ -0,0 +1,105 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    logger.h
+ * Purpose: Binary logger with deferred formatting over UART0 DMA
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef LOGGER_H__
+#define LOGGER_H__
+
+#include <stdint.h>
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+/*
+  Call sites store the address of the format string and up to four raw
+  32-bit arguments; no formatting happens on the target. Format strings are
+  placed in section .logstr so that a host decoder can resolve the address
+  with the strings of the ELF file:
+
+    LG_LOG(LG_LEVEL_WARN, "adc %u out of range: %d", ch, value);
+
+  Arguments are converted to uint32_t. Pointers to strings are not
+  supported (the string is gone by the time the record is sent).
+
+  Wire format on UART0 (little-endian, one frame per record):
+    0xA5                                sync
+    level | (nargs << 4)                header
+    seq                                 record counter (8 bit, gaps = lost)
+    ts      (4 bytes)                   tbGetUs() at the call site
+    fmt     (4 bytes)                   address of the format string
+    args    (nargs * 4 bytes)
+  A record with fmt = 0 reports lost records: args[0] holds the count.
+
+  The host decoder is tools/lg_decode.c, tools/log_decode prints the stream
+  as text.
+*/
+
+// Log levels
+#define LG_LEVEL_DEBUG          0U
+#define LG_LEVEL_INFO           1U
+#define LG_LEVEL_WARN           2U
+#define LG_LEVEL_ERROR          3U
+#define LG_LEVEL_OFF            4U      // Filter only: suppress all records
+
+// Record ring size (power of 2)
+#ifndef LG_RING_SIZE
+#define LG_RING_SIZE            64U
+#endif
+
+// UART0 baud rate
+#ifndef LG_BAUDRATE
+#define LG_BAUDRATE             921600U
+#endif
+
+// Runtime filter: records below this level are discarded at the call site
+extern volatile uint32_t lgLevel;
+
+// Statistics
+typedef struct {
+  uint32_t written;                     // Records stored in the ring
+  uint32_t dropped;                     // Records lost (ring full)
+  uint32_t sent;                        // Records transmitted
+  uint32_t tx_bytes;                    // Bytes transmitted
+  uint32_t ring_max;                    // Highest ring fill level
+} lgStats_t;
+
+/* Call site helpers (up to four arguments) */
+#define LG_LOG(level, ...)      LG_LOG_(level, LG_NARGS_(__VA_ARGS__), __VA_ARGS__, 0, 0, 0, 0, 0)
+#define LG_NARGS_(...)          LG_NARGS__(__VA_ARGS__, 4U, 3U, 2U, 1U, 0U, 0)
+#define LG_NARGS__(f, a0, a1, a2, a3, n, ...)   n
+
+#define LG_LOG_(level, n, fmt, a0, a1, a2, a3, ...)                         \
+  do {                                                                      \
+    static const char lg_fmt_[] __attribute__((section(".logstr"), used)) = fmt; \
+    if ((uint32_t)(level) >= lgLevel) {                                     \
+      lgWrite((uint32_t)(level), lg_fmt_, n,                                \
+              (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3)); \
+    }                                                                       \
+  } while (0)
+
+/* Prototypes */
+extern int32_t lgInit     (void);
+extern void    lgWrite    (uint32_t level, const char *fmt, uint32_t nargs,
+                           uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+extern void    lgSetLevel (uint32_t level);
+extern void    lgGetStats (lgStats_t *stats);
+
+#endif
@@ -0,0 +1,317 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    lowpower.c
+ * Purpose: Idle thread with deep-sleep and power-down, RTC wake-up
+ *----------------------------------------------------------------------------*/
+
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "rtx_os.h"                     // osRtxInfo (next timeout)
+#include "lowpower.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "clk_profile.h"
+#include "clk_governor.h"
+#include "timebase.h"
+#include "pwr_periph.h"
+#include "irq_prio.h"
+
+#define LP_DAY_S                86400U  // RTC time of day wraps after one day
+#define LP_IRC_MHZ              4U      // Clock between wake-up and clkResume
+
+// RTC register bits
+#define RTC_ILR_CIF             0x01U   // Counter increment interrupt
+#define RTC_ILR_ALF             0x02U   // Alarm interrupt
+#define RTC_CCR_CLKEN           0x01U
+#define RTC_CIIR_IMSEC          0x01U
+#define RTC_AMR_TIME_ONLY       0xF8U   // Compare seconds, minutes, hours
+
+static volatile uint32_t lpSecUs;       // tbGetUs at the last RTC second
+static volatile uint32_t lpSecValid;    // lpSecUs is in sync with the RTC
+static uint32_t          lpHoldCount;
+static void             *lpDeferThread[LP_DEFER_MAX];
+static uint32_t          lpDeferNum;
+static uint32_t          lpTickFreq;    // Kernel tick frequency (0 = not ready)
+static uint32_t          lpWakeCycles;  // Wake-up to clocks restored in us
+
+__USED lpStats_t         lpStats;
+
+/*-----------------------------------------------------------------------------
+  RTC time of day in seconds
+ *----------------------------------------------------------------------------*/
+static uint32_t lpRtcSeconds (void) {
+  uint32_t t = LPC_RTC->CTIME0;         // Consolidated: one consistent read
+
+  return (((t >> 16) & 0x1FU) * 3600U) + (((t >> 8) & 0x3FU) * 60U) + (t & 0x3FU);
+}
+
+/*-----------------------------------------------------------------------------
+  RTC interrupt: track the second boundary in timebase units
+ *----------------------------------------------------------------------------*/
+void RTC_IRQHandler (void) {
+  uint32_t ilr = LPC_RTC->ILR;
+
+  LPC_RTC->ILR = ilr;
+  if ((ilr & RTC_ILR_CIF) != 0U) {
+    lpSecUs    = tbGetUs();
+    lpSecValid = 1U;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Thread timeouts that may be deferred across deep sleep
+ *----------------------------------------------------------------------------*/
+static uint32_t lpIsDeferred (const void *thread) {
+  uint32_t n;
+
+  for (n = 0U; n < lpDeferNum; n++) {
+    if (lpDeferThread[n] == thread) {
+      return 1U;
+    }
+  }
+  return 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  Next kernel timeout in ticks, deferred threads excluded
+  Peeks the delay lists (entries are relative to the previous entry).
+ *----------------------------------------------------------------------------*/
+static uint32_t lpNextTimeout (void) {
+  const osRtxThread_t *thread = osRtxInfo.thread.delay_list;
+  const osRtxTimer_t  *timer  = osRtxInfo.timer.list;
+  uint32_t             ticks  = osWaitForever;
+  uint32_t             delay  = 0U;
+
+  for (; thread != NULL; thread = thread->delay_next) {
+    delay += thread->delay;
+    if (lpIsDeferred(thread) == 0U) {
+      ticks = delay;
+      break;
+    }
+  }
+  if ((timer != NULL) && (timer->tick < ticks)) {
+    ticks = timer->tick;
+  }
+  return ticks;
+}
+
+/*-----------------------------------------------------------------------------
+  Deep sleep or power-down until the RTC alarm before the next timeout
+  Kernel is suspended, returns the slept time in kernel ticks.
+ *----------------------------------------------------------------------------*/
+static uint32_t lpSleep (uint32_t ticks) {
+  uint32_t ms;
+  uint32_t frac;
+  uint32_t n;
+  uint32_t sod;
+  uint32_t alarm;
+  uint32_t ilr;
+  uint32_t slept_s;
+  uint32_t elapsed_us;
+  uint32_t cycles;
+  uint32_t pd;
+  uint32_t lock;
+
+  ms = LP_SLEEP_MAX_S * 1000U;
+  if ((ticks != osWaitForever) && (((uint64_t)ticks * 1000U) / lpTickFreq) < ms) {
+    ms = (uint32_t)(((uint64_t)ticks * 1000U) / lpTickFreq);
+  }
+
+  __disable_irq();
+
+  // A pending second interrupt would leave sod and lpSecUs out of sync
+  sod = lpRtcSeconds();
+  if ((lpSecValid == 0U) || ((LPC_RTC->ILR & RTC_ILR_CIF) != 0U)) {
+    __enable_irq();
+    return 0U;
+  }
+  frac = (tbGetUs() - lpSecUs) % 1000000U;
+
+  // Alarm at the last second boundary before the timeout
+  n = (uint32_t)((((uint64_t)ms * 1000U) + frac) / 1000000U);
+  if (n == 0U) {
+    __enable_irq();
+    return 0U;
+  }
+  alarm = (sod + n) % LP_DAY_S;
+  LPC_RTC->ALSEC  = (uint8_t)(alarm % 60U);
+  LPC_RTC->ALMIN  = (uint8_t)((alarm / 60U) % 60U);
+  LPC_RTC->ALHOUR = (uint8_t)(alarm / 3600U);
+  LPC_RTC->CIIR   = 0U;                 // No second interrupts while asleep
+  LPC_RTC->ILR    = RTC_ILR_CIF | RTC_ILR_ALF;
+
+  pd = (ms >= LP_PD_MIN_MS) ? 1U : 0U;
+  (void)clkSuspend();                  // Interrupts disabled: never deferred
+  LPC_SC->PCON  = (LPC_SC->PCON & ~0x03U) | pd;     // PM: deep sleep / power-down
+  SCB->SCR     |= SCB_SCR_SLEEPDEEP_Msk;
+  __DSB();
+  __WFI();
+  cycles        = DWT->CYCCNT;          // Core runs from the IRC again
+  // BASEPRI only after WFI (it would block the wake-up): kernel-aware
+  // interrupts wait for the clocks, zero-latency ones run during clkResume
+  lock          = irqKernelLock();
+  __enable_irq();
+  SCB->SCR     &= ~SCB_SCR_SLEEPDEEP_Msk;
+  LPC_SC->PCON  = (LPC_SC->PCON & ~0x03U) | (3UL << 9);     // Clear DSFLAG, PDFLAG
+  clkResume();
+  cycles        = DWT->CYCCNT - cycles;
+
+  ilr     = LPC_RTC->ILR;
+  slept_s = ((lpRtcSeconds() + LP_DAY_S) - sod) % LP_DAY_S;
+  if ((ilr & RTC_ILR_ALF) != 0U) {
+    elapsed_us = (n * 1000000U) - frac;
+    tbAdvance(elapsed_us);              // TIMER1 was stopped while asleep
+    lpSecUs    = tbGetUs();             // Alarm fired on a second boundary
+  } else {
+    // Position in the current second is unknown: count full seconds only
+    elapsed_us = (slept_s != 0U) ? ((slept_s * 1000000U) - frac) : 0U;
+    tbAdvance(elapsed_us);
+    lpSecValid = 0U;
+    lpStats.ext_wakeups++;
+  }
+  LPC_RTC->ILR  = RTC_ILR_CIF | RTC_ILR_ALF;
+  LPC_RTC->CIIR = RTC_CIIR_IMSEC;
+
+  if (pd != 0U) {
+    lpStats.power_downs++;
+  } else {
+    lpStats.deep_sleeps++;
+  }
+  lpStats.slept_ms += elapsed_us / 1000U;
+  lpWakeCycles      = cycles / LP_IRC_MHZ;
+
+  irqKernelUnlock(lock);
+
+  return (uint32_t)(((uint64_t)elapsed_us * lpTickFreq) / 1000000U);
+}
+
+/*-----------------------------------------------------------------------------
+  OS Idle Thread: low-power sleep when idle long enough, WFI otherwise
+ *----------------------------------------------------------------------------*/
+__NO_RETURN void osRtxIdleThread (void *argument) {
+  uint32_t ticks;
+  uint32_t start;
+  uint32_t us;
+  (void)argument;
+
+  for (;;) {
+    if ((lpTickFreq != 0U) && (lpHoldCount == 0U) &&
+        (lpNextTimeout() >= ((LP_DEEP_MIN_MS * lpTickFreq) / 1000U))) {
+      (void)osKernelSuspend();
+      ticks = lpNextTimeout();          // Lists are stable while suspended
+      if (ticks >= ((LP_DEEP_MIN_MS * lpTickFreq) / 1000U)) {
+        ticks = lpSleep(ticks);
+      } else {
+        ticks = 0U;
+      }
+      start = tbGetCycles();
+      osKernelResume(ticks);
+      if (ticks != 0U) {
+        // Resume latency: clocks restored plus kernel resumed
+        us = lpWakeCycles + tbCyclesToUs(tbGetCycles() - start);
+        lpStats.resume_us = us;
+        if (us > lpStats.resume_us_max) {
+          lpStats.resume_us_max = us;
+        }
+        if (us > LP_RESUME_BUDGET_US) {
+          lpStats.budget_misses++;
+        }
+        continue;
+      }
+      // Not slept (RTC second not in sync yet or alarm too close): WFI
+    }
+
+    // Interrupts stay masked across WFI so ISR time is not counted as idle
+    __disable_irq();
+    start = tbGetUs();
+    __WFI();
+    govIdleAdd(tbGetUs() - start);
+    __enable_irq();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  lpInit: start the RTC and enable low-power idle (thread context)
+ *----------------------------------------------------------------------------*/
+int32_t lpInit (void) {
+  if (pmAcquire(PM_RTC, PM_PCLK_ANY) != 0) {
+    return -1;
+  }
+  LPC_RTC->CCR  = RTC_CCR_CLKEN;        // Keeps time across resets
+  LPC_RTC->AMR  = RTC_AMR_TIME_ONLY;
+  LPC_RTC->ILR  = RTC_ILR_CIF | RTC_ILR_ALF;
+  LPC_RTC->CIIR = RTC_CIIR_IMSEC;
+  NVIC_ClearPendingIRQ(RTC_IRQn);
+  NVIC_EnableIRQ(RTC_IRQn);
+
+  lpTickFreq = osKernelGetTickFreq();
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  lpDefer: let the timeouts of thread expire late when the system sleeps
+  Returns 0 on success or -1 if the table is full.
+ *----------------------------------------------------------------------------*/
+int32_t lpDefer (void *thread) {
+  uint32_t lock;
+  int32_t  status = -1;
+
+  if (thread == NULL) {
+    return -1;
+  }
+  lock = irqKernelLock();
+  if (lpIsDeferred(thread) != 0U) {
+    status = 0;
+  } else if (lpDeferNum < LP_DEFER_MAX) {
+    lpDeferThread[lpDeferNum++] = thread;
+    status = 0;
+  }
+  irqKernelUnlock(lock);
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  lpHold: keep the system out of deep sleep until lpRelease
+ *----------------------------------------------------------------------------*/
+void lpHold (void) {
+  uint32_t lock = irqKernelLock();
+
+  lpHoldCount++;
+  irqKernelUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  lpRelease: release a lpHold request
+ *----------------------------------------------------------------------------*/
+void lpRelease (void) {
+  uint32_t lock = irqKernelLock();
+
+  if (lpHoldCount != 0U) {
+    lpHoldCount--;
+  }
+  irqKernelUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  lpGetStats: get low-power statistics
+ *----------------------------------------------------------------------------*/
+void lpGetStats (lpStats_t *stats) {
+  *stats = lpStats;
+}
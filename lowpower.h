@@ -0,0 +1,95 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    lowpower.h
+ * Purpose: Idle thread with deep-sleep and power-down, RTC wake-up
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef LOWPOWER_H__
+#define LOWPOWER_H__
+
+#include <stdint.h>
+
+/*
+  The idle thread suspends the kernel and, when no thread is due for at
+  least LP_DEEP_MIN_MS, enters deep sleep (or power-down beyond LP_PD_MIN_MS)
+  until the RTC alarm or any other enabled wake-up interrupt (EINTx, GPIO,
+  CAN or USB activity). The RTC alarm has a resolution of one second and is
+  set to the last second boundary before the next kernel timeout.
+
+  All PCLK based peripherals stop while asleep, this includes the TIMER1
+  timebase and the RIT timer wheel. The timebase is advanced by the slept
+  time on wake-up (tbAdvance), tbGetUs keeps counting wall time. Drivers
+  with transfers in flight or armed hardware timers call lpHold / lpRelease
+  around them.
+
+  Periodic housekeeping threads would otherwise keep every idle period
+  short of LP_DEEP_MIN_MS. A thread registered with lpDefer is ignored when
+  the idle time is computed; its timeout expires late, on wake-up. This
+  suits threads whose period only matters while the CPU runs:
+  - the supervisor: the WDT counts PCLK_WDT and pauses in deep sleep, so
+    the SUP_FEED_MS feed is not due until the CPU runs again,
+  - the governor: its load window is measured in running time.
+  Event-driven threads (logger) wait without a timeout and never block
+  deep sleep; the logger holds it while a DMA transfer is in flight.
+*/
+
+// Minimum idle time for deep sleep in ms
+#ifndef LP_DEEP_MIN_MS
+#define LP_DEEP_MIN_MS          2000U
+#endif
+
+// Minimum idle time for power-down (flash powered down as well) in ms
+#ifndef LP_PD_MIN_MS
+#define LP_PD_MIN_MS            10000U
+#endif
+
+// Longest single sleep when no thread has a timeout in s
+#ifndef LP_SLEEP_MAX_S
+#define LP_SLEEP_MAX_S          3600U
+#endif
+
+// Threads that can be registered with lpDefer
+#ifndef LP_DEFER_MAX
+#define LP_DEFER_MAX            4U
+#endif
+
+// Resume latency budget (wake-up to kernel resumed) in us
+#ifndef LP_RESUME_BUDGET_US
+#define LP_RESUME_BUDGET_US     1000U
+#endif
+
+// Low-power statistics
+typedef struct {
+  uint32_t deep_sleeps;                 // Deep-sleep entries
+  uint32_t power_downs;                 // Power-down entries
+  uint32_t ext_wakeups;                 // Woken by another source than the alarm
+  uint32_t slept_ms;                    // Total time asleep
+  uint32_t resume_us;                   // Latest resume latency
+  uint32_t resume_us_max;               // Worst case resume latency
+  uint32_t budget_misses;               // Resumes exceeding LP_RESUME_BUDGET_US
+} lpStats_t;
+
+/* Prototypes */
+extern int32_t  lpInit     (void);
+extern int32_t  lpDefer    (void *thread);
+extern void     lpHold     (void);
+extern void     lpRelease  (void);
+extern void     lpGetStats (lpStats_t *stats);
+
+#endif
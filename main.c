@@ -23,6 +23,12 @@
 #include "main.h"
 #include "LPC17xx.h"                    // Device header
 #include "cmsis_vio.h"                  // CMSIS:VIO
+#include "timebase.h"
+#include "irq_prio.h"
+#include "boot_time.h"
+#include "retained.h"
+#include "brownout.h"
+#include "crash.h"
 
 
 // extern int app_main (void *arg);
@@ -32,7 +38,16 @@
  *---------------------------------------------------------------------------*/
 int main (void) {
 
+  bootMark(BOOT_CRT_DONE, SystemCoreClock);     // C runtime done (scatter load)
+  retInit();                            // Reset cause and retained RAM block
+  crashInit();                          // Crash record of previous run, fault handlers
   SystemCoreClockUpdate ();             // System Initialization
+  irqPrioInit();                        // Apply interrupt priority plan
+  bodInit();                            // Brown-out snapshot of previous run
+  if (tbInit() != 0) {                  // Start microsecond timebase
+    for (;;) {}                         // Nothing runs without it
+  }
   vioInit();                            // Initialize Virtual I/O
+  bootPll1Connect();                    // USB PLL has locked in the meantime
   return app_main();                    // Run application main function
 }
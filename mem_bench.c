@@ -0,0 +1,129 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    mem_bench.c
+ * Purpose: Flash versus local SRAM execution benchmark
+ *----------------------------------------------------------------------------*/
+
+#include "mem_bench.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "gpdma.h"
+#include "mem_sections.h"
+#include "timebase.h"
+
+#define MEM_BENCH_WORDS         4U      // Transfer size per round
+
+typedef void (*memBenchIsr_t) (void);
+
+static uint32_t  memBenchSrc[MEM_BENCH_WORDS]  __DMA_RAM;
+static uint32_t  memBenchDst[MEM_BENCH_WORDS]  __DMA_RAM;
+static dmaLli_t  memBenchLli                   __DMA_RAM;
+static uint32_t  memBenchDone;
+
+extern void DMA_IRQHandler (void);
+
+static void memBenchCallback (uint32_t event, void *arg) {
+  (void)arg;
+  if ((event & DMA_EVENT_DONE) != 0U) {
+    memBenchDone++;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Run one transfer and time the handler that completes it
+ *----------------------------------------------------------------------------*/
+static int32_t memBenchRound (int32_t ch, memBenchIsr_t isr, memBenchCycles_t *cycles, uint32_t *sum) {
+  uint32_t start;
+  uint32_t done = memBenchDone;
+
+  if (dmaStart(ch, &memBenchLli, DMA_M2M) != 0) {
+    return -1;
+  }
+  while ((LPC_GPDMA->DMACRawIntTCStat & (1UL << ch)) == 0U) {
+    // 4 words from AHB SRAM to AHB SRAM: a few bus cycles
+  }
+
+  start = tbGetCycles();
+  isr();
+  start = tbGetCycles() - start;
+
+  if (memBenchDone == done) {
+    return -1;                          // Handler did not see the completion
+  }
+  if (start < cycles->min) {
+    cycles->min = start;
+  }
+  if (start > cycles->max) {
+    cycles->max = start;
+  }
+  *sum += start;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  memBenchDmaIrq: compare flash and RAM execution of the DMA interrupt
+  Needs tbInit (DWT cycle counter). Call from a thread; the DMA interrupt is
+  disabled while the benchmark runs, so no other channel may be active.
+ *----------------------------------------------------------------------------*/
+int32_t memBenchDmaIrq (uint32_t rounds, memBench_t *result) {
+  uint32_t sum_flash = 0U;
+  uint32_t sum_ram   = 0U;
+  uint32_t n;
+  int32_t  ch;
+  int32_t  status    = 0;
+
+  if ((result == NULL) || (rounds == 0U)) {
+    return -1;
+  }
+
+  ch = dmaAlloc(DMA_PRIO_LOW, DMA_REQ_MEM, memBenchCallback, NULL);
+  if (ch < 0) {
+    return -1;
+  }
+  NVIC_DisableIRQ(DMA_IRQn);
+
+  memBenchLli.src  = (uint32_t)memBenchSrc;
+  memBenchLli.dst  = (uint32_t)memBenchDst;
+  memBenchLli.next = NULL;
+  memBenchLli.ctrl = DMA_CTRL_SIZE(MEM_BENCH_WORDS) |
+                     DMA_CTRL_SWIDTH(DMA_WIDTH_32) | DMA_CTRL_DWIDTH(DMA_WIDTH_32) |
+                     DMA_CTRL_SI | DMA_CTRL_DI | DMA_CTRL_I;
+
+  result->flash.min = 0xFFFFFFFFU;
+  result->flash.max = 0U;
+  result->ram.min   = 0xFFFFFFFFU;
+  result->ram.max   = 0U;
+
+  // Alternate the variants so both see the same flash accelerator history
+  for (n = 0U; (n < rounds) && (status == 0); n++) {
+    status = memBenchRound(ch, dmaIrqFlash, &result->flash, &sum_flash);
+    if (status == 0) {
+      status = memBenchRound(ch, DMA_IRQHandler, &result->ram, &sum_ram);
+    }
+  }
+  result->flash.avg = sum_flash / rounds;
+  result->ram.avg   = sum_ram   / rounds;
+
+  NVIC_ClearPendingIRQ(DMA_IRQn);
+  NVIC_EnableIRQ(DMA_IRQn);
+  dmaFree(ch);
+
+  return status;
+}
@@ -0,0 +1,51 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    mem_bench.h
+ * Purpose: Flash versus local SRAM execution benchmark
+ *----------------------------------------------------------------------------*/
+
+#ifndef MEM_BENCH_H__
+#define MEM_BENCH_H__
+
+#include <stdint.h>
+
+/*
+  Times the DMA interrupt handler body (dmaIrqDispatch) completing one
+  memory-to-memory transfer, alternating the __RAMFUNC DMA_IRQHandler in
+  ER_RAMCODE with an identical copy linked to flash. The handler is called
+  directly with the DMA interrupt masked, so the DWT cycle counts cover the
+  body only: entry and exit cost the same for both variants.
+*/
+
+// Cycle counts of one variant
+typedef struct {
+  uint32_t min;                         // Best case (flash accelerator warm)
+  uint32_t max;                         // Worst case
+  uint32_t avg;                         // Average over all rounds
+} memBenchCycles_t;
+
+// Benchmark result
+typedef struct {
+  memBenchCycles_t flash;               // Handler executed from ER_IROM1
+  memBenchCycles_t ram;                 // Handler executed from ER_RAMCODE
+} memBench_t;
+
+/* Prototypes */
+extern int32_t memBenchDmaIrq (uint32_t rounds, memBench_t *result);
+
+#endif
@@ -0,0 +1,45 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    mem_sections.h
+ * Purpose: Linker section placement attributes (see LPC1768.sct)
+ *----------------------------------------------------------------------------*/
+
+#ifndef MEM_SECTIONS_H__
+#define MEM_SECTIONS_H__
+
+/*
+  __RAMFUNC: execute function from local SRAM (ER_RAMCODE).
+  The scatter loader copies the code from flash at startup, execution then
+  runs without flash wait states and independent of the flash accelerator.
+*/
+#define __RAMFUNC               __attribute__((section(".ramfunc"), noinline))
+
+/*
+  __NOINIT: place variable in RW_NOINIT (AHB SRAM) which the C runtime does
+  not zero. Use for large buffers that are initialized before use anyway and
+  for data that is written before the C runtime runs.
+*/
+#define __NOINIT                __attribute__((section(".bss.noinit")))
+
+/*
+  __DMA_RAM: place variable in AHB SRAM (RW_IRAM2). The GPDMA and the
+  Ethernet DMA cannot access the local SRAM where .ANY data usually goes.
+*/
+#define __DMA_RAM               __attribute__((section(".bss.dma")))
+
+#endif
@@ -0,0 +1,452 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    net.c
+ * Purpose: Minimal ARP, IPv4, ICMP echo and UDP fast path
+ *----------------------------------------------------------------------------*/
+
+
+#include <stddef.h>
+#include <string.h>
+
+#include "net.h"
+
+// Ethernet
+#define ETH_HDR                 14U
+#define ETH_TYPE_IP             0x0800U
+#define ETH_TYPE_ARP            0x0806U
+
+// ARP (Ethernet / IPv4)
+#define ARP_LEN                 28U
+#define ARP_REQUEST             1U
+#define ARP_REPLY               2U
+
+// IPv4
+#define IP_HDR                  20U
+#define IP_PROTO_ICMP           1U
+#define IP_PROTO_UDP            17U
+#define IP_FLAG_DF              0x4000U
+#define IP_FRAG_MASK            0x3FFFU // More fragments and fragment offset
+#define IP_TTL                  64U
+#define IP_BROADCAST            0xFFFFFFFFU
+
+// ICMP and UDP
+#define ICMP_ECHO_REPLY         0U
+#define ICMP_ECHO_REQUEST       8U
+#define UDP_HDR                 8U
+
+typedef struct {
+  uint32_t ip;
+  uint8_t  mac[6];
+} netArp_t;
+
+typedef struct {
+  udpRecv_t cb;
+  void     *arg;
+  uint16_t  port;
+} netPort_t;
+
+static const netIf_t *netIf;
+static netConfig_t    netCfg;
+static netArp_t       netArp[NET_ARP_SIZE];
+static uint32_t       netArpNext;       // Replacement index
+static netPort_t      netPort[NET_UDP_PORTS];
+static uint8_t       *netTxFrame;       // Buffer between udpAlloc and udpSend
+static uint32_t       netTxKey;
+static uint16_t       netIpId;
+
+static netStats_t     netStats;
+
+static const uint8_t  netBroadcast[6] = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+
+/*-----------------------------------------------------------------------------
+  Network byte order access (headers are not word aligned)
+ *----------------------------------------------------------------------------*/
+static uint32_t netGet16 (const uint8_t *p) {
+  return ((uint32_t)p[0] << 8) | p[1];
+}
+
+static uint32_t netGet32 (const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void netPut16 (uint8_t *p, uint32_t val) {
+  p[0] = (uint8_t)(val >> 8);
+  p[1] = (uint8_t)val;
+}
+
+static void netPut32 (uint8_t *p, uint32_t val) {
+  p[0] = (uint8_t)(val >> 24);
+  p[1] = (uint8_t)(val >> 16);
+  p[2] = (uint8_t)(val >> 8);
+  p[3] = (uint8_t)val;
+}
+
+// Internet checksum (RFC 1071)
+static uint32_t netChecksum (const uint8_t *p, uint32_t len) {
+  uint32_t sum = 0U;
+
+  while (len > 1U) {
+    sum += netGet16(p);
+    p   += 2U;
+    len -= 2U;
+  }
+  if (len != 0U) {
+    sum += (uint32_t)p[0] << 8;
+  }
+  while ((sum >> 16) != 0U) {
+    sum = (sum & 0xFFFFU) + (sum >> 16);
+  }
+  return (~sum) & 0xFFFFU;
+}
+
+/*-----------------------------------------------------------------------------
+  Transmit lock (held from udpAlloc to udpSend)
+ *----------------------------------------------------------------------------*/
+static uint8_t *netTxBegin (void) {
+  uint32_t key = 0U;
+  uint8_t *frame;
+
+  if (netIf->lock != NULL) {
+    key = netIf->lock();
+  }
+  frame = netIf->tx_alloc();
+  if (frame == NULL) {
+    netStats.tx_busy++;
+    if (netIf->unlock != NULL) {
+      netIf->unlock(key);
+    }
+    return NULL;
+  }
+  netTxKey = key;
+  return frame;
+}
+
+static int32_t netTxEnd (uint32_t len) {
+  int32_t status = 0;
+
+  if (len != 0U) {
+    status = netIf->tx_send(len);
+    if (status == 0) {
+      netStats.tx_frames++;
+    }
+  }
+  if (netIf->unlock != NULL) {
+    netIf->unlock(netTxKey);
+  }
+  return status;
+}
+
+static void netEthHeader (uint8_t *frame, const uint8_t *dst, uint32_t type) {
+  memcpy(&frame[0], dst, 6U);
+  memcpy(&frame[6], netCfg.mac, 6U);
+  netPut16(&frame[12], type);
+}
+
+/*-----------------------------------------------------------------------------
+  ARP cache (updated under the transmit lock, read by udpSend)
+ *----------------------------------------------------------------------------*/
+static netArp_t *netArpFind (uint32_t ip) {
+  uint32_t n;
+
+  for (n = 0U; n < NET_ARP_SIZE; n++) {
+    if ((netArp[n].ip == ip) && (ip != 0U)) {
+      return &netArp[n];
+    }
+  }
+  return NULL;
+}
+
+static void netArpUpdate (uint32_t ip, const uint8_t *mac) {
+  netArp_t *e;
+  uint32_t  key = 0U;
+
+  if (netIf->lock != NULL) {
+    key = netIf->lock();
+  }
+  e = netArpFind(ip);
+  if (e == NULL) {
+    e = &netArp[netArpNext];
+    netArpNext = (netArpNext + 1U) % NET_ARP_SIZE;
+    e->ip = ip;
+  }
+  memcpy(e->mac, mac, 6U);
+  if (netIf->unlock != NULL) {
+    netIf->unlock(key);
+  }
+}
+
+// ARP packet into frame (tha: NULL for a request)
+static uint32_t netArpBuild (uint8_t *frame, uint32_t op, const uint8_t *tha, uint32_t tpa) {
+  uint8_t *arp = &frame[ETH_HDR];
+
+  netEthHeader(frame, (tha != NULL) ? tha : netBroadcast, ETH_TYPE_ARP);
+  netPut16(&arp[0], 1U);                // Ethernet
+  netPut16(&arp[2], ETH_TYPE_IP);
+  arp[4] = 6U;
+  arp[5] = 4U;
+  netPut16(&arp[6], op);
+  memcpy(&arp[8], netCfg.mac, 6U);
+  netPut32(&arp[14], netCfg.ip);
+  if (tha != NULL) {
+    memcpy(&arp[18], tha, 6U);
+  } else {
+    memset(&arp[18], 0, 6U);
+  }
+  netPut32(&arp[24], tpa);
+  return ETH_HDR + ARP_LEN;
+}
+
+static void netArpInput (const uint8_t *arp, uint32_t len) {
+  uint8_t *frame;
+  uint32_t spa;
+  uint32_t tpa;
+  uint8_t  sha[6];
+
+  if ((len < ARP_LEN) || (netGet16(&arp[0]) != 1U) || (netGet16(&arp[2]) != ETH_TYPE_IP) ||
+      (arp[4] != 6U) || (arp[5] != 4U)) {
+    netStats.rx_drops++;
+    return;
+  }
+  netStats.rx_arp++;
+  memcpy(sha, &arp[8], 6U);
+  spa = netGet32(&arp[14]);
+  tpa = netGet32(&arp[24]);
+
+  if (((spa ^ netCfg.ip) & netCfg.mask) == 0U) {
+    netArpUpdate(spa, sha);
+  }
+  if ((netGet16(&arp[6]) == ARP_REQUEST) && (tpa == netCfg.ip)) {
+    frame = netTxBegin();
+    if (frame != NULL) {
+      (void)netTxEnd(netArpBuild(frame, ARP_REPLY, sha, spa));
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  IPv4 header (payload length len)
+ *----------------------------------------------------------------------------*/
+static void netIpHeader (uint8_t *ip, uint32_t proto, uint32_t dst, uint32_t len) {
+  ip[0] = 0x45U;                        // Version 4, 20 byte header
+  ip[1] = 0U;
+  netPut16(&ip[2], IP_HDR + len);
+  netPut16(&ip[4], netIpId++);
+  netPut16(&ip[6], IP_FLAG_DF);
+  ip[8] = IP_TTL;
+  ip[9] = (uint8_t)proto;
+  netPut16(&ip[10], 0U);
+  netPut32(&ip[12], netCfg.ip);
+  netPut32(&ip[16], dst);
+  netPut16(&ip[10], netChecksum(ip, IP_HDR));
+}
+
+static void netIcmpInput (const uint8_t *rx, const uint8_t *icmp, uint32_t len, uint32_t src) {
+  uint8_t *frame;
+  uint8_t *out;
+
+  netStats.rx_icmp++;
+  if ((len < 8U) || (len > (NET_UDP_MAX + UDP_HDR)) || (icmp[0] != ICMP_ECHO_REQUEST)) {
+    return;
+  }
+  frame = netTxBegin();
+  if (frame == NULL) {
+    return;
+  }
+  out = &frame[ETH_HDR + IP_HDR];
+  netEthHeader(frame, &rx[6], ETH_TYPE_IP);
+  netIpHeader(&frame[ETH_HDR], IP_PROTO_ICMP, src, len);
+  memcpy(out, icmp, len);
+  out[0] = ICMP_ECHO_REPLY;
+  netPut16(&out[2], 0U);
+  netPut16(&out[2], netChecksum(out, len));
+  (void)netTxEnd(ETH_HDR + IP_HDR + len);
+}
+
+static void netUdpInput (const uint8_t *udp, uint32_t len, uint32_t src) {
+  uint32_t port;
+  uint32_t ulen;
+  uint32_t n;
+
+  if (len < UDP_HDR) {
+    netStats.rx_drops++;
+    return;
+  }
+  ulen = netGet16(&udp[4]);
+  port = netGet16(&udp[2]);
+  if ((ulen < UDP_HDR) || (ulen > len)) {
+    netStats.rx_drops++;
+    return;
+  }
+  for (n = 0U; n < NET_UDP_PORTS; n++) {
+    if ((netPort[n].cb != NULL) && (netPort[n].port == port)) {
+      netStats.rx_udp++;
+      netPort[n].cb(&udp[UDP_HDR], ulen - UDP_HDR, src, (uint16_t)netGet16(&udp[0]), netPort[n].arg);
+      return;
+    }
+  }
+  netStats.rx_drops++;
+}
+
+static void netIpInput (const uint8_t *frame, uint32_t len) {
+  const uint8_t *ip = &frame[ETH_HDR];
+  uint32_t hlen;
+  uint32_t tlen;
+  uint32_t dst;
+  uint32_t src;
+
+  if ((len < IP_HDR) || ((ip[0] >> 4) != 4U)) {
+    netStats.rx_drops++;
+    return;
+  }
+  hlen = (ip[0] & 0x0FU) * 4U;
+  tlen = netGet16(&ip[2]);
+  dst  = netGet32(&ip[16]);
+  src  = netGet32(&ip[12]);
+  if ((hlen < IP_HDR) || (tlen < hlen) || (tlen > len) ||
+      ((netGet16(&ip[6]) & IP_FRAG_MASK) != 0U) || (netChecksum(ip, hlen) != 0U) ||
+      ((dst != netCfg.ip) && (dst != IP_BROADCAST) && (dst != (netCfg.ip | ~netCfg.mask)))) {
+    netStats.rx_drops++;
+    return;
+  }
+  switch (ip[9]) {
+    case IP_PROTO_UDP:
+      netUdpInput(&ip[hlen], tlen - hlen, src);
+      break;
+    case IP_PROTO_ICMP:
+      if (dst == netCfg.ip) {
+        netIcmpInput(frame, &ip[hlen], tlen - hlen, src);
+      }
+      break;
+    default:
+      netStats.rx_drops++;
+      break;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  netInit: set interface and addresses
+ *----------------------------------------------------------------------------*/
+void netInit (const netIf_t *ifc, const netConfig_t *cfg) {
+  netIf  = ifc;
+  netCfg = *cfg;
+  memset(netArp,  0, sizeof(netArp));
+  memset(netPort, 0, sizeof(netPort));
+}
+
+/*-----------------------------------------------------------------------------
+  netInput: process one received frame (length without FCS, one thread)
+ *----------------------------------------------------------------------------*/
+void netInput (uint8_t *frame, uint32_t len) {
+  netStats.rx_frames++;
+  if (len < ETH_HDR) {
+    netStats.rx_drops++;
+    return;
+  }
+  switch (netGet16(&frame[12])) {
+    case ETH_TYPE_ARP:
+      netArpInput(&frame[ETH_HDR], len - ETH_HDR);
+      break;
+    case ETH_TYPE_IP:
+      netIpInput(frame, len - ETH_HDR);
+      break;
+    default:
+      netStats.rx_drops++;
+      break;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  udpBind: deliver datagrams for port to cb (NULL: unbind)
+ *----------------------------------------------------------------------------*/
+int32_t udpBind (uint16_t port, udpRecv_t cb, void *arg) {
+  netPort_t *slot = NULL;
+  uint32_t   n;
+
+  for (n = 0U; n < NET_UDP_PORTS; n++) {
+    if ((netPort[n].cb != NULL) && (netPort[n].port == port)) {
+      slot = &netPort[n];
+      break;
+    }
+    if ((netPort[n].cb == NULL) && (slot == NULL)) {
+      slot = &netPort[n];
+    }
+  }
+  if (slot == NULL) {
+    return -1;
+  }
+  slot->arg  = arg;
+  slot->port = port;
+  slot->cb   = cb;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  udpAlloc: payload area of the next transmit buffer (NULL: none free)
+  Takes the transmit lock until udpSend.
+ *----------------------------------------------------------------------------*/
+uint8_t *udpAlloc (void) {
+  netTxFrame = netTxBegin();
+  return (netTxFrame != NULL) ? &netTxFrame[NET_HDR_SIZE] : NULL;
+}
+
+/*-----------------------------------------------------------------------------
+  udpSend: send len bytes of the udpAlloc buffer (len 0: release only)
+ *----------------------------------------------------------------------------*/
+int32_t udpSend (uint32_t ip, uint16_t dst_port, uint16_t src_port, uint32_t len) {
+  uint8_t  *frame = netTxFrame;
+  uint8_t  *udp;
+  netArp_t *e;
+  uint32_t  hop;
+
+  if (frame == NULL) {
+    return -1;
+  }
+  netTxFrame = NULL;
+  if ((len == 0U) || (len > NET_UDP_MAX)) {
+    (void)netTxEnd(0U);
+    return (len == 0U) ? 0 : -1;
+  }
+
+  if ((ip == IP_BROADCAST) || (ip == (netCfg.ip | ~netCfg.mask))) {
+    netEthHeader(frame, netBroadcast, ETH_TYPE_IP);
+  } else {
+    hop = (((ip ^ netCfg.ip) & netCfg.mask) == 0U) ? ip : netCfg.gw;
+    e   = netArpFind(hop);
+    if (e == NULL) {
+      netStats.arp_misses++;
+      (void)netTxEnd(netArpBuild(frame, ARP_REQUEST, NULL, hop));
+      return -1;
+    }
+    netEthHeader(frame, e->mac, ETH_TYPE_IP);
+  }
+
+  netIpHeader(&frame[ETH_HDR], IP_PROTO_UDP, ip, UDP_HDR + len);
+  udp = &frame[ETH_HDR + IP_HDR];
+  netPut16(&udp[0], src_port);
+  netPut16(&udp[2], dst_port);
+  netPut16(&udp[4], UDP_HDR + len);
+  netPut16(&udp[6], 0U);                // No checksum (Ethernet FCS protects)
+  return netTxEnd(NET_HDR_SIZE + len);
+}
+
+/*-----------------------------------------------------------------------------
+  netGetStats: get stack statistics
+ *----------------------------------------------------------------------------*/
+void netGetStats (netStats_t *stats) {
+  *stats = netStats;
+}
@@ -0,0 +1,103 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    net.h
+ * Purpose: Minimal ARP, IPv4, ICMP echo and UDP fast path
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef NET_H__
+#define NET_H__
+
+#include <stdint.h>
+
+/*
+  A single interface stack for telemetry and commands: ARP (with a small
+  cache), IPv4 without options or fragments, ICMP echo and UDP without
+  checksums on transmit. Received payloads are handed to the bound port in
+  place, in the frame buffer of the driver; payloads to send are written
+  into the transmit buffer, where the headers are added in front:
+
+    uint8_t *p = udpAlloc();
+    if (p != NULL) {
+      len = fill(p);                    // up to NET_UDP_MAX bytes
+      udpSend(NET_IP(192, 168, 1, 2), 5000U, 5001U, len);
+    }
+
+  udpAlloc takes the transmit lock and udpSend releases it (len 0: nothing
+  is sent). If the next hop is not in the ARP cache, udpSend sends an ARP
+  request instead of the datagram and returns -1; the caller retries.
+
+  The stack does not depend on the RTOS or the device: the frame buffers and
+  the lock are supplied by netIf_t and frames are passed to netInput, so it
+  also runs on a host against a loopback model (test/stubs/emac_loop.c).
+  On the target see net_emac.h.
+*/
+
+#ifndef NET_UDP_PORTS
+#define NET_UDP_PORTS           4U      // Bound ports
+#endif
+#ifndef NET_ARP_SIZE
+#define NET_ARP_SIZE            4U      // ARP cache entries
+#endif
+
+#define NET_HDR_SIZE            42U     // Ethernet, IPv4 and UDP headers
+#define NET_UDP_MAX             1472U   // Largest payload (MTU 1500)
+
+#define NET_IP(a, b, c, d)      (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | \
+                                 ((uint32_t)(c) <<  8) |  (uint32_t)(d))
+
+// Interface (lock and unlock may be NULL for single thread use)
+typedef struct {
+  uint8_t *(*tx_alloc) (void);
+  int32_t  (*tx_send)  (uint32_t len);
+  uint32_t (*lock)     (void);
+  void     (*unlock)   (uint32_t key);
+} netIf_t;
+
+// Address configuration (IPv4 addresses in host byte order)
+typedef struct {
+  uint8_t  mac[6];
+  uint32_t ip;
+  uint32_t mask;
+  uint32_t gw;
+} netConfig_t;
+
+// Receive callback (payload valid during the call only)
+typedef void (*udpRecv_t) (const uint8_t *data, uint32_t len, uint32_t ip, uint16_t port, void *arg);
+
+// Statistics
+typedef struct {
+  uint32_t rx_frames;
+  uint32_t rx_arp;
+  uint32_t rx_icmp;
+  uint32_t rx_udp;
+  uint32_t rx_drops;                    // Malformed, not for us or port not bound
+  uint32_t tx_frames;
+  uint32_t tx_busy;                     // No transmit buffer
+  uint32_t arp_misses;                  // Datagrams replaced by an ARP request
+} netStats_t;
+
+/* Prototypes */
+extern void     netInit     (const netIf_t *ifc, const netConfig_t *cfg);
+extern void     netInput    (uint8_t *frame, uint32_t len);
+extern int32_t  udpBind     (uint16_t port, udpRecv_t cb, void *arg);
+extern uint8_t *udpAlloc    (void);
+extern int32_t  udpSend     (uint32_t ip, uint16_t dst_port, uint16_t src_port, uint32_t len);
+extern void     netGetStats (netStats_t *stats);
+
+#endif
@@ -0,0 +1,175 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    net_emac.c
+ * Purpose: Network stack on the Ethernet MAC with benchmarks
+ *----------------------------------------------------------------------------*/
+
+
+#include <string.h>
+
+#include "net_emac.h"
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+
+#include "emac.h"
+#include "timebase.h"
+
+#define NE_ARP_RETRIES          100U    // Benchmark: wait for the peer's ARP reply
+
+static osMutexId_t  neLock;
+static osThreadId_t neThreadId;
+static neBench_t    neDiscard;          // Receive benchmark (port 9)
+static uint32_t     neDiscardFirst;     // Time of the first datagram
+
+const osThreadAttr_t net_attr      = {.name = "Network", .priority = osPriorityAboveNormal};
+const osMutexAttr_t  net_lock_attr = {.name = "NetTx", .attr_bits = osMutexPrioInherit};
+
+/*-----------------------------------------------------------------------------
+  Transmit lock (threads only)
+ *----------------------------------------------------------------------------*/
+static uint32_t neTxLock (void) {
+  osMutexAcquire(neLock, osWaitForever);
+  return 0U;
+}
+
+static void neTxUnlock (uint32_t key) {
+  (void)key;
+  osMutexRelease(neLock);
+}
+
+static const netIf_t neIf = { emacTxAlloc, emacTxSend, neTxLock, neTxUnlock };
+
+/*-----------------------------------------------------------------------------
+  Benchmark ports (network thread)
+ *----------------------------------------------------------------------------*/
+static void neEcho (const uint8_t *data, uint32_t len, uint32_t ip, uint16_t port, void *arg) {
+  uint8_t *p = udpAlloc();
+  (void)arg;
+
+  if (p != NULL) {
+    memcpy(p, data, len);
+    (void)udpSend(ip, port, NE_ECHO_PORT, len);
+  }
+}
+
+static void neDiscardRecv (const uint8_t *data, uint32_t len, uint32_t ip, uint16_t port, void *arg) {
+  uint32_t now = tbGetUs();
+  (void)data;
+  (void)ip;
+  (void)port;
+  (void)arg;
+
+  if (neDiscard.frames == 0U) {
+    neDiscardFirst = now;
+  }
+  neDiscard.frames++;
+  neDiscard.bytes += len;
+  neDiscard.us     = now - neDiscardFirst;
+}
+
+/*-----------------------------------------------------------------------------
+  Network thread: receive and link state
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void neThread (void *argument) {
+  uint8_t *frame;
+  uint32_t len;
+  uint32_t poll = osKernelGetTickCount();
+  (void)argument;
+
+  (void)emacLinkPoll();
+  for (;;) {
+    frame = emacRxGet(&len, NE_LINK_POLL);
+    if (frame != NULL) {
+      netInput(frame, len);
+      emacRxRelease();
+    }
+    if ((osKernelGetTickCount() - poll) >= NE_LINK_POLL) {
+      poll += NE_LINK_POLL;
+      (void)emacLinkPoll();
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  neStart: start the MAC, the stack and the benchmark ports
+ *----------------------------------------------------------------------------*/
+int32_t neStart (const netConfig_t *cfg) {
+  neLock = osMutexNew(&net_lock_attr);
+  if (neLock == NULL) {
+    return -1;
+  }
+  if (emacInit(cfg->mac) != 0) {
+    (void)osMutexDelete(neLock);
+    neLock = NULL;
+    return -1;
+  }
+  netInit(&neIf, cfg);
+  (void)udpBind(NE_ECHO_PORT, neEcho, NULL);
+  (void)udpBind(NE_DISCARD_PORT, neDiscardRecv, NULL);
+
+  neThreadId = osThreadNew(neThread, NULL, &net_attr);
+  if (neThreadId == NULL) {
+    (void)osMutexDelete(neLock);        // Failed start: the stack is not used
+    neLock = NULL;
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  neBenchTx: send count datagrams of len bytes as fast as possible
+  The payload is not written, so only the zero-copy path is measured.
+ *----------------------------------------------------------------------------*/
+int32_t neBenchTx (uint32_t ip, uint16_t port, uint32_t len, uint32_t count, neBench_t *result) {
+  uint32_t retries = 0U;
+  uint32_t start;
+
+  memset(result, 0, sizeof(neBench_t));
+  if ((len == 0U) || (len > NET_UDP_MAX)) {
+    return -1;
+  }
+
+  start = tbGetUs();
+  while (result->frames < count) {
+    if (udpAlloc() == NULL) {
+      result->busy++;                   // Ring full: wait for the MAC
+      continue;
+    }
+    if (udpSend(ip, port, NE_DISCARD_PORT, len) != 0) {
+      if (++retries > NE_ARP_RETRIES) {
+        return -1;
+      }
+      osDelay(10U);                     // ARP request sent instead
+      start = tbGetUs();
+      continue;
+    }
+    result->frames++;
+    result->bytes += len;
+  }
+  result->us   = tbGetUs() - start;
+  result->kbps = (result->us != 0U) ? (uint32_t)(((uint64_t)result->bytes * 8000U) / result->us) : 0U;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  neGetDiscard: receive benchmark result (port 9, since start)
+ *----------------------------------------------------------------------------*/
+void neGetDiscard (neBench_t *result) {
+  *result      = neDiscard;
+  result->kbps = (result->us != 0U) ? (uint32_t)(((uint64_t)result->bytes * 8000U) / result->us) : 0U;
+}
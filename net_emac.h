@@ -0,0 +1,68 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    net_emac.h
+ * Purpose: Network stack on the Ethernet MAC with benchmarks
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef NET_EMAC_H__
+#define NET_EMAC_H__
+
+#include <stdint.h>
+
+#include "net.h"
+
+/*
+  Runs the network stack (net.h) on the Ethernet MAC driver (emac.h). One
+  thread receives frames and calls netInput for each of them, so UDP
+  callbacks run in that thread with the payload still in the receive
+  buffer. The PHY link state is polled by the same thread.
+
+  Benchmarks:
+    - UDP echo (port 7) and ICMP echo: round trip latency from a host,
+      e.g. ping -i 0.01, or a UDP client measuring the reply time
+    - UDP discard (port 9): receive throughput, see neGetDiscard
+    - neBenchTx: transmit throughput of the zero-copy path
+  The driver records the worst interrupt to delivery latency and the
+  largest receive batch (emacGetStats). The same benchmarks run on a host
+  against a loopback model of the MAC: make -C test bench (bench_net).
+*/
+
+#define NE_ECHO_PORT            7U
+#define NE_DISCARD_PORT         9U
+
+// Link poll interval in ms
+#ifndef NE_LINK_POLL
+#define NE_LINK_POLL            500U
+#endif
+
+// Benchmark result
+typedef struct {
+  uint32_t frames;
+  uint32_t bytes;                       // UDP payload bytes
+  uint32_t us;                          // Duration
+  uint32_t kbps;                        // Payload rate in kbit/s
+  uint32_t busy;                        // Waits for a free transmit buffer
+} neBench_t;
+
+/* Prototypes */
+extern int32_t neStart      (const netConfig_t *cfg);
+extern int32_t neBenchTx    (uint32_t ip, uint16_t port, uint32_t len, uint32_t count, neBench_t *result);
+extern void    neGetDiscard (neBench_t *result);
+
+#endif
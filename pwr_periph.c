@@ -0,0 +1,205 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    pwr_periph.c
+ * Purpose: Reference counted peripheral power and clock manager
+ *----------------------------------------------------------------------------*/
+
+#include "pwr_periph.h"
+#include "clk_profile.h"
+#include "irq_prio.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#define PM_NO_PCLK              0xFFU   // Peripheral has no PCLKSEL field
+
+// Peripheral description
+typedef struct {
+  uint8_t pconp;                        // PCONP bit
+  uint8_t pclksel;                      // PCLKSEL register (0 or 1)
+  uint8_t shift;                        // PCLKSEL field position
+  uint8_t can;                          // Divider code 3 means /6
+} pmPeriph_t;
+
+static const pmPeriph_t pmPeriph[PM_NUM] = {
+  {  1U, 0U,           2U, 0U },        // TIMER0
+  {  2U, 0U,           4U, 0U },        // TIMER1
+  {  3U, 0U,           6U, 0U },        // UART0
+  {  4U, 0U,           8U, 0U },        // UART1
+  {  6U, 0U,          12U, 0U },        // PWM1
+  {  7U, 0U,          14U, 0U },        // I2C0
+  {  8U, 0U,          16U, 0U },        // SPI
+  {  9U, PM_NO_PCLK,   0U, 0U },        // RTC
+  { 10U, 0U,          20U, 0U },        // SSP1
+  { 12U, 0U,          24U, 0U },        // ADC
+  { 13U, 0U,          26U, 1U },        // CAN1
+  { 14U, 0U,          28U, 1U },        // CAN2
+  { 15U, 1U,           2U, 0U },        // GPIO
+  { 16U, 1U,          26U, 0U },        // RIT
+  { 17U, 1U,          30U, 0U },        // MCPWM
+  { 18U, 1U,           0U, 0U },        // QEI
+  { 19U, 1U,           6U, 0U },        // I2C1
+  { 21U, 1U,          10U, 0U },        // SSP0
+  { 22U, 1U,          12U, 0U },        // TIMER2
+  { 23U, 1U,          14U, 0U },        // TIMER3
+  { 24U, 1U,          16U, 0U },        // UART2
+  { 25U, 1U,          18U, 0U },        // UART3
+  { 26U, 1U,          20U, 0U },        // I2C2
+  { 27U, 1U,          22U, 0U },        // I2S
+  { 29U, PM_NO_PCLK,   0U, 0U },        // GPDMA
+  { 30U, PM_NO_PCLK,   0U, 0U },        // ENET
+  { 31U, PM_NO_PCLK,   0U, 0U }         // USB
+};
+
+static uint8_t pmRefCount[PM_NUM];
+
+__USED uint32_t pmLive;                 // Bit mask of acquired peripherals (PM_xxx)
+
+/*-----------------------------------------------------------------------------
+  Get divider code of a peripheral clock
+ *----------------------------------------------------------------------------*/
+static uint32_t pmPclkCode (const pmPeriph_t *p) {
+  uint32_t reg = (p->pclksel == 0U) ? LPC_SC->PCLKSEL0 : LPC_SC->PCLKSEL1;
+  return ((reg >> p->shift) & 0x03U);
+}
+
+/*-----------------------------------------------------------------------------
+  pmAcquire: power peripheral and select its clock divider
+  The divider can only be changed by the first user (PM_PCLK_ANY: keep).
+  PCLKSEL is written only when the divider actually changes. Callable from
+  threads and kernel-aware ISRs (reference counts use irqKernelLock).
+ *----------------------------------------------------------------------------*/
+int32_t pmAcquire (uint32_t id, uint32_t pclk_div) {
+  const pmPeriph_t *p;
+  uint32_t basepri;
+  int32_t  status = 0;
+
+  if ((id >= PM_NUM) || ((pclk_div > PM_PCLK_DIV8) && (pclk_div != PM_PCLK_ANY))) {
+    return -1;
+  }
+  p = &pmPeriph[id];
+
+  basepri = irqKernelLock();
+
+  if ((p->pclksel != PM_NO_PCLK) && (pclk_div != PM_PCLK_ANY) &&
+      (pmPclkCode(p) != pclk_div)) {
+    if (pmRefCount[id] == 0U) {
+      clkPclkSelect(p->pclksel, 0x03UL << p->shift, pclk_div << p->shift);
+    } else {
+      status = -1;                      // In use with a different clock
+    }
+  }
+  if (status == 0) {
+    if (pmRefCount[id]++ == 0U) {
+      LPC_SC->PCONP |= (1UL << p->pconp);
+      pmLive        |= (1UL << id);
+    }
+  }
+
+  irqKernelUnlock(basepri);
+
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  pmRelease: release peripheral, power it down with the last user
+ *----------------------------------------------------------------------------*/
+void pmRelease (uint32_t id) {
+  uint32_t basepri;
+
+  if (id >= PM_NUM) {
+    return;
+  }
+
+  basepri = irqKernelLock();
+
+  if (pmRefCount[id] != 0U) {
+    if (--pmRefCount[id] == 0U) {
+      LPC_SC->PCONP &= ~(1UL << pmPeriph[id].pconp);
+      pmLive        &= ~(1UL << id);
+    }
+  }
+
+  irqKernelUnlock(basepri);
+}
+
+/*-----------------------------------------------------------------------------
+  pmGetPclk: get peripheral clock in Hz
+ *----------------------------------------------------------------------------*/
+uint32_t pmGetPclk (uint32_t id) {
+  return pmGetPclkAt(id, SystemCoreClock);
+}
+
+/*-----------------------------------------------------------------------------
+  pmGetPclkAt: peripheral clock in Hz if the core ran at cclk (same divider)
+ *----------------------------------------------------------------------------*/
+uint32_t pmGetPclkAt (uint32_t id, uint32_t cclk) {
+  const pmPeriph_t *p;
+
+  if (id >= PM_NUM) {
+    return 0U;
+  }
+  p = &pmPeriph[id];
+  if (p->pclksel == PM_NO_PCLK) {
+    return cclk;
+  }
+  switch (pmPclkCode(p)) {
+    case PM_PCLK_DIV1: return cclk;
+    case PM_PCLK_DIV2: return cclk / 2U;
+    case PM_PCLK_DIV8: return cclk / ((p->can != 0U) ? 6U : 8U);
+    default:           return cclk / 4U;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  pmGetLive: get bit mask of acquired peripherals (bit n = PM_xxx id n)
+ *----------------------------------------------------------------------------*/
+uint32_t pmGetLive (void) {
+  return pmLive;
+}
+
+/*-----------------------------------------------------------------------------
+  pmUartPclkDiv: select UART clock divider with the lowest baud rate error
+  (16x oversampling, integer divisor latch)
+ *----------------------------------------------------------------------------*/
+uint32_t pmUartPclkDiv (uint32_t baudrate) {
+  static const uint8_t code[4] = { PM_PCLK_DIV1, PM_PCLK_DIV2, PM_PCLK_DIV4, PM_PCLK_DIV8 };
+  static const uint8_t div[4]  = { 1U, 2U, 4U, 8U };
+  uint32_t best     = PM_PCLK_DIV4;
+  uint32_t best_err = 0xFFFFFFFFU;
+  uint32_t pclk;
+  uint32_t dl;
+  uint32_t actual;
+  uint32_t err;
+  uint32_t n;
+
+  for (n = 0U; n < 4U; n++) {
+    pclk = SystemCoreClock / div[n];
+    dl   = (pclk + (8U * baudrate)) / (16U * baudrate);
+    if ((dl == 0U) || (dl > 0xFFFFU)) {
+      continue;
+    }
+    actual = pclk / (16U * dl);
+    err    = (actual > baudrate) ? (actual - baudrate) : (baudrate - actual);
+    if (err < best_err) {
+      best_err = err;
+      best     = code[n];
+    }
+  }
+  return best;
+}
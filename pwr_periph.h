@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    pwr_periph.h
+ * Purpose: Reference counted peripheral power and clock manager
+ *----------------------------------------------------------------------------*/
+
+#ifndef PWR_PERIPH_H__
+#define PWR_PERIPH_H__
+
+#include <stdint.h>
+
+// Peripheral identifiers
+#define PM_TIMER0               0U
+#define PM_TIMER1               1U
+#define PM_UART0                2U
+#define PM_UART1                3U
+#define PM_PWM1                 4U
+#define PM_I2C0                 5U
+#define PM_SPI                  6U
+#define PM_RTC                  7U
+#define PM_SSP1                 8U
+#define PM_ADC                  9U
+#define PM_CAN1                 10U
+#define PM_CAN2                 11U
+#define PM_GPIO                 12U
+#define PM_RIT                  13U
+#define PM_MCPWM                14U
+#define PM_QEI                  15U
+#define PM_I2C1                 16U
+#define PM_SSP0                 17U
+#define PM_TIMER2               18U
+#define PM_TIMER3               19U
+#define PM_UART2                20U
+#define PM_UART3                21U
+#define PM_I2C2                 22U
+#define PM_I2S                  23U
+#define PM_GPDMA                24U
+#define PM_ENET                 25U
+#define PM_USB                  26U
+#define PM_NUM                  27U
+
+// Peripheral clock dividers (PCLKSEL codes)
+#define PM_PCLK_DIV4            0U      // PCLK = CCLK / 4 (reset default)
+#define PM_PCLK_DIV1            1U      // PCLK = CCLK
+#define PM_PCLK_DIV2            2U      // PCLK = CCLK / 2
+#define PM_PCLK_DIV8            3U      // PCLK = CCLK / 8 (CAN: CCLK / 6)
+#define PM_PCLK_ANY             0xFFU   // Keep current divider
+
+/* Prototypes */
+extern int32_t  pmAcquire      (uint32_t id, uint32_t pclk_div);
+extern void     pmRelease      (uint32_t id);
+extern uint32_t pmGetPclk      (uint32_t id);
+extern uint32_t pmGetPclkAt    (uint32_t id, uint32_t cclk);
+extern uint32_t pmGetLive      (void);
+extern uint32_t pmUartPclkDiv  (uint32_t baudrate);
+
+#endif
@@ -0,0 +1,110 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    retained.c
+ * Purpose: Reset cause and RAM block retained across warm restarts
+ *----------------------------------------------------------------------------*/
+
+
+#include <stddef.h>
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "retained.h"
+
+#include "crc32.h"
+#include "irq_prio.h"
+#include "mem_sections.h"
+
+#define RET_MAGIC               0x52455431U     // "RET1"
+#define RET_CRC_OFFSET          offsetof(retBlock_t, boots)     // CRC covers boots..app
+
+retBlock_t      retBlock __NOINIT;              // Survives all but power-on
+static uint32_t retWarm;                        // Block was intact at boot
+
+static uint32_t retBlockCrc (void) {
+  return crc32Calc((const uint8_t *)&retBlock + RET_CRC_OFFSET,
+                   sizeof(retBlock) - RET_CRC_OFFSET);
+}
+
+/*-----------------------------------------------------------------------------
+  retInit: read and clear the reset cause, validate the retained block
+  Call once from main before anything else uses retBlock.
+  Returns the reset cause (RET_RESET_xxx bits).
+ *----------------------------------------------------------------------------*/
+uint32_t retInit (void) {
+  uint32_t cause;
+  uint32_t n;
+
+  cause = LPC_SC->RSID & 0x0FU;
+  LPC_SC->RSID = 0x0FU;                 // Clear: next software reset reads 0
+
+  retWarm = ((cause & RET_RESET_POR) == 0U) &&
+            (retBlock.magic == RET_MAGIC)   &&
+            (retBlock.size  == sizeof(retBlock)) &&
+            (retBlock.crc   == retBlockCrc());
+
+  if (retWarm == 0U) {
+    for (n = 0U; n < sizeof(retBlock); n++) {
+      ((uint8_t *)&retBlock)[n] = 0U;
+    }
+    retBlock.magic = RET_MAGIC;
+    retBlock.size  = sizeof(retBlock);
+  } else {
+    retBlock.warm_boots++;
+  }
+
+  retBlock.boots++;
+  if ((cause & RET_RESET_WDT) != 0U) {
+    retBlock.resets_wdt++;
+  }
+  if ((cause & RET_RESET_BOD) != 0U) {
+    retBlock.resets_bod++;
+  }
+  if (cause == RET_RESET_SOFT) {
+    retBlock.resets_soft++;
+  }
+  retBlock.last_cause = cause;
+  retCommit();
+
+  return cause;
+}
+
+/*-----------------------------------------------------------------------------
+  retCommit: update the CRC after modifying retBlock
+  May be called from threads and from kernel-aware ISRs.
+ *----------------------------------------------------------------------------*/
+void retCommit (void) {
+  uint32_t basepri = irqKernelLock();
+
+  retBlock.crc = retBlockCrc();
+  irqKernelUnlock(basepri);
+}
+
+/*-----------------------------------------------------------------------------
+  retIsWarm: retained block survived the last reset
+ *----------------------------------------------------------------------------*/
+uint32_t retIsWarm (void) {
+  return retWarm;
+}
+
+/*-----------------------------------------------------------------------------
+  retGetResetCause: reset cause of the current boot (RET_RESET_xxx bits)
+ *----------------------------------------------------------------------------*/
+uint32_t retGetResetCause (void) {
+  return retBlock.last_cause;
+}
@@ -0,0 +1,64 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    retained.h
+ * Purpose: Reset cause and RAM block retained across warm restarts
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef RETAINED_H__
+#define RETAINED_H__
+
+#include <stdint.h>
+
+// Size of the application area in the retained block in bytes
+#ifndef RET_APP_SIZE
+#define RET_APP_SIZE            64U
+#endif
+
+// Reset causes (RSID bits, RET_RESET_SOFT when no bit is set)
+#define RET_RESET_POR           0x01U   // Power-on reset
+#define RET_RESET_EXTR          0x02U   // External reset pin
+#define RET_RESET_WDT           0x04U   // Watchdog reset
+#define RET_RESET_BOD           0x08U   // Brown-out reset
+#define RET_RESET_SOFT          0x00U   // Software or debugger reset
+
+// Retained block (in RW_NOINIT, protected by a CRC-32)
+typedef struct {
+  uint32_t magic;                       // RET_MAGIC
+  uint32_t size;                        // sizeof(retBlock_t), changes with layout
+  uint32_t crc;                         // CRC-32 of the fields below
+  uint32_t boots;                       // Boots since the block was created
+  uint32_t warm_boots;                  // Boots that found the block intact
+  uint32_t resets_wdt;                  // Watchdog resets
+  uint32_t resets_bod;                  // Brown-out resets
+  uint32_t resets_soft;                 // Software and debugger resets
+  uint32_t last_cause;                  // RET_RESET_xxx of the latest boot
+  uint32_t wdt_late_ms;                 // Supervisor: lateness of the stalled thread
+  char     wdt_thread[16];              // Supervisor: name of the stalled thread
+  uint8_t  app[RET_APP_SIZE];           // Application state
+} retBlock_t;
+
+extern retBlock_t retBlock;
+
+/* Prototypes */
+extern uint32_t retInit         (void);
+extern void     retCommit       (void);
+extern uint32_t retIsWarm       (void);
+extern uint32_t retGetResetCause(void);
+
+#endif
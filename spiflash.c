@@ -0,0 +1,644 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    spiflash.c
+ * Purpose: Serial NOR flash on SSP1 with DMA reads and sector cache
+ *----------------------------------------------------------------------------*/
+
+
+#include <string.h>
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "spiflash.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "PIN_LPC17xx.h"
+
+#include "clk_governor.h"
+#include "clk_profile.h"
+#include "gpdma.h"
+#include "irq_prio.h"
+#include "mem_sections.h"
+#include "pwr_periph.h"
+#include "timebase.h"
+
+#if ((SF_LINE_SIZE & (SF_LINE_SIZE - 1U)) != 0U) || (SF_LINE_SIZE > SF_SECTOR_SIZE)
+#error "SF_LINE_SIZE must be a power of 2 of at most one sector"
+#endif
+
+#ifndef SF_SSP
+#define SF_SSP                  LPC_SSP1        // Host test: device model
+#endif
+#define SF_CS_BIT               (1UL << 6)      // P0.6
+
+// Device commands
+#define SF_CMD_WREN             0x06U
+#define SF_CMD_RDSR             0x05U
+#define SF_CMD_READ_FAST        0x0BU
+#define SF_CMD_PP               0x02U
+#define SF_CMD_SE               0x20U
+#define SF_CMD_RDID             0x9FU
+#define SF_SR_WIP               0x01U   // Write in progress
+
+// Timeouts in ms
+#define SF_TIMEOUT_DMA          100U
+#define SF_TIMEOUT_PROGRAM      10U
+#define SF_TIMEOUT_ERASE        500U
+
+// SSP status register
+#define SF_SR_TNF               0x02U
+#define SF_SR_RNE               0x04U
+#define SF_SR_BSY               0x10U
+
+// Worker thread flags
+#define SF_FLAG_REQ             0x0001U // Request queued
+#define SF_FLAG_DMA             0x0002U // DMA receive finished
+#define SF_FLAG_SYNC            0x4000U // Calling thread of sfRead/sfProgram/sfErase
+
+// One DMA transfer: linked list items of up to 4092 bytes
+#define SF_LLI_BYTES            4092U
+#define SF_LLI_MAX              4U
+#define SF_XFER_MAX             (SF_LLI_BYTES * SF_LLI_MAX)
+
+// AHB SRAM banks 0 and 1: the only RAM the GPDMA can write
+#define SF_AHB_SRAM_START       0x2007C000U
+#define SF_AHB_SRAM_END         0x20084000U
+
+// Cache line state
+typedef struct {
+  uint32_t addr;                        // Flash address of the line
+  uint32_t used;                        // Last access (LRU stamp)
+  uint32_t valid;
+} sfLine_t;
+
+static uint8_t      sfCacheData[SF_CACHE_LINES][SF_LINE_SIZE] __DMA_RAM;
+static sfLine_t     sfCache[SF_CACHE_LINES];
+static uint32_t     sfStamp;
+static uint32_t     sfAhead = 0xFFFFFFFFU;  // Line to prefetch (none: all ones)
+
+static dmaLli_t     sfLliRx[SF_LLI_MAX] __DMA_RAM;
+static dmaLli_t     sfLliTx[SF_LLI_MAX] __DMA_RAM;
+static uint8_t      sfDummy __DMA_RAM;      // Clocked out during reads
+static int32_t      sfDmaRx = -1;
+static int32_t      sfDmaTx = -1;
+static volatile uint32_t sfDmaError;
+static uint32_t     sfGovProfile;       // Lowest clock profile reaching SF_SCK_HZ
+
+static sfReq_t     *sfHead;             // Request queue
+static sfReq_t     *sfTail;
+static uint32_t     sfQueued;
+static osThreadId_t sfThreadId;
+
+__USED sfStats_t    sfStats;            // Flash driver statistics
+
+const osThreadAttr_t spiflash_attr = {.name = "SpiFlash", .priority = osPriorityAboveNormal};
+
+/*-----------------------------------------------------------------------------
+  SSP primitives (polled, command phase)
+ *----------------------------------------------------------------------------*/
+static inline void sfSelect (void) {
+  LPC_GPIO0->FIOCLR = SF_CS_BIT;
+}
+
+static inline void sfDeselect (void) {
+  while ((SF_SSP->SR & SF_SR_BSY) != 0U) {}
+  LPC_GPIO0->FIOSET = SF_CS_BIT;
+}
+
+static uint8_t sfXfer (uint8_t tx) {
+  while ((SF_SSP->SR & SF_SR_TNF) == 0U) {}
+  SF_SSP->DR = tx;
+  while ((SF_SSP->SR & SF_SR_RNE) == 0U) {}
+  return (uint8_t)SF_SSP->DR;
+}
+
+static void sfCommand (uint8_t cmd, uint32_t addr) {
+  sfXfer(cmd);
+  sfXfer((uint8_t)(addr >> 16));
+  sfXfer((uint8_t)(addr >> 8));
+  sfXfer((uint8_t)addr);
+}
+
+static void sfWriteEnable (void) {
+  sfSelect();
+  sfXfer(SF_CMD_WREN);
+  sfDeselect();
+}
+
+/*-----------------------------------------------------------------------------
+  Wait for program/erase to finish, sleeping between status polls
+ *----------------------------------------------------------------------------*/
+static int32_t sfWaitReady (uint32_t timeout_ms) {
+  uint32_t start = osKernelGetTickCount();
+  uint8_t  sr;
+
+  for (;;) {
+    sfSelect();
+    sfXfer(SF_CMD_RDSR);
+    sr = sfXfer(0xFFU);
+    sfDeselect();
+    if ((sr & SF_SR_WIP) == 0U) {
+      return 0;
+    }
+    if ((osKernelGetTickCount() - start) > timeout_ms) {
+      return -1;
+    }
+    osDelay(1U);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  DMA receive finished (DMA interrupt context)
+ *----------------------------------------------------------------------------*/
+static void sfDmaEvent (uint32_t event, void *arg) {
+  (void)arg;
+  if ((event & DMA_EVENT_ERROR) != 0U) {
+    sfDmaError = 1U;
+  }
+  osThreadFlagsSet(sfThreadId, SF_FLAG_DMA);
+}
+
+/*-----------------------------------------------------------------------------
+  Read len bytes (at most SF_XFER_MAX) into AHB SRAM in one transfer
+  The receive channel has the higher priority so the RX FIFO cannot overflow.
+ *----------------------------------------------------------------------------*/
+static int32_t sfReadDma (uint32_t addr, uint8_t *buf, uint32_t len) {
+  uint32_t ctrl_rx = DMA_CTRL_SBSIZE(DMA_BURST_4) | DMA_CTRL_DBSIZE(DMA_BURST_4) |
+                     DMA_CTRL_SWIDTH(DMA_WIDTH_8) | DMA_CTRL_DWIDTH(DMA_WIDTH_8) | DMA_CTRL_DI;
+  uint32_t ctrl_tx = DMA_CTRL_SBSIZE(DMA_BURST_4) | DMA_CTRL_DBSIZE(DMA_BURST_4) |
+                     DMA_CTRL_SWIDTH(DMA_WIDTH_8) | DMA_CTRL_DWIDTH(DMA_WIDTH_8);
+  uint32_t start;
+  uint32_t flags;
+  uint32_t n;
+  uint32_t i;
+  int32_t  status = 0;
+
+  for (i = 0U; len != 0U; i++) {
+    n = (len > SF_LLI_BYTES) ? SF_LLI_BYTES : len;
+    sfLliRx[i].src  = (uint32_t)&SF_SSP->DR;
+    sfLliRx[i].dst  = (uint32_t)buf;
+    sfLliRx[i].next = &sfLliRx[i + 1U];
+    sfLliRx[i].ctrl = ctrl_rx | DMA_CTRL_SIZE(n);
+    sfLliTx[i].src  = (uint32_t)&sfDummy;
+    sfLliTx[i].dst  = (uint32_t)&SF_SSP->DR;
+    sfLliTx[i].next = &sfLliTx[i + 1U];
+    sfLliTx[i].ctrl = ctrl_tx | DMA_CTRL_SIZE(n);
+    buf += n;
+    len -= n;
+    sfStats.read_bytes += n;
+  }
+  sfLliRx[i - 1U].next  = NULL;
+  sfLliRx[i - 1U].ctrl |= DMA_CTRL_I;
+  sfLliTx[i - 1U].next  = NULL;
+
+  // The CPU idles during the transfer: keep the governor from stepping down
+  govHoldMin(sfGovProfile);
+  if (clkProfileGet() < sfGovProfile) {
+    (void)osThreadYield();              // Same priority: let the governor switch first
+  }
+
+  start = tbGetUs();
+  sfDmaError = 0U;
+  osThreadFlagsClear(SF_FLAG_DMA);
+
+  sfSelect();
+  sfCommand(SF_CMD_READ_FAST, addr);
+  sfXfer(0xFFU);                        // Dummy byte
+  SF_SSP->DMACR = 0x03U;                // RX and TX DMA enable
+  if ((dmaStart(sfDmaRx, &sfLliRx[0], DMA_P2M) != 0) ||
+      (dmaStart(sfDmaTx, &sfLliTx[0], DMA_M2P) != 0)) {
+    status = -1;
+  } else {
+    flags = osThreadFlagsWait(SF_FLAG_DMA, osFlagsWaitAny, SF_TIMEOUT_DMA);
+    if (((flags & osFlagsError) != 0U) || (sfDmaError != 0U)) {
+      status = -1;
+    }
+  }
+  if (status != 0) {
+    dmaStop(sfDmaTx);
+    dmaStop(sfDmaRx);
+  }
+  SF_SSP->DMACR = 0U;
+  sfDeselect();
+  while ((SF_SSP->SR & SF_SR_RNE) != 0U) {
+    (void)SF_SSP->DR;                   // Flush after an aborted transfer
+  }
+
+  sfStats.read_us += tbGetUs() - start;
+  govReleaseMin(sfGovProfile);
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  Sector cache
+ *----------------------------------------------------------------------------*/
+static sfLine_t *sfCacheFind (uint32_t addr) {
+  uint32_t n;
+
+  for (n = 0U; n < SF_CACHE_LINES; n++) {
+    if ((sfCache[n].valid != 0U) && (sfCache[n].addr == addr)) {
+      return &sfCache[n];
+    }
+  }
+  return NULL;
+}
+
+static sfLine_t *sfCacheLoad (uint32_t addr) {
+  sfLine_t *line = &sfCache[0];
+  uint32_t  n;
+
+  for (n = 0U; n < SF_CACHE_LINES; n++) {
+    if (sfCache[n].valid == 0U) {
+      line = &sfCache[n];
+      break;
+    }
+    if ((int32_t)(sfCache[n].used - line->used) < 0) {
+      line = &sfCache[n];
+    }
+  }
+  n = (uint32_t)(line - sfCache);
+  line->valid = 0U;
+  if (sfReadDma(addr, sfCacheData[n], SF_LINE_SIZE) != 0) {
+    return NULL;
+  }
+  line->addr  = addr;
+  line->used  = sfStamp++;
+  line->valid = 1U;
+  return line;
+}
+
+static void sfCacheInvalidate (uint32_t addr, uint32_t len) {
+  uint32_t n;
+
+  for (n = 0U; n < SF_CACHE_LINES; n++) {
+    if ((sfCache[n].addr < (addr + len)) && ((sfCache[n].addr + SF_LINE_SIZE) > addr)) {
+      sfCache[n].valid = 0U;
+    }
+  }
+  if ((sfAhead < (addr + len)) && ((sfAhead + SF_LINE_SIZE) > addr)) {
+    sfAhead = 0xFFFFFFFFU;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Execute a read request
+ *----------------------------------------------------------------------------*/
+static int32_t sfDoRead (uint32_t addr, uint8_t *buf, uint32_t len) {
+  sfLine_t *line;
+  uint32_t  base;
+  uint32_t  off;
+  uint32_t  n;
+
+  while (len != 0U) {
+    base = addr & ~(SF_LINE_SIZE - 1U);
+    off  = addr - base;
+    line = sfCacheFind(base);
+    n    = len & ~(SF_LINE_SIZE - 1U);
+    if (n > (SF_XFER_MAX & ~(SF_LINE_SIZE - 1U))) {
+      n = SF_XFER_MAX & ~(SF_LINE_SIZE - 1U);
+    }
+
+    if ((line == NULL) && (off == 0U) && (n != 0U) &&
+        ((uint32_t)buf >= SF_AHB_SRAM_START) && (((uint32_t)buf + n) <= SF_AHB_SRAM_END)) {
+      // Whole lines into AHB SRAM: read past the cache
+      if (sfReadDma(addr, buf, n) != 0) {
+        return -1;
+      }
+      sfStats.direct_bytes += n;
+    } else {
+      if (line != NULL) {
+        sfStats.hits++;
+        line->used = sfStamp++;
+      } else {
+        sfStats.misses++;
+        line = sfCacheLoad(base);
+        if (line == NULL) {
+          return -1;
+        }
+      }
+      n = SF_LINE_SIZE - off;
+      if (n > len) {
+        n = len;
+      }
+      memcpy(buf, &sfCacheData[line - sfCache][off], n);
+    }
+    addr += n;
+    buf  += n;
+    len  -= n;
+  }
+  sfAhead = (addr + SF_LINE_SIZE - 1U) & ~(SF_LINE_SIZE - 1U);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  Execute a program request (page by page)
+ *----------------------------------------------------------------------------*/
+static int32_t sfDoProgram (uint32_t addr, const uint8_t *buf, uint32_t len) {
+  uint32_t n;
+  uint32_t i;
+  int32_t  status = 0;
+
+  sfCacheInvalidate(addr, len);
+  while ((len != 0U) && (status == 0)) {
+    n = SF_PAGE_SIZE - (addr & (SF_PAGE_SIZE - 1U));
+    if (n > len) {
+      n = len;
+    }
+    sfWriteEnable();
+    sfSelect();
+    sfCommand(SF_CMD_PP, addr);
+    for (i = 0U; i < n; i++) {
+      sfXfer(buf[i]);
+    }
+    sfDeselect();
+    status = sfWaitReady(SF_TIMEOUT_PROGRAM);
+    addr += n;
+    buf  += n;
+    len  -= n;
+  }
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  Execute an erase request (sector by sector)
+ *----------------------------------------------------------------------------*/
+static int32_t sfDoErase (uint32_t addr, uint32_t len) {
+  int32_t status = 0;
+
+  if (((addr | len) & (SF_SECTOR_SIZE - 1U)) != 0U) {
+    return -1;
+  }
+  sfCacheInvalidate(addr, len);
+  while ((len != 0U) && (status == 0)) {
+    sfWriteEnable();
+    sfSelect();
+    sfCommand(SF_CMD_SE, addr);
+    sfDeselect();
+    status = sfWaitReady(SF_TIMEOUT_ERASE);
+    addr += SF_SECTOR_SIZE;
+    len  -= SF_SECTOR_SIZE;
+  }
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  Take the oldest request from the queue
+ *----------------------------------------------------------------------------*/
+static sfReq_t *sfDequeue (void) {
+  sfReq_t *req;
+  uint32_t lock = irqKernelLock();
+
+  req = sfHead;
+  if (req != NULL) {
+    sfHead = req->next;
+    if (sfHead == NULL) {
+      sfTail = NULL;
+    }
+    sfQueued--;
+  }
+  irqKernelUnlock(lock);
+  return req;
+}
+
+/*-----------------------------------------------------------------------------
+  sfThread: execute requests in order, prefetch while idle
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void sfThread (void *argument) {
+  sfReq_t *req;
+  int32_t  status;
+  (void)argument;
+
+  for (;;) {
+    req = sfDequeue();
+    if (req == NULL) {
+      if (sfAhead != 0xFFFFFFFFU) {
+        if (sfCacheFind(sfAhead) == NULL) {
+          if (sfCacheLoad(sfAhead) != NULL) {
+            sfStats.prefetches++;
+          }
+        }
+        sfAhead = 0xFFFFFFFFU;
+        continue;
+      }
+      osThreadFlagsWait(SF_FLAG_REQ, osFlagsWaitAny, osWaitForever);
+      continue;
+    }
+
+    switch (req->op) {
+      case SF_OP_READ:    status = sfDoRead(req->addr, req->buf, req->len);    break;
+      case SF_OP_PROGRAM: status = sfDoProgram(req->addr, req->buf, req->len); break;
+      case SF_OP_ERASE:   status = sfDoErase(req->addr, req->len);             break;
+      default:            status = -1;                                         break;
+    }
+    sfStats.requests++;
+    if (status != 0) {
+      sfStats.errors++;
+    }
+    if (req->cb != NULL) {
+      req->cb(req, status);
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Lowest clock profile at which the SPI clock reaches SF_SCK_HZ (prescaler 2)
+ *----------------------------------------------------------------------------*/
+static uint32_t sfGovMin (void) {
+  uint32_t profile;
+
+  for (profile = 0U; profile < (CLK_PROFILE_NUM - 1U); profile++) {
+    if ((pmGetPclkAt(PM_SSP1, clkProfileGetFreq(profile)) / 2U) >= SF_SCK_HZ) {
+      break;
+    }
+  }
+  return profile;
+}
+
+/*-----------------------------------------------------------------------------
+  Set the SPI clock for the current PCLK (even prescaler, at most SF_SCK_HZ)
+ *----------------------------------------------------------------------------*/
+static void sfSetClock (void) {
+  uint32_t pclk = pmGetPclk(PM_SSP1);
+  uint32_t div  = (pclk + SF_SCK_HZ - 1U) / SF_SCK_HZ;
+
+  div = (div < 2U) ? 2U : ((div + 1U) & ~1U);
+  SF_SSP->CPSR = (div > 254U) ? 254U : div;
+}
+
+static void sfClockNotify (uint32_t event, uint32_t cclk) {
+  (void)cclk;
+  if (event == CLK_EVENT_POST) {
+    sfSetClock();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Undo sfInit after a failure: DMA channels, SSP1 and the GPIO clock
+ *----------------------------------------------------------------------------*/
+static int32_t sfInitFail (void) {
+  if (sfDmaTx >= 0) {
+    dmaFree(sfDmaTx);
+    sfDmaTx = -1;
+  }
+  if (sfDmaRx >= 0) {
+    dmaFree(sfDmaRx);
+    sfDmaRx = -1;
+  }
+  SF_SSP->CR1 = 0U;
+  pmRelease(PM_GPIO);
+  pmRelease(PM_SSP1);
+  return -1;
+}
+
+/*-----------------------------------------------------------------------------
+  sfInit: set up SSP1 (SPI mode 0, 8 bit), DMA channels and the worker
+  Returns -1 if no device answers the JEDEC ID command or a resource is
+  missing; everything acquired up to that point is released again.
+ *----------------------------------------------------------------------------*/
+int32_t sfInit (void) {
+  uint8_t id[3];
+  uint32_t n;
+
+  if (pmAcquire(PM_SSP1, PM_PCLK_DIV1) != 0) {
+    return -1;
+  }
+  pmAcquire(PM_GPIO, PM_PCLK_ANY);
+  sfGovProfile = sfGovMin();
+
+  PIN_Configure(0U, 7U, PIN_FUNC_2, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // SCK1
+  PIN_Configure(0U, 8U, PIN_FUNC_2, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // MISO1
+  PIN_Configure(0U, 9U, PIN_FUNC_2, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // MOSI1
+  PIN_Configure(0U, 6U, PIN_FUNC_0, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);   // CS (GPIO)
+  LPC_GPIO0->FIOSET  = SF_CS_BIT;
+  LPC_GPIO0->FIODIR |= SF_CS_BIT;
+
+  SF_SSP->CR1 = 0U;
+  SF_SSP->CR0 = 0x07U;                  // 8 bit, SPI, CPOL = 0, CPHA = 0, SCR = 0
+  sfSetClock();
+  SF_SSP->CR1 = 0x02U;                  // Enable, master
+
+  sfSelect();
+  sfXfer(SF_CMD_RDID);
+  for (n = 0U; n < 3U; n++) {
+    id[n] = sfXfer(0xFFU);
+  }
+  sfDeselect();
+  if ((id[0] == 0x00U) || (id[0] == 0xFFU)) {
+    return sfInitFail();
+  }
+
+  sfDummy = 0xFFU;
+  sfDmaRx = dmaAlloc(DMA_PRIO_HIGH, DMA_REQ_SSP1_RX, sfDmaEvent, NULL);
+  sfDmaTx = dmaAlloc(DMA_PRIO_LOW,  DMA_REQ_SSP1_TX, NULL, NULL);
+  if ((sfDmaRx < 0) || (sfDmaTx < 0)) {
+    return sfInitFail();
+  }
+
+  sfThreadId = osThreadNew(sfThread, NULL, &spiflash_attr);
+  if (sfThreadId == NULL) {
+    return sfInitFail();
+  }
+
+  // Last: there is no way to remove a clock callback again
+  if (clkNotifyRegister(sfClockNotify) != 0) {
+    (void)osThreadTerminate(sfThreadId);
+    sfThreadId = NULL;
+    return sfInitFail();
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  sfSubmit: queue a request (thread or ISR context)
+ *----------------------------------------------------------------------------*/
+int32_t sfSubmit (sfReq_t *req) {
+  uint32_t lock;
+
+  if ((req == NULL) || (req->op > SF_OP_ERASE) || (sfThreadId == NULL)) {
+    return -1;
+  }
+  req->next = NULL;
+
+  lock = irqKernelLock();
+  if (sfTail != NULL) {
+    sfTail->next = req;
+  } else {
+    sfHead = req;
+  }
+  sfTail = req;
+  if (++sfQueued > sfStats.queue_max) {
+    sfStats.queue_max = sfQueued;
+  }
+  irqKernelUnlock(lock);
+
+  osThreadFlagsSet(sfThreadId, SF_FLAG_REQ);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  Blocking helpers (thread context, not from a request callback)
+ *----------------------------------------------------------------------------*/
+typedef struct {
+  osThreadId_t thread;
+  int32_t      status;
+} sfSync_t;
+
+static void sfSyncDone (sfReq_t *req, int32_t status) {
+  sfSync_t *sync = (sfSync_t *)req->arg;
+
+  sync->status = status;
+  osThreadFlagsSet(sync->thread, SF_FLAG_SYNC);
+}
+
+static int32_t sfSync (uint32_t op, uint32_t addr, void *buf, uint32_t len) {
+  sfReq_t  req;
+  sfSync_t sync;
+
+  sync.thread = osThreadGetId();
+  sync.status = -1;
+  req.buf     = buf;
+  req.addr    = addr;
+  req.len     = len;
+  req.op      = op;
+  req.cb      = sfSyncDone;
+  req.arg     = &sync;
+  if (sfSubmit(&req) != 0) {
+    return -1;
+  }
+  osThreadFlagsWait(SF_FLAG_SYNC, osFlagsWaitAny, osWaitForever);
+  return sync.status;
+}
+
+int32_t sfRead (uint32_t addr, void *buf, uint32_t len) {
+  return sfSync(SF_OP_READ, addr, buf, len);
+}
+
+int32_t sfProgram (uint32_t addr, const void *buf, uint32_t len) {
+  return sfSync(SF_OP_PROGRAM, addr, (void *)(uintptr_t)buf, len);
+}
+
+int32_t sfErase (uint32_t addr, uint32_t len) {
+  return sfSync(SF_OP_ERASE, addr, NULL, len);
+}
+
+/*-----------------------------------------------------------------------------
+  sfGetStats: get driver statistics
+ *----------------------------------------------------------------------------*/
+void sfGetStats (sfStats_t *stats) {
+  *stats = sfStats;
+}
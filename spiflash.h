@@ -0,0 +1,100 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    spiflash.h
+ * Purpose: Serial NOR flash on SSP1 with DMA reads and sector cache
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef SPIFLASH_H__
+#define SPIFLASH_H__
+
+#include <stdint.h>
+
+/*
+  Requests are queued and executed in order by the flash worker thread. The
+  callback runs in the worker thread when the request is finished.
+
+  Reads are served through a cache of SF_CACHE_LINES lines (least recently
+  used is replaced); the line following the last read is fetched while the
+  queue is empty. Line aligned reads of whole lines into AHB SRAM (__DMA_RAM)
+  bypass the cache and run as one DMA linked list transfer at the full SSP
+  clock.
+
+  Program and erase wait for the device in the worker thread (osDelay), so
+  other threads keep running. Lines covering modified areas are dropped.
+
+  Wiring (mbed): p5 MOSI P0.9, p6 MISO P0.8, p7 SCK P0.7, p8 CS P0.6 (GPIO).
+*/
+
+// SPI clock limit in Hz (SSP1 runs at PCLK / 2 at most)
+#ifndef SF_SCK_HZ
+#define SF_SCK_HZ               50000000U
+#endif
+
+// Cache geometry
+#ifndef SF_LINE_SIZE
+#define SF_LINE_SIZE            512U
+#endif
+#ifndef SF_CACHE_LINES
+#define SF_CACHE_LINES          8U
+#endif
+
+#define SF_PAGE_SIZE            256U    // Program granularity
+#define SF_SECTOR_SIZE          4096U   // Erase granularity
+
+// Request operations
+#define SF_OP_READ              0U
+#define SF_OP_PROGRAM           1U      // Area must be erased
+#define SF_OP_ERASE             2U      // Sector aligned address and length
+
+typedef struct sfReq_s sfReq_t;
+typedef void (*sfCallback_t) (sfReq_t *req, int32_t status);
+
+// Request (owned by the caller until the callback)
+struct sfReq_s {
+  sfReq_t      *next;                   // Queue link (internal)
+  uint8_t      *buf;                    // Data (read: destination)
+  uint32_t      addr;                   // Flash address
+  uint32_t      len;                    // Bytes
+  uint32_t      op;                     // SF_OP_xxx
+  sfCallback_t  cb;                     // Completion callback (may be NULL)
+  void         *arg;                    // Callback argument
+};
+
+// Statistics
+typedef struct {
+  uint32_t requests;                    // Completed requests
+  uint32_t errors;                      // Failed requests
+  uint32_t hits;                        // Cache line hits
+  uint32_t misses;                      // Cache line loads on demand
+  uint32_t prefetches;                  // Lines loaded ahead
+  uint32_t direct_bytes;                // Bytes read past the cache
+  uint32_t read_bytes;                  // Bytes transferred from the device
+  uint32_t read_us;                     // Time spent in DMA reads
+  uint32_t queue_max;                   // Most requests waiting
+} sfStats_t;
+
+/* Prototypes */
+extern int32_t sfInit     (void);
+extern int32_t sfSubmit   (sfReq_t *req);
+extern int32_t sfRead     (uint32_t addr, void *buf, uint32_t len);
+extern int32_t sfProgram  (uint32_t addr, const void *buf, uint32_t len);
+extern int32_t sfErase    (uint32_t addr, uint32_t len);
+extern void    sfGetStats (sfStats_t *stats);
+
+#endif
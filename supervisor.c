@@ -0,0 +1,233 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    supervisor.c
+ * Purpose: Thread deadline supervisor feeding the hardware watchdog
+ *----------------------------------------------------------------------------*/
+
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "supervisor.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "clock_tree.h"
+#include "irq_prio.h"
+#include "lowpower.h"
+#include "retained.h"
+
+// WDT counts PCLK_WDT with a fixed divide by 4
+#define SUP_WDT_TICKS_PER_MS    (CLK_BOOT_PCLK_WDT_HZ / 4U / 1000U)
+
+#if ((SUP_WDT_MS * SUP_WDT_TICKS_PER_MS) > 0xFFFFFFFFUL)
+#error "SUP_WDT_MS exceeds the WDT counter range"
+#endif
+#if (SUP_FEED_MS >= SUP_WDT_MS)
+#error "SUP_FEED_MS must be shorter than SUP_WDT_MS"
+#endif
+
+static supThread_t  supSlot[SUP_THREAD_MAX];
+static osThreadId_t supThreadId;
+static uint32_t     supTickFreq;
+
+__USED int32_t      supStalled = -1;    // Slot that starved the WDT (-1 = none)
+
+const osThreadAttr_t supervisor_attr = {.name = "Supervisor", .priority = osPriorityRealtime};
+
+/*-----------------------------------------------------------------------------
+  Conversion between ms and kernel ticks
+ *----------------------------------------------------------------------------*/
+static uint32_t supMsToTicks (uint32_t ms) {
+  return (uint32_t)(((uint64_t)ms * supTickFreq) / 1000U);
+}
+
+static uint32_t supTicksToMs (uint32_t ticks) {
+  return (uint32_t)(((uint64_t)ticks * 1000U) / supTickFreq);
+}
+
+/*-----------------------------------------------------------------------------
+  Feed the hardware watchdog (sequence must not be interleaved)
+ *----------------------------------------------------------------------------*/
+static void supWdtFeed (void) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  LPC_WDT->WDFEED = 0xAAU;
+  LPC_WDT->WDFEED = 0x55U;
+  __set_PRIMASK(primask);
+}
+
+/*-----------------------------------------------------------------------------
+  RTX thread watchdog expired: mark the thread late (SysTick context)
+ *----------------------------------------------------------------------------*/
+uint32_t osWatchdogAlarm_Handler (osThreadId_t thread_id) {
+  uint32_t n;
+
+  for (n = 0U; n < SUP_THREAD_MAX; n++) {
+    if (supSlot[n].thread == thread_id) {
+      supSlot[n].deadline = osKernelGetTickCount();
+      supSlot[n].late     = 1U;
+      supSlot[n].misses++;
+      break;
+    }
+  }
+  return 0U;                            // Re-armed by the next check-in
+}
+
+/*-----------------------------------------------------------------------------
+  supPolicy: find a thread late by more than grace ticks
+  Returns the slot index or -1 if all threads are healthy.
+ *----------------------------------------------------------------------------*/
+int32_t supPolicy (const supThread_t *threads, uint32_t num, uint32_t now, uint32_t grace) {
+  uint32_t n;
+
+  for (n = 0U; n < num; n++) {
+    if ((threads[n].thread != NULL) && (threads[n].late != 0U) &&
+        ((now - threads[n].deadline) > grace)) {
+      return (int32_t)n;
+    }
+  }
+  return -1;
+}
+
+/*-----------------------------------------------------------------------------
+  Record the stalled thread in the retained block before the WDT resets
+ *----------------------------------------------------------------------------*/
+static void supLog (int32_t id, uint32_t now) {
+  const char *name = osThreadGetName(supSlot[id].thread);
+  uint32_t    n    = 0U;
+
+  if (name != NULL) {
+    for (; (n < (sizeof(retBlock.wdt_thread) - 1U)) && (name[n] != '\0'); n++) {
+      retBlock.wdt_thread[n] = name[n];
+    }
+  }
+  retBlock.wdt_thread[n] = '\0';
+  retBlock.wdt_late_ms   = supTicksToMs(now - supSlot[id].deadline);
+  retCommit();
+}
+
+/*-----------------------------------------------------------------------------
+  supThread: feed the WDT while all supervised threads are healthy
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void supThread (void *argument) {
+  uint32_t next;
+  uint32_t now;
+  uint32_t grace;
+  int32_t  id;
+  (void)argument;
+
+  grace = supMsToTicks(SUP_GRACE_MS);
+  next  = osKernelGetTickCount();
+
+  for (;;) {
+    now   = osKernelGetTickCount();
+    next += supMsToTicks(SUP_FEED_MS);
+    if ((int32_t)(next - now) <= 0) {
+      next = now + supMsToTicks(SUP_FEED_MS);     // Woken late from deep sleep
+    }
+    osDelayUntil(next);
+
+    now = osKernelGetTickCount();
+    id  = supPolicy(supSlot, SUP_THREAD_MAX, now, grace);
+    if (id < 0) {
+      supWdtFeed();
+      continue;
+    }
+
+    // Stop feeding: the WDT resets within SUP_WDT_MS
+    supStalled = id;
+    supLog(id, now);
+    for (;;) {
+      osDelay(osWaitForever);
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  supInit: start the hardware watchdog and the supervisor thread
+ *----------------------------------------------------------------------------*/
+int32_t supInit (void) {
+  supTickFreq = osKernelGetTickFreq();
+
+  supThreadId = osThreadNew(supThread, NULL, &supervisor_attr);
+  if (supThreadId == NULL) {
+    return -1;
+  }
+  (void)lpDefer(supThreadId);           // WDT pauses in deep sleep as well
+
+  LPC_WDT->WDCLKSEL = 0x01U;            // PCLK_WDT (stops in deep sleep)
+  LPC_WDT->WDTC     = SUP_WDT_MS * SUP_WDT_TICKS_PER_MS;
+  LPC_WDT->WDMOD    = 0x03U;            // WDEN, WDRESET
+  supWdtFeed();                         // Start
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  supRegister: supervise the calling thread
+  period_ms: longest time between two supCheckIn calls
+  Returns the id for supCheckIn or -1 if no slot is free.
+ *----------------------------------------------------------------------------*/
+int32_t supRegister (uint32_t period_ms) {
+  osThreadId_t thread = osThreadGetId();
+  uint32_t     lock;
+  int32_t      id = -1;
+  uint32_t     n;
+
+  if ((thread == NULL) || (period_ms == 0U)) {
+    return -1;
+  }
+
+  lock = irqKernelLock();
+  for (n = 0U; n < SUP_THREAD_MAX; n++) {
+    if (supSlot[n].thread == NULL) {
+      supSlot[n].thread = thread;
+      supSlot[n].ticks  = supMsToTicks(period_ms);
+      id = (int32_t)n;
+      break;
+    }
+  }
+  irqKernelUnlock(lock);
+
+  if (id >= 0) {
+    osThreadFeedWatchdog(supSlot[id].ticks);
+  }
+  return id;
+}
+
+/*-----------------------------------------------------------------------------
+  supCheckIn: report progress of the calling thread (fast path)
+ *----------------------------------------------------------------------------*/
+void supCheckIn (int32_t id) {
+  supThread_t *slot;
+  uint32_t     late;
+
+  if (id < 0) {
+    return;
+  }
+  slot = &supSlot[id];
+  osThreadFeedWatchdog(slot->ticks);
+  if (slot->late != 0U) {
+    // Recovered within the grace period
+    late = osKernelGetTickCount() - slot->deadline;
+    if (late > slot->late_max) {
+      slot->late_max = late;
+    }
+    slot->late = 0U;
+  }
+}
@@ -0,0 +1,77 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    supervisor.h
+ * Purpose: Thread deadline supervisor feeding the hardware watchdog
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef SUPERVISOR_H__
+#define SUPERVISOR_H__
+
+#include <stdint.h>
+
+/*
+  Each supervised thread registers itself with its check-in period and then
+  calls supCheckIn at least once per period. Deadlines are monitored by the
+  RTX thread watchdog (osThreadFeedWatchdog). The supervisor thread feeds the
+  hardware WDT only while no thread is late by more than SUP_GRACE_MS; it
+  logs the offending thread in the retained block and lets the WDT reset.
+
+  The WDT counts the watchdog PCLK: the timeout is exact at 100 MHz, longer
+  at lower clock profiles, and the WDT pauses in deep sleep. The feed is
+  therefore not due while the system sleeps: the supervisor thread is
+  registered with lpDefer and does not keep the system out of deep sleep.
+*/
+
+// Maximum number of supervised threads
+#ifndef SUP_THREAD_MAX
+#define SUP_THREAD_MAX          8U
+#endif
+
+// Hardware watchdog timeout in ms
+#ifndef SUP_WDT_MS
+#define SUP_WDT_MS              1000U
+#endif
+
+// Supervisor (and WDT feed) period in ms
+#ifndef SUP_FEED_MS
+#define SUP_FEED_MS             100U
+#endif
+
+// Lateness tolerated before the watchdog is starved in ms
+#ifndef SUP_GRACE_MS
+#define SUP_GRACE_MS            200U
+#endif
+
+// Supervised thread state
+typedef struct {
+  void     *thread;                     // Thread ID (NULL = free slot)
+  uint32_t  ticks;                      // Check-in period in kernel ticks
+  uint32_t  deadline;                   // Tick of the missed deadline
+  uint32_t  late;                       // Deadline missed, not checked in yet
+  uint32_t  misses;                     // Missed deadlines (recovered or not)
+  uint32_t  late_max;                   // Worst recovered lateness in ticks
+} supThread_t;
+
+/* Prototypes */
+extern int32_t  supInit     (void);
+extern int32_t  supRegister (uint32_t period_ms);
+extern void     supCheckIn  (int32_t id);
+extern int32_t  supPolicy   (const supThread_t *threads, uint32_t num, uint32_t now, uint32_t grace);
+
+#endif
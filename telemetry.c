@@ -0,0 +1,311 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    telemetry.c
+ * Purpose: Telemetry channel registry with delta encoding and COBS framing
+ *----------------------------------------------------------------------------*/
+
+
+#include <string.h>
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "telemetry.h"
+
+#include "irq_prio.h"
+#include "timebase.h"
+
+#if (TM_PACKET_MAX < 64U)
+#error "TM_PACKET_MAX must be at least 64 bytes"
+#endif
+
+#define TM_NAME_MAX             32U     // Longest name in TM_PKT_DESC
+#define TM_RECORD_MAX           (5U + 1U + 3U + 1U + TM_NAME_MAX)
+
+static tmChannel_t *tmChannel[TM_CHANNEL_MAX];
+static uint32_t     tmChannelNum;
+static volatile uint32_t tmKeyNow;      // Send key packets on the next pass
+static tmSend_t     tmSend;
+static uint32_t     tmStart;            // Kernel ticks at tmInit
+
+// Packet under construction
+static uint8_t      tmRaw[TM_PACKET_MAX];
+static uint32_t     tmRawLen;
+static uint32_t     tmRawHdr;           // Header length (type, seq, time)
+static uint32_t     tmRawRecords;
+static uint8_t      tmSeq;
+
+// COBS output: one overhead byte per 254 data bytes and the delimiter
+static uint8_t      tmOut[TM_PACKET_MAX + (TM_PACKET_MAX / 254U) + 2U];
+static uint32_t     tmSendCycles;
+
+__USED tmStats_t    tmStats;            // Encoder statistics
+
+const osThreadAttr_t telemetry_attr = {.name = "Telemetry", .priority = osPriorityBelowNormal};
+
+/*-----------------------------------------------------------------------------
+  tmVarint: encode little-endian base 128, returns the length (1..5)
+ *----------------------------------------------------------------------------*/
+uint32_t tmVarint (uint8_t *dst, uint32_t val) {
+  uint32_t n = 0U;
+
+  while (val >= 0x80U) {
+    dst[n++] = (uint8_t)(val | 0x80U);
+    val    >>= 7;
+  }
+  dst[n++] = (uint8_t)val;
+  return n;
+}
+
+/*-----------------------------------------------------------------------------
+  tmCobsEncode: Consistent Overhead Byte Stuffing (no zero bytes in dst)
+  dst needs len + 1 + len / 254 bytes. Returns the encoded length.
+ *----------------------------------------------------------------------------*/
+uint32_t tmCobsEncode (const uint8_t *src, uint32_t len, uint8_t *dst) {
+  uint32_t code_pos = 0U;
+  uint32_t out      = 1U;
+  uint8_t  code     = 1U;
+  uint32_t n;
+
+  for (n = 0U; n < len; n++) {
+    if (src[n] != 0U) {
+      dst[out++] = src[n];
+      code++;
+    }
+    if ((src[n] == 0U) || (code == 0xFFU)) {
+      dst[code_pos] = code;
+      code_pos      = out++;
+      code          = 1U;
+    }
+  }
+  dst[code_pos] = code;
+  return out;
+}
+
+/*-----------------------------------------------------------------------------
+  Packet assembly
+ *----------------------------------------------------------------------------*/
+static void tmBegin (uint32_t type, uint32_t now) {
+  tmRaw[0]     = (uint8_t)type;
+  tmRawHdr     = 2U + tmVarint(&tmRaw[2], now);
+  tmRawLen     = tmRawHdr;
+  tmRawRecords = 0U;
+}
+
+static void tmFlush (void) {
+  uint32_t len;
+  uint32_t start;
+
+  if (tmRawRecords == 0U) {
+    return;
+  }
+  tmRaw[1] = tmSeq++;
+  len = tmCobsEncode(tmRaw, tmRawLen, tmOut);
+  tmOut[len++] = 0U;                    // Packet delimiter
+
+  if (tmSend != NULL) {
+    start = tbGetCycles();
+    if (tmSend(tmOut, len) != 0) {
+      tmStats.send_errors++;
+    }
+    tmSendCycles += tbGetCycles() - start;
+  }
+  tmStats.packets++;
+  tmStats.bytes += len;
+
+  // Continue with a packet of the same type and time
+  tmRawLen     = tmRawHdr;
+  tmRawRecords = 0U;
+}
+
+static void tmRecord (tmChannel_t *ch, const uint8_t *rec, uint32_t len) {
+  if ((tmRawLen + len) > TM_PACKET_MAX) {
+    tmFlush();
+  }
+  memcpy(&tmRaw[tmRawLen], rec, len);
+  tmRawLen += len;
+  tmRawRecords++;
+  ch->bytes += len;
+}
+
+/*-----------------------------------------------------------------------------
+  Read a channel value widened to 32 bits
+ *----------------------------------------------------------------------------*/
+static uint32_t tmSample (const tmChannel_t *ch) {
+  switch (ch->type) {
+    case TM_U8:  return *(const volatile uint8_t  *)ch->addr;
+    case TM_I8:  return (uint32_t)(int32_t)*(const volatile int8_t  *)ch->addr;
+    case TM_U16: return *(const volatile uint16_t *)ch->addr;
+    case TM_I16: return (uint32_t)(int32_t)*(const volatile int16_t *)ch->addr;
+    default:     return *(const volatile uint32_t *)ch->addr;   // 32 bit and float
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Encode channel descriptions
+ *----------------------------------------------------------------------------*/
+static void tmEncodeDesc (uint32_t now) {
+  uint8_t      rec[TM_RECORD_MAX];
+  tmChannel_t *ch;
+  uint32_t     name_len;
+  uint32_t     len;
+  uint32_t     n;
+
+  tmBegin(TM_PKT_DESC, now);
+  for (n = 0U; n < tmChannelNum; n++) {
+    ch       = tmChannel[n];
+    name_len = (uint32_t)strlen(ch->name);
+    if (name_len > TM_NAME_MAX) {
+      name_len = TM_NAME_MAX;
+    }
+    len        = tmVarint(rec, ch->id);
+    rec[len++] = ch->type;
+    len       += tmVarint(&rec[len], ch->period_ms);
+    rec[len++] = (uint8_t)name_len;
+    memcpy(&rec[len], ch->name, name_len);
+    tmRecord(ch, rec, len + name_len);
+  }
+  tmFlush();
+}
+
+/*-----------------------------------------------------------------------------
+  Encode values: all channels (key) or changed channels that are due
+ *----------------------------------------------------------------------------*/
+static void tmEncodeValues (uint32_t now, uint32_t key) {
+  uint8_t      rec[10];
+  tmChannel_t *ch;
+  uint32_t     value;
+  uint32_t     delta;
+  uint32_t     len;
+  uint32_t     n;
+
+  tmBegin((key != 0U) ? TM_PKT_KEY : TM_PKT_DATA, now);
+  for (n = 0U; n < tmChannelNum; n++) {
+    ch = tmChannel[n];
+    if ((key == 0U) && ((int32_t)(now - ch->due) < 0)) {
+      continue;
+    }
+    ch->due += ch->period_ms;
+    if ((int32_t)(now - ch->due) >= 0) {
+      ch->due = now + ch->period_ms;    // Fell behind: skip missed samples
+    }
+
+    value = tmSample(ch);
+    delta = (key != 0U) ? value : (value - ch->value);
+    if ((key == 0U) && (delta == 0U)) {
+      continue;                         // Unchanged
+    }
+    ch->value = value;
+
+    len  = tmVarint(rec, ch->id);
+    len += tmVarint(&rec[len], (delta << 1) ^ (uint32_t)((int32_t)delta >> 31));
+    tmRecord(ch, rec, len);
+  }
+  tmFlush();
+}
+
+/*-----------------------------------------------------------------------------
+  tmThread: sample and send channels every TM_TICK_MS
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void tmThread (void *argument) {
+  uint32_t tick = osKernelGetTickCount();
+  uint32_t key  = tick;
+  uint32_t now;
+  uint32_t cycles;
+  (void)argument;
+
+  for (;;) {
+    tick += TM_TICK_MS;
+    osDelayUntil(tick);
+    now = osKernelGetTickCount();
+
+    cycles       = tbGetCycles();
+    tmSendCycles = 0U;
+    if ((tmKeyNow != 0U) || ((int32_t)(now - key) >= 0)) {
+      tmKeyNow = 0U;
+      key      = now + TM_KEY_PERIOD;
+      tmEncodeDesc(now);
+      tmEncodeValues(now, 1U);
+    } else {
+      tmEncodeValues(now, 0U);
+    }
+    cycles = (tbGetCycles() - cycles) - tmSendCycles;
+
+    tmStats.passes++;
+    tmStats.cycles_sum += cycles;
+    if (cycles > tmStats.cycles_max) {
+      tmStats.cycles_max = cycles;
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  tmInit: start the encoder
+  send: byte transport (NULL: encode only, for bandwidth measurement)
+ *----------------------------------------------------------------------------*/
+int32_t tmInit (tmSend_t send) {
+  tmSend  = send;
+  tmStart = osKernelGetTickCount();
+  if (osThreadNew(tmThread, NULL, &telemetry_attr) == NULL) {
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  tmRegister: add a channel (thread context, before or after tmInit)
+  Returns the channel id or -1.
+ *----------------------------------------------------------------------------*/
+int32_t tmRegister (tmChannel_t *ch) {
+  uint32_t lock;
+  int32_t  id = -1;
+
+  if ((ch == NULL) || (ch->addr == NULL) || (ch->name == NULL) ||
+      (ch->type > TM_F32) || (ch->period_ms == 0U)) {
+    return -1;
+  }
+
+  lock = irqKernelLock();
+  if (tmChannelNum < TM_CHANNEL_MAX) {
+    ch->id    = (uint8_t)tmChannelNum;
+    ch->bytes = 0U;
+    tmChannel[tmChannelNum++] = ch;
+    id        = (int32_t)ch->id;
+  }
+  irqKernelUnlock(lock);
+
+  tmKeyNow = 1U;                        // Describe the new channel
+  return id;
+}
+
+/*-----------------------------------------------------------------------------
+  tmGetRate: average encoded bytes per second of a channel since tmInit
+ *----------------------------------------------------------------------------*/
+uint32_t tmGetRate (const tmChannel_t *ch) {
+  uint32_t elapsed = osKernelGetTickCount() - tmStart;
+
+  if (elapsed == 0U) {
+    return 0U;
+  }
+  return (uint32_t)(((uint64_t)ch->bytes * osKernelGetTickFreq()) / elapsed);
+}
+
+/*-----------------------------------------------------------------------------
+  tmGetStats: get encoder statistics
+ *----------------------------------------------------------------------------*/
+void tmGetStats (tmStats_t *stats) {
+  *stats = tmStats;
+}
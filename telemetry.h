@@ -0,0 +1,121 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    telemetry.h
+ * Purpose: Telemetry channel registry with delta encoding and COBS framing
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef TELEMETRY_H__
+#define TELEMETRY_H__
+
+#include <stdint.h>
+
+/*
+  Modules declare channels on variables and register them once:
+
+    static TM_CHANNEL(tm_led, "g_ledSet", &g_ledSet, TM_U32, 100U);
+    tmRegister(&tm_led);
+
+  The encoder thread samples every channel at its period and sends only
+  values that changed, as the difference to the last sent value. Every
+  TM_KEY_PERIOD ms all channels are sent with absolute values, preceded by
+  their descriptions, so a decoder can start at any point of the stream.
+
+  Packet (before COBS encoding, terminated by 0x00 on the wire):
+    type                        TM_PKT_xxx
+    seq                         packet counter (8 bit, gaps = lost)
+    time                        varint, kernel ticks (ms at OS_TICK_FREQ 1000)
+    TM_PKT_DATA, TM_PKT_KEY:    { varint id, varint zigzag(delta) } ...
+    TM_PKT_DESC:                { varint id, type, varint period_ms,
+                                  name length, name } ...
+  Varints are little-endian base 128. Deltas are computed modulo 2^32 on the
+  value widened to 32 bits (TM_F32: on the IEEE bit pattern). TM_PKT_KEY
+  deltas are relative to 0.
+
+  The host decoder is tools/tm_decode.c, tools/tm_dump prints the stream as
+  CSV or JSON.
+*/
+
+// Channel value types
+#define TM_U8                   0U
+#define TM_I8                   1U
+#define TM_U16                  2U
+#define TM_I16                  3U
+#define TM_U32                  4U
+#define TM_I32                  5U
+#define TM_F32                  6U
+
+// Packet types
+#define TM_PKT_DATA             0x01U   // Changed values (delta)
+#define TM_PKT_KEY              0x02U   // All values (absolute)
+#define TM_PKT_DESC             0x03U   // Channel descriptions
+
+#ifndef TM_CHANNEL_MAX
+#define TM_CHANNEL_MAX          32U
+#endif
+
+// Sample tick and key packet period in ms
+#ifndef TM_TICK_MS
+#define TM_TICK_MS              10U
+#endif
+#ifndef TM_KEY_PERIOD
+#define TM_KEY_PERIOD           5000U
+#endif
+
+// Largest packet before COBS encoding
+#ifndef TM_PACKET_MAX
+#define TM_PACKET_MAX           128U
+#endif
+
+// Byte transport (thread context), returns 0 or -1
+typedef int32_t (*tmSend_t) (const uint8_t *data, uint32_t len);
+
+// Channel (owned by the module, registered once)
+typedef struct {
+  const char          *name;            // Channel name
+  const volatile void *addr;            // Sampled variable
+  uint16_t             period_ms;       // Sample period
+  uint8_t              type;            // TM_xxx
+  uint8_t              id;              // Channel id (set by tmRegister)
+  uint32_t             due;             // Next sample time (internal)
+  uint32_t             value;           // Last sent value (internal)
+  uint32_t             bytes;           // Encoded bytes sent for this channel
+} tmChannel_t;
+
+#define TM_CHANNEL(var, name, addr, type, period_ms)                        \
+  tmChannel_t var = { (name), (addr), (uint16_t)(period_ms), (type), 0U, 0U, 0U, 0U }
+
+// Encoder statistics
+typedef struct {
+  uint32_t packets;                     // Packets sent
+  uint32_t bytes;                       // Bytes on the wire (COBS and delimiter)
+  uint32_t send_errors;                 // Packets rejected by the transport
+  uint32_t cycles_sum;                  // Encoder cycles (all passes)
+  uint32_t cycles_max;                  // Worst case cycles of one pass
+  uint32_t passes;                      // Encoder passes
+} tmStats_t;
+
+/* Prototypes */
+extern int32_t  tmInit       (tmSend_t send);
+extern int32_t  tmRegister   (tmChannel_t *ch);
+extern uint32_t tmGetRate    (const tmChannel_t *ch);
+extern void     tmGetStats   (tmStats_t *stats);
+extern uint32_t tmCobsEncode (const uint8_t *src, uint32_t len, uint8_t *dst);
+extern uint32_t tmVarint     (uint8_t *dst, uint32_t val);
+
+#endif
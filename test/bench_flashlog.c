@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    bench_flashlog.c
+ * Purpose: Host benchmark of the flash log engine on a RAM flash model
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "flashlog.h"
+
+/*
+  Appends records of a fixed size with a flush after each one (the writer
+  keeps up) and reports the engine cost per record on this host next to the
+  throughput the flash itself allows. The device bound uses typical serial
+  NOR timings: page program SIM_T_PP_US, sector erase SIM_T_SE_US, plus the
+  page transfer at SIM_SCK_HZ. Mount time is measured on a full log.
+*/
+#define SIM_BASE                0x100000U
+#define SIM_SEGS                256U            // 1 MiB
+#define SIM_SIZE                (SIM_SEGS * FL_SEG_SIZE)
+#define SIM_T_PP_US             700.0
+#define SIM_T_SE_US             45000.0
+#define SIM_SCK_HZ              50000000.0
+
+static uint8_t  simFlash[SIM_SIZE];
+static uint64_t simReadBytes;
+
+static int32_t simRead (uint32_t addr, void *buf, uint32_t len) {
+  memcpy(buf, &simFlash[addr - SIM_BASE], len);
+  simReadBytes += len;
+  return 0;
+}
+
+static int32_t simProgram (uint32_t addr, const void *buf, uint32_t len) {
+  const uint8_t *src = buf;
+  uint32_t       i;
+
+  for (i = 0U; i < len; i++) {
+    simFlash[addr - SIM_BASE + i] &= src[i];
+  }
+  return 0;
+}
+
+static int32_t simErase (uint32_t addr, uint32_t len) {
+  memset(&simFlash[addr - SIM_BASE], 0xFF, len);
+  return 0;
+}
+
+static const flOps_t simOps = { simRead, simProgram, simErase, NULL, NULL };
+
+static double nowNs (void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static void bench (uint32_t size, uint32_t num) {
+  uint8_t   rec[FL_RECORD_MAX];
+  flStats_t stats;
+  double    t0, append_ns, flash_us, mount_ns;
+  uint32_t  n;
+
+  memset(simFlash, 0xFF, SIM_SIZE);
+  if (flMount(&simOps, SIM_BASE, SIM_SEGS) != 0) {
+    return;
+  }
+  for (n = 0U; n < size; n++) {
+    rec[n] = (uint8_t)rand();
+  }
+
+  t0 = nowNs();
+  for (n = 0U; n < num; n++) {
+    rec[0] = (uint8_t)n;
+    (void)flAppend(rec, size);
+    (void)flFlush();
+  }
+  (void)flSync();
+  append_ns = (nowNs() - t0) / num;
+  flGetStats(&stats);
+
+  flash_us = (stats.pages * (SIM_T_PP_US + ((FL_PAGE_SIZE * 8.0 * 1e6) / SIM_SCK_HZ))) +
+             (stats.erases * SIM_T_SE_US);
+
+  simReadBytes = 0U;
+  t0 = nowNs();
+  (void)flMount(&simOps, SIM_BASE, SIM_SEGS);
+  mount_ns = nowNs() - t0;
+
+  printf("%3u byte records  append+flush ns %6.1f (%6.1f MB/s host)   flash bound %6.1f kB/s   "
+         "efficiency %5.1f%%   mount us %7.1f (%llu bytes read)\n",
+         size, append_ns, (size * 1e3) / append_ns, (size * (double)stats.appended * 1e3) / flash_us,
+         (100.0 * size * stats.appended) / ((double)stats.pages * FL_PAGE_SIZE),
+         mount_ns / 1e3, (unsigned long long)simReadBytes);
+}
+
+int main (void) {
+  srand(1U);
+  bench(8U,   400000U);
+  bench(32U,  200000U);
+  bench(100U, 100000U);
+  bench(FL_RECORD_MAX, 50000U);
+  return 0;
+}
@@ -0,0 +1,146 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    bench_net.c
+ * Purpose: Host benchmark of the network stack on the loopback MAC model
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "stubs.h"
+#include "net.h"
+#include "net_emac.h"
+#include "emac_loop.h"
+
+/*
+  Runs the benchmarks of net_emac.h without a target or a TAP device: the
+  stack and its network thread are the target code, the MAC is the loopback
+  model (stubs/emac_loop.c) whose wire takes no time. Per payload size:
+    - tx:   neBenchTx to the peer's discard port, zero-copy path
+    - rx:   datagrams to the discard port, the ring filled EMAC_RX_NUM at a
+            time (the copy into the ring stands in for the receive DMA)
+    - echo: one datagram to the echo port and its reply, round trip
+  next to the payload rate a 100 Mbit/s link allows (preamble, FCS and
+  inter-frame gap included). Host times show the cost of the stack per
+  frame, not the time on the Cortex-M3.
+*/
+#define SIM_IP                  NET_IP(192, 168, 1, 10)
+
+static const netConfig_t simCfg = {
+  { 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x10U }, SIM_IP, NET_IP(255, 255, 255, 0), LOOP_GW_IP
+};
+
+static uint8_t simData[NET_UDP_MAX];
+static uint8_t simFrame[EMAC_BUF_SIZE];
+
+static double nowNs (void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+// neBenchTx and the discard port measure with the host clock
+uint32_t tbGetUs (void) {
+  return (uint32_t)(uint64_t)(nowNs() / 1e3);
+}
+
+static double wireMbps (uint32_t len) {
+  uint32_t frame = NET_HDR_SIZE + len;
+
+  if (frame < 60U) {
+    frame = 60U;                        // Padded to the minimum frame
+  }
+  return (len * 8.0 * 100.0) / ((frame + 4U + 8U + 12U) * 8.0);
+}
+
+static void bench (uint32_t len, uint32_t num) {
+  neBench_t tx;
+  double    t0, rx_ns, echo_ns;
+  uint32_t  flen;
+  uint32_t  n, k;
+
+  // Transmit
+  if (neBenchTx(LOOP_PEER_IP, NE_DISCARD_PORT, len, num, &tx) != 0) {
+    printf("%4u byte datagrams  neBenchTx failed\n", len);
+    return;
+  }
+
+  // Receive (one frame built by the peer, then copied into the ring)
+  memcpy(simFrame, loopPeerUdp(SIM_IP, NE_DISCARD_PORT, 6000U, simData, len), NET_HDR_SIZE + len);
+  loopRun();
+  flen = NET_HDR_SIZE + len;
+  t0   = nowNs();
+  for (n = 0U; n < num; n += EMAC_RX_NUM) {
+    for (k = 0U; k < EMAC_RX_NUM; k++) {
+      (void)loopPeerRaw(simFrame, flen);
+    }
+    loopRun();
+  }
+  rx_ns = (nowNs() - t0) / n;
+
+  // Echo round trip
+  t0 = nowNs();
+  for (n = 0U; n < (num / 4U); n++) {
+    (void)loopPeerUdp(SIM_IP, NE_ECHO_PORT, 6000U, simData, len);
+    loopRun();
+  }
+  echo_ns = (nowNs() - t0) / n;
+
+  printf("%4u byte datagrams  tx ns %6.1f (%8.1f Mbit/s, %u busy)   rx ns %6.1f (%8.1f Mbit/s)   "
+         "echo ns %6.1f   100 Mbit/s link %5.1f Mbit/s\n",
+         len, (tx.us * 1e3) / tx.frames, tx.kbps / 1e3, tx.busy, rx_ns, (len * 8e3) / rx_ns,
+         echo_ns, wireMbps(len));
+}
+
+static void benchPing (uint32_t len, uint32_t num) {
+  double   t0;
+  uint32_t n;
+
+  t0 = nowNs();
+  for (n = 0U; n < num; n++) {
+    (void)loopPeerPing(SIM_IP, 1U, (uint16_t)n, simData, len);
+    loopRun();
+  }
+  printf("%4u byte ICMP echo  round trip ns %6.1f   %u replies\n",
+         len, (nowNs() - t0) / num, loopStats.icmp_replies);
+}
+
+int main (void) {
+  netStats_t s;
+  uint32_t   n;
+
+  srand(1U);
+  for (n = 0U; n < sizeof(simData); n++) {
+    simData[n] = (uint8_t)rand();
+  }
+  if (neStart(&simCfg) != 0) {
+    return 1;
+  }
+  bench(18U,   400000U);
+  bench(64U,   400000U);
+  bench(256U,  200000U);
+  bench(1024U, 100000U);
+  bench(NET_UDP_MAX, 100000U);
+  benchPing(56U, 200000U);
+
+  netGetStats(&s);
+  printf("stack  rx %u frames, %u drops   tx %u frames, %u busy, %u ARP misses\n",
+         s.rx_frames, s.rx_drops, s.tx_frames, s.tx_busy, s.arp_misses);
+  return (s.rx_drops == 0U) ? 0 : 1;
+}
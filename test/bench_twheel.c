@@ -0,0 +1,187 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    bench_twheel.c
+ * Purpose: Host benchmark of the timer wheel against the osTimer algorithm
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "stubs.h"
+#include "twheel.h"
+
+extern void RIT_IRQHandler (void);
+
+/*
+  RTX5 keeps its timers in one list sorted by expiry where every entry holds
+  the delta to its predecessor (osRtxTimerInsert/osRtxTimerTick): starting a
+  timer walks the list, a tick only decrements the head. This is a faithful
+  model of that list, run on the same host so both costs are comparable.
+  The first expiry is one tick later than osTimerStart, as in twStart
+  (twheel.h), so both must expire exactly the same number of timers.
+*/
+typedef struct rtxTimer_s {
+  struct rtxTimer_s *next;
+  struct rtxTimer_s *prev;
+  uint32_t           tick;
+  uint32_t           load;
+  uint32_t           active;
+} rtxTimer_t;
+
+static rtxTimer_t *rtxList;
+
+static void rtxInsert (rtxTimer_t *timer, uint32_t tick) {
+  rtxTimer_t *prev = NULL;
+  rtxTimer_t *next = rtxList;
+
+  while (next != NULL) {
+    if (tick < next->tick) {
+      next->tick -= tick;
+      break;
+    }
+    tick -= next->tick;
+    prev  = next;
+    next  = next->next;
+  }
+  timer->tick = tick;
+  timer->prev = prev;
+  timer->next = next;
+  if (next != NULL) {
+    next->prev = timer;
+  }
+  if (prev != NULL) {
+    prev->next = timer;
+  } else {
+    rtxList = timer;
+  }
+  timer->active = 1U;
+}
+
+static void rtxRemove (rtxTimer_t *timer) {
+  if (timer->next != NULL) {
+    timer->next->tick += timer->tick;
+    timer->next->prev  = timer->prev;
+  }
+  if (timer->prev != NULL) {
+    timer->prev->next = timer->next;
+  } else {
+    rtxList = timer->next;
+  }
+  timer->active = 0U;
+}
+
+static uint32_t rtxFired;
+
+static void rtxTick (void) {
+  rtxTimer_t *timer = rtxList;
+
+  if (timer == NULL) {
+    return;
+  }
+  timer->tick--;
+  while ((timer != NULL) && (timer->tick == 0U)) {
+    rtxRemove(timer);
+    rtxFired++;
+    if (timer->load != 0U) {
+      rtxInsert(timer, timer->load);
+    }
+    timer = rtxList;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Benchmark
+ *----------------------------------------------------------------------------*/
+#define TIMER_MAX               1000U
+#define TICKS                   100000U
+
+static twTimer_t  twT[TIMER_MAX];
+static rtxTimer_t rtxT[TIMER_MAX];
+static uint32_t   period[TIMER_MAX];
+static uint32_t   twFired;
+
+static void twCallback (void *arg) {
+  (void)arg;
+  twFired++;
+}
+
+static double nowNs (void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static int32_t bench (uint32_t num) {
+  double   t0, start_tw, tick_tw, start_rtx, tick_rtx;
+  uint32_t n;
+
+  for (n = 0U; n < num; n++) {
+    period[n] = 10U + ((uint32_t)rand() % 5000U);
+  }
+
+  // Timer wheel
+  t0 = nowNs();
+  for (n = 0U; n < num; n++) {
+    twTimerInit(&twT[n], twCallback, NULL, TW_CONTEXT_ISR);
+    twStart(&twT[n], period[n], period[n]);
+  }
+  start_tw = (nowNs() - t0) / num;
+  twFired = 0U;
+  t0 = nowNs();
+  for (n = 0U; n < TICKS; n++) {
+    RIT_IRQHandler();
+  }
+  tick_tw = (nowNs() - t0) / TICKS;
+  for (n = 0U; n < num; n++) {
+    twStop(&twT[n]);
+  }
+
+  // osTimer model
+  rtxList = NULL;
+  t0 = nowNs();
+  for (n = 0U; n < num; n++) {
+    rtxT[n].load = period[n];
+    rtxInsert(&rtxT[n], period[n] + 1U);  // First expiry as twStart (twheel.h)
+  }
+  start_rtx = (nowNs() - t0) / num;
+  rtxFired = 0U;
+  t0 = nowNs();
+  for (n = 0U; n < TICKS; n++) {
+    rtxTick();
+  }
+  tick_rtx = (nowNs() - t0) / TICKS;
+  for (n = 0U; n < num; n++) {
+    rtxRemove(&rtxT[n]);
+  }
+
+  printf("%5u timers  start ns: wheel %7.1f  osTimer %7.1f   tick ns: wheel %7.1f  osTimer %8.1f   expired %u/%u\n",
+         num, start_tw, start_rtx, tick_tw, tick_rtx, twFired, rtxFired);
+  return (twFired == rtxFired) ? 0 : -1;
+}
+
+int main (void) {
+  srand(1U);
+  if (twInit() != 0) {
+    return 1;
+  }
+  if ((bench(10U) != 0) || (bench(100U) != 0) || (bench(1000U) != 0)) {
+    printf("wheel and osTimer model expired a different number of timers\n");
+    return 1;
+  }
+  return 0;
+}
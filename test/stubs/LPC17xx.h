@@ -0,0 +1,71 @@
+/* Host stand-in for LPC17xx.h used by the unit tests (test/Makefile) */
+#ifndef LPC17XX_STUB
+#define __ASM __asm
+#define LPC17XX_STUB
+#include <stdint.h>
+#include <stddef.h>
+#define __I volatile const
+#define __O volatile
+#define __IO volatile
+#define __IM volatile const
+#define __OM volatile
+#define __IOM volatile
+#define __USED __attribute__((used))
+#define __NO_RETURN __attribute__((noreturn))
+#define __WEAK __attribute__((weak))
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#define __PACKED_STRUCT struct __attribute__((packed))
+#define __NVIC_PRIO_BITS 5
+typedef enum { NonMaskableInt_IRQn=-14, HardFault_IRQn=-13, MemoryManagement_IRQn=-12, BusFault_IRQn=-11, UsageFault_IRQn=-10, SVCall_IRQn=-5, DebugMonitor_IRQn=-4, PendSV_IRQn=-2, SysTick_IRQn=-1,
+ WDT_IRQn=0, TIMER0_IRQn, TIMER1_IRQn, TIMER2_IRQn, TIMER3_IRQn, UART0_IRQn, UART1_IRQn, UART2_IRQn, UART3_IRQn, PWM1_IRQn, I2C0_IRQn, I2C1_IRQn, I2C2_IRQn, SPI_IRQn, SSP0_IRQn, SSP1_IRQn, PLL0_IRQn, RTC_IRQn, EINT0_IRQn, EINT1_IRQn, EINT2_IRQn, EINT3_IRQn, ADC_IRQn, BOD_IRQn, USB_IRQn, CAN_IRQn, DMA_IRQn, I2S_IRQn, ENET_IRQn, RIT_IRQn, MCPWM_IRQn, QEI_IRQn, PLL1_IRQn, USBActivity_IRQn, CANActivity_IRQn } IRQn_Type;
+uint32_t __LDREXW(volatile uint32_t*); uint32_t __STREXW(uint32_t, volatile uint32_t*); void __CLREX(void);
+uint16_t __LDREXH(volatile uint16_t*); uint32_t __STREXH(uint16_t, volatile uint16_t*);
+uint8_t __LDREXB(volatile uint8_t*); uint32_t __STREXB(uint8_t, volatile uint8_t*);
+void __disable_irq(void); void __enable_irq(void); uint32_t __get_PRIMASK(void); void __set_PRIMASK(uint32_t);
+uint32_t __get_BASEPRI(void); void __set_BASEPRI(uint32_t); uint32_t __get_IPSR(void); uint32_t __get_MSP(void); uint32_t __get_PSP(void); uint32_t __get_CONTROL(void);
+void __WFI(void); void __WFE(void); void __SEV(void); void __DSB(void); void __ISB(void); void __DMB(void); void __NOP(void); uint32_t __CLZ(uint32_t); uint32_t __RBIT(uint32_t); uint32_t __REV(uint32_t); uint32_t __REV16(uint32_t);
+void NVIC_EnableIRQ(IRQn_Type); void NVIC_DisableIRQ(IRQn_Type); void NVIC_SetPriority(IRQn_Type, uint32_t); uint32_t NVIC_GetPriority(IRQn_Type); void NVIC_ClearPendingIRQ(IRQn_Type); void NVIC_SetPendingIRQ(IRQn_Type); uint32_t NVIC_GetPendingIRQ(IRQn_Type);
+void NVIC_SetPriorityGrouping(uint32_t); uint32_t NVIC_GetPriorityGrouping(void); uint32_t NVIC_EncodePriority(uint32_t,uint32_t,uint32_t); __NO_RETURN void NVIC_SystemReset(void);
+typedef struct { __IO uint32_t CTRL, CYCCNT, CPICNT, EXCCNT, SLEEPCNT, LSUCNT, FOLDCNT; } DWT_Type;
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+typedef struct { __IO uint32_t CTRL, LOAD, VAL; __I uint32_t CALIB; } SysTick_Type;
+typedef struct { __I uint32_t CPUID; __IO uint32_t ICSR, VTOR, AIRCR, SCR, CCR; __IO uint8_t SHP[12]; __IO uint32_t SHCSR, CFSR, HFSR, DFSR, MMFAR, BFAR, AFSR; } SCB_Type;
+typedef struct { __IOM uint32_t ISER[8]; uint32_t r0[24]; __IOM uint32_t ICER[8]; uint32_t r1[24]; __IOM uint32_t ISPR[8]; uint32_t r2[24]; __IOM uint32_t ICPR[8]; uint32_t r3[24]; __IOM uint32_t IABR[8]; uint32_t r4[56]; __IOM uint8_t IP[240]; } NVIC_Type;
+extern DWT_Type *DWT; extern CoreDebug_Type *CoreDebug; extern SysTick_Type *SysTick; extern SCB_Type *SCB; extern NVIC_Type *NVIC;
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL<<24)
+#define DWT_CTRL_CYCCNTENA_Msk 1UL
+#define SysTick_CTRL_ENABLE_Msk 1UL
+#define SysTick_CTRL_TICKINT_Msk 2UL
+#define SysTick_CTRL_CLKSOURCE_Msk 4UL
+#define SysTick_CTRL_COUNTFLAG_Msk (1UL<<16)
+#define SCB_SCR_SLEEPDEEP_Msk 4UL
+#define SCB_ICSR_VECTACTIVE_Msk 0x1FFUL
+#define SCB_SHCSR_USGFAULTENA_Msk (1UL<<18)
+#define SCB_SHCSR_BUSFAULTENA_Msk (1UL<<17)
+#define SCB_SHCSR_MEMFAULTENA_Msk (1UL<<16)
+#define SCB_CCR_DIV_0_TRP_Msk (1UL<<4)
+extern uint32_t SystemCoreClock; void SystemCoreClockUpdate(void); void SystemInit(void);
+typedef struct { __IO uint32_t FLASHCFG; uint32_t r0[31]; __IO uint32_t PLL0CON, PLL0CFG; __I uint32_t PLL0STAT; __O uint32_t PLL0FEED; uint32_t r1[4]; __IO uint32_t PLL1CON, PLL1CFG; __I uint32_t PLL1STAT; __O uint32_t PLL1FEED; uint32_t r2[4]; __IO uint32_t PCON, PCONP; uint32_t r3[15]; __IO uint32_t CCLKCFG, USBCLKCFG, CLKSRCSEL, CANSLEEPCLR, CANWAKEFLAGS; uint32_t r4[10]; __IO uint32_t EXTINT; uint32_t r5; __IO uint32_t EXTMODE, EXTPOLAR; uint32_t r6[12]; __IO uint32_t RSID; uint32_t r7[7]; __IO uint32_t SCS, IRCTRIM, PCLKSEL0, PCLKSEL1; uint32_t r8[4]; __IO uint32_t USBIntSt, DMAREQSEL, CLKOUTCFG; } LPC_SC_TypeDef;
+typedef struct { __IO uint32_t IR, TCR, TC, PR, PC, MCR, MR0, MR1, MR2, MR3, CCR; __I uint32_t CR0, CR1; uint32_t r[2]; __IO uint32_t EMR; uint32_t r2[12]; __IO uint32_t CTCR; } LPC_TIM_TypeDef;
+typedef struct { __IO uint32_t RICOMPVAL, RIMASK; __IO uint8_t RICTRL; uint8_t r[3]; __IO uint32_t RICOUNTER; } LPC_RIT_TypeDef;
+typedef struct { union { __I uint8_t RBR; __O uint8_t THR; __IO uint8_t DLL; uint32_t r0; }; union { __IO uint8_t DLM; __IO uint32_t IER; }; union { __I uint32_t IIR; __O uint8_t FCR; }; __IO uint8_t LCR; uint8_t r1[7]; __I uint8_t LSR; uint8_t r2[7]; __IO uint8_t SCR; uint8_t r3[3]; __IO uint32_t ACR; __IO uint8_t ICR; uint8_t r4[3]; __IO uint8_t FDR; uint8_t r5[7]; __IO uint8_t TER; } LPC_UART_TypeDef;
+typedef struct { __I uint32_t DMACIntStat, DMACIntTCStat; __O uint32_t DMACIntTCClear; __I uint32_t DMACIntErrStat; __O uint32_t DMACIntErrClr; __I uint32_t DMACRawIntTCStat, DMACRawIntErrStat, DMACEnbldChns; __IO uint32_t DMACSoftBReq, DMACSoftSReq, DMACSoftLBReq, DMACSoftLSReq, DMACConfig, DMACSync; } LPC_GPDMA_TypeDef;
+typedef struct { __IO uint32_t DMACCSrcAddr, DMACCDestAddr, DMACCLLI, DMACCControl, DMACCConfig; } LPC_GPDMACH_TypeDef;
+typedef struct { __IO uint32_t CR0, CR1, DR; __I uint32_t SR; __IO uint32_t CPSR, IMSC, RIS, MIS; __O uint32_t ICR; __IO uint32_t DMACR; } LPC_SSP_TypeDef;
+typedef struct { __IO uint32_t I2CONSET; __I uint32_t I2STAT; __IO uint32_t I2DAT, I2ADR0, I2SCLH, I2SCLL; __O uint32_t I2CONCLR; } LPC_I2C_TypeDef;
+typedef struct { __IO uint32_t MOD; __O uint32_t CMR; __IO uint32_t GSR; __I uint32_t ICR; __IO uint32_t IER, BTR, EWL; __I uint32_t SR; __IO uint32_t RFS, RID, RDA, RDB, TFI1, TID1, TDA1, TDB1, TFI2, TID2, TDA2, TDB2, TFI3, TID3, TDA3, TDB3; } LPC_CAN_TypeDef;
+typedef struct { __IO uint32_t AFMR, SFF_sa, SFF_GRP_sa, EFF_sa, EFF_GRP_sa, ENDofTable; __I uint32_t LUTerrAd, LUTerr; __IO uint32_t FCANIE, FCANIC0, FCANIC1; } LPC_CANAF_TypeDef;
+typedef struct { __IO uint32_t mask[512]; } LPC_CANAF_RAM_TypeDef;
+typedef struct { __I uint32_t CANTxSR, CANRxSR, CANMSR; } LPC_CANCR_TypeDef;
+typedef struct { __IO uint8_t WDMOD; uint8_t r0[3]; __IO uint32_t WDTC; __O uint8_t WDFEED; uint8_t r1[3]; __I uint32_t WDTV; __IO uint32_t WDCLKSEL; } LPC_WDT_TypeDef;
+typedef struct { __IO uint8_t ILR; uint8_t r0[7]; __IO uint8_t CCR; uint8_t r1[3]; __IO uint8_t CIIR; uint8_t r2[3]; __IO uint8_t AMR; uint8_t r3[3]; __I uint32_t CTIME0, CTIME1, CTIME2; __IO uint8_t SEC; uint8_t r4[3]; __IO uint8_t MIN; uint8_t r5[3]; __IO uint8_t HOUR; uint8_t r6[3]; __IO uint8_t DOM; uint8_t r7[3]; __IO uint8_t DOW; uint8_t r8[3]; __IO uint16_t DOY; uint16_t r9; __IO uint8_t MONTH; uint8_t r10[3]; __IO uint16_t YEAR; uint16_t r11; __IO uint32_t CALIBRATION, GPREG0, GPREG1, GPREG2, GPREG3, GPREG4; __IO uint8_t RTC_AUXEN; uint8_t r12[3]; __IO uint8_t RTC_AUX; uint8_t r13[3]; __IO uint8_t ALSEC; uint8_t r14[3]; __IO uint8_t ALMIN; uint8_t r15[3]; __IO uint8_t ALHOUR; uint8_t r16[3]; __IO uint8_t ALDOM; uint8_t r17[3]; __IO uint8_t ALDOW; uint8_t r18[3]; __IO uint16_t ALDOY; uint16_t r19; __IO uint8_t ALMON; uint8_t r20[3]; __IO uint16_t ALYEAR; } LPC_RTC_TypeDef;
+typedef struct { __IO uint32_t MAC1, MAC2, IPGT, IPGR, CLRT, MAXF, SUPP, TEST, MCFG, MCMD, MADR; __O uint32_t MWTD; __I uint32_t MRDD, MIND; uint32_t r0[2]; __IO uint32_t SA0, SA1, SA2; uint32_t r1[45]; __IO uint32_t Command; __I uint32_t Status; __IO uint32_t RxDescriptor, RxStatus, RxDescriptorNumber; __I uint32_t RxProduceIndex; __IO uint32_t RxConsumeIndex, TxDescriptor, TxStatus, TxDescriptorNumber, TxProduceIndex; __I uint32_t TxConsumeIndex; uint32_t r2[10]; __I uint32_t TSV0, TSV1, RSV; uint32_t r3[3]; __IO uint32_t FlowControlCounter; __I uint32_t FlowControlStatus; uint32_t r4[34]; __IO uint32_t RxFilterCtrl; __I uint32_t RxFilterWoLStatus; __O uint32_t RxFilterWoLClear; uint32_t r5; __IO uint32_t HashFilterL, HashFilterH; uint32_t r6[882]; __I uint32_t IntStatus; __IO uint32_t IntEnable; __O uint32_t IntClear, IntSet; uint32_t r7; __IO uint32_t PowerDown; } LPC_EMAC_TypeDef;
+extern LPC_SC_TypeDef *LPC_SC; extern LPC_TIM_TypeDef *LPC_TIM0, *LPC_TIM1, *LPC_TIM2, *LPC_TIM3; extern LPC_RIT_TypeDef *LPC_RIT;
+typedef LPC_UART_TypeDef LPC_UART0_TypeDef; extern LPC_UART0_TypeDef *LPC_UART0; extern LPC_UART_TypeDef *LPC_UART2, *LPC_UART3; extern LPC_GPDMA_TypeDef *LPC_GPDMA; extern LPC_GPDMACH_TypeDef *LPC_GPDMACH0;
+extern LPC_SSP_TypeDef *LPC_SSP0, *LPC_SSP1; extern LPC_I2C_TypeDef *LPC_I2C0, *LPC_I2C1, *LPC_I2C2; extern LPC_CAN_TypeDef *LPC_CAN1, *LPC_CAN2; extern LPC_CANAF_TypeDef *LPC_CANAF; extern LPC_CANAF_RAM_TypeDef *LPC_CANAF_RAM; extern LPC_CANCR_TypeDef *LPC_CANCR;
+extern LPC_WDT_TypeDef *LPC_WDT; extern LPC_RTC_TypeDef *LPC_RTC; extern LPC_EMAC_TypeDef *LPC_EMAC;
+#define LPC_GPDMACH0_BASE 0x50004100UL
+typedef struct { __IO uint32_t FIODIR; uint32_t r0[3]; __IO uint32_t FIOMASK, FIOPIN, FIOSET; __O uint32_t FIOCLR; } LPC_GPIO_TypeDef; extern LPC_GPIO_TypeDef *LPC_GPIO0, *LPC_GPIO1, *LPC_GPIO2;
+#endif
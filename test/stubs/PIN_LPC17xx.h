@@ -0,0 +1,13 @@
+/* Host stand-in for PIN_LPC17xx.h used by the unit tests (test/Makefile) */
+#include <stdint.h>
+#define PIN_FUNC_0 0U
+#define PIN_FUNC_1 1U
+#define PIN_FUNC_2 2U
+#define PIN_FUNC_3 3U
+#define PIN_PINMODE_PULLUP 0U
+#define PIN_PINMODE_REPEATER 1U
+#define PIN_PINMODE_TRISTATE 2U
+#define PIN_PINMODE_PULLDOWN 3U
+#define PIN_PINMODE_NORMAL 0U
+#define PIN_PINMODE_OPENDRAIN 1U
+extern int32_t PIN_Configure (uint8_t port, uint8_t pin, uint8_t function, uint8_t mode, uint8_t open_drain);
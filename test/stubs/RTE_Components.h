@@ -0,0 +1,2 @@
+/* Host stand-in for RTE_Components.h used by the unit tests (test/Makefile) */
+#define CMSIS_device_header "LPC17xx.h"
@@ -0,0 +1,42 @@
+/* Host stand-in for cmsis_os2.h used by the unit tests (test/Makefile) */
+#ifndef CMSIS_OS2_H_
+#define CMSIS_OS2_H_
+#include <stdint.h>
+#include <stddef.h>
+typedef void *osThreadId_t; typedef void *osTimerId_t; typedef void *osEventFlagsId_t; typedef void *osMutexId_t; typedef void *osSemaphoreId_t; typedef void *osMessageQueueId_t;
+typedef enum { osOK=0, osError=-1, osErrorTimeout=-2, osErrorResource=-3, osErrorParameter=-4 } osStatus_t;
+typedef void (*osThreadFunc_t)(void*); typedef void (*osTimerFunc_t)(void*);
+typedef enum {osTimerOnce=0, osTimerPeriodic=1} osTimerType_t;
+typedef enum {osPriorityNone=0, osPriorityIdle=1, osPriorityLow=8, osPriorityBelowNormal=16, osPriorityNormal=24, osPriorityAboveNormal=32, osPriorityHigh=40, osPriorityRealtime=48, osPriorityISR=56} osPriority_t;
+typedef struct { const char *name; uint32_t attr_bits; void *cb_mem; uint32_t cb_size; void *stack_mem; uint32_t stack_size; osPriority_t priority; uint32_t tz_module; uint32_t reserved;} osThreadAttr_t;
+typedef struct { const char *name; uint32_t attr_bits; void *cb_mem; uint32_t cb_size;} osTimerAttr_t;
+typedef struct { const char *name; uint32_t attr_bits; void *cb_mem; uint32_t cb_size;} osEventFlagsAttr_t;
+typedef struct { const char *name; uint32_t attr_bits; void *cb_mem; uint32_t cb_size;} osMutexAttr_t;
+#define osWaitForever 0xFFFFFFFFU
+#define osFlagsWaitAny 0U
+#define osFlagsWaitAll 1U
+#define osFlagsNoClear 2U
+#define osFlagsError 0x80000000U
+osThreadId_t osThreadNew(osThreadFunc_t, void*, const osThreadAttr_t*);
+uint32_t osThreadFlagsWait(uint32_t, uint32_t, uint32_t);
+uint32_t osThreadFlagsSet(osThreadId_t, uint32_t);
+uint32_t osKernelGetTickCount(void);
+uint32_t osKernelGetTickFreq(void);
+uint32_t osKernelGetSysTimerCount(void);
+uint32_t osKernelGetSysTimerFreq(void);
+int32_t osKernelLock(void); int32_t osKernelUnlock(void); int32_t osKernelRestoreLock(int32_t);
+uint32_t osKernelSuspend(void); void osKernelResume(uint32_t);
+osStatus_t osDelay(uint32_t); osStatus_t osDelayUntil(uint32_t);
+osThreadId_t osThreadGetId(void); const char *osThreadGetName(osThreadId_t);
+osStatus_t osThreadFeedWatchdog(uint32_t);
+osTimerId_t osTimerNew(osTimerFunc_t, osTimerType_t, void*, const osTimerAttr_t*);
+osStatus_t osTimerStart(osTimerId_t, uint32_t); osStatus_t osTimerStop(osTimerId_t);
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t*);
+uint32_t osEventFlagsSet(osEventFlagsId_t, uint32_t); uint32_t osEventFlagsWait(osEventFlagsId_t,uint32_t,uint32_t,uint32_t);
+osMutexId_t osMutexNew(const osMutexAttr_t*); osStatus_t osMutexAcquire(osMutexId_t,uint32_t); osStatus_t osMutexRelease(osMutexId_t);
+uint32_t osWatchdogAlarm_Handler(osThreadId_t);
+uint32_t osThreadFlagsClear(uint32_t);
+void osThreadExit(void) __attribute__((noreturn)); osStatus_t osThreadTerminate(osThreadId_t);
+osStatus_t osThreadYield(void); osStatus_t osEventFlagsDelete(osEventFlagsId_t); osStatus_t osMutexDelete(osMutexId_t);
+#define osMutexPrioInherit 0x02U
+#endif
@@ -0,0 +1,9 @@
+/* Host stand-in for cmsis_vio.h used by the unit tests (test/Makefile) */
+#include <stdint.h>
+#define vioLED0 1U
+#define vioLED1 2U
+#define vioLED2 4U
+#define vioLED3 8U
+#define vioLEDon 0xFFU
+#define vioLEDoff 0U
+void vioInit(void); void vioSetSignal(uint32_t,uint32_t); uint32_t vioGetSignal(uint32_t);
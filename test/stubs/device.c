@@ -0,0 +1,145 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    device.c
+ * Purpose: Host model of the LPC1768 registers and core intrinsics
+ *----------------------------------------------------------------------------*/
+
+#include "LPC17xx.h"
+
+/*
+  Peripheral registers are plain memory: a test writes status registers
+  before calling the driver and inspects control registers afterwards.
+*/
+#define STUB_REG(type, name)    static type name##_reg; type *name = &name##_reg
+
+STUB_REG(DWT_Type,              DWT);
+STUB_REG(CoreDebug_Type,        CoreDebug);
+STUB_REG(SysTick_Type,          SysTick);
+STUB_REG(SCB_Type,              SCB);
+STUB_REG(NVIC_Type,             NVIC);
+STUB_REG(LPC_SC_TypeDef,        LPC_SC);
+STUB_REG(LPC_TIM_TypeDef,       LPC_TIM0);
+STUB_REG(LPC_TIM_TypeDef,       LPC_TIM1);
+STUB_REG(LPC_TIM_TypeDef,       LPC_TIM2);
+STUB_REG(LPC_TIM_TypeDef,       LPC_TIM3);
+STUB_REG(LPC_RIT_TypeDef,       LPC_RIT);
+STUB_REG(LPC_UART0_TypeDef,     LPC_UART0);
+STUB_REG(LPC_UART_TypeDef,      LPC_UART2);
+STUB_REG(LPC_UART_TypeDef,      LPC_UART3);
+STUB_REG(LPC_GPDMA_TypeDef,     LPC_GPDMA);
+STUB_REG(LPC_GPDMACH_TypeDef,   LPC_GPDMACH0);
+STUB_REG(LPC_SSP_TypeDef,       LPC_SSP0);
+STUB_REG(LPC_SSP_TypeDef,       LPC_SSP1);
+STUB_REG(LPC_I2C_TypeDef,       LPC_I2C0);
+STUB_REG(LPC_I2C_TypeDef,       LPC_I2C1);
+STUB_REG(LPC_I2C_TypeDef,       LPC_I2C2);
+STUB_REG(LPC_CAN_TypeDef,       LPC_CAN1);
+STUB_REG(LPC_CAN_TypeDef,       LPC_CAN2);
+STUB_REG(LPC_CANAF_TypeDef,     LPC_CANAF);
+STUB_REG(LPC_CANAF_RAM_TypeDef, LPC_CANAF_RAM);
+STUB_REG(LPC_CANCR_TypeDef,     LPC_CANCR);
+STUB_REG(LPC_WDT_TypeDef,       LPC_WDT);
+STUB_REG(LPC_RTC_TypeDef,       LPC_RTC);
+STUB_REG(LPC_EMAC_TypeDef,      LPC_EMAC);
+STUB_REG(LPC_GPIO_TypeDef,      LPC_GPIO0);
+STUB_REG(LPC_GPIO_TypeDef,      LPC_GPIO1);
+STUB_REG(LPC_GPIO_TypeDef,      LPC_GPIO2);
+
+__WEAK uint32_t SystemCoreClock = 100000000U;
+
+__WEAK void SystemCoreClockUpdate (void) {}
+__WEAK void SystemInit (void) {}
+
+/*-----------------------------------------------------------------------------
+  Core intrinsics (single threaded host: exclusive stores always succeed)
+ *----------------------------------------------------------------------------*/
+static uint32_t stubPrimask;
+static uint32_t stubBasepri;
+
+uint32_t __LDREXW (volatile uint32_t *addr)               { return *addr; }
+uint32_t __STREXW (uint32_t value, volatile uint32_t *addr) { *addr = value; return 0U; }
+uint16_t __LDREXH (volatile uint16_t *addr)               { return *addr; }
+uint32_t __STREXH (uint16_t value, volatile uint16_t *addr) { *addr = value; return 0U; }
+uint8_t  __LDREXB (volatile uint8_t *addr)                { return *addr; }
+uint32_t __STREXB (uint8_t value, volatile uint8_t *addr)   { *addr = value; return 0U; }
+void     __CLREX  (void) {}
+
+void     __disable_irq  (void)           { stubPrimask = 1U; }
+void     __enable_irq   (void)           { stubPrimask = 0U; }
+uint32_t __get_PRIMASK  (void)           { return stubPrimask; }
+void     __set_PRIMASK  (uint32_t value) { stubPrimask = value; }
+uint32_t __get_BASEPRI  (void)           { return stubBasepri; }
+void     __set_BASEPRI  (uint32_t value) { stubBasepri = value; }
+uint32_t __get_IPSR     (void)           { return 0U; }
+uint32_t __get_MSP      (void)           { return 0U; }
+uint32_t __get_PSP      (void)           { return 0U; }
+uint32_t __get_CONTROL  (void)           { return 0U; }
+
+__WEAK void __WFI (void) {}
+void __WFE (void) {}
+void __SEV (void) {}
+void __DSB (void) {}
+void __ISB (void) {}
+void __DMB (void) {}
+void __NOP (void) {}
+
+uint32_t __CLZ (uint32_t value) {
+  return (value == 0U) ? 32U : (uint32_t)__builtin_clz(value);
+}
+
+uint32_t __RBIT (uint32_t value) {
+  uint32_t result = 0U;
+  uint32_t n;
+
+  for (n = 0U; n < 32U; n++) {
+    result = (result << 1) | ((value >> n) & 1U);
+  }
+  return result;
+}
+
+uint32_t __REV   (uint32_t value) { return __builtin_bswap32(value); }
+uint32_t __REV16 (uint32_t value) {
+  return ((value & 0xFF00FF00U) >> 8) | ((value & 0x00FF00FFU) << 8);
+}
+
+/*-----------------------------------------------------------------------------
+  NVIC (priorities and pending state are recorded, nothing is dispatched)
+ *----------------------------------------------------------------------------*/
+static uint8_t stubNvicPrio[64];
+static uint8_t stubNvicPend[64];
+static uint8_t stubNvicEna[64];
+
+void     NVIC_EnableIRQ        (IRQn_Type irq)                { stubNvicEna[irq & 63]  = 1U; }
+void     NVIC_DisableIRQ       (IRQn_Type irq)                { stubNvicEna[irq & 63]  = 0U; }
+void     NVIC_SetPriority      (IRQn_Type irq, uint32_t prio) { stubNvicPrio[irq & 63] = (uint8_t)prio; }
+uint32_t NVIC_GetPriority      (IRQn_Type irq)                { return stubNvicPrio[irq & 63]; }
+void     NVIC_ClearPendingIRQ  (IRQn_Type irq)                { stubNvicPend[irq & 63] = 0U; }
+void     NVIC_SetPendingIRQ    (IRQn_Type irq)                { stubNvicPend[irq & 63] = 1U; }
+uint32_t NVIC_GetPendingIRQ    (IRQn_Type irq)                { return stubNvicPend[irq & 63]; }
+void     NVIC_SetPriorityGrouping (uint32_t group)            { (void)group; }
+uint32_t NVIC_GetPriorityGrouping (void)                      { return 0U; }
+
+uint32_t NVIC_EncodePriority (uint32_t group, uint32_t preempt, uint32_t sub) {
+  (void)group;
+  (void)sub;
+  return preempt;
+}
+
+void NVIC_SystemReset (void) {
+  for (;;) {}
+}
@@ -0,0 +1,352 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    emac_loop.c
+ * Purpose: Host loopback model of the Ethernet MAC with a scripted peer
+ *----------------------------------------------------------------------------*/
+
+#include <setjmp.h>
+#include <string.h>
+#include "LPC17xx.h"
+#include "cmsis_os2.h"
+#include "stubs.h"
+#include "emac_loop.h"
+
+#define LOOP_ETH_HDR            14U
+#define LOOP_IP_HDR             20U
+
+const uint8_t loopPeerMac[6] = { 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x02U };
+const uint8_t loopGwMac[6]   = { 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U };
+uint8_t       loopStackMac[6];
+uint8_t       loopTxFrame[EMAC_BUF_SIZE];
+uint32_t      loopTxLen;
+uint32_t      loopTxStall;
+uint32_t      loopArpOff;
+loopStats_t   loopStats;
+
+static uint8_t     loopRx[EMAC_RX_NUM][EMAC_BUF_SIZE];
+static uint32_t    loopRxLen[EMAC_RX_NUM];
+static uint32_t    loopRxHead;          // Next frame for emacRxGet
+static uint32_t    loopRxCount;
+static uint16_t    loopIpId;
+static emacStats_t loopEmacStats;
+static jmp_buf     loopIdle;
+static uint32_t    loopInThread;
+
+static const uint8_t loopBroadcast[6] = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+
+/*-----------------------------------------------------------------------------
+  Network byte order
+ *----------------------------------------------------------------------------*/
+static uint32_t loopGet16 (const uint8_t *p) {
+  return ((uint32_t)p[0] << 8) | p[1];
+}
+
+static uint32_t loopGet32 (const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void loopPut16 (uint8_t *p, uint32_t val) {
+  p[0] = (uint8_t)(val >> 8);
+  p[1] = (uint8_t)val;
+}
+
+static void loopPut32 (uint8_t *p, uint32_t val) {
+  loopPut16(&p[0], val >> 16);
+  loopPut16(&p[2], val);
+}
+
+// Internet checksum, 0 over a block that includes a valid checksum
+uint32_t loopChecksum (const uint8_t *p, uint32_t len) {
+  uint32_t sum = 0U;
+
+  for (; len > 1U; len -= 2U, p += 2U) {
+    sum += loopGet16(p);
+  }
+  if (len != 0U) {
+    sum += (uint32_t)p[0] << 8;
+  }
+  while ((sum >> 16) != 0U) {
+    sum = (sum & 0xFFFFU) + (sum >> 16);
+  }
+  return (~sum) & 0xFFFFU;
+}
+
+/*-----------------------------------------------------------------------------
+  Peer: frames into the receive ring
+ *----------------------------------------------------------------------------*/
+static uint8_t *loopRxPut (uint32_t len) {
+  uint8_t *frame;
+
+  if ((loopRxCount == EMAC_RX_NUM) || (len > EMAC_BUF_SIZE)) {
+    loopEmacStats.rx_overruns++;
+    return NULL;
+  }
+  frame = loopRx[(loopRxHead + loopRxCount) % EMAC_RX_NUM];
+  loopRxLen[(loopRxHead + loopRxCount) % EMAC_RX_NUM] = len;
+  loopRxCount++;
+  return frame;
+}
+
+uint8_t *loopPeerRaw (const uint8_t *frame, uint32_t len) {
+  uint8_t *rx = loopRxPut(len);
+
+  if (rx != NULL) {
+    memcpy(rx, frame, len);
+  }
+  return rx;
+}
+
+static void loopEthHeader (uint8_t *frame, const uint8_t *dst, const uint8_t *src, uint32_t type) {
+  memcpy(&frame[0], dst, 6U);
+  memcpy(&frame[6], src, 6U);
+  loopPut16(&frame[12], type);
+}
+
+static void loopArpBuild (uint8_t *frame, uint32_t op, const uint8_t *sha, uint32_t spa,
+                          const uint8_t *tha, uint32_t tpa) {
+  uint8_t *arp = &frame[LOOP_ETH_HDR];
+
+  loopEthHeader(frame, (op == 1U) ? loopBroadcast : tha, sha, 0x0806U);
+  loopPut16(&arp[0], 1U);
+  loopPut16(&arp[2], 0x0800U);
+  arp[4] = 6U;
+  arp[5] = 4U;
+  loopPut16(&arp[6], op);
+  memcpy(&arp[8], sha, 6U);
+  loopPut32(&arp[14], spa);
+  memcpy(&arp[18], tha, 6U);
+  loopPut32(&arp[24], tpa);
+}
+
+// ARP request (op 1) or unsolicited reply (op 2) from the peer to the stack
+uint8_t *loopPeerArp (uint32_t op, uint32_t tpa) {
+  uint8_t *frame = loopRxPut(LOOP_ETH_HDR + 28U);
+
+  if (frame != NULL) {
+    loopArpBuild(frame, op, loopPeerMac, LOOP_PEER_IP, loopStackMac, tpa);
+  }
+  return frame;
+}
+
+static uint8_t *loopPeerIp (uint32_t dst_ip, uint32_t proto, uint32_t len) {
+  uint8_t *frame = loopRxPut(LOOP_ETH_HDR + LOOP_IP_HDR + len);
+  uint8_t *ip;
+
+  if (frame == NULL) {
+    return NULL;
+  }
+  if ((dst_ip & 0xFFU) == 0xFFU) {        // Broadcast on the /24 of the peer
+    loopEthHeader(frame, loopBroadcast, loopPeerMac, 0x0800U);
+  } else {
+    loopEthHeader(frame, loopStackMac, loopPeerMac, 0x0800U);
+  }
+  ip    = &frame[LOOP_ETH_HDR];
+  ip[0] = 0x45U;
+  ip[1] = 0U;
+  loopPut16(&ip[2], LOOP_IP_HDR + len);
+  loopPut16(&ip[4], loopIpId++);
+  loopPut16(&ip[6], 0x4000U);           // Don't fragment
+  ip[8] = 64U;
+  ip[9] = (uint8_t)proto;
+  loopPut16(&ip[10], 0U);
+  loopPut32(&ip[12], LOOP_PEER_IP);
+  loopPut32(&ip[16], dst_ip);
+  loopPut16(&ip[10], loopChecksum(ip, LOOP_IP_HDR));
+  return frame;
+}
+
+uint8_t *loopPeerUdp (uint32_t dst_ip, uint16_t dst_port, uint16_t src_port, const void *data, uint32_t len) {
+  uint8_t *frame = loopPeerIp(dst_ip, 17U, 8U + len);
+  uint8_t *udp;
+
+  if (frame != NULL) {
+    udp = &frame[LOOP_ETH_HDR + LOOP_IP_HDR];
+    loopPut16(&udp[0], src_port);
+    loopPut16(&udp[2], dst_port);
+    loopPut16(&udp[4], 8U + len);
+    loopPut16(&udp[6], 0U);
+    if (data != NULL) {
+      memcpy(&udp[8], data, len);
+    }
+  }
+  return frame;
+}
+
+uint8_t *loopPeerPing (uint32_t dst_ip, uint16_t id, uint16_t seq, const void *data, uint32_t len) {
+  uint8_t *frame = loopPeerIp(dst_ip, 1U, 8U + len);
+  uint8_t *icmp;
+
+  if (frame != NULL) {
+    icmp    = &frame[LOOP_ETH_HDR + LOOP_IP_HDR];
+    icmp[0] = 8U;                       // Echo request
+    icmp[1] = 0U;
+    loopPut16(&icmp[2], 0U);
+    loopPut16(&icmp[4], id);
+    loopPut16(&icmp[6], seq);
+    memcpy(&icmp[8], data, len);
+    loopPut16(&icmp[2], loopChecksum(icmp, 8U + len));
+  }
+  return frame;
+}
+
+uint32_t loopRxPending (void) {
+  return loopRxCount;
+}
+/*-----------------------------------------------------------------------------
+  Peer: frame sent by the stack
+ *----------------------------------------------------------------------------*/
+static void loopPeerArpInput (const uint8_t *arp) {
+  const uint8_t *mac;
+  uint8_t       *frame;
+  uint32_t       tpa = loopGet32(&arp[24]);
+
+  if (loopGet16(&arp[6]) != 1U) {
+    loopStats.arp_replies++;
+    return;
+  }
+  if (tpa == LOOP_PEER_IP) {
+    mac = loopPeerMac;
+  } else if (tpa == LOOP_GW_IP) {
+    mac = loopGwMac;
+  } else {
+    return;
+  }
+  if (loopArpOff != 0U) {
+    return;
+  }
+  frame = loopRxPut(LOOP_ETH_HDR + 28U);
+  if (frame != NULL) {
+    loopStats.arp_requests++;
+    loopArpBuild(frame, 2U, mac, tpa, &arp[8], loopGet32(&arp[14]));
+  }
+}
+
+static void loopPeerIpInput (const uint8_t *ip, uint32_t len) {
+  uint32_t tlen = loopGet16(&ip[2]);
+
+  if ((len < LOOP_IP_HDR) || (ip[0] != 0x45U) || (tlen > len) || (loopChecksum(ip, LOOP_IP_HDR) != 0U)) {
+    loopStats.bad++;
+    return;
+  }
+  if ((ip[9] == 17U) && (tlen >= (LOOP_IP_HDR + 8U))) {
+    loopStats.udp_frames++;
+    loopStats.udp_bytes += loopGet16(&ip[LOOP_IP_HDR + 4U]) - 8U;
+  } else if ((ip[9] == 1U) && (ip[LOOP_IP_HDR] == 0U)) {
+    loopStats.icmp_replies++;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  MAC driver (emac.h)
+ *----------------------------------------------------------------------------*/
+int32_t emacInit (const uint8_t *mac) {
+  memcpy(loopStackMac, mac, 6U);
+  memset(&loopEmacStats, 0, sizeof(loopEmacStats));
+  memset(&loopStats, 0, sizeof(loopStats));
+  loopRxHead  = 0U;
+  loopRxCount = 0U;
+  loopTxLen   = 0U;
+  return 0;
+}
+
+uint32_t emacLinkPoll (void) {
+  return EMAC_LINK_UP | EMAC_LINK_100M | EMAC_LINK_FULL;
+}
+
+// Network thread only: an empty ring ends loopRun
+uint8_t *emacRxGet (uint32_t *len, uint32_t timeout) {
+  (void)timeout;
+
+  if (loopRxCount == 0U) {
+    if (loopInThread != 0U) {
+      longjmp(loopIdle, 1);
+    }
+    return NULL;
+  }
+  *len = loopRxLen[loopRxHead];
+  loopEmacStats.rx_frames++;
+  loopEmacStats.rx_bytes += *len;
+  return loopRx[loopRxHead];
+}
+
+void emacRxRelease (void) {
+  loopRxHead = (loopRxHead + 1U) % EMAC_RX_NUM;
+  loopRxCount--;
+}
+
+uint8_t *emacTxAlloc (void) {
+  if (loopTxStall != 0U) {
+    loopTxStall--;
+    loopEmacStats.tx_full++;
+    return NULL;
+  }
+  return loopTxFrame;
+}
+
+// The wire is instant: the peer sees the frame before emacTxSend returns
+int32_t emacTxSend (uint32_t len) {
+  if ((len == 0U) || (len > (EMAC_BUF_SIZE - 4U))) {
+    return -1;
+  }
+  loopTxLen = len;
+  loopEmacStats.tx_frames++;
+  loopEmacStats.tx_bytes += len;
+
+  if (memcmp(loopTxFrame, loopBroadcast, 6U) == 0) {
+    loopStats.broadcasts++;
+  }
+  if (len >= LOOP_ETH_HDR) {
+    switch (loopGet16(&loopTxFrame[12])) {
+      case 0x0806U:
+        if (len >= (LOOP_ETH_HDR + 28U)) {
+          loopPeerArpInput(&loopTxFrame[LOOP_ETH_HDR]);
+        }
+        break;
+      case 0x0800U:
+        loopPeerIpInput(&loopTxFrame[LOOP_ETH_HDR], len - LOOP_ETH_HDR);
+        break;
+      default:
+        break;
+    }
+  }
+  return 0;
+}
+
+void emacGetStats (emacStats_t *stats) {
+  *stats = loopEmacStats;
+}
+
+/*-----------------------------------------------------------------------------
+  Network thread (the last thread created, see neStart)
+ *----------------------------------------------------------------------------*/
+void loopRun (void) {
+  if ((loopInThread != 0U) || (stubThreadNum == 0U)) {
+    return;
+  }
+  loopInThread = 1U;
+  if (setjmp(loopIdle) == 0) {
+    stubThreadFunc[stubThreadNum - 1U](NULL);
+  }
+  loopInThread = 0U;
+}
+
+osStatus_t osDelay (uint32_t ticks) {
+  stubTick += ticks;
+  loopRun();
+  return osOK;
+}
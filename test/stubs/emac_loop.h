@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    emac_loop.h
+ * Purpose: Host loopback model of the Ethernet MAC with a scripted peer
+ *----------------------------------------------------------------------------*/
+
+#ifndef EMAC_LOOP_H__
+#define EMAC_LOOP_H__
+
+#include <stdint.h>
+#include "emac.h"
+#include "net.h"
+
+/*
+  Replaces emac.c for the host build of the network stack, no TAP device
+  needed. Frames sent by the stack end in one transmit buffer where the
+  peer parses them: ARP requests for the peer or the gateway are answered
+  into the receive ring, everything else is counted in loopStats and left
+  in loopTxFrame for the test to inspect. Frames from the peer are built
+  into the receive ring by the loopPeer* functions (the returned frame may
+  be edited before it is received) and processed by loopRun, which runs
+  the network thread until the ring is empty. osDelay does the same, as
+  the network thread would run while the caller sleeps.
+*/
+
+#define LOOP_PEER_IP            NET_IP(192, 168, 1, 2)
+#define LOOP_GW_IP              NET_IP(192, 168, 1, 1)
+
+typedef struct {
+  uint32_t arp_requests;                // Answered (peer or gateway)
+  uint32_t arp_replies;                 // From the stack
+  uint32_t udp_frames;
+  uint32_t udp_bytes;                   // UDP payload bytes
+  uint32_t icmp_replies;
+  uint32_t broadcasts;                  // Destination MAC ff:ff:ff:ff:ff:ff
+  uint32_t bad;                         // IPv4 header checksum or length wrong
+} loopStats_t;
+
+extern const uint8_t loopPeerMac[6];
+extern const uint8_t loopGwMac[6];
+extern uint8_t       loopStackMac[6];   // From emacInit
+extern uint8_t       loopTxFrame[EMAC_BUF_SIZE];  // Last frame sent by the stack
+extern uint32_t      loopTxLen;
+extern uint32_t      loopTxStall;       // emacTxAlloc calls to fail (ring full)
+extern uint32_t      loopArpOff;        // Peer ignores ARP requests
+extern loopStats_t   loopStats;
+
+/* Prototypes */
+extern uint8_t *loopPeerRaw  (const uint8_t *frame, uint32_t len);
+extern uint8_t *loopPeerArp  (uint32_t op, uint32_t tpa);
+extern uint8_t *loopPeerUdp  (uint32_t dst_ip, uint16_t dst_port, uint16_t src_port, const void *data, uint32_t len);
+extern uint8_t *loopPeerPing (uint32_t dst_ip, uint16_t id, uint16_t seq, const void *data, uint32_t len);
+extern uint32_t loopRxPending(void);
+extern void     loopRun      (void);
+extern uint32_t loopChecksum (const uint8_t *p, uint32_t len);
+
+#endif
@@ -0,0 +1,220 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    i2c_slave.c
+ * Purpose: Host model of the I2C1 master interface and a register slave
+ *----------------------------------------------------------------------------*/
+
+#include "i2c_slave.h"
+
+// I2CONSET / I2CONCLR bits
+#define SIM_CON_AA              0x04U
+#define SIM_CON_SI              0x08U
+#define SIM_CON_STO             0x10U
+#define SIM_CON_STA             0x20U
+#define SIM_CON_EN              0x40U
+
+// Bus phase of the model
+#define SIM_IDLE                0U      // Bus free
+#define SIM_ADDR                1U      // Start sent, address byte expected
+#define SIM_WRITE               2U      // Slave receiving
+#define SIM_READ                3U      // Slave sending
+#define SIM_HOLD                4U      // Bus owned, waiting for start or stop
+
+extern void I2C1_IRQHandler (void);
+
+uint8_t       simI2cMem[256];
+uint32_t      simI2cNackAfter;
+simI2cStats_t simI2cStats;
+
+static LPC_I2C_TypeDef simReg;
+static uint32_t simCon;                 // Control state (EN, STA, STO, SI, AA)
+static uint32_t simPhase;
+static uint32_t simDat;                 // Byte written by the driver
+static uint32_t simDatNew;
+static uint32_t simFault;
+static uint32_t simCount;               // Data bytes in the current segment
+static uint8_t  simPtr;                 // Slave register pointer
+
+/*-----------------------------------------------------------------------------
+  Fold the register writes of the driver into the model
+ *----------------------------------------------------------------------------*/
+static void simLatch (void) {
+  if (simReg.I2CONSET != 0U) {
+    simCon |= simReg.I2CONSET;
+    simReg.I2CONSET = 0U;
+  }
+  if (simReg.I2CONCLR != 0U) {
+    simCon &= ~simReg.I2CONCLR;
+    if ((simReg.I2CONCLR & SIM_CON_EN) != 0U) {
+      simPhase = SIM_IDLE;              // Interface reset releases the bus
+      simI2cStats.resets++;
+    }
+    simReg.I2CONCLR = 0U;
+  }
+  if (simReg.I2DAT <= 0xFFU) {
+    simDat    = simReg.I2DAT;
+    simDatNew = 1U;
+    simReg.I2DAT = 0x100U | simDat;
+  }
+}
+
+static void simStatus (uint32_t stat) {
+  *(volatile uint32_t *)&simReg.I2STAT = stat;
+  simCon |= SIM_CON_SI;
+}
+
+/*-----------------------------------------------------------------------------
+  Register access of the driver
+ *----------------------------------------------------------------------------*/
+LPC_I2C_TypeDef *simI2c (void) {
+  simLatch();
+  return &simReg;
+}
+
+void simI2cFault (uint32_t fault) {
+  simFault = fault;
+}
+
+/*-----------------------------------------------------------------------------
+  One bus event; returns 0 if the bus waits for the driver or is stalled
+ *----------------------------------------------------------------------------*/
+static uint32_t simEvent (void) {
+  uint32_t byte;
+
+  simLatch();
+  if (((simCon & SIM_CON_EN) == 0U) || ((simCon & SIM_CON_SI) != 0U) ||
+      (simFault == SIM_I2C_STALL)) {
+    return 0U;
+  }
+  if ((simFault == SIM_I2C_BUS_ERROR) && (simPhase != SIM_IDLE)) {
+    simFault = SIM_I2C_OK;
+    simPhase = SIM_HOLD;
+    simStatus(0x00U);
+    return 1U;
+  }
+
+  if ((simCon & SIM_CON_STO) != 0U) {
+    simCon &= ~SIM_CON_STO;             // Cleared by the hardware
+    if (simPhase != SIM_IDLE) {
+      simI2cStats.stops++;
+    }
+    simPhase = SIM_IDLE;
+    if ((simCon & SIM_CON_STA) == 0U) {
+      return 1U;
+    }
+  }
+  if ((simCon & SIM_CON_STA) != 0U) {
+    if (simPhase == SIM_IDLE) {
+      simI2cStats.starts++;
+      simStatus(0x08U);
+    } else {
+      simI2cStats.restarts++;
+      simStatus(0x10U);
+    }
+    simPhase  = SIM_ADDR;
+    simDatNew = 0U;
+    return 1U;
+  }
+
+  switch (simPhase) {
+    case SIM_ADDR:
+      if (simDatNew == 0U) {
+        return 0U;
+      }
+      simDatNew = 0U;
+      simCount  = 0U;
+      if (simFault == SIM_I2C_ARB_LOST) {
+        simFault = SIM_I2C_OK;
+        simPhase = SIM_IDLE;            // Other master owns the bus
+        simStatus(0x38U);
+      } else if ((simDat >> 1) != SIM_I2C_ADDR) {
+        simPhase = SIM_HOLD;
+        simStatus(((simDat & 1U) != 0U) ? 0x48U : 0x20U);
+      } else if ((simDat & 1U) != 0U) {
+        simPhase = SIM_READ;
+        simStatus(0x40U);
+      } else {
+        simPhase = SIM_WRITE;
+        simStatus(0x18U);
+      }
+      return 1U;
+
+    case SIM_WRITE:
+      if (simDatNew == 0U) {
+        return 0U;
+      }
+      simDatNew = 0U;
+      if (simCount++ == 0U) {
+        simPtr = (uint8_t)simDat;
+      } else {
+        simI2cMem[simPtr++] = (uint8_t)simDat;
+      }
+      simI2cStats.tx_bytes++;
+      if ((simI2cNackAfter != 0U) && (simCount >= simI2cNackAfter)) {
+        simPhase = SIM_HOLD;
+        simStatus(0x30U);
+      } else {
+        simStatus(0x28U);
+      }
+      return 1U;
+
+    case SIM_READ:
+      byte = simI2cMem[simPtr++];
+      simReg.I2DAT = 0x100U | byte;
+      simI2cStats.rx_bytes++;
+      if ((simCon & SIM_CON_AA) != 0U) {
+        simStatus(0x50U);
+      } else {
+        simPhase = SIM_HOLD;            // Master NACKed the last byte
+        simStatus(0x58U);
+      }
+      return 1U;
+
+    default:
+      return 0U;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  simI2cRun: up to events bus events, the interrupt handler runs in between
+  Returns the number of events that took place.
+ *----------------------------------------------------------------------------*/
+uint32_t simI2cRun (uint32_t events) {
+  uint32_t n = 0U;
+
+  for (;;) {
+    simLatch();
+    if ((simCon & SIM_CON_SI) != 0U) {
+      I2C1_IRQHandler();
+      continue;
+    }
+    if ((n == events) || (simEvent() == 0U)) {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+/*-----------------------------------------------------------------------------
+  simI2cIdle: bus released and no interrupt pending
+ *----------------------------------------------------------------------------*/
+uint32_t simI2cIdle (void) {
+  simLatch();
+  return ((simPhase == SIM_IDLE) && ((simCon & (SIM_CON_SI | SIM_CON_STA)) == 0U)) ? 1U : 0U;
+}
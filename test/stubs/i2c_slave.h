@@ -0,0 +1,69 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    i2c_slave.h
+ * Purpose: Host model of the I2C1 master interface and a register slave
+ *----------------------------------------------------------------------------*/
+
+#ifndef I2C_SLAVE_H__
+#define I2C_SLAVE_H__
+
+#include <stdint.h>
+#include "LPC17xx.h"
+
+/*
+  The Makefile builds i2c_engine.c with I2C_REG = simI2c(), so every
+  register access of the driver passes the model first. simI2c folds the
+  I2CONSET / I2CONCLR writes into the control state and latches a byte
+  written to I2DAT (bytes for the driver are left with bit 8 set, so a new
+  write is always seen).
+
+  simI2cRun advances the bus by one event at a time (start, address, data
+  byte, stop) and calls I2C1_IRQHandler while SI is set, like the NVIC.
+  The slave at SIM_I2C_ADDR is a register bank: the first byte written
+  sets the register pointer, further bytes write, reads continue from the
+  pointer. Faults are injected through simI2cFault before the next event.
+*/
+
+#define SIM_I2C_ADDR            0x1DU
+
+// Fault injection (simI2cFault)
+#define SIM_I2C_OK              0U
+#define SIM_I2C_ARB_LOST        1U      // Next address byte loses arbitration
+#define SIM_I2C_BUS_ERROR       2U      // Next event is a bus error
+#define SIM_I2C_STALL           3U      // Slave holds SCL: no further events
+
+typedef struct {
+  uint32_t starts;
+  uint32_t restarts;
+  uint32_t stops;
+  uint32_t tx_bytes;                    // Data bytes written to the slave
+  uint32_t rx_bytes;                    // Data bytes read from the slave
+  uint32_t resets;                      // Interface disabled by the driver
+} simI2cStats_t;
+
+extern uint8_t        simI2cMem[256];   // Slave registers
+extern uint32_t       simI2cNackAfter;  // Slave NACKs the n-th data byte (0: never)
+extern simI2cStats_t  simI2cStats;
+
+/* Prototypes */
+extern LPC_I2C_TypeDef *simI2c      (void);
+extern void             simI2cFault (uint32_t fault);
+extern uint32_t         simI2cRun   (uint32_t events);
+extern uint32_t         simI2cIdle  (void);
+
+#endif
@@ -0,0 +1,144 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    rtos.c
+ * Purpose: Host fakes of CMSIS-RTOS2 and of the board support modules
+ *----------------------------------------------------------------------------*/
+
+#include "LPC17xx.h"
+#include "cmsis_os2.h"
+#include "stubs.h"
+
+/*
+  Threads are never run: osThreadNew hands out a dummy ID and records the
+  thread function so a test can drive a worker by hand if needed. Waits
+  return immediately. Every function is weak, a test overrides what it
+  needs to observe.
+*/
+uint32_t       stubTick;
+osThreadFunc_t stubThreadFunc[STUB_THREAD_MAX];
+uint32_t       stubThreadNum;
+uint32_t       stubThreadFlags[STUB_THREAD_MAX];
+
+static uint8_t stubObject[STUB_THREAD_MAX];
+
+__attribute__((weak)) osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+  (void)argument;
+  (void)attr;
+  if (stubThreadNum >= STUB_THREAD_MAX) {
+    return NULL;
+  }
+  stubThreadFunc[stubThreadNum] = func;
+  return &stubObject[stubThreadNum++];
+}
+
+__attribute__((weak)) uint32_t osThreadFlagsSet (osThreadId_t id, uint32_t flags) {
+  uint32_t idx = (uint32_t)((uint8_t *)id - stubObject);
+
+  if (idx >= STUB_THREAD_MAX) {
+    return osFlagsError;
+  }
+  stubThreadFlags[idx] |= flags;
+  return stubThreadFlags[idx];
+}
+
+__attribute__((weak)) uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout) {
+  (void)flags; (void)options; (void)timeout;
+  return osFlagsError;
+}
+
+__attribute__((weak)) uint32_t osThreadFlagsClear (uint32_t flags) { (void)flags; return 0U; }
+__attribute__((weak)) osThreadId_t osThreadGetId (void) { return &stubObject[0]; }
+__attribute__((weak)) const char *osThreadGetName (osThreadId_t id) { (void)id; return "stub"; }
+__attribute__((weak)) osStatus_t osThreadTerminate (osThreadId_t id) { (void)id; return osOK; }
+__attribute__((weak)) osStatus_t osThreadYield (void) { return osOK; }
+__attribute__((weak)) osStatus_t osThreadFeedWatchdog (uint32_t ticks) { (void)ticks; return osOK; }
+
+__attribute__((weak)) uint32_t osKernelGetTickCount     (void) { return stubTick; }
+__attribute__((weak)) uint32_t osKernelGetTickFreq      (void) { return 1000U; }
+__attribute__((weak)) uint32_t osKernelGetSysTimerCount (void) { return stubTick * 100000U; }
+__attribute__((weak)) uint32_t osKernelGetSysTimerFreq  (void) { return 100000000U; }
+__attribute__((weak)) int32_t  osKernelLock         (void) { return 0; }
+__attribute__((weak)) int32_t  osKernelUnlock       (void) { return 0; }
+__attribute__((weak)) int32_t  osKernelRestoreLock  (int32_t lock) { return lock; }
+__attribute__((weak)) uint32_t osKernelSuspend      (void) { return osWaitForever; }
+__attribute__((weak)) void     osKernelResume       (uint32_t ticks) { stubTick += ticks; }
+
+__attribute__((weak)) osStatus_t osDelay (uint32_t ticks) { stubTick += ticks; return osOK; }
+__attribute__((weak)) osStatus_t osDelayUntil (uint32_t ticks) { stubTick = ticks; return osOK; }
+
+__attribute__((weak)) osTimerId_t osTimerNew (osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr) {
+  (void)func; (void)type; (void)argument; (void)attr;
+  return &stubObject[0];
+}
+__attribute__((weak)) osStatus_t osTimerStart (osTimerId_t id, uint32_t ticks) { (void)id; (void)ticks; return osOK; }
+__attribute__((weak)) osStatus_t osTimerStop  (osTimerId_t id) { (void)id; return osOK; }
+
+__attribute__((weak)) osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr) { (void)attr; return &stubObject[0]; }
+__attribute__((weak)) uint32_t osEventFlagsSet (osEventFlagsId_t id, uint32_t flags) { (void)id; return flags; }
+__attribute__((weak)) osStatus_t osEventFlagsDelete (osEventFlagsId_t id) { (void)id; return osOK; }
+__attribute__((weak)) uint32_t osEventFlagsWait (osEventFlagsId_t id, uint32_t flags, uint32_t options, uint32_t timeout) {
+  (void)id; (void)flags; (void)options; (void)timeout;
+  return osFlagsError;
+}
+
+__attribute__((weak)) osMutexId_t osMutexNew (const osMutexAttr_t *attr) { (void)attr; return &stubObject[0]; }
+__attribute__((weak)) osStatus_t osMutexAcquire (osMutexId_t id, uint32_t timeout) { (void)id; (void)timeout; return osOK; }
+__attribute__((weak)) osStatus_t osMutexRelease (osMutexId_t id) { (void)id; return osOK; }
+__attribute__((weak)) osStatus_t osMutexDelete (osMutexId_t id) { (void)id; return osOK; }
+
+/*-----------------------------------------------------------------------------
+  Board support modules not under test
+ *----------------------------------------------------------------------------*/
+clkNotify_t stubClkNotify[STUB_NOTIFY_MAX];
+uint32_t    stubClkNotifyNum;
+
+__attribute__((weak)) int32_t clkNotifyRegister (clkNotify_t func) {
+  if (stubClkNotifyNum >= STUB_NOTIFY_MAX) {
+    return -1;
+  }
+  stubClkNotify[stubClkNotifyNum++] = func;
+  return 0;
+}
+
+__attribute__((weak)) int32_t  clkProfileSet     (uint32_t profile) { (void)profile; return 0; }
+__attribute__((weak)) uint32_t clkProfileGet     (void) { return 0U; }
+__attribute__((weak)) uint32_t clkProfileGetFreq (uint32_t profile) { (void)profile; return SystemCoreClock; }
+__attribute__((weak)) void     clkPclkSelect     (uint32_t reg, uint32_t mask, uint32_t value) {
+  (void)reg; (void)mask; (void)value;
+}
+
+__attribute__((weak)) int32_t  pmAcquire (uint32_t id, uint32_t pclk_div) { (void)id; (void)pclk_div; return 0; }
+__attribute__((weak)) void     pmRelease (uint32_t id) { (void)id; }
+__attribute__((weak)) uint32_t pmGetPclk (uint32_t id) { (void)id; return SystemCoreClock / 4U; }
+__attribute__((weak)) uint32_t pmGetPclkAt (uint32_t id, uint32_t cclk) { (void)id; return cclk / 4U; }
+
+__attribute__((weak)) void     govHoldMin    (uint32_t profile) { (void)profile; }
+__attribute__((weak)) void     govReleaseMin (uint32_t profile) { (void)profile; }
+
+__attribute__((weak)) uint32_t tbCyclesPerUs = 100U;
+__attribute__((weak)) uint32_t tbGetUs   (void) { return stubTick * 1000U; }
+__attribute__((weak)) uint64_t tbGetUs64 (void) { return (uint64_t)stubTick * 1000U; }
+
+__attribute__((weak)) int32_t  lpDefer   (void *thread) { (void)thread; return 0; }
+__attribute__((weak)) void     lpHold    (void) {}
+__attribute__((weak)) void     lpRelease (void) {}
+__attribute__((weak)) uint32_t pmUartPclkDiv (uint32_t baudrate) { (void)baudrate; return 0U; }
+__attribute__((weak)) int32_t  PIN_Configure (uint8_t port, uint8_t pin, uint8_t function, uint8_t mode, uint8_t open_drain) {
+  (void)port; (void)pin; (void)function; (void)mode; (void)open_drain;
+  return 0;
+}
@@ -0,0 +1,9 @@
+/* Host stand-in for rtx_os.h used by the unit tests (test/Makefile) */
+#ifndef RTX_OS_H_
+#define RTX_OS_H_
+#include <stdint.h>
+typedef struct osRtxThread_s { const char *name; struct osRtxThread_s *delay_next; uint32_t delay; } osRtxThread_t;
+typedef struct osRtxTimer_s { struct osRtxTimer_s *next; uint32_t tick; } osRtxTimer_t;
+typedef struct { struct { struct { osRtxThread_t *curr; } run; osRtxThread_t *delay_list; } thread; struct { osRtxTimer_t *list; } timer; } osRtxInfo_t;
+extern osRtxInfo_t osRtxInfo;
+#endif
@@ -0,0 +1,39 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    stubs.h
+ * Purpose: Host fakes shared by the unit tests
+ *----------------------------------------------------------------------------*/
+
+#ifndef STUBS_H__
+#define STUBS_H__
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+#include "clk_profile.h"
+
+#define STUB_THREAD_MAX         8U
+#define STUB_NOTIFY_MAX         16U
+
+extern uint32_t       stubTick;                         // osKernelGetTickCount
+extern osThreadFunc_t stubThreadFunc[STUB_THREAD_MAX];  // Created threads
+extern uint32_t       stubThreadNum;
+extern uint32_t       stubThreadFlags[STUB_THREAD_MAX]; // Flags set per thread
+extern clkNotify_t    stubClkNotify[STUB_NOTIFY_MAX];   // Registered callbacks
+extern uint32_t       stubClkNotifyNum;
+
+#endif
@@ -0,0 +1,56 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test.h
+ * Purpose: Minimal assertion helpers for the host unit tests
+ *----------------------------------------------------------------------------*/
+
+#ifndef TEST_H__
+#define TEST_H__
+
+#include <stdio.h>
+
+static unsigned int testFailed;
+static unsigned int testChecked;
+
+#define TEST_ASSERT(expr)                                             \
+  do {                                                                \
+    testChecked++;                                                    \
+    if (!(expr)) {                                                    \
+      testFailed++;                                                   \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+    }                                                                 \
+  } while (0)
+
+#define TEST_EQUAL(a, b)                                              \
+  do {                                                                \
+    long long a_ = (long long)(a), b_ = (long long)(b);               \
+    testChecked++;                                                    \
+    if (a_ != b_) {                                                   \
+      testFailed++;                                                   \
+      printf("%s:%d: %s == %lld, expected %lld\n",                    \
+             __FILE__, __LINE__, #a, a_, b_);                         \
+    }                                                                 \
+  } while (0)
+
+// Print summary and return process exit code
+static inline int testReport (const char *name) {
+  printf("%-20s %u checks, %u failed\n", name, testChecked, testFailed);
+  return (testFailed == 0U) ? 0 : 1;
+}
+
+#endif
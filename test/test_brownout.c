@@ -0,0 +1,186 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_brownout.c
+ * Purpose: Unit test of the brown-out snapshot handler and its cycle budget
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "brownout.h"
+#include "retained.h"
+
+/*
+  BOD_IRQHandler is called directly. DWT->CYCCNT is plain memory here, so
+  the handler's own measurement sees only what the clock model below adds.
+  The copy loop is bounded with a Cortex-M3 cost model instead: the worst
+  case (all regions, full snapshot) must fit BOD_BUDGET_CYCLES.
+
+  Cycles at the IRC, handler and data in RAM (zero wait states):
+    exception entry                      12
+    NVIC->ICER write, clkSuspend call    60  (both PLLs connected)
+    PCONP read, mask, write               8
+    per region: pointer and count load    6
+    per word: LDR 2, STR 1, SUBS 1, BNE 3 7
+    size, seq, cycles, DMB, magic        20
+*/
+#define CYC_ENTRY               12U
+#define CYC_SUSPEND             60U
+#define CYC_PCONP               8U
+#define CYC_REGION              6U
+#define CYC_WORD                7U
+#define CYC_COMMIT              20U
+
+extern void     BOD_IRQHandler (void);
+extern uint32_t bodBudgetMisses;
+extern uint32_t bodClkDeferred;
+
+static uint32_t clkSuspends;
+static uint32_t clkResumes;
+static uint32_t clkCycles = CYC_SUSPEND;   // DWT cycles added by clkSuspend
+static int32_t  clkDefer;                  // clkSuspend preempted a PLL sequence
+static uint32_t resetCause;
+
+int32_t clkSuspend (void) {
+  clkSuspends++;
+  DWT->CYCCNT += clkCycles;
+  return clkDefer;
+}
+
+void clkResume (void) {
+  clkResumes++;
+}
+
+uint32_t retGetResetCause (void) {
+  return resetCause;
+}
+
+// Snapshot sources: 3 regions filling BOD_SNAPSHOT_SIZE
+static uint32_t regA[4];
+static uint32_t regB[2];
+static uint32_t regC[(BOD_SNAPSHOT_SIZE / 4U) - 6U];
+
+static void fillRegions (uint32_t seed) {
+  uint32_t n;
+
+  for (n = 0U; n < 4U; n++)                       { regA[n] = seed + n; }
+  for (n = 0U; n < 2U; n++)                       { regB[n] = (seed << 8) + n; }
+  for (n = 0U; n < (sizeof(regC) / 4U); n++)      { regC[n] = ~(seed + n); }
+}
+
+static void checkSnapshot (const bodRecord_t *rec, uint32_t seed) {
+  uint32_t n;
+
+  TEST_ASSERT(rec != NULL);
+  if (rec == NULL) {
+    return;
+  }
+  TEST_EQUAL(rec->size, BOD_SNAPSHOT_SIZE);
+  for (n = 0U; n < 4U; n++) {
+    TEST_EQUAL(rec->data[n], seed + n);
+  }
+  for (n = 0U; n < 2U; n++) {
+    TEST_EQUAL(rec->data[4U + n], (seed << 8) + n);
+  }
+  for (n = 0U; n < (sizeof(regC) / 4U); n++) {
+    TEST_EQUAL(rec->data[6U + n], ~(seed + n));
+  }
+}
+
+int main (void) {
+  const bodRecord_t *rec;
+  uint32_t           pad;
+
+  // Worst case of the cost model against the budget
+  TEST_ASSERT((CYC_ENTRY + CYC_SUSPEND + CYC_PCONP + (BOD_REGION_MAX * CYC_REGION) +
+               ((BOD_SNAPSHOT_SIZE / 4U) * CYC_WORD) + CYC_COMMIT) <= BOD_BUDGET_CYCLES);
+
+  // Registration: aligned, within size and region limits
+  TEST_EQUAL(bodRegister(NULL, 4U), -1);
+  TEST_EQUAL(bodRegister((const uint8_t *)regA + 2, 4U), -1);
+  TEST_EQUAL(bodRegister(regA, 6U), -1);
+  TEST_EQUAL(bodRegister(regA, sizeof(regA)), 0);
+  TEST_EQUAL(bodRegister(regB, sizeof(regB)), 0);
+  TEST_EQUAL(bodRegister(regC, sizeof(regC) + 4U), -1);
+  TEST_EQUAL(bodRegister(regC, sizeof(regC)), 0);
+  TEST_EQUAL(bodRegister(&pad, 4U), -1);  // Snapshot full
+
+  // Power-on: no previous record, interrupt enabled
+  resetCause = RET_RESET_POR;
+  TEST_EQUAL(bodInit(), 0);
+  TEST_ASSERT(bodGetLast() == NULL);
+  TEST_EQUAL(bodIsTripped(), 0U);
+  TEST_EQUAL(bodRecover(), -1);
+
+  // Brown-out: interrupt disabled by register, load shed, snapshot taken
+  fillRegions(0x100U);
+  LPC_SC->PCONP = 0xFFFFFFFFU;
+  NVIC->ICER[0] = 0U;
+  BOD_IRQHandler();
+  TEST_EQUAL(NVIC->ICER[0], 1UL << BOD_IRQn);
+  TEST_EQUAL(clkSuspends, 1U);
+  TEST_EQUAL(bodClkDeferred, 0U);
+  TEST_EQUAL(LPC_SC->PCONP, BOD_KEEP_PCONP);
+  TEST_EQUAL(bodIsTripped(), 1U);
+  TEST_EQUAL(bodBudgetMisses, 0U);
+
+  // Supply back: peripherals and clocks restored
+  TEST_EQUAL(bodRecover(), 0);
+  TEST_EQUAL(LPC_SC->PCONP, 0xFFFFFFFFU);
+  TEST_EQUAL(clkResumes, 1U);
+  TEST_EQUAL(bodIsTripped(), 0U);
+
+  // Changes after the snapshot are not in it
+  fillRegions(0x200U);
+
+  // Brown-out reset: the record is published on the next boot
+  resetCause = RET_RESET_BOD;
+  TEST_EQUAL(bodInit(), 0);
+  rec = bodGetLast();
+  checkSnapshot(rec, 0x100U);
+  if (rec != NULL) {
+    TEST_EQUAL(rec->seq, 1U);
+    TEST_EQUAL(rec->cycles, CYC_SUSPEND);
+  }
+
+  // Brown-out during a PLL sequence: snapshot at once, clock drop deferred
+  clkDefer = -1;
+  BOD_IRQHandler();
+  TEST_EQUAL(clkSuspends, 2U);
+  TEST_EQUAL(bodClkDeferred, 1U);
+  TEST_EQUAL(bodIsTripped(), 1U);
+  TEST_EQUAL(bodRecover(), 0);
+  clkDefer = 0;
+
+  // Slow clock stop: counted as a budget miss, snapshot still committed
+  clkCycles = BOD_BUDGET_CYCLES + 1U;
+  fillRegions(0x300U);
+  BOD_IRQHandler();
+  TEST_EQUAL(bodBudgetMisses, 1U);
+  TEST_EQUAL(bodRecover(), 0);
+  TEST_EQUAL(bodInit(), 0);
+  rec = bodGetLast();
+  checkSnapshot(rec, 0x300U);
+  if (rec != NULL) {
+    TEST_EQUAL(rec->seq, 3U);
+    TEST_EQUAL(rec->cycles, BOD_BUDGET_CYCLES + 1U);
+  }
+
+  return testReport("test_brownout");
+}
@@ -0,0 +1,235 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_can_filter.c
+ * Purpose: Acceptance filter compiler against a model of the lookup
+ *----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "can_filter.h"
+
+/*
+  simAccept searches the compiled image the way the acceptance filter does
+  (UM10360 21.16): each table is scanned in ascending order and the search
+  ends at the first entry above the frame. An entry that is out of order
+  therefore hides frames, so comparing simAccept with a direct evaluation
+  of the rules also checks the sort order of every table.
+*/
+static uint32_t ram[CAN_FILTER_RAM_WORDS];
+static canFilterTable_t tab;
+
+static uint32_t simAccept (uint32_t ctrl, uint32_t ext, uint32_t id) {
+  uint32_t key;
+  uint32_t entry;
+  uint32_t n;
+
+  if (ext == 0U) {
+    key = (ctrl << 13) | id;
+    for (n = 0U; n < (tab.sff_grp_sa / 2U); n++) {  // Two entries per word
+      entry = (ram[n / 2U] >> (((n & 1U) != 0U) ? 0U : 16U)) & 0xFFFFU;
+      if ((entry & 0x1000U) != 0U) {
+        continue;                       // Disabled
+      }
+      if (entry == key) {
+        return 1U;
+      }
+      if (entry > key) {
+        break;
+      }
+    }
+    for (n = tab.sff_grp_sa / 4U; n < (tab.eff_sa / 4U); n++) {
+      if (((ram[n] >> 16) <= key) && ((ram[n] & 0xFFFFU) >= key)) {
+        return 1U;
+      }
+    }
+    return 0U;
+  }
+  key = (ctrl << 29) | id;
+  for (n = tab.eff_sa / 4U; n < (tab.eff_grp_sa / 4U); n++) {
+    if (ram[n] == key) {
+      return 1U;
+    }
+    if (ram[n] > key) {
+      break;
+    }
+  }
+  for (n = tab.eff_grp_sa / 4U; n < (tab.end / 4U); n += 2U) {
+    if ((ram[n] <= key) && (ram[n + 1U] >= key)) {
+      return 1U;
+    }
+  }
+  return 0U;
+}
+
+static uint32_t ruleAccept (const canFilterRule_t *rule, uint32_t num,
+                            uint32_t ctrl, uint32_t ext, uint32_t id) {
+  uint32_t n;
+
+  for (n = 0U; n < num; n++) {
+    if ((rule[n].ctrl == ctrl) && (rule[n].ext == ext) &&
+        (rule[n].lo <= id) && (rule[n].hi >= id)) {
+      return 1U;
+    }
+  }
+  return 0U;
+}
+
+// Table bounds are consistent and ascending
+static void checkLayout (int32_t used) {
+  uint32_t n;
+
+  TEST_EQUAL(tab.sff_sa, 0U);
+  TEST_ASSERT(tab.sff_grp_sa <= tab.eff_sa);
+  TEST_ASSERT(tab.eff_sa <= tab.eff_grp_sa);
+  TEST_ASSERT(tab.eff_grp_sa <= tab.end);
+  TEST_EQUAL(tab.end, (uint32_t)used * 4U);
+  TEST_EQUAL((tab.end - tab.eff_grp_sa) % 8U, 0U);
+  for (n = tab.sff_sa / 4U; n < (tab.sff_grp_sa / 4U); n++) {
+    TEST_ASSERT((ram[n] >> 16) <= (ram[n] & 0xFFFFU));
+    if (n > 0U) {
+      TEST_ASSERT((ram[n - 1U] & 0xFFFFU) < (ram[n] >> 16));
+    }
+  }
+  for (n = tab.eff_sa / 4U; (n + 1U) < (tab.eff_grp_sa / 4U); n++) {
+    TEST_ASSERT(ram[n] < ram[n + 1U]);
+  }
+}
+
+// Random rule set: every frame is accepted exactly when a rule matches
+static void checkRandom (uint32_t num) {
+  canFilterRule_t rule[64];
+  uint32_t        id_max;
+  uint32_t        n;
+  uint32_t        id;
+  uint32_t        ctrl;
+  uint32_t        bad = 0U;
+  int32_t         used;
+
+  for (n = 0U; n < num; n++) {
+    rule[n].ext  = (uint8_t)(rand() & 1);
+    rule[n].ctrl = (uint8_t)(rand() & 1);
+    id_max       = (rule[n].ext != 0U) ? 0x1FFFFFFFU : 0x7FFU;
+    rule[n].lo   = (uint32_t)rand() % ((rule[n].ext != 0U) ? 4096U : (id_max + 1U));
+    rule[n].hi   = rule[n].lo;
+    if ((rand() % 3) == 0) {
+      rule[n].hi = rule[n].lo + ((uint32_t)rand() % 64U);
+      if (rule[n].hi > id_max) {
+        rule[n].hi = id_max;
+      }
+    }
+    if ((n > 0U) && ((rand() % 8) == 0)) {
+      rule[n] = rule[(uint32_t)rand() % n];     // Duplicate
+    }
+  }
+  used = canFilterCompile(rule, num, ram, &tab);
+  TEST_ASSERT(used >= 0);
+  if (used < 0) {
+    return;
+  }
+  checkLayout(used);
+  for (ctrl = 0U; ctrl < 2U; ctrl++) {
+    for (id = 0U; id <= 0x7FFU; id++) {
+      bad += (simAccept(ctrl, 0U, id) != ruleAccept(rule, num, ctrl, 0U, id)) ? 1U : 0U;
+    }
+    for (id = 0U; id < 4200U; id++) {
+      bad += (simAccept(ctrl, 1U, id) != ruleAccept(rule, num, ctrl, 1U, id)) ? 1U : 0U;
+    }
+  }
+  TEST_EQUAL(bad, 0U);
+}
+
+int main (void) {
+  canFilterRule_t rule[CAN_FILTER_RAM_WORDS * 2U + 2U];
+  uint32_t        n;
+  int32_t         used;
+
+  // No rules: empty tables
+  TEST_EQUAL(canFilterCompile(NULL, 0U, ram, &tab), 0);
+  TEST_EQUAL(tab.end, 0U);
+  TEST_EQUAL(canFilterCompile(NULL, 1U, ram, &tab), -1);
+
+  // Three standard identifiers: sorted, packed two per word, odd one padded
+  memset(rule, 0, sizeof(rule));
+  rule[0].lo = rule[0].hi = 0x300U;
+  rule[1].lo = rule[1].hi = 0x100U;
+  rule[2].lo = rule[2].hi = 0x200U; rule[2].ctrl = 1U;
+  used = canFilterCompile(rule, 3U, ram, &tab);
+  TEST_EQUAL(used, 2);
+  TEST_EQUAL(ram[0], (0x100UL << 16) | 0x300U);
+  TEST_EQUAL(ram[1], (((1UL << 13) | 0x200U) << 16) | 0x1000U | (1UL << 13) | 0x200U);
+  TEST_EQUAL(tab.sff_grp_sa, 8U);
+  TEST_EQUAL(tab.end, 8U);
+  TEST_EQUAL(simAccept(1U, 0U, 0x200U), 1U);
+  TEST_EQUAL(simAccept(0U, 0U, 0x200U), 0U);
+
+  // Duplicates collapse, identifiers inside a range of the same kind go
+  memset(rule, 0, sizeof(rule));
+  rule[0].lo = 0x10U;   rule[0].hi = 0x1FU;
+  rule[1].lo = rule[1].hi = 0x15U;
+  rule[2].lo = rule[2].hi = 0x15U; rule[2].ctrl = 1U;
+  rule[3].lo = rule[3].hi = 0x15U; rule[3].ctrl = 1U;
+  rule[4].lo = rule[4].hi = 0x1234567U; rule[4].ext = 1U;
+  rule[5].lo = rule[5].hi = 0x1234567U; rule[5].ext = 1U;
+  rule[6].lo = 0x1000000U; rule[6].hi = 0x1FFFFFFU; rule[6].ext = 1U; rule[6].ctrl = 1U;
+  used = canFilterCompile(rule, 7U, ram, &tab);
+  checkLayout(used);
+  TEST_EQUAL(tab.sff_grp_sa, 4U);                   // CAN2 0x15 and padding
+  TEST_EQUAL(tab.eff_sa - tab.sff_grp_sa, 4U);      // One standard group
+  TEST_EQUAL(tab.eff_grp_sa - tab.eff_sa, 4U);      // 0x1234567 once
+  TEST_EQUAL(tab.end - tab.eff_grp_sa, 8U);
+  TEST_EQUAL(ram[3], (1UL << 29) | 0x1000000U);
+  TEST_EQUAL(ram[4], (1UL << 29) | 0x1FFFFFFU);
+  TEST_EQUAL(simAccept(0U, 1U, 0x1234567U), 1U);
+  TEST_EQUAL(simAccept(1U, 1U, 0x1234567U), 1U);
+  TEST_EQUAL(simAccept(0U, 1U, 0x1000000U), 0U);
+
+  // Invalid rules
+  memset(rule, 0, sizeof(rule));
+  rule[0].lo = 5U; rule[0].hi = 4U;
+  TEST_EQUAL(canFilterCompile(rule, 1U, ram, &tab), -1);
+  rule[0].lo = rule[0].hi = 0x800U;
+  TEST_EQUAL(canFilterCompile(rule, 1U, ram, &tab), -1);
+  rule[0].lo = rule[0].hi = 0x20000000U; rule[0].ext = 1U;
+  TEST_EQUAL(canFilterCompile(rule, 1U, ram, &tab), -1);
+  rule[0].lo = rule[0].hi = 1U; rule[0].ctrl = 2U;
+  TEST_EQUAL(canFilterCompile(rule, 1U, ram, &tab), -1);
+
+  // Filter RAM limit: 512 extended identifiers fit, one more does not
+  memset(rule, 0, sizeof(rule));
+  for (n = 0U; n <= CAN_FILTER_RAM_WORDS; n++) {
+    rule[n].lo  = rule[n].hi = n * 3U;
+    rule[n].ext = 1U;
+  }
+  TEST_EQUAL(canFilterCompile(rule, CAN_FILTER_RAM_WORDS, ram, &tab), (int32_t)CAN_FILTER_RAM_WORDS);
+  TEST_EQUAL(canFilterCompile(rule, CAN_FILTER_RAM_WORDS + 1U, ram, &tab), -1);
+  for (n = 0U; n < CAN_FILTER_RAM_WORDS; n++) {
+    rule[n].lo  = rule[n].hi = n;
+    rule[n].ext = 0U;
+  }
+  rule[n].lo = 0U; rule[n].hi = 100U; rule[n].ext = 1U;
+  TEST_EQUAL(canFilterCompile(rule, CAN_FILTER_RAM_WORDS + 1U, ram, &tab), 258);
+
+  // Random rule sets against the lookup model
+  srand(48);
+  for (n = 0U; n < 200U; n++) {
+    checkRandom(1U + (n % 64U));
+  }
+
+  return testReport("test_can_filter");
+}
@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_clock_tree.c
+ * Purpose: Host test decoding the clock registers programmed by SystemInit
+ *----------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include "test.h"
+#include "LPC17xx.h"
+#include "clock_tree.h"
+#include "boot_time.h"
+
+/*
+  SystemInit from system_LPC17xx.c runs against the register model while a
+  second thread plays the clock block: it raises OSCSTAT once the oscillator
+  is enabled and mirrors PLL0/PLL1 configuration and control into the status
+  registers after each feed sequence. The values left in the registers are
+  then decoded with clock_tree.h and checked against the data sheet.
+*/
+bootStamp_t bootStamp[BOOT_PHASE_NUM];
+uint32_t    bootWarmClock;
+
+static volatile int modelRun;
+
+#define STATUS(reg)             (*(volatile uint32_t *)&(reg))
+
+static void *modelThread (void *arg) {
+  (void)arg;
+  while (modelRun != 0) {
+    if (((LPC_SC->SCS & (1UL << 5)) != 0U) && ((LPC_SC->SCS & (1UL << 6)) == 0U)) {
+      LPC_SC->SCS |= (1UL << 6);        // OSCSTAT
+    }
+    STATUS(LPC_SC->PLL0STAT) = (LPC_SC->PLL0CFG & 0x00FF7FFFU) |
+                               ((LPC_SC->PLL0CON & 0x03U) << 24) |
+                               (((LPC_SC->PLL0CON & 0x01U) != 0U) ? (1UL << 26) : 0U);
+    STATUS(LPC_SC->PLL1STAT) = (LPC_SC->PLL1CFG & 0x7FU) |
+                               ((LPC_SC->PLL1CON & 0x03U) << 8) |
+                               (((LPC_SC->PLL1CON & 0x01U) != 0U) ? (1UL << 10) : 0U);
+  }
+  return NULL;
+}
+
+static void runSystemInit (void) {
+  pthread_t model;
+
+  modelRun = 1;
+  pthread_create(&model, NULL, modelThread, NULL);
+  SystemInit();
+  modelRun = 0;
+  pthread_join(model, NULL);
+}
+
+int main (void) {
+  uint32_t pll0cfg;
+  uint32_t pll1cfg;
+  uint32_t cclkcfg;
+  uint32_t cclk;
+  uint32_t shift;
+
+  // Cold reset: everything at reset values
+  runSystemInit();
+  TEST_EQUAL(bootWarmClock, 0U);
+  TEST_EQUAL(bootStamp[BOOT_RESET].cclk, 4000000U);            // IRC until the PLL runs
+  TEST_EQUAL(bootStamp[BOOT_PLL0_READY].cclk, CLK_BOOT_CCLK_HZ);
+
+  pll0cfg = LPC_SC->PLL0CFG;
+  pll1cfg = LPC_SC->PLL1CFG;
+  cclkcfg = LPC_SC->CCLKCFG;
+  cclk    = CLK_CCLK_PLL0(CLK_XTAL_HZ, pll0cfg, cclkcfg);
+
+  // PLL0: M = 100, N = 6, F_cco0 = 2 * 100 * 12 MHz / 6 = 400 MHz
+  TEST_EQUAL(LPC_SC->CLKSRCSEL & 0x03U, 1U);
+  TEST_EQUAL(CLK_PLL0_M(pll0cfg), 100U);
+  TEST_EQUAL(CLK_PLL0_N(pll0cfg), 6U);
+  TEST_EQUAL(CLK_PLL0_FCCO(CLK_XTAL_HZ, pll0cfg), 400000000U);
+  TEST_ASSERT(CLK_PLL0_VALID(CLK_XTAL_HZ, pll0cfg));
+  TEST_EQUAL((LPC_SC->PLL0STAT >> 24) & 0x03U, 3U);           // Enabled and connected
+
+  // CPU clock: 400 MHz / 4 = 100 MHz, 5 flash clocks
+  TEST_EQUAL(CLK_CCLK_DIV(cclkcfg), 4U);
+  TEST_EQUAL(cclk, 100000000U);
+  TEST_EQUAL(cclk, CLK_BOOT_CCLK_HZ);
+  TEST_EQUAL((LPC_SC->FLASHCFG >> 12) & 0x0FU, 4U);
+  TEST_ASSERT(CLK_FLASHTIM_VALID(cclk, (LPC_SC->FLASHCFG >> 12) & 0x0FU));
+
+  // PLL1: M = 4, P = 2: 48 MHz USB clock from F_cco1 = 192 MHz (connected later)
+  TEST_EQUAL(CLK_PLL1_M(pll1cfg), 4U);
+  TEST_EQUAL(CLK_PLL1_P(pll1cfg), 2U);
+  TEST_EQUAL(CLK_PLL1_OUT(CLK_XTAL_HZ, pll1cfg), 48000000U);
+  TEST_EQUAL(CLK_PLL1_FCCO(CLK_XTAL_HZ, pll1cfg), 192000000U);
+  TEST_EQUAL((LPC_SC->PLL1STAT >> 8) & 0x03U, 1U);             // Enabled, not connected
+
+  // Every peripheral clock at CCLK / 4 (CAN included: code 0)
+  for (shift = 0U; shift < 32U; shift += 2U) {
+    TEST_EQUAL(CLK_PCLK(cclk, CLK_PCLKSEL_CODE(LPC_SC->PCLKSEL0, shift)), 25000000U);
+    TEST_EQUAL(CLK_PCLK(cclk, CLK_PCLKSEL_CODE(LPC_SC->PCLKSEL1, shift)), 25000000U);
+  }
+  TEST_EQUAL(CLK_PCLK_CAN(cclk, CLK_PCLKSEL_CODE(LPC_SC->PCLKSEL0, 26U)), 25000000U);
+  TEST_EQUAL(CLK_BOOT_PCLK_TIMER1_HZ, 25000000U);
+  TEST_EQUAL(CLK_BOOT_PCLK_UART0_HZ, 25000000U);
+
+  // CMSIS decode of the same registers agrees, on the fast and the slow path
+  SystemCoreClock = 0U;
+  SystemCoreClockUpdate();
+  TEST_EQUAL(SystemCoreClock, CLK_BOOT_CCLK_HZ);
+  LPC_SC->CCLKCFG = 5U;                 // 400 MHz / 6 takes the register decode
+  SystemCoreClockUpdate();
+  TEST_EQUAL(SystemCoreClock, CLK_CCLK_PLL0(CLK_XTAL_HZ, pll0cfg, 5U));
+  LPC_SC->CCLKCFG = cclkcfg;
+
+  // Warm restart: PLL0 left running, SystemInit keeps it and says so.
+  // Drivers changed peripheral dividers (SSP1 DIV1, CAN/ACF DIV2, I2C1 DIV4)
+  // in the last run: still warm, the boot dividers are restored.
+  bootStamp[BOOT_RESET].cclk = 0U;
+  LPC_SC->PCLKSEL0 = (1UL << 20) | (2UL << 26) | (2UL << 28) | (2UL << 30);
+  LPC_SC->PCLKSEL1 = 1UL << 6;
+  runSystemInit();
+  TEST_EQUAL(bootWarmClock, 1U);
+  TEST_EQUAL(bootStamp[BOOT_RESET].cclk, CLK_BOOT_CCLK_HZ);
+  TEST_EQUAL(LPC_SC->PLL0CFG, pll0cfg);
+  TEST_EQUAL(LPC_SC->CCLKCFG, cclkcfg);
+  TEST_EQUAL(LPC_SC->PCLKSEL0, 0U);
+  TEST_EQUAL(LPC_SC->PCLKSEL1, 0U);
+
+  // Another CCLK divider (governor profile) is a cold start
+  LPC_SC->CCLKCFG = 5U;
+  runSystemInit();
+  TEST_EQUAL(bootWarmClock, 0U);
+  TEST_EQUAL(LPC_SC->CCLKCFG, cclkcfg);
+
+  // Decoder boundaries against the data sheet
+  TEST_EQUAL(CLK_PCLK(100000000U, 1U), 100000000U);
+  TEST_EQUAL(CLK_PCLK(100000000U, 2U),  50000000U);
+  TEST_EQUAL(CLK_PCLK(100000000U, 3U),  12500000U);
+  TEST_EQUAL(CLK_PCLK_CAN(96000000U, 3U), 16000000U);
+  TEST_EQUAL(CLK_FLASHTIM_MIN(20000000U), 0U);
+  TEST_EQUAL(CLK_FLASHTIM_MIN(20000001U), 1U);
+  TEST_EQUAL(CLK_FLASHTIM_MIN(100000000U), 4U);
+  TEST_EQUAL(CLK_FLASHTIM_MIN(120000000U), 5U);
+  TEST_ASSERT(!CLK_PLL0_VALID(CLK_XTAL_HZ, 0x00000009U));     // F_cco0 240 MHz
+
+  return testReport("test_clock_tree");
+}
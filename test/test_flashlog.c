@@ -0,0 +1,303 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_flashlog.c
+ * Purpose: Flash log engine against a RAM model of a NOR flash
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "test.h"
+#include "flashlog.h"
+
+/*
+  The model behaves like NOR flash: erase sets a block to 0xFF, program can
+  only clear bits (setting one counts as a violation). simBudget simulates
+  a power loss: programming stops after that many more bytes and the rest
+  of the flash stays as it was. A remount then plays the reboot.
+
+  Records carry a running number and a pattern derived from it, so the
+  reader can tell lost, repeated or damaged records apart.
+*/
+#define SIM_BASE                0x100000U
+#define SIM_SEGS                16U
+#define SIM_SIZE                (SIM_SEGS * FL_SEG_SIZE)
+
+static uint8_t  simFlash[SIM_SIZE];
+static uint32_t simErases[SIM_SEGS];
+static uint32_t simBad;                 // Bits set by program
+static uint32_t simBudget = 0xFFFFFFFFU;
+
+static int32_t simRead (uint32_t addr, void *buf, uint32_t len) {
+  if ((addr < SIM_BASE) || ((addr + len) > (SIM_BASE + SIM_SIZE))) {
+    return -1;
+  }
+  memcpy(buf, &simFlash[addr - SIM_BASE], len);
+  return 0;
+}
+
+static int32_t simProgram (uint32_t addr, const void *buf, uint32_t len) {
+  const uint8_t *src = buf;
+  uint32_t       i;
+
+  if ((addr < SIM_BASE) || ((addr + len) > (SIM_BASE + SIM_SIZE))) {
+    return -1;
+  }
+  for (i = 0U; (i < len) && (simBudget != 0U); i++, simBudget--) {
+    if ((simFlash[addr - SIM_BASE + i] & src[i]) != src[i]) {
+      simBad++;
+    }
+    simFlash[addr - SIM_BASE + i] &= src[i];
+  }
+  return 0;
+}
+
+static int32_t simErase (uint32_t addr, uint32_t len) {
+  if (((addr % FL_SEG_SIZE) != 0U) || (len != FL_SEG_SIZE) ||
+      (addr < SIM_BASE) || ((addr + len) > (SIM_BASE + SIM_SIZE))) {
+    return -1;
+  }
+  if (simBudget == 0U) {
+    return 0;                           // No power
+  }
+  memset(&simFlash[addr - SIM_BASE], 0xFF, len);
+  simErases[(addr - SIM_BASE) / FL_SEG_SIZE]++;
+  return 0;
+}
+
+static const flOps_t simOps = { simRead, simProgram, simErase, NULL, NULL };
+
+/*-----------------------------------------------------------------------------
+  Records
+ *----------------------------------------------------------------------------*/
+static uint32_t simLen (uint32_t seq) {
+  return 4U + (seq % (FL_RECORD_MAX - 3U));
+}
+
+static uint32_t simMake (uint32_t seq, uint8_t *rec) {
+  uint32_t len = simLen(seq);
+  uint32_t i;
+
+  memcpy(rec, &seq, 4U);
+  for (i = 4U; i < len; i++) {
+    rec[i] = (uint8_t)((seq * 31U) + i);
+  }
+  return len;
+}
+
+static uint32_t simAppended;            // Next record number
+static uint32_t simSynced;              // Records on flash for sure
+static uint32_t simGaps;                // Missing runs seen by simReadAll
+
+static int32_t simAppend (void) {
+  uint8_t  rec[FL_RECORD_MAX];
+  uint32_t len = simMake(simAppended, rec);
+  int32_t  status = flAppend(rec, len);
+
+  if (status == 0) {
+    simAppended++;
+  }
+  return status;
+}
+
+static int32_t simSync (void) {
+  int32_t status = flSync();
+
+  if (status == 0) {
+    simSynced = simAppended;
+  }
+  return status;
+}
+
+// Read the whole log: records must be valid and in order; returns the count
+static uint32_t simReadAll (uint32_t *first, uint32_t *last) {
+  uint8_t    buf[FL_RECORD_MAX];
+  uint8_t    ref[FL_RECORD_MAX];
+  flCursor_t cur;
+  uint32_t   num = 0U;
+  uint32_t   seq;
+  int32_t    len;
+
+  simGaps = 0U;
+  flCursorInit(&cur);
+  while ((len = flRead(&cur, buf, sizeof(buf))) > 0) {
+    memcpy(&seq, buf, 4U);
+    TEST_EQUAL((uint32_t)len, simMake(seq, ref));
+    TEST_ASSERT(memcmp(buf, ref, (uint32_t)len) == 0);
+    if (num == 0U) {
+      *first = seq;
+    } else {
+      TEST_ASSERT(seq > *last);
+      if (seq != (*last + 1U)) {
+        simGaps++;
+      }
+    }
+    *last = seq;
+    num++;
+  }
+  TEST_EQUAL(len, 0);
+  return num;
+}
+
+static void simEraseSpread (uint32_t *min, uint32_t *max) {
+  uint32_t n;
+
+  *min = 0xFFFFFFFFU;
+  *max = 0U;
+  for (n = 0U; n < SIM_SEGS; n++) {
+    *min = (simErases[n] < *min) ? simErases[n] : *min;
+    *max = (simErases[n] > *max) ? simErases[n] : *max;
+  }
+}
+
+int main (void) {
+  static const flOps_t no_erase = { simRead, simProgram, NULL, NULL, NULL };
+  uint8_t   rec[FL_RECORD_MAX + 1U];
+  flStats_t stats;
+  flCursor_t cur;
+  uint32_t  first = 0U;
+  uint32_t  last = 0U;
+  uint32_t  min;
+  uint32_t  max;
+  uint32_t  num;
+  uint32_t  n;
+
+  // Not mounted, bad parameters
+  memset(simFlash, 0xFF, SIM_SIZE);
+  memset(rec, 0, sizeof(rec));
+  TEST_EQUAL(flAppend(rec, 4U), -1);
+  TEST_EQUAL(flFlush(), -1);
+  TEST_EQUAL(flMount(NULL, SIM_BASE, SIM_SEGS), -1);
+  TEST_EQUAL(flMount(&no_erase, SIM_BASE, SIM_SEGS), -1);
+  TEST_EQUAL(flMount(&simOps, SIM_BASE, 1U), -1);
+  TEST_EQUAL(flMount(&simOps, SIM_BASE + FL_PAGE_SIZE, SIM_SEGS), -1);
+
+  // Blank flash is an empty log
+  TEST_EQUAL(flMount(&simOps, SIM_BASE, SIM_SEGS), 0);
+  TEST_EQUAL(simReadAll(&first, &last), 0U);
+  flCursorInit(&cur);
+  TEST_EQUAL(flRead(&cur, rec, sizeof(rec)), 0);
+  TEST_EQUAL(flAppend(rec, 0U), -1);
+  TEST_EQUAL(flAppend(rec, FL_RECORD_MAX + 1U), -1);
+
+  // Records survive a remount and read back in order
+  for (n = 0U; n < 100U; n++) {
+    TEST_EQUAL(simAppend(), 0);
+    TEST_EQUAL(flFlush(), 0);
+  }
+  TEST_EQUAL(simSync(), 0);
+  TEST_EQUAL(flMount(&simOps, SIM_BASE, SIM_SEGS), 0);
+  flGetStats(&stats);
+  TEST_ASSERT((stats.recovered > 0U) && (stats.recovered <= 100U));
+  TEST_EQUAL(simReadAll(&first, &last), 100U);
+  TEST_EQUAL(first, 0U);
+  TEST_EQUAL(last, 99U);
+
+  // Appending continues behind the recovered records, in whole pages
+  for (n = 0U; n < 50U; n++) {
+    TEST_EQUAL(simAppend(), 0);
+    TEST_EQUAL(flFlush(), 0);
+  }
+  TEST_EQUAL(simSync(), 0);
+  TEST_EQUAL(simReadAll(&first, &last), 150U);
+  TEST_EQUAL(last, 149U);
+  flGetStats(&stats);
+  TEST_EQUAL(stats.appended, 50U);
+  TEST_EQUAL(stats.errors, 0U);
+
+  // Both page buffers full: records are dropped until flFlush runs
+  for (n = 0U; (n < 100U) && (simAppend() == 0); n++) {}
+  TEST_ASSERT(n < 100U);
+  TEST_ASSERT((n * (FL_REC_HDR + 4U)) <= (2U * FL_PAGE_SIZE));
+  flGetStats(&stats);
+  TEST_EQUAL(stats.dropped, 1U);
+  TEST_EQUAL(flFlush(), 0);
+  TEST_EQUAL(simAppend(), 0);
+  TEST_EQUAL(simSync(), 0);
+  TEST_EQUAL(simReadAll(&first, &last), simAppended);
+
+  // Largest record, record filling a page after the segment header
+  memset(rec, 0xA5, sizeof(rec));
+  TEST_EQUAL(flAppend(rec, FL_RECORD_MAX), 0);
+  TEST_EQUAL(flSync(), 0);
+  flCursorInit(&cur);
+  num = 0U;
+  while (flRead(&cur, rec, sizeof(rec)) > 0) {
+    num++;
+  }
+  TEST_EQUAL(num, simAppended + 1U);
+  TEST_EQUAL(rec[0], 0xA5U);
+  TEST_EQUAL(rec[FL_RECORD_MAX - 1U], 0xA5U);
+
+  // Many rounds through the ring: blocks wear evenly, the oldest data goes
+  for (n = 0U; n < 20000U; n++) {
+    TEST_EQUAL(simAppend(), 0);
+    TEST_EQUAL(flFlush(), 0);
+    if ((n % 5000U) == 4999U) {
+      TEST_EQUAL(simSync(), 0);
+      TEST_EQUAL(flMount(&simOps, SIM_BASE, SIM_SEGS), 0);
+    }
+  }
+  TEST_EQUAL(simSync(), 0);
+  simEraseSpread(&min, &max);
+  TEST_ASSERT(min >= 10U);
+  TEST_ASSERT((max - min) <= 1U);
+  flGetStats(&stats);
+  TEST_EQUAL(stats.erase_max, max);
+  TEST_EQUAL(stats.errors, 0U);
+  num = simReadAll(&first, &last);
+  TEST_EQUAL(last, simAppended - 1U);
+  TEST_EQUAL(num, last - first + 1U);
+  TEST_EQUAL(simGaps, 0U);
+  TEST_ASSERT(num > ((SIM_SEGS - 2U) * FL_SEG_SIZE) / (FL_REC_HDR + FL_RECORD_MAX));
+  TEST_ASSERT(first > 0U);
+
+  // Power loss in the middle of a page: the torn segment is closed
+  for (n = 0U; n < 10U; n++) {
+    TEST_EQUAL(simAppend(), 0);
+    TEST_EQUAL(flFlush(), 0);
+  }
+  TEST_EQUAL(simSync(), 0);
+  while (simAppend() == 0) {}            // Both page buffers in use
+  simBudget = FL_PAGE_SIZE / 2U;
+  (void)flSync();
+  simBudget = 0xFFFFFFFFU;
+  TEST_EQUAL(flMount(&simOps, SIM_BASE, SIM_SEGS), 0);
+  num = simReadAll(&first, &last);
+  TEST_ASSERT(last >= (simSynced - 1U));
+  TEST_ASSERT(last < (simAppended - 1U));
+  for (n = 0U; n < 10U; n++) {
+    TEST_EQUAL(simAppend(), 0);
+    TEST_EQUAL(flFlush(), 0);
+  }
+  TEST_EQUAL(simSync(), 0);
+  TEST_ASSERT(simReadAll(&first, &last) >= 10U);
+  TEST_EQUAL(last, simAppended - 1U);
+  TEST_EQUAL(simGaps, 1U);                            // Only the torn records
+
+  // A damaged record ends its segment, the following segments are kept
+  TEST_EQUAL(flMount(&simOps, SIM_BASE, SIM_SEGS), 0);
+  flCursorInit(&cur);
+  TEST_ASSERT(flRead(&cur, rec, sizeof(rec)) > 0);
+  simFlash[cur.addr - SIM_BASE + FL_REC_HDR + 5U] ^= 0x01U;     // Second record
+  num = simReadAll(&first, &last);
+  TEST_ASSERT(num > 0U);
+  TEST_EQUAL(last, simAppended - 1U);
+  TEST_EQUAL(simGaps, 2U);
+
+  TEST_EQUAL(simBad, 0U);
+  return testReport("test_flashlog");
+}
@@ -0,0 +1,140 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_governor.c
+ * Purpose: Host trace simulation of the clock governor policy
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "clk_governor.h"
+#include "clk_profile.h"
+
+/*
+  Closed loop trace simulation: a workload needs a given number of CPU
+  cycles per window, the load seen by the governor is that demand divided
+  by the capacity of the profile it selected for the window.
+*/
+static const uint32_t profileHz[CLK_PROFILE_NUM] = { 12000000U, 48000000U, 100000000U };
+
+typedef struct {
+  uint32_t switches;                    // Profile changes
+  uint32_t overload;                    // Windows with demand above capacity
+  uint32_t profile;                     // Profile after the trace
+  uint32_t window_top;                  // Windows spent at the top profile
+} simResult_t;
+
+// Profile table of clk_profile.c (used by the step down prediction)
+uint32_t clkProfileGetFreq (uint32_t profile) {
+  return (profile < CLK_PROFILE_NUM) ? profileHz[profile] : 0U;
+}
+
+static uint32_t simLoad (uint32_t demand_mcycles, uint32_t profile) {
+  uint64_t capacity = ((uint64_t)profileHz[profile] * GOV_WINDOW_MS) / 1000U;
+  uint64_t load     = ((uint64_t)demand_mcycles * 1000000U * 100U) / capacity;
+
+  return (load > 100U) ? 100U : (uint32_t)load;
+}
+
+static void simRun (govPolicy_t *policy, const uint32_t *demand, uint32_t num,
+
+                    uint32_t repeat, uint32_t min_profile, simResult_t *res) {
+  uint32_t profile = policy->profile;
+  uint32_t next;
+  uint32_t load;
+  uint32_t n;
+
+  memset(res, 0, sizeof(*res));
+  for (n = 0U; n < (num * repeat); n++) {
+    load = simLoad(demand[n % num], profile);
+    if (load >= 100U) {
+      res->overload++;
+    }
+    next = govPolicy(policy, load, min_profile);
+    if (next != profile) {
+      res->switches++;
+      profile = next;
+    }
+    if (profile == (CLK_PROFILE_NUM - 1U)) {
+      res->window_top++;
+    }
+  }
+  res->profile = profile;
+}
+
+static void simReset (govPolicy_t *policy, uint32_t profile) {
+  memset(policy, 0, sizeof(*policy));
+  policy->profile = (uint8_t)profile;
+}
+
+int main (void) {
+  // Demand in million cycles per 100 ms window
+  static const uint32_t idle[]     = { 0U };
+  static const uint32_t busy[]     = { 10U };               // 100 MHz fully used
+  static const uint32_t periodic[] = { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 3U };
+  static const uint32_t burst[]    = { 4U, 4U, 4U, 0U, 0U, 0U, 0U, 0U, 0U, 0U,
+                                       0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U };
+  govPolicy_t policy;
+  simResult_t res;
+  uint32_t    n;
+
+  // Idle system settles at the lowest profile and stays there
+  simReset(&policy, CLK_PROFILE_100MHZ);
+  simRun(&policy, idle, 1U, 50U, 0U, &res);
+  TEST_EQUAL(res.profile, CLK_PROFILE_12MHZ);
+  TEST_EQUAL(res.switches, 2U);
+
+  // A busy loop pins the load at 100 % and the clock at the top
+  simReset(&policy, CLK_PROFILE_12MHZ);
+  simRun(&policy, busy, 1U, 50U, 0U, &res);
+  TEST_EQUAL(res.profile, CLK_PROFILE_100MHZ);
+  TEST_EQUAL(res.switches, 2U);
+  TEST_ASSERT(res.window_top >= 48U);
+
+  // Light periodic load fits into 12 MHz without ping-pong
+  simReset(&policy, CLK_PROFILE_100MHZ);
+  simRun(&policy, periodic, 10U, 20U, 0U, &res);
+  TEST_EQUAL(res.profile, CLK_PROFILE_48MHZ);
+  TEST_ASSERT(res.switches <= 4U);
+
+  // Bursts: step up on the first overloaded window, step down when quiet
+  simReset(&policy, CLK_PROFILE_12MHZ);
+  simRun(&policy, burst, 20U, 10U, 0U, &res);
+  TEST_ASSERT(res.overload <= 10U);               // At most one per burst
+  TEST_EQUAL(res.profile, CLK_PROFILE_12MHZ);
+  TEST_ASSERT(res.switches <= 40U);
+
+  // Driver constraint is a floor independent of the load
+  simReset(&policy, CLK_PROFILE_12MHZ);
+  simRun(&policy, idle, 1U, 20U, CLK_PROFILE_48MHZ, &res);
+  TEST_EQUAL(res.profile, CLK_PROFILE_48MHZ);
+
+  // Step down needs GOV_DOWN_HOLD quiet windows in a row
+  simReset(&policy, CLK_PROFILE_48MHZ);
+  for (n = 1U; n < GOV_DOWN_HOLD; n++) {
+    TEST_EQUAL(govPolicy(&policy, 0U, 0U), CLK_PROFILE_48MHZ);
+  }
+  TEST_EQUAL(govPolicy(&policy, 0U, 0U), CLK_PROFILE_12MHZ);
+
+  // A single peak steps up immediately, even with a low average
+  simReset(&policy, CLK_PROFILE_12MHZ);
+  TEST_EQUAL(govPolicy(&policy, GOV_UP_LOAD + 1U, 0U), CLK_PROFILE_48MHZ);
+  TEST_EQUAL(govPolicy(&policy, 50U, 0U), CLK_PROFILE_48MHZ);
+
+  return testReport("test_governor");
+}
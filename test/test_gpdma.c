@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_gpdma.c
+ * Purpose: Unit test of the GPDMA channel allocator and linked list check
+ *----------------------------------------------------------------------------*/
+
+#include <sys/mman.h>
+#include "test.h"
+#include "stubs.h"
+#include "gpdma.h"
+
+#define AHB_SRAM                0x2007C000U
+#define LOCAL_SRAM              0x10000000U
+
+static void testAllocCore (void) {
+  uint32_t used;
+  uint32_t n;
+
+  // Empty: high priority from channel 0, low priority from channel 7
+  TEST_EQUAL(dmaAllocCore(0x00U, DMA_PRIO_HIGH), 0);
+  TEST_EQUAL(dmaAllocCore(0x00U, DMA_PRIO_LOW),  7);
+
+  // First free channel in the search direction
+  TEST_EQUAL(dmaAllocCore(0x07U, DMA_PRIO_HIGH), 3);
+  TEST_EQUAL(dmaAllocCore(0xE0U, DMA_PRIO_LOW),  4);
+  TEST_EQUAL(dmaAllocCore(0x7FU, DMA_PRIO_HIGH), 7);
+  TEST_EQUAL(dmaAllocCore(0xFEU, DMA_PRIO_LOW),  0);
+
+  // Full
+  TEST_EQUAL(dmaAllocCore(0xFFU, DMA_PRIO_HIGH), -1);
+  TEST_EQUAL(dmaAllocCore(0xFFU, DMA_PRIO_LOW),  -1);
+
+  // Every mask: result is free and no free channel is skipped
+  for (used = 0U; used < 0xFFU; used++) {
+    n = (uint32_t)dmaAllocCore(used, DMA_PRIO_HIGH);
+    TEST_ASSERT((n < DMA_CH_NUM) && ((used & (1UL << n)) == 0U) &&
+                ((used & ((1UL << n) - 1U)) == ((1UL << n) - 1U)));
+    n = (uint32_t)dmaAllocCore(used, DMA_PRIO_LOW);
+    TEST_ASSERT((n < DMA_CH_NUM) && ((used & (1UL << n)) == 0U) &&
+                ((used >> (n + 1U)) == (0xFFU >> (n + 1U))));
+  }
+}
+
+static void testLliCheck (void) {
+  static dmaLli_t lli[4];
+  dmaLli_t       *local;
+  uint32_t        n;
+
+  for (n = 0U; n < 4U; n++) {
+    lli[n].src  = AHB_SRAM + (n * 0x100U);
+    lli[n].dst  = 0x4000C000U;          // UART0 THR
+    lli[n].next = (n < 3U) ? &lli[n + 1U] : NULL;
+  }
+  TEST_EQUAL(dmaLliCheck(NULL), 0);
+  TEST_EQUAL(dmaLliCheck(&lli[0]), 0);
+
+  // Buffer in local SRAM: first item and a later item
+  lli[0].src = LOCAL_SRAM + 0x100U;
+  TEST_EQUAL(dmaLliCheck(&lli[0]), -1);
+  lli[0].src = AHB_SRAM;
+  lli[3].dst = LOCAL_SRAM + 0x7FFCU;
+  TEST_EQUAL(dmaLliCheck(&lli[0]), -1);
+  TEST_EQUAL(dmaLliCheck(&lli[1]), -1);
+  lli[3].dst = 0x4000C000U;
+
+  // Ring (circular receive buffer): terminates, checks every item
+  lli[3].next = &lli[0];
+  TEST_EQUAL(dmaLliCheck(&lli[0]), 0);
+  TEST_EQUAL(dmaLliCheck(&lli[2]), 0);
+  lli[3].src = LOCAL_SRAM;
+  TEST_EQUAL(dmaLliCheck(&lli[0]), -1);
+  TEST_EQUAL(dmaLliCheck(&lli[3]), -1);
+  lli[3].src = AHB_SRAM;
+
+  // Loop back to a middle item (tail 0, 1 then 2, 3, 2, ...)
+  lli[3].next = &lli[2];
+  TEST_EQUAL(dmaLliCheck(&lli[0]), 0);
+  lli[2].dst = LOCAL_SRAM;
+  TEST_EQUAL(dmaLliCheck(&lli[0]), -1);
+  lli[2].dst = 0x4000C000U;
+
+  // Item linking to itself
+  lli[0].next = &lli[0];
+  TEST_EQUAL(dmaLliCheck(&lli[0]), 0);
+  lli[0].next = &lli[1];
+
+  // Misaligned item fetched by the hardware
+  lli[1].next = (const dmaLli_t *)((uint8_t *)&lli[2] + 2);
+  TEST_EQUAL(dmaLliCheck(&lli[0]), -1);
+  lli[1].next = &lli[2];
+
+  // Item placed in local SRAM: allowed first (read by the CPU), not later
+  local = mmap((void *)(uintptr_t)LOCAL_SRAM, 4096U, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  if (local == (void *)(uintptr_t)LOCAL_SRAM) {
+    lli[3].next = NULL;
+    *local      = lli[0];
+    TEST_EQUAL(dmaLliCheck(local), 0);
+    lli[3].next = local;
+    local->next = NULL;
+    TEST_EQUAL(dmaLliCheck(&lli[0]), -1);
+    munmap(local, 4096U);
+  } else {
+    printf("test_gpdma: local SRAM address not mappable, placement check skipped\n");
+  }
+}
+
+int main (void) {
+  testAllocCore();
+  testLliCheck();
+  return testReport("test_gpdma");
+}
@@ -0,0 +1,272 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_i2c.c
+ * Purpose: Unit test of the I2C engine against the I2C1 bus model
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "i2c_engine.h"
+#include "i2c_slave.h"
+
+/*
+  The engine runs on the bus model in stubs/i2c_slave.c and on the real
+  timer wheel, driven tick by tick through RIT_IRQHandler. A 400 kHz bus
+  moves about 40 bytes per 1 ms tick; simTick lets the bus run SIM_EVENTS
+  events after each tick.
+*/
+#define SIM_EVENTS              40U
+
+extern void RIT_IRQHandler (void);
+
+static i2cXfer_t *simDone[8];           // Completion order
+static uint32_t   simDoneNum;
+
+static void simCallback (i2cXfer_t *xfer) {
+  if (simDoneNum < 8U) {
+    simDone[simDoneNum] = xfer;
+  }
+  simDoneNum++;
+}
+
+static void simTick (uint32_t ticks, uint32_t events) {
+  while (ticks-- != 0U) {
+    RIT_IRQHandler();
+    (void)simI2cRun(events);
+  }
+}
+
+static void simXfer (i2cXfer_t *xfer, const i2cSeg_t *seg, uint8_t seg_num) {
+  memset(xfer, 0, sizeof(i2cXfer_t));
+  xfer->seg     = seg;
+  xfer->seg_num = seg_num;
+  xfer->cb      = simCallback;
+}
+
+int main (void) {
+  static uint8_t    wr[4]  = { 0x10U, 0xA1U, 0xA2U, 0xA3U };
+  static uint8_t    reg    = 0x10U;
+  static uint8_t    rd[6];
+  static uint8_t    one[1];
+  static i2cSeg_t   segWrite[1]  = { { wr, 4U, SIM_I2C_ADDR, I2C_WRITE } };
+  static i2cSeg_t   segRead[2]   = { { &reg, 1U, SIM_I2C_ADDR, I2C_WRITE },
+                                     { rd,   6U, SIM_I2C_ADDR, I2C_READ  } };
+  static i2cSeg_t   segOne[2]    = { { &reg, 1U, SIM_I2C_ADDR, I2C_WRITE },
+                                     { one,  1U, SIM_I2C_ADDR, I2C_READ  } };
+  static i2cSeg_t   segChain[3]  = { { wr,   4U, SIM_I2C_ADDR, I2C_WRITE },
+                                     { &reg, 1U, SIM_I2C_ADDR, I2C_WRITE },
+                                     { rd,   3U, SIM_I2C_ADDR, I2C_READ  } };
+  static i2cSeg_t   segOther[1]  = { { wr, 4U, 0x50U, I2C_WRITE } };
+  static i2cSeg_t   segProbe[1]  = { { one, 1U, 0x50U, I2C_READ } };
+  i2cXfer_t         x[4];
+  i2cXfer_t        *bx[2];
+  i2cBatch_t        batch;
+  i2cStats_t        stats;
+  simI2cStats_t     bus;
+  uint32_t          n;
+
+  // Timeouts and batches need the wheel
+  TEST_EQUAL(i2cInit(), -1);
+  TEST_EQUAL(twInit(), 0);
+  TEST_EQUAL(i2cInit(), 0);
+  TEST_EQUAL(simI2c()->I2SCLH, ((SystemCoreClock / 4U) + (2U * I2C_RATE_HZ) - 1U) / (2U * I2C_RATE_HZ));
+  TEST_EQUAL(simI2c()->I2SCLL, simI2c()->I2SCLH);
+
+  // Invalid transactions
+  simXfer(&x[0], NULL, 1U);
+  TEST_EQUAL(i2cSubmit(&x[0]), -1);
+  simXfer(&x[0], segWrite, 0U);
+  TEST_EQUAL(i2cSubmit(&x[0]), -1);
+
+  // Write: start, address, 4 bytes, stop
+  for (n = 0U; n < 256U; n++) {
+    simI2cMem[n] = (uint8_t)(n ^ 0x5AU);
+  }
+  simXfer(&x[0], segWrite, 1U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  TEST_EQUAL(x[0].status, I2C_PENDING);
+  TEST_EQUAL(i2cSubmit(&x[0]), -1);     // Still pending
+  (void)simI2cRun(100U);
+  TEST_EQUAL(x[0].status, I2C_OK);
+  TEST_EQUAL(simDoneNum, 1U);
+  TEST_EQUAL(simI2cMem[0x10], 0xA1U);
+  TEST_EQUAL(simI2cMem[0x11], 0xA2U);
+  TEST_EQUAL(simI2cMem[0x12], 0xA3U);
+  TEST_EQUAL(simI2cStats.starts, 1U);
+  TEST_EQUAL(simI2cStats.stops, 1U);
+  TEST_EQUAL(simI2cIdle(), 1U);
+
+  // Register read: repeated start, last byte NACKed
+  simXfer(&x[0], segRead, 2U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  (void)simI2cRun(100U);
+  TEST_EQUAL(x[0].status, I2C_OK);
+  TEST_EQUAL(rd[0], 0xA1U);
+  TEST_EQUAL(rd[2], 0xA3U);
+  TEST_EQUAL(rd[5], 0x15U ^ 0x5AU);
+  TEST_EQUAL(simI2cStats.restarts, 1U);
+  TEST_EQUAL(simI2cStats.rx_bytes, 6U);
+  TEST_EQUAL(simI2cStats.stops, 2U);
+  TEST_EQUAL(simI2cIdle(), 1U);
+
+  // Single byte read: NACK right after the address
+  simXfer(&x[0], segOne, 2U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  (void)simI2cRun(100U);
+  TEST_EQUAL(x[0].status, I2C_OK);
+  TEST_EQUAL(one[0], 0xA1U);
+  TEST_EQUAL(simI2cStats.rx_bytes, 7U);
+
+  // Three segments: two repeated starts, one stop
+  bus = simI2cStats;
+  wr[1] = 0xB1U;
+  simXfer(&x[0], segChain, 3U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  (void)simI2cRun(100U);
+  TEST_EQUAL(x[0].status, I2C_OK);
+  TEST_EQUAL(simI2cStats.starts - bus.starts, 1U);
+  TEST_EQUAL(simI2cStats.restarts - bus.restarts, 2U);
+  TEST_EQUAL(simI2cStats.stops - bus.stops, 1U);
+  TEST_EQUAL(rd[0], 0xB1U);
+  TEST_EQUAL(rd[2], 0xA3U);
+
+  // Address not acknowledged (write and read), stop sent
+  bus = simI2cStats;
+  simXfer(&x[0], segOther, 1U);
+  simXfer(&x[1], segProbe, 1U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  TEST_EQUAL(i2cSubmit(&x[1]), 0);
+  (void)simI2cRun(100U);
+  TEST_EQUAL(x[0].status, I2C_ERR_NACK);
+  TEST_EQUAL(x[1].status, I2C_ERR_NACK);
+  TEST_EQUAL(simI2cStats.stops - bus.stops, 2U);
+  TEST_EQUAL(simI2cStats.tx_bytes, bus.tx_bytes);
+
+  // Data byte not acknowledged
+  simI2cNackAfter = 2U;
+  simXfer(&x[0], segWrite, 1U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  (void)simI2cRun(100U);
+  simI2cNackAfter = 0U;
+  TEST_EQUAL(x[0].status, I2C_ERR_NACK);
+  TEST_EQUAL(simI2cStats.tx_bytes - bus.tx_bytes, 2U);
+  i2cGetStats(&stats);
+  TEST_EQUAL(stats.nacks, 3U);
+  TEST_EQUAL(simI2cIdle(), 1U);
+
+  // Arbitration lost: no stop of our own, the queue goes on in order
+  bus = simI2cStats;
+  simDoneNum = 0U;
+  simI2cFault(SIM_I2C_ARB_LOST);
+  simXfer(&x[0], segWrite, 1U);
+  simXfer(&x[1], segRead, 2U);
+  simXfer(&x[2], segWrite, 1U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  TEST_EQUAL(i2cSubmit(&x[1]), 0);
+  TEST_EQUAL(i2cSubmit(&x[2]), 0);
+  (void)simI2cRun(200U);
+  TEST_EQUAL(x[0].status, I2C_ERR_BUS);
+  TEST_EQUAL(x[1].status, I2C_OK);
+  TEST_EQUAL(x[2].status, I2C_OK);
+  TEST_EQUAL(simDoneNum, 3U);
+  TEST_ASSERT((simDone[0] == &x[0]) && (simDone[1] == &x[1]) && (simDone[2] == &x[2]));
+  TEST_EQUAL(simI2cStats.starts - bus.starts, 3U);
+  TEST_EQUAL(simI2cStats.stops - bus.stops, 2U);
+  i2cGetStats(&stats);
+  TEST_EQUAL(stats.bus_errors, 1U);
+  TEST_EQUAL(stats.queue_max, 2U);
+
+  // Bus error: stop to recover
+  simI2cFault(SIM_I2C_BUS_ERROR);
+  simXfer(&x[0], segRead, 2U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  (void)simI2cRun(100U);
+  TEST_EQUAL(x[0].status, I2C_ERR_BUS);
+  TEST_EQUAL(simI2cIdle(), 1U);
+
+  // Bus fits a transaction into one tick: the timeout never fires
+  simXfer(&x[0], segRead, 2U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  simTick(3U * I2C_TIMEOUT_TICKS, SIM_EVENTS);
+  TEST_EQUAL(x[0].status, I2C_OK);
+
+  // Slave holds the bus: the timeout resets the interface
+  simI2cFault(SIM_I2C_STALL);
+  bus = simI2cStats;
+  simXfer(&x[0], segRead, 2U);
+  simXfer(&x[1], segRead, 2U);
+  TEST_EQUAL(i2cSubmit(&x[0]), 0);
+  TEST_EQUAL(i2cSubmit(&x[1]), 0);
+  simTick(I2C_TIMEOUT_TICKS, SIM_EVENTS);
+  TEST_EQUAL(x[0].status, I2C_PENDING);
+  simI2cFault(SIM_I2C_OK);
+  RIT_IRQHandler();                     // Tick I2C_TIMEOUT_TICKS + 1
+  TEST_EQUAL(x[0].status, I2C_ERR_TIMEOUT);
+  TEST_EQUAL(simI2cStats.resets - bus.resets, 1U);
+  i2cGetStats(&stats);
+  TEST_EQUAL(stats.timeouts, 1U);
+
+  // The next transaction was started by the timeout with a new timer:
+  // a slow bus (two events per tick) still finishes it in time
+  simTick(I2C_TIMEOUT_TICKS, 2U);
+  TEST_EQUAL(x[1].status, I2C_OK);
+  simTick(3U * I2C_TIMEOUT_TICKS, SIM_EVENTS);
+  i2cGetStats(&stats);
+  TEST_EQUAL(stats.timeouts, 1U);
+  TEST_EQUAL(simI2cIdle(), 1U);
+
+  // Periodic batch of two reads
+  simXfer(&x[0], segRead, 2U);
+  simXfer(&x[1], segOne, 2U);
+  x[0].status = I2C_OK;
+  x[1].status = I2C_OK;
+  bx[0] = &x[0];
+  bx[1] = &x[1];
+  memset(&batch, 0, sizeof(batch));
+  batch.xfer = bx;
+  batch.num  = 2U;
+  TEST_EQUAL(i2cBatchStart(NULL, 5U), -1);
+  TEST_EQUAL(i2cBatchStart(&batch, 0U), -1);
+  TEST_EQUAL(i2cBatchStart(&batch, 5U), 0);
+  simDoneNum = 0U;
+  simTick(5U * 4U + 1U, SIM_EVENTS);
+  TEST_EQUAL(batch.runs, 4U);
+  TEST_EQUAL(batch.overruns, 0U);
+  TEST_EQUAL(simDoneNum, 8U);
+  TEST_EQUAL(x[0].status, I2C_OK);
+  TEST_EQUAL(x[1].status, I2C_OK);
+
+  // Batch overrun: on a slow bus a run takes longer than the period, the
+  // next one is skipped while it is pending
+  simTick(5U * 4U, 2U);
+  TEST_EQUAL(batch.runs + batch.overruns, 8U);
+  TEST_ASSERT(batch.overruns != 0U);
+  i2cGetStats(&stats);
+  TEST_EQUAL(stats.timeouts, 1U);
+  n = batch.runs;
+  i2cBatchStop(&batch);
+  simTick(3U * I2C_TIMEOUT_TICKS, SIM_EVENTS);
+  TEST_EQUAL(batch.runs, n);
+  TEST_EQUAL(x[0].status, I2C_OK);
+  TEST_EQUAL(x[1].status, I2C_OK);
+  TEST_EQUAL(simI2cIdle(), 1U);
+
+  return testReport("test_i2c");
+}
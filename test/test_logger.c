@@ -0,0 +1,330 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_logger.c
+ * Purpose: Round trip test of the binary logger and the host decoder
+ *----------------------------------------------------------------------------*/
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "gpdma.h"
+#include "logger.h"
+#include "lg_decode.h"
+
+/*
+  Every record is also formatted with snprintf when it is written. The
+  worker runs until the ring is empty (the wait for new data ends the run),
+  its DMA transfers are appended to one capture buffer, and the format
+  strings come from section .logstr of this test program. The build links
+  without PIE so that addresses fit the 32-bit fields of the wire format.
+*/
+#define SIM_EXP_MAX             400U
+#define SIM_STREAM_MAX          (SIM_EXP_MAX * LGD_FRAME_MAX)
+#define SIM_DMA_CH              7
+#define SIM_TX_SIZE             512U    // LG_TX_SIZE of logger.c
+
+typedef struct {
+  uint32_t level;
+  uint32_t nargs;
+  uint32_t ts;
+  char     text[96];
+} simExp_t;
+
+typedef struct {
+  uint32_t idx;                         // Expected record
+  uint32_t mismatch;
+  uint32_t drops;                       // Drop reports received
+} simCheck_t;
+
+static jmp_buf       simStop;
+static uint32_t      simRand = 4711U;
+static simExp_t      simExp[SIM_EXP_MAX];
+static uint32_t      simExpNum;
+static uint8_t       simStream[SIM_STREAM_MAX];
+static uint32_t      simStreamLen;
+static uint32_t      simFrameOff[SIM_EXP_MAX + 1U];
+static uint32_t      simTransfers;
+static uint32_t      simBadDma;
+static dmaCallback_t simDmaCb;
+static void         *simDmaArg;
+static lgdStrings_t  simStr;
+
+static const char    simProbe[] __attribute__((section(".logstr"), used)) = "probe %u";
+
+static uint32_t simNext (void) {
+  simRand = (simRand * 1103515245U) + 12345U;
+  return simRand >> 8;
+}
+
+/*-----------------------------------------------------------------------------
+  Expected output of the record written next (skipped below the filter)
+ *----------------------------------------------------------------------------*/
+static void simExpect (uint32_t level, uint32_t nargs, const char *fmt, ...)
+  __attribute__((format(printf, 3, 4)));
+
+static void simExpect (uint32_t level, uint32_t nargs, const char *fmt, ...) {
+  va_list ap;
+
+  stubTick += 1U + (simNext() % 50U);
+  if ((level < lgLevel) || (simExpNum >= SIM_EXP_MAX)) {
+    return;
+  }
+  simExp[simExpNum].level = level;
+  simExp[simExpNum].nargs = nargs;
+  simExp[simExpNum].ts    = stubTick * 1000U;
+  va_start(ap, fmt);
+  vsnprintf(simExp[simExpNum].text, sizeof(simExp[0].text), fmt, ap);
+  va_end(ap);
+  simExpNum++;
+}
+
+#define SIM_LOG(level, ...)                                                 \
+  do {                                                                      \
+    simExpect(level, LG_NARGS_(__VA_ARGS__), __VA_ARGS__);                  \
+    LG_LOG(level, __VA_ARGS__);                                             \
+  } while (0)
+
+/*-----------------------------------------------------------------------------
+  GPDMA and RTOS fakes for the worker
+ *----------------------------------------------------------------------------*/
+int32_t dmaAlloc (uint32_t prio, uint32_t req, dmaCallback_t cb, void *arg) {
+  if ((prio != DMA_PRIO_LOW) || (req != DMA_REQ_UART0_TX)) {
+    return -1;
+  }
+  simDmaCb  = cb;
+  simDmaArg = arg;
+  return SIM_DMA_CH;
+}
+
+void dmaFree (int32_t ch) {
+  (void)ch;
+}
+
+int32_t dmaStart (int32_t ch, const dmaLli_t *lli, uint32_t type) {
+  uint32_t len = lli->ctrl & 0xFFFU;
+
+  if ((ch != SIM_DMA_CH) || (type != DMA_M2P) || (len == 0U) || (len > SIM_TX_SIZE) ||
+      ((simStreamLen + len) > SIM_STREAM_MAX)) {
+    simBadDma++;
+    return -1;
+  }
+  memcpy(&simStream[simStreamLen], (const uint8_t *)(uintptr_t)lli->src, len);
+  simStreamLen += len;
+  simTransfers++;
+  simDmaCb(0U, simDmaArg);              // Transfer done at once
+  return 0;
+}
+
+uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout) {
+  (void)options;
+  (void)timeout;
+  if ((flags & 0x0002U) != 0U) {
+    longjmp(simStop, 1);                // Ring empty: end of this run
+  }
+  return flags;
+}
+
+static void simRun (void) {
+  if (setjmp(simStop) == 0) {
+    stubThreadFunc[0](NULL);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Compare decoded records with the expectations
+ *----------------------------------------------------------------------------*/
+static void simOut (const lgdRecord_t *rec, void *arg) {
+  simCheck_t *chk = arg;
+  char        text[128];
+
+  chk->idx += rec->gap;
+  if (rec->fmt == 0U) {
+    chk->drops++;
+  }
+  lgdText(&simStr, rec, text, sizeof(text));
+  if ((chk->idx >= simExpNum) || (rec->level != simExp[chk->idx].level) ||
+      (rec->nargs != simExp[chk->idx].nargs) || (rec->ts != simExp[chk->idx].ts) ||
+      (rec->seq != (chk->idx & 0xFFU)) || (strcmp(text, simExp[chk->idx].text) != 0)) {
+    if (chk->mismatch++ == 0U) {
+      printf("record %u: \"%s\", expected \"%s\"\n", (unsigned int)chk->idx, text,
+             (chk->idx < simExpNum) ? simExp[chk->idx].text : "");
+    }
+  }
+  chk->idx++;
+}
+
+static void simRecords (uint32_t num) {
+  uint32_t n;
+  uint32_t a;
+  uint32_t b;
+
+  for (n = 0U; n < num; n++) {
+    a = simNext();
+    b = simNext();
+    switch (a % 6U) {
+      case 0U: SIM_LOG(LG_LEVEL_INFO,  "tick"); break;
+      case 1U: SIM_LOG(LG_LEVEL_WARN,  "adc %u out of range: %d", a & 7U, (int32_t)b - 0x800000); break;
+      case 2U: SIM_LOG(LG_LEVEL_ERROR, "reg 0x%08X = %x (%c)", a, b, (int)('A' + (b % 26U))); break;
+      case 3U: SIM_LOG(LG_LEVEL_INFO,  "%u/%u/%u/%u", a, b, a ^ b, a + b); break;
+      case 4U: SIM_LOG(LG_LEVEL_WARN,  "[%5u] [%-4d] 100%%", b % 1000U, (int32_t)(a % 200U) - 100); break;
+      default: SIM_LOG(LG_LEVEL_INFO,  "%+d", (int32_t)a); break;
+    }
+  }
+}
+
+static void testFormat (void) {
+  static const uint32_t args[4] = { 7U, 0xFFFFFFFEU, 0x41U, 12U };
+  lgdRecord_t           rec;
+  char                  text[64];
+
+  TEST_EQUAL(lgdFormat(text, sizeof(text), "%lu %ld %hhc %%", args, 3U), 8U);
+  TEST_EQUAL(strcmp(text, "7 -2 A %"), 0);
+  TEST_EQUAL(lgdFormat(text, sizeof(text), "[%*u] %u %u", args, 2U), 32U);
+  TEST_EQUAL(strcmp(text, "[4294967294] <missing> <missing>"), 0);
+  TEST_EQUAL(lgdFormat(text, sizeof(text), "%s %p", args, 2U), 21U);
+  TEST_EQUAL(strcmp(text, "0x00000007 0xFFFFFFFE"), 0);
+  TEST_EQUAL(lgdFormat(text, 6U, "%u%u%u", &args[3], 1U), 5U);
+  TEST_EQUAL(strcmp(text, "12<mi"), 0);
+
+  memset(&rec, 0, sizeof(rec));
+  rec.fmt   = 0x1234U;
+  rec.nargs = 1U;
+  rec.args[0] = 5U;
+  lgdText(&simStr, &rec, text, sizeof(text));
+  TEST_EQUAL(strcmp(text, "<unknown format 0x00001234> 0x00000005"), 0);
+  rec.fmt = 0U;
+  lgdText(&simStr, &rec, text, sizeof(text));
+  TEST_EQUAL(strcmp(text, "5 records dropped"), 0);
+  rec.fmt = (uint32_t)(uintptr_t)simProbe;
+  lgdText(&simStr, &rec, text, sizeof(text));
+  TEST_EQUAL(strcmp(text, "probe 5"), 0);
+}
+
+int main (void) {
+  static lgDecoder_t dec;
+  simCheck_t         chk;
+  lgStats_t          stats;
+  uint32_t           written;
+  uint32_t           drop;
+  uint32_t           n;
+  uint32_t           k;
+  uint32_t           cut;
+  uint32_t           skip;
+
+  TEST_EQUAL(lgdLoadElf(&simStr, "/proc/self/exe"), 0);
+  TEST_ASSERT(lgdLookup(&simStr, (uint32_t)(uintptr_t)simProbe) == &simStr.data[simProbe - (const char *)(uintptr_t)simStr.addr]);
+  TEST_ASSERT(lgdLookup(&simStr, simStr.addr + simStr.size) == NULL);
+  testFormat();
+
+  stubTick = 100U;
+  TEST_EQUAL(lgInit(), 0);
+
+  // Every argument count, the default filter drops debug records
+  SIM_LOG(LG_LEVEL_INFO,  "started");
+  SIM_LOG(LG_LEVEL_DEBUG, "not sent %u", 1U);
+  SIM_LOG(LG_LEVEL_WARN,  "one %u", 1U);
+  SIM_LOG(LG_LEVEL_ERROR, "two %d %d", -1, 2);
+  SIM_LOG(LG_LEVEL_INFO,  "three %x %X %o", 0xABCU, 0xDEFU, 8U);
+  SIM_LOG(LG_LEVEL_INFO,  "four %u %u %u %u", 1U, 22U, 333U, 4444U);
+  simRun();
+  TEST_EQUAL(simExpNum, 5U);
+
+  // Level filter at the call site
+  lgSetLevel(LG_LEVEL_WARN);
+  SIM_LOG(LG_LEVEL_INFO, "filtered");
+  SIM_LOG(LG_LEVEL_WARN, "passed %u", 2U);
+  lgSetLevel(LG_LEVEL_OFF);
+  lgGetStats(&stats);
+  written = stats.written;
+  SIM_LOG(LG_LEVEL_ERROR, "off");
+  lgGetStats(&stats);
+  TEST_EQUAL(stats.written, written);
+  lgSetLevel(LG_LEVEL_DEBUG);
+  SIM_LOG(LG_LEVEL_DEBUG, "debug %u", 3U);
+  simRun();
+  TEST_EQUAL(simExpNum, 7U);
+
+  // Batches of up to two transmit buffers
+  for (n = 0U; n < 10U; n++) {
+    simRecords(1U + (simNext() % 40U));
+    simRun();
+  }
+
+  // Overflow: the report of the dropped records comes before the ring
+  drop = simExpNum;
+  simExpect(LG_LEVEL_WARN, 1U, "%u records dropped", 10U);
+  simRecords(LG_RING_SIZE);
+  for (n = 0U; n < 10U; n++) {
+    LG_LOG(LG_LEVEL_ERROR, "lost %u", n);
+  }
+  simExp[drop].ts = stubTick * 1000U;
+  simRun();
+  lgGetStats(&stats);
+  TEST_EQUAL(stats.dropped, 10U);
+  TEST_EQUAL(stats.sent, simExpNum - 1U);
+  TEST_EQUAL(stats.ring_max, LG_RING_SIZE);
+
+  simRecords(20U);
+  simRun();
+  TEST_EQUAL(simBadDma, 0U);
+  TEST_ASSERT(simTransfers > (simStreamLen / SIM_TX_SIZE));
+  TEST_ASSERT(simExpNum > 200U);
+  TEST_ASSERT(simExpNum < SIM_EXP_MAX);
+
+  for (n = 0U; n < simExpNum; n++) {
+    simFrameOff[n + 1U] = simFrameOff[n] + 11U + (4U * simExp[n].nargs);
+  }
+  TEST_EQUAL(simFrameOff[simExpNum], simStreamLen);
+
+  // Whole stream in random chunks
+  memset(&chk, 0, sizeof(chk));
+  lgdInit(&dec, simOut, &chk);
+  for (n = 0U; n < simStreamLen; n += k) {
+    k = 1U + (simNext() % 37U);
+    k = ((simStreamLen - n) < k) ? (simStreamLen - n) : k;
+    lgdPut(&dec, &simStream[n], k);
+  }
+  TEST_EQUAL(chk.mismatch, 0U);
+  TEST_EQUAL(chk.idx, simExpNum);
+  TEST_EQUAL(chk.drops, 1U);
+  TEST_EQUAL(dec.stats.records, simExpNum);
+  TEST_EQUAL(dec.stats.dropped, 10U);
+  TEST_EQUAL(dec.stats.lost, 0U);
+  TEST_EQUAL(dec.stats.errors, 0U);
+
+  // Start inside frame 3, lose frames 100 to 109 and the start of 110
+  memset(&chk, 0, sizeof(chk));
+  chk.idx = 4U;
+  lgdInit(&dec, simOut, &chk);
+  skip = simFrameOff[3] + 5U;
+  cut  = simFrameOff[110] + 7U;
+  lgdPut(&dec, &simStream[skip], simFrameOff[100] - skip);
+  lgdPut(&dec, &simStream[cut], simStreamLen - cut);
+  TEST_EQUAL(chk.mismatch, 0U);
+  TEST_EQUAL(chk.idx, simExpNum);
+  TEST_EQUAL(dec.stats.records, simExpNum - 4U - 11U);
+  TEST_EQUAL(dec.stats.lost, 11U);
+  TEST_EQUAL(dec.stats.errors, (simFrameOff[4] - skip) + (simFrameOff[111] - cut));
+
+  lgdFree(&simStr);
+  return testReport("test_logger");
+}
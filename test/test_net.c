@@ -0,0 +1,369 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_net.c
+ * Purpose: Network stack and its MAC glue on the loopback model
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "net.h"
+#include "net_emac.h"
+#include "emac_loop.h"
+
+/*
+  The stack runs exactly as on the target (net_emac.c: network thread,
+  transmit lock, echo and discard ports) with emac.c replaced by the
+  loopback model in stubs/emac_loop.c. The peer is 192.168.1.2, the
+  gateway 192.168.1.1; both answer ARP, any other address does not.
+*/
+#define SIM_IP                  NET_IP(192, 168, 1, 10)
+#define SIM_PORT                5000U
+
+static const netConfig_t simCfg = {
+  { 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x10U }, SIM_IP, NET_IP(255, 255, 255, 0), LOOP_GW_IP
+};
+
+static uint8_t  simData[NET_UDP_MAX];
+static uint8_t  simRecv[NET_UDP_MAX];
+static uint32_t simRecvLen;
+static uint32_t simRecvIp;
+static uint32_t simRecvPort;
+static uint32_t simRecvNum;
+
+static void simUdpRecv (const uint8_t *data, uint32_t len, uint32_t ip, uint16_t port, void *arg) {
+  TEST_ASSERT(arg == &simRecvNum);
+  memcpy(simRecv, data, len);
+  simRecvLen  = len;
+  simRecvIp   = ip;
+  simRecvPort = port;
+  simRecvNum++;
+}
+
+static uint32_t get16 (const uint8_t *p) {
+  return ((uint32_t)p[0] << 8) | p[1];
+}
+
+static uint32_t get32 (const uint8_t *p) {
+  return (get16(&p[0]) << 16) | get16(&p[2]);
+}
+
+// New IPv4 header checksum after a test edited the header
+static void reseal (uint8_t *frame) {
+  uint32_t sum;
+
+  frame[14 + 10] = 0U;
+  frame[14 + 11] = 0U;
+  sum = loopChecksum(&frame[14], 20U);
+  frame[14 + 10] = (uint8_t)(sum >> 8);
+  frame[14 + 11] = (uint8_t)sum;
+}
+
+static netStats_t stats (void) {
+  netStats_t s;
+  netGetStats(&s);
+  return s;
+}
+
+// Last frame from the stack: valid IPv4 from SIM_IP to dst, returns the payload
+static const uint8_t *checkIp (uint32_t proto, uint32_t dst, const uint8_t *mac, uint32_t len) {
+  const uint8_t *ip = &loopTxFrame[14];
+
+  TEST_EQUAL(loopTxLen, 14U + 20U + len);
+  TEST_ASSERT(memcmp(&loopTxFrame[0], mac, 6U) == 0);
+  TEST_ASSERT(memcmp(&loopTxFrame[6], simCfg.mac, 6U) == 0);
+  TEST_EQUAL(get16(&loopTxFrame[12]), 0x0800U);
+  TEST_EQUAL(ip[0], 0x45U);
+  TEST_EQUAL(get16(&ip[2]), 20U + len);
+  TEST_EQUAL(get16(&ip[6]), 0x4000U);
+  TEST_EQUAL(ip[9], proto);
+  TEST_EQUAL(loopChecksum(ip, 20U), 0U);
+  TEST_EQUAL(get32(&ip[12]), SIM_IP);
+  TEST_EQUAL(get32(&ip[16]), dst);
+  return &ip[20];
+}
+
+/*-----------------------------------------------------------------------------
+  Start: network thread and ports
+ *----------------------------------------------------------------------------*/
+static void testStart (void) {
+  TEST_EQUAL(neStart(&simCfg), 0);
+  TEST_EQUAL(stubThreadNum, 1U);
+  TEST_EQUAL(udpBind(SIM_PORT, simUdpRecv, &simRecvNum), 0);
+  TEST_EQUAL(udpBind(SIM_PORT + 1U, simUdpRecv, &simRecvNum), 0);
+  TEST_EQUAL(udpBind(SIM_PORT + 2U, simUdpRecv, &simRecvNum), -1);   // NET_UDP_PORTS
+  TEST_EQUAL(udpBind(SIM_PORT + 1U, NULL, NULL), 0);
+  loopRun();                                                          // Idle thread returns
+  TEST_EQUAL(stats().rx_frames, 0U);
+}
+
+/*-----------------------------------------------------------------------------
+  neBenchTx: the first datagram resolves the peer, osDelay lets the reply in
+ *----------------------------------------------------------------------------*/
+static void testBenchTx (void) {
+  neBench_t r;
+
+  TEST_EQUAL(neBenchTx(LOOP_PEER_IP, 9U, 100U, 50U, &r), 0);
+  TEST_EQUAL(r.frames, 50U);
+  TEST_EQUAL(r.bytes, 5000U);
+  TEST_EQUAL(r.busy, 0U);
+  TEST_EQUAL(stats().arp_misses, 1U);
+  TEST_EQUAL(loopStats.arp_requests, 1U);
+  TEST_EQUAL(loopStats.udp_frames, 50U);
+  TEST_EQUAL(loopStats.udp_bytes, 5000U);
+  (void)checkIp(17U, LOOP_PEER_IP, loopPeerMac, 8U + 100U);
+
+  loopTxStall = 7U;
+  TEST_EQUAL(neBenchTx(LOOP_PEER_IP, 9U, NET_UDP_MAX, 10U, &r), 0);
+  TEST_EQUAL(r.frames, 10U);
+  TEST_EQUAL(r.busy, 7U);
+  TEST_EQUAL(stats().tx_busy, 7U);
+  TEST_EQUAL(loopStats.udp_bytes, 5000U + (10U * NET_UDP_MAX));
+
+  TEST_EQUAL(neBenchTx(LOOP_PEER_IP, 9U, 0U, 10U, &r), -1);
+  TEST_EQUAL(neBenchTx(LOOP_PEER_IP, 9U, NET_UDP_MAX + 1U, 10U, &r), -1);
+  TEST_EQUAL(neBenchTx(NET_IP(192, 168, 1, 3), 9U, 64U, 10U, &r), -1);  // Nobody answers
+  TEST_EQUAL(r.frames, 0U);
+}
+
+/*-----------------------------------------------------------------------------
+  ARP: requests for the stack are answered, unknown next hops are resolved
+ *----------------------------------------------------------------------------*/
+static void testArp (void) {
+  const uint8_t *arp = &loopTxFrame[14];
+  uint32_t       tx  = stats().tx_frames;
+  uint32_t       miss;
+  uint8_t       *p;
+
+  TEST_ASSERT(loopPeerArp(1U, SIM_IP) != NULL);
+  loopRun();
+  TEST_EQUAL(stats().tx_frames, tx + 1U);
+  TEST_EQUAL(loopTxLen, 42U);
+  TEST_ASSERT(memcmp(&loopTxFrame[0], loopPeerMac, 6U) == 0);
+  TEST_EQUAL(get16(&loopTxFrame[12]), 0x0806U);
+  TEST_EQUAL(get16(&arp[6]), 2U);
+  TEST_ASSERT(memcmp(&arp[8], simCfg.mac, 6U) == 0);
+  TEST_EQUAL(get32(&arp[14]), SIM_IP);
+  TEST_ASSERT(memcmp(&arp[18], loopPeerMac, 6U) == 0);
+  TEST_EQUAL(get32(&arp[24]), LOOP_PEER_IP);
+  TEST_EQUAL(loopStats.arp_replies, 1U);
+
+  TEST_ASSERT(loopPeerArp(1U, NET_IP(192, 168, 1, 11)) != NULL);      // Not for us
+  loopRun();
+  TEST_EQUAL(stats().tx_frames, tx + 1U);
+  TEST_EQUAL(stats().rx_arp, 3U);                                     // With the reply of testBenchTx
+
+  // Unknown host on the subnet: broadcast request instead of the datagram
+  miss = stats().arp_misses;
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(NET_IP(192, 168, 1, 4), 1U, 2U, 10U), -1);
+  TEST_EQUAL(stats().arp_misses, miss + 1U);
+  TEST_ASSERT(memcmp(&loopTxFrame[0], "\xFF\xFF\xFF\xFF\xFF\xFF", 6U) == 0);
+  TEST_EQUAL(get16(&arp[6]), 1U);
+  TEST_EQUAL(get32(&arp[24]), NET_IP(192, 168, 1, 4));
+
+  // Off the subnet: the gateway is resolved and used as next hop
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(NET_IP(10, 0, 0, 1), 1U, 2U, 10U), -1);
+  TEST_EQUAL(get32(&arp[24]), LOOP_GW_IP);
+  TEST_EQUAL(loopRxPending(), 1U);
+  loopRun();
+  p = udpAlloc();
+  TEST_ASSERT(p != NULL);
+  memset(p, 0xA5, 10U);
+  TEST_EQUAL(udpSend(NET_IP(10, 0, 0, 1), 1U, 2U, 10U), 0);
+  p = (uint8_t *)checkIp(17U, NET_IP(10, 0, 0, 1), loopGwMac, 18U);
+  TEST_EQUAL(p[8], 0xA5U);
+
+  // Unsolicited reply from the subnet is cached
+  p = loopPeerArp(2U, SIM_IP);
+  p[14 + 17] = 7U;                                                    // Sender 192.168.1.7
+  loopRun();
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(NET_IP(192, 168, 1, 7), 1U, 2U, 10U), 0);
+  TEST_ASSERT(memcmp(&loopTxFrame[0], loopPeerMac, 6U) == 0);
+}
+
+/*-----------------------------------------------------------------------------
+  udpAlloc/udpSend edge cases
+ *----------------------------------------------------------------------------*/
+static void testSend (void) {
+  uint32_t tx = stats().tx_frames;
+  uint8_t *p;
+
+  TEST_EQUAL(udpSend(LOOP_PEER_IP, 1U, 2U, 10U), -1);                 // No udpAlloc
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(LOOP_PEER_IP, 1U, 2U, 0U), 0);                   // Release only
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(LOOP_PEER_IP, 1U, 2U, NET_UDP_MAX + 1U), -1);
+  TEST_EQUAL(stats().tx_frames, tx);
+
+  loopTxStall = 1U;
+  TEST_ASSERT(udpAlloc() == NULL);
+  TEST_EQUAL(udpSend(LOOP_PEER_IP, 1U, 2U, 10U), -1);
+
+  // Subnet and limited broadcast need no ARP
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(NET_IP(192, 168, 1, 255), 1U, 2U, 4U), 0);
+  (void)checkIp(17U, NET_IP(192, 168, 1, 255), (const uint8_t *)"\xFF\xFF\xFF\xFF\xFF\xFF", 12U);
+  TEST_ASSERT(udpAlloc() != NULL);
+  TEST_EQUAL(udpSend(0xFFFFFFFFU, 1U, 2U, 4U), 0);
+  (void)checkIp(17U, 0xFFFFFFFFU, (const uint8_t *)"\xFF\xFF\xFF\xFF\xFF\xFF", 12U);
+
+  p = udpAlloc();
+  TEST_ASSERT(p != NULL);
+  memcpy(p, "abc", 3U);
+  TEST_EQUAL(udpSend(LOOP_PEER_IP, 1234U, 4321U, 3U), 0);
+  p = (uint8_t *)checkIp(17U, LOOP_PEER_IP, loopPeerMac, 11U);
+  TEST_EQUAL(get16(&p[0]), 4321U);
+  TEST_EQUAL(get16(&p[2]), 1234U);
+  TEST_EQUAL(get16(&p[4]), 11U);
+  TEST_ASSERT(memcmp(&p[8], "abc", 3U) == 0);
+  TEST_EQUAL(stats().tx_frames, tx + 3U);
+}
+
+/*-----------------------------------------------------------------------------
+  Echo port and ICMP echo: replies carry the request back
+ *----------------------------------------------------------------------------*/
+static void testEcho (void) {
+  static const uint32_t lens[] = { 1U, 18U, 64U, 513U, NET_UDP_MAX };
+  const uint8_t *p;
+  uint32_t       n;
+  uint32_t       id;
+
+  for (n = 0U; n < sizeof(simData); n++) {
+    simData[n] = (uint8_t)((n * 7U) + 3U);
+  }
+  for (n = 0U; n < (sizeof(lens) / sizeof(lens[0])); n++) {
+    TEST_ASSERT(loopPeerUdp(SIM_IP, NE_ECHO_PORT, 40000U, simData, lens[n]) != NULL);
+    loopRun();
+    p = checkIp(17U, LOOP_PEER_IP, loopPeerMac, 8U + lens[n]);
+    TEST_EQUAL(get16(&p[0]), NE_ECHO_PORT);
+    TEST_EQUAL(get16(&p[2]), 40000U);
+    TEST_EQUAL(get16(&p[4]), 8U + lens[n]);
+    TEST_ASSERT(memcmp(&p[8], simData, lens[n]) == 0);
+  }
+
+  // Consecutive datagrams get consecutive IP identifications
+  id = get16(&loopTxFrame[14 + 4]);
+  TEST_ASSERT(loopPeerUdp(SIM_IP, NE_ECHO_PORT, 40000U, simData, 4U) != NULL);
+  loopRun();
+  TEST_EQUAL(get16(&loopTxFrame[14 + 4]), (id + 1U) & 0xFFFFU);
+
+  for (n = 0U; n < (sizeof(lens) / sizeof(lens[0])); n++) {
+    TEST_ASSERT(loopPeerPing(SIM_IP, 0x1234U, (uint16_t)n, simData, lens[n]) != NULL);
+    loopRun();
+    p = checkIp(1U, LOOP_PEER_IP, loopPeerMac, 8U + lens[n]);
+    TEST_EQUAL(p[0], 0U);
+    TEST_EQUAL(get16(&p[4]), 0x1234U);
+    TEST_EQUAL(get16(&p[6]), n);
+    TEST_EQUAL(loopChecksum(p, 8U + lens[n]), 0U);
+    TEST_ASSERT(memcmp(&p[8], simData, lens[n]) == 0);
+  }
+  TEST_EQUAL(loopStats.icmp_replies, n);
+
+  // No reply to a broadcast ping
+  n = stats().tx_frames;
+  TEST_ASSERT(loopPeerPing(NET_IP(192, 168, 1, 255), 1U, 1U, simData, 8U) != NULL);
+  loopRun();
+  TEST_EQUAL(stats().tx_frames, n);
+  TEST_EQUAL(loopStats.bad, 0U);
+}
+
+/*-----------------------------------------------------------------------------
+  Receive: bound port, discard port, a full ring
+ *----------------------------------------------------------------------------*/
+static void testReceive (void) {
+  neBench_t r;
+  uint32_t  n;
+
+  TEST_ASSERT(loopPeerUdp(SIM_IP, SIM_PORT, 6000U, simData, 100U) != NULL);
+  TEST_ASSERT(loopPeerUdp(NET_IP(192, 168, 1, 255), SIM_PORT, 6001U, simData, 0U) != NULL);
+  loopRun();
+  TEST_EQUAL(simRecvNum, 2U);
+  TEST_EQUAL(simRecvLen, 0U);
+  TEST_EQUAL(simRecvIp, LOOP_PEER_IP);
+  TEST_EQUAL(simRecvPort, 6001U);
+  TEST_ASSERT(loopPeerUdp(0xFFFFFFFFU, SIM_PORT, 6002U, simData, 100U) != NULL);
+  loopRun();
+  TEST_EQUAL(simRecvNum, 3U);
+  TEST_EQUAL(simRecvLen, 100U);
+  TEST_ASSERT(memcmp(simRecv, simData, 100U) == 0);
+
+  for (n = 0U; n < EMAC_RX_NUM; n++) {
+    TEST_ASSERT(loopPeerUdp(SIM_IP, NE_DISCARD_PORT, 6000U, simData, 1000U + n) != NULL);
+  }
+  TEST_ASSERT(loopPeerUdp(SIM_IP, NE_DISCARD_PORT, 6000U, simData, 1U) == NULL);  // Ring full
+  loopRun();
+  TEST_EQUAL(loopRxPending(), 0U);
+  neGetDiscard(&r);
+  TEST_EQUAL(r.frames, EMAC_RX_NUM);
+  TEST_EQUAL(r.bytes, (EMAC_RX_NUM * 1000U) + ((EMAC_RX_NUM * (EMAC_RX_NUM - 1U)) / 2U));
+}
+
+/*-----------------------------------------------------------------------------
+  Malformed or foreign frames are dropped without a reply
+ *----------------------------------------------------------------------------*/
+static void testDrops (void) {
+  netStats_t s = stats();
+  uint8_t   *f;
+
+  TEST_ASSERT(loopPeerRaw(simData, 10U) != NULL);                     // Runt
+  f = loopPeerUdp(SIM_IP, SIM_PORT, 1U, simData, 8U);                 // Not IPv4 or ARP
+  f[12] = 0x86U;
+  f[13] = 0xDDU;
+  f = loopPeerUdp(SIM_IP, SIM_PORT, 1U, simData, 8U);                 // Header checksum
+  f[14 + 10] ^= 0x01U;
+  f = loopPeerUdp(SIM_IP, SIM_PORT, 1U, simData, 8U);                 // More fragments
+  f[14 + 6] |= 0x20U;
+  reseal(f);
+  f = loopPeerUdp(SIM_IP, SIM_PORT, 1U, simData, 8U);                 // Total length too long
+  f[14 + 3] += 1U;
+  reseal(f);
+  f = loopPeerUdp(SIM_IP, SIM_PORT, 1U, simData, 8U);                 // UDP length too long
+  f[14 + 20 + 5] += 1U;
+  loopRun();
+
+  TEST_ASSERT(loopPeerUdp(NET_IP(192, 168, 1, 99), SIM_PORT, 1U, simData, 8U) != NULL);  // Not for us
+  TEST_ASSERT(loopPeerUdp(SIM_IP, 4444U, 1U, simData, 8U) != NULL);  // Port not bound
+  f = loopPeerUdp(SIM_IP, SIM_PORT, 1U, simData, 8U);                 // TCP
+  f[14 + 9] = 6U;
+  reseal(f);
+  f = loopPeerArp(1U, SIM_IP);
+  TEST_ASSERT(loopPeerRaw(f, 14U + 27U) != NULL);                     // Truncated ARP
+  f[14 + 1] = 6U;                                                     // Not Ethernet
+  loopRun();
+
+  TEST_EQUAL(stats().rx_frames, s.rx_frames + 11U);
+  TEST_EQUAL(stats().rx_drops, s.rx_drops + 11U);
+  TEST_EQUAL(stats().rx_arp, s.rx_arp);
+  TEST_EQUAL(stats().tx_frames, s.tx_frames);
+  TEST_EQUAL(simRecvNum, 3U);
+}
+
+int main (void) {
+  testStart();
+  testBenchTx();
+  testArp();
+  testSend();
+  testEcho();
+  testReceive();
+  testDrops();
+  return testReport("test_net");
+}
@@ -0,0 +1,592 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_spiflash.c
+ * Purpose: SPI flash driver against a simulated serial NOR device
+ *----------------------------------------------------------------------------*/
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "clk_profile.h"
+#include "gpdma.h"
+#include "pwr_periph.h"
+#include "spiflash.h"
+
+/*
+  The Makefile builds spiflash.c with SF_SSP = simSsp(), so every register
+  access of the driver passes the device model first. simSsp shifts the
+  byte left in DR through the flash model (the answer keeps bit 8 set, so
+  a new byte from the driver is always seen), follows chip select on the
+  FIOSET/FIOCLR writes and raises RNE while the chip is selected.
+
+  The flash model knows RDID, RDSR, WREN, fast read, page program (wraps
+  inside the page, clears bits only) and sector erase. Program and erase
+  keep WIP set for a while in ticks. Commands sent while the device is
+  busy, without WREN, or programming bits that are not erased count as
+  violations.
+
+  The GPDMA is modelled in dmaStart: starting the TX channel clocks the RX
+  items through the model. The worker thread is run by hand until it waits
+  for a request.
+*/
+#define SIM_SIZE                (256U * 1024U)
+#define SIM_CH_RX               0
+#define SIM_CH_TX               7
+#define SIM_DIRECT              ((uint8_t *)0x2007C000U)    // AHB SRAM banks 0 and 1
+#define SIM_DIRECT_SIZE         (40U * 1024U)                // 8K past the end of bank 1
+#define SIM_PROG_MS             1U
+
+#define SIM_SR_TNF              0x02U
+#define SIM_SR_RNE              0x04U
+#define SIM_CS_BIT              (1UL << 6)
+
+static LPC_SSP_TypeDef simReg;
+static uint8_t  simFlash[SIM_SIZE];
+static uint8_t  simShadow[SIM_SIZE];    // Expected contents
+static uint32_t simPresent = 1U;
+static uint32_t simSelected;
+static uint32_t simCount;               // Bytes in the current command
+static uint8_t  simCmd;
+static uint32_t simAddr;
+static uint8_t  simProg[SF_PAGE_SIZE];
+static uint32_t simProgLen;
+static uint32_t simWel;
+static uint32_t simBusyUntil;
+static uint32_t simEraseMs = 30U;
+static uint32_t simBad;                 // Protocol violations
+static uint32_t simCommands[256];
+
+static uint32_t simBusy (void) {
+  return ((int32_t)(simBusyUntil - stubTick) > 0) ? 1U : 0U;
+}
+
+static uint8_t simByte (uint8_t tx) {
+  static const uint8_t id[3] = {0xEFU, 0x40U, 0x18U};
+  uint32_t n = simCount++;
+  uint8_t  rx = 0xFFU;
+
+  if ((simPresent == 0U) || (simSelected == 0U)) {
+    return 0xFFU;
+  }
+  if (n == 0U) {
+    simCmd  = tx;
+    simAddr = 0U;
+    simProgLen = 0U;
+    simCommands[tx]++;
+    if ((simBusy() != 0U) && (tx != 0x05U)) {
+      simBad++;
+    }
+    if (tx == 0x06U) {
+      simWel = 1U;
+    }
+    if (((tx == 0x02U) || (tx == 0x20U)) && (simWel == 0U)) {
+      simBad++;
+    }
+    return rx;
+  }
+  switch (simCmd) {
+    case 0x9FU:                         // RDID
+      rx = id[(n - 1U) % 3U];
+      break;
+    case 0x05U:                         // RDSR
+      rx = (uint8_t)(simBusy() | (simWel << 1));
+      break;
+    case 0x0BU:                         // Fast read, one dummy byte
+    case 0x02U:                         // Page program
+    case 0x20U:                         // Sector erase
+      if (n <= 3U) {
+        simAddr = (simAddr << 8) | tx;
+      } else if (simCmd == 0x0BU) {
+        if (n > 4U) {
+          rx = simFlash[simAddr % SIM_SIZE];
+          simAddr++;
+        }
+      } else if (simCmd == 0x02U) {
+        simProg[simProgLen % SF_PAGE_SIZE] = tx;
+        simProgLen++;
+      }
+      break;
+    default:
+      break;
+  }
+  return rx;
+}
+
+static void simDeselect (void) {
+  uint32_t base;
+  uint32_t a;
+  uint32_t i;
+
+  if ((simSelected == 0U) || (simPresent == 0U)) {
+    return;
+  }
+  if ((simCmd == 0x02U) && (simCount > 4U) && (simWel != 0U)) {
+    base = simAddr & ~(SF_PAGE_SIZE - 1U);
+    for (i = 0U; i < simProgLen; i++) {
+      a = (base | ((simAddr + i) & (SF_PAGE_SIZE - 1U))) % SIM_SIZE;
+      if ((simFlash[a] & simProg[i % SF_PAGE_SIZE]) != simProg[i % SF_PAGE_SIZE]) {
+        simBad++;
+      }
+      simFlash[a] &= simProg[i % SF_PAGE_SIZE];
+    }
+    simWel = 0U;
+    simBusyUntil = stubTick + SIM_PROG_MS;
+  }
+  if ((simCmd == 0x20U) && (simCount == 4U) && (simWel != 0U)) {
+    memset(&simFlash[(simAddr & ~(SF_SECTOR_SIZE - 1U)) % SIM_SIZE], 0xFF, SF_SECTOR_SIZE);
+    simWel = 0U;
+    simBusyUntil = stubTick + simEraseMs;
+  }
+  simSelected = 0U;
+}
+
+LPC_SSP_TypeDef *simSsp (void) {
+  if ((LPC_GPIO0->FIOSET & SIM_CS_BIT) != 0U) {
+    LPC_GPIO0->FIOSET = 0U;
+    simDeselect();
+  }
+  if ((LPC_GPIO0->FIOCLR & SIM_CS_BIT) != 0U) {
+    LPC_GPIO0->FIOCLR = 0U;
+    simSelected = 1U;
+    simCount    = 0U;
+  }
+  if (simReg.DR <= 0xFFU) {
+    simReg.DR = 0x100U | simByte((uint8_t)simReg.DR);
+  }
+  *(volatile uint32_t *)&simReg.SR = SIM_SR_TNF | ((simSelected != 0U) ? SIM_SR_RNE : 0U);
+  return &simReg;
+}
+
+/*-----------------------------------------------------------------------------
+  GPDMA model
+ *----------------------------------------------------------------------------*/
+static dmaCallback_t   simDmaCb;
+static const dmaLli_t *simRxLli;
+static uint32_t simAllocFail;           // Fail the TX channel
+static uint32_t simDmaError;            // Report a bus error
+static uint32_t simDmaFreed;
+static uint32_t simDmaXfers;
+
+int32_t dmaAlloc (uint32_t prio, uint32_t req, dmaCallback_t cb, void *arg) {
+  (void)arg;
+  if (req == DMA_REQ_SSP1_RX) {
+    TEST_EQUAL(prio, DMA_PRIO_HIGH);
+    simDmaCb = cb;
+    return SIM_CH_RX;
+  }
+  TEST_EQUAL(req, DMA_REQ_SSP1_TX);
+  return (simAllocFail != 0U) ? -1 : SIM_CH_TX;
+}
+
+void dmaFree (int32_t ch) {
+  (void)ch;
+  simDmaFreed++;
+}
+
+void dmaStop (int32_t ch) {
+  (void)ch;
+}
+
+int32_t dmaStart (int32_t ch, const dmaLli_t *lli, uint32_t type) {
+  const dmaLli_t *rx;
+  const dmaLli_t *tx;
+  uint8_t        *dst;
+  uint32_t        n;
+  uint32_t        i;
+
+  if (ch == SIM_CH_RX) {
+    TEST_EQUAL(type, DMA_P2M);
+    simRxLli = lli;
+    return 0;
+  }
+  TEST_EQUAL(ch, SIM_CH_TX);
+  TEST_EQUAL(type, DMA_M2P);
+  TEST_ASSERT(simSelected != 0U);
+  simDmaXfers++;
+  for (rx = simRxLli, tx = lli; rx != NULL; rx = rx->next, tx = tx->next) {
+    TEST_ASSERT(tx != NULL);
+    if (tx == NULL) {
+      return -1;
+    }
+    n = DMA_CTRL_SIZE(rx->ctrl);
+    TEST_EQUAL(DMA_CTRL_SIZE(tx->ctrl), n);
+    TEST_ASSERT((rx->next != NULL) || ((rx->ctrl & DMA_CTRL_I) != 0U));
+    // Items hold 32-bit addresses: static buffers share the upper half
+    if ((rx->dst >> 20) == 0x200U) {
+      dst = (uint8_t *)(uintptr_t)rx->dst;
+    } else {
+      dst = (uint8_t *)((((uintptr_t)rx) & ~(uintptr_t)0xFFFFFFFFU) | rx->dst);
+    }
+    for (i = 0U; i < n; i++) {
+      dst[i] = simByte(0xFFU);
+    }
+  }
+  TEST_ASSERT(tx == NULL);
+  simDmaCb((simDmaError != 0U) ? DMA_EVENT_ERROR : DMA_EVENT_DONE, NULL);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  RTOS: one worker thread, run until it waits for a request
+ *----------------------------------------------------------------------------*/
+static osThreadFunc_t simWorker;
+static uint32_t       simThreadFail;
+static uint32_t       simFlags;
+static uint32_t       simInWorker;
+static jmp_buf        simIdle;
+static uint8_t        simThreadObj;
+static uint32_t       simPmAcquired;
+static uint32_t       simPmReleased;
+static uint32_t       simPclk = 25000000U;
+
+osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+  (void)argument;
+  (void)attr;
+  if (simThreadFail != 0U) {
+    return NULL;
+  }
+  simWorker = func;
+  return &simThreadObj;
+}
+
+osThreadId_t osThreadGetId (void) {
+  return &simThreadObj;
+}
+
+uint32_t osThreadFlagsSet (osThreadId_t id, uint32_t flags) {
+  (void)id;
+  simFlags |= flags;
+  return simFlags;
+}
+
+uint32_t osThreadFlagsClear (uint32_t flags) {
+  uint32_t prev = simFlags;
+
+  simFlags &= ~flags;
+  return prev;
+}
+
+static void simRun (void) {
+  simInWorker = 1U;
+  if (setjmp(simIdle) == 0) {
+    simWorker(NULL);
+  }
+  simInWorker = 0U;
+}
+
+uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout) {
+  uint32_t got;
+  (void)options;
+
+  if (((simFlags & flags) == 0U) && (timeout == osWaitForever)) {
+    if (simInWorker != 0U) {
+      longjmp(simIdle, 1);              // Worker idle
+    }
+    simRun();                           // Caller of sfRead/sfProgram/sfErase
+  }
+  got = simFlags & flags;
+  if (got == 0U) {
+    return osFlagsError;
+  }
+  simFlags &= ~got;
+  return got;
+}
+
+int32_t pmAcquire (uint32_t id, uint32_t pclk_div) {
+  (void)pclk_div;
+  TEST_ASSERT((id == PM_SSP1) || (id == PM_GPIO));
+  simPmAcquired++;
+  return 0;
+}
+
+void pmRelease (uint32_t id) {
+  TEST_ASSERT((id == PM_SSP1) || (id == PM_GPIO));
+  simPmReleased++;
+}
+
+uint32_t pmGetPclk (uint32_t id) {
+  TEST_EQUAL(id, PM_SSP1);
+  return simPclk;
+}
+
+uint32_t pmGetPclkAt (uint32_t id, uint32_t cclk) {
+  TEST_EQUAL(id, PM_SSP1);
+  return cclk;                          // PM_PCLK_DIV1
+}
+
+uint32_t clkProfileGetFreq (uint32_t profile) {
+  static const uint32_t freq[CLK_PROFILE_NUM] = { 12000000U, 48000000U, 100000000U };
+  return freq[profile];
+}
+
+// Governor holds: only 100 MHz gives the 50 MHz SPI clock
+static uint32_t simGovHeld;
+static uint32_t simGovHolds;
+
+void govHoldMin (uint32_t profile) {
+  TEST_EQUAL(profile, CLK_PROFILE_100MHZ);
+  simGovHeld++;
+  simGovHolds++;
+}
+
+void govReleaseMin (uint32_t profile) {
+  TEST_EQUAL(profile, CLK_PROFILE_100MHZ);
+  TEST_ASSERT(simGovHeld != 0U);
+  simGovHeld--;
+}
+
+/*-----------------------------------------------------------------------------
+  Asynchronous requests
+ *----------------------------------------------------------------------------*/
+static uint32_t simDone[8];
+static int32_t  simStatus[8];
+static uint32_t simDoneNum;
+
+static void simCallback (sfReq_t *req, int32_t status) {
+  simDone[simDoneNum % 8U]   = (uint32_t)(uintptr_t)req->arg;
+  simStatus[simDoneNum % 8U] = status;
+  simDoneNum++;
+}
+
+static void simInitFails (void) {
+  simPmAcquired = 0U;
+  simPmReleased = 0U;
+  simDmaFreed   = 0U;
+  stubClkNotifyNum = 0U;
+  TEST_EQUAL(sfInit(), -1);
+  TEST_EQUAL(simPmReleased, simPmAcquired);
+  TEST_EQUAL(stubClkNotifyNum, 0U);
+  TEST_EQUAL(simReg.CR1, 0U);
+}
+
+static uint8_t simBuf[24U * 1024U];
+static uint8_t simData[24U * 1024U];
+
+int main (void) {
+  static sfReq_t req[4];
+  sfStats_t stats;
+  sfStats_t prev;
+  uint8_t  *direct;
+  uint32_t  addr;
+  uint32_t  len;
+  uint32_t  i;
+  uint32_t  n;
+  int32_t   status;
+
+  simReg.DR = 0x100U;
+  memset(simFlash, 0x5A, SIM_SIZE);
+  srand(45);
+
+  // No device: everything acquired is released, no clock callback
+  simPresent = 0U;
+  simInitFails();
+  TEST_EQUAL(simPmAcquired, 2U);
+  TEST_EQUAL(simDmaFreed, 0U);
+  simPresent = 1U;
+
+  // DMA channel missing: the channel already allocated is freed
+  simAllocFail = 1U;
+  simInitFails();
+  TEST_EQUAL(simDmaFreed, 1U);
+  simAllocFail = 0U;
+
+  // Worker thread missing: both channels are freed
+  simThreadFail = 1U;
+  simInitFails();
+  TEST_EQUAL(simDmaFreed, 2U);
+  simThreadFail = 0U;
+  TEST_EQUAL(sfRead(0U, simBuf, 1U), -1);
+
+  // Clock callback table full: the worker is stopped again
+  simPmAcquired = 0U;
+  simPmReleased = 0U;
+  simDmaFreed   = 0U;
+  stubClkNotifyNum = STUB_NOTIFY_MAX;
+  TEST_EQUAL(sfInit(), -1);
+  TEST_EQUAL(simPmReleased, simPmAcquired);
+  TEST_EQUAL(simDmaFreed, 2U);
+  TEST_EQUAL(sfRead(0U, simBuf, 1U), -1);
+  stubClkNotifyNum = 0U;
+
+  // Device found: JEDEC ID read, SCK at most 50 MHz with an even prescaler
+  simPmAcquired = 0U;
+  simPmReleased = 0U;
+  TEST_EQUAL(sfInit(), 0);
+  TEST_EQUAL(simPmAcquired, 2U);
+  TEST_EQUAL(simPmReleased, 0U);
+  TEST_EQUAL(stubClkNotifyNum, 1U);
+  TEST_EQUAL(simCommands[0x9FU], 4U);                // DMA, thread, callback, found
+  TEST_EQUAL(simReg.CR1, 0x02U);
+  TEST_EQUAL(simReg.CPSR, 2U);
+  simPclk = 120000000U;
+  stubClkNotify[0](CLK_EVENT_POST, 120000000U);
+  TEST_EQUAL(simReg.CPSR, 4U);
+  simPclk = 25000000U;
+  stubClkNotify[0](CLK_EVENT_POST, 25000000U);
+  TEST_EQUAL(simReg.CPSR, 2U);
+
+  // Erase, then program across page boundaries and read back unaligned
+  TEST_EQUAL(sfErase(0U, 2U * SF_SECTOR_SIZE), 0);
+  memset(simShadow, 0x5A, SIM_SIZE);
+  memset(simShadow, 0xFF, 2U * SF_SECTOR_SIZE);
+  TEST_EQUAL(memcmp(simFlash, simShadow, SIM_SIZE), 0);
+  for (i = 0U; i < 1000U; i++) {
+    simData[i] = (uint8_t)(i * 7U + 3U);
+  }
+  TEST_EQUAL(sfProgram(100U, simData, 1000U), 0);
+  memcpy(&simShadow[100], simData, 1000U);
+  TEST_EQUAL(memcmp(simFlash, simShadow, SIM_SIZE), 0);
+  TEST_EQUAL(simCommands[0x02U], 5U);                // Pages 0..4
+  memset(simBuf, 0, sizeof(simBuf));
+  TEST_EQUAL(sfRead(100U, simBuf, 1000U), 0);
+  TEST_EQUAL(memcmp(simBuf, simData, 1000U), 0);
+
+  // Lines 0..2 were loaded, line 3 was fetched ahead; reading again hits
+  sfGetStats(&stats);
+  TEST_EQUAL(stats.misses, 3U);
+  TEST_EQUAL(stats.prefetches, 1U);
+  TEST_EQUAL(stats.errors, 0U);
+  prev = stats;
+  TEST_EQUAL(sfRead(SF_LINE_SIZE + 5U, simBuf, 3U * SF_LINE_SIZE - 5U), 0);
+  TEST_EQUAL(memcmp(simBuf, &simShadow[SF_LINE_SIZE + 5U], 3U * SF_LINE_SIZE - 5U), 0);
+  sfGetStats(&stats);
+  TEST_EQUAL(stats.misses, prev.misses);
+  TEST_EQUAL(stats.hits, prev.hits + 3U);
+  TEST_EQUAL(stats.prefetches, prev.prefetches + 1U);   // Line 4
+
+  // Programming drops the stale line
+  simData[0] = 0x00U;
+  TEST_EQUAL(sfProgram(SF_LINE_SIZE + 700U, simData, 1U), 0);
+  simShadow[SF_LINE_SIZE + 700U] = 0x00U;
+  TEST_EQUAL(sfRead(SF_LINE_SIZE + 699U, simBuf, 3U), 0);
+  TEST_EQUAL(memcmp(simBuf, &simShadow[SF_LINE_SIZE + 699U], 3U), 0);
+
+  // Whole lines into AHB SRAM bypass the cache, over several DMA transfers
+  direct = mmap(SIM_DIRECT, SIM_DIRECT_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  TEST_ASSERT(direct == SIM_DIRECT);
+  if (direct == SIM_DIRECT) {
+    for (i = 0U; i < sizeof(simBuf); i++) {
+      simFlash[64U * 1024U + i] = (uint8_t)rand();
+    }
+    memcpy(&simShadow[64U * 1024U], &simFlash[64U * 1024U], sizeof(simBuf));
+    sfGetStats(&prev);
+    n = simDmaXfers;
+    TEST_EQUAL(sfRead(64U * 1024U, direct, 20U * 1024U), 0);
+    TEST_EQUAL(memcmp(direct, &simShadow[64U * 1024U], 20U * 1024U), 0);
+    sfGetStats(&stats);
+    TEST_EQUAL(stats.direct_bytes - prev.direct_bytes, 20U * 1024U);
+    TEST_EQUAL(stats.misses, prev.misses);
+    TEST_EQUAL(simDmaXfers - n, 3U);                 // 15872 + 4608 bytes, prefetch
+
+    // Buffer running past the end of AHB SRAM: through the cache
+    sfGetStats(&prev);
+    TEST_EQUAL(sfRead(64U * 1024U, &direct[30U * 1024U], 4U * 1024U), 0);
+    TEST_EQUAL(memcmp(&direct[30U * 1024U], &simShadow[64U * 1024U], 4U * 1024U), 0);
+    sfGetStats(&stats);
+    TEST_EQUAL(stats.direct_bytes, prev.direct_bytes);
+    TEST_ASSERT((stats.hits + stats.misses) > (prev.hits + prev.misses));
+    munmap(direct, SIM_DIRECT_SIZE);
+  }
+
+  // Queued requests complete in order with their callbacks
+  for (i = 0U; i < 4U; i++) {
+    req[i].cb  = simCallback;
+    req[i].arg = (void *)(uintptr_t)(i + 1U);
+  }
+  for (i = 0U; i < SF_PAGE_SIZE; i++) {
+    simData[i] = (uint8_t)~i;
+  }
+  req[0].op = SF_OP_ERASE;   req[0].addr = 3U * SF_SECTOR_SIZE; req[0].len = SF_SECTOR_SIZE;
+  req[1].op = SF_OP_PROGRAM; req[1].addr = 3U * SF_SECTOR_SIZE; req[1].len = SF_PAGE_SIZE; req[1].buf = simData;
+  req[2].op = SF_OP_READ;    req[2].addr = 3U * SF_SECTOR_SIZE; req[2].len = SF_PAGE_SIZE; req[2].buf = simBuf;
+  req[3].op = SF_OP_ERASE;   req[3].addr = 5U;                  req[3].len = SF_SECTOR_SIZE;
+  for (i = 0U; i < 4U; i++) {
+    TEST_EQUAL(sfSubmit(&req[i]), 0);
+  }
+  sfGetStats(&prev);
+  simRun();
+  TEST_EQUAL(simDoneNum, 4U);
+  for (i = 0U; i < 4U; i++) {
+    TEST_EQUAL(simDone[i], i + 1U);
+    TEST_EQUAL(simStatus[i], (i < 3U) ? 0 : -1);        // Misaligned erase
+  }
+  TEST_EQUAL(memcmp(simBuf, simData, SF_PAGE_SIZE), 0);
+  sfGetStats(&stats);
+  TEST_EQUAL(stats.requests - prev.requests, 4U);
+  TEST_EQUAL(stats.errors - prev.errors, 1U);
+  TEST_EQUAL(stats.queue_max, 4U);
+  memset(&simShadow[3U * SF_SECTOR_SIZE], 0xFF, SF_SECTOR_SIZE);
+  memcpy(&simShadow[3U * SF_SECTOR_SIZE], simData, SF_PAGE_SIZE);
+  req[0].op = 3U;
+  TEST_EQUAL(sfSubmit(&req[0]), -1);
+
+  // Device errors: erase timeout and DMA bus error fail the request
+  simEraseMs = 600U;
+  TEST_EQUAL(sfErase(6U * SF_SECTOR_SIZE, SF_SECTOR_SIZE), -1);
+  stubTick += simEraseMs;
+  simEraseMs = 30U;
+  memset(&simShadow[6U * SF_SECTOR_SIZE], 0xFF, SF_SECTOR_SIZE);
+  simDmaError = 1U;
+  TEST_EQUAL(sfRead(100U * 1024U, simBuf, 10U), -1);
+  simDmaError = 0U;
+  TEST_EQUAL(sfRead(100U * 1024U, simBuf, 10U), 0);
+  TEST_EQUAL(memcmp(simBuf, &simShadow[100U * 1024U], 10U), 0);
+
+  // Random traffic against the shadow copy
+  for (n = 0U; n < 300U; n++) {
+    addr = (uint32_t)rand() % (SIM_SIZE - sizeof(simBuf));
+    len  = 1U + ((uint32_t)rand() % 3000U);
+    switch (rand() % 4) {
+      case 0:
+        addr &= ~(SF_SECTOR_SIZE - 1U);
+        len   = SF_SECTOR_SIZE * (1U + ((uint32_t)rand() % 2U));
+        status = sfErase(addr, len);
+        memset(&simShadow[addr], 0xFF, len);
+        break;
+      case 1:
+        for (i = 0U; (i < len) && (simShadow[addr + i] == 0xFFU); i++) {}
+        len = i;
+        for (i = 0U; i < len; i++) {
+          simData[i] = (uint8_t)rand();
+        }
+        status = sfProgram(addr, simData, len);
+        memcpy(&simShadow[addr], simData, len);
+        break;
+      default:
+        status = sfRead(addr, simBuf, len);
+        if (memcmp(simBuf, &simShadow[addr], len) != 0) {
+          status = -2;
+        }
+        break;
+    }
+    TEST_EQUAL(status, 0);
+  }
+  TEST_EQUAL(memcmp(simFlash, simShadow, SIM_SIZE), 0);
+  TEST_EQUAL(simBad, 0U);
+
+  // Every DMA read held the clock and released it again, also on errors
+  TEST_ASSERT(simGovHolds != 0U);
+  TEST_EQUAL(simGovHeld, 0U);
+
+  return testReport("test_spiflash");
+}
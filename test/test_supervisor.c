@@ -0,0 +1,178 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_supervisor.c
+ * Purpose: Unit test of the supervisor grace and late-marking logic
+ *----------------------------------------------------------------------------*/
+
+#include <setjmp.h>
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "supervisor.h"
+#include "retained.h"
+
+/*
+  Deadlines are reported by the RTX thread watchdog (osWatchdogAlarm_Handler),
+  which the test calls directly. The supervisor thread is run loop by loop:
+  osDelayUntil returns to the test through simStop after simLoops calls.
+*/
+extern uint32_t osWatchdogAlarm_Handler (osThreadId_t thread_id);
+extern int32_t  supStalled;
+
+retBlock_t retBlock;
+static uint32_t retCommits;
+
+void retCommit (void) {
+  retCommits++;
+}
+
+static jmp_buf  simStop;
+static uint32_t simLoops;
+static uint32_t simCalls;
+static uint32_t simWake[4];             // Ticks requested by osDelayUntil
+static uint32_t simLate;                // Ticks the next wake-up comes late
+
+osStatus_t osDelayUntil (uint32_t ticks) {
+  if (simCalls < 4U) {
+    simWake[simCalls] = ticks;
+  }
+  simCalls++;
+  if (simLoops-- == 0U) {
+    longjmp(simStop, 1);
+  }
+  stubTick = ticks + simLate;
+  simLate  = 0U;
+  return osOK;
+}
+
+osStatus_t osDelay (uint32_t ticks) {
+  (void)ticks;
+  longjmp(simStop, 2);                  // Stalled: supervisor stopped feeding
+}
+
+// Run the supervisor thread until it waits for the (loops + 1)th time
+static int simRun (uint32_t loops) {
+  int stop;
+
+  simLoops = loops;
+  simCalls = 0U;
+  stop = setjmp(simStop);
+  if (stop == 0) {
+    stubThreadFunc[0](NULL);
+  }
+  return stop;
+}
+
+static void testPolicy (void) {
+  supThread_t slot[3];
+  uint32_t    grace = 200U;
+
+  memset(slot, 0, sizeof(slot));
+  slot[0].thread = &slot[0];
+  slot[1].thread = &slot[1];
+
+  // Nobody late
+  TEST_EQUAL(supPolicy(slot, 3U, 1000U, grace), -1);
+
+  // Late, but within the grace period (boundary included)
+  slot[1].late     = 1U;
+  slot[1].deadline = 1000U;
+  TEST_EQUAL(supPolicy(slot, 3U, 1000U, grace), -1);
+  TEST_EQUAL(supPolicy(slot, 3U, 1200U, grace),  -1);
+  TEST_EQUAL(supPolicy(slot, 3U, 1201U, grace),  1);
+
+  // Free slots are ignored even with stale state
+  slot[2].late     = 1U;
+  slot[2].deadline = 0U;
+  TEST_EQUAL(supPolicy(slot, 3U, 1100U, grace), -1);
+
+  // Lowest late slot is reported first
+  slot[0].late     = 1U;
+  slot[0].deadline = 900U;
+  TEST_EQUAL(supPolicy(slot, 3U, 1300U, grace), 0);
+
+  // Tick counter wrap between deadline and now
+  memset(slot, 0, sizeof(slot));
+  slot[0].thread   = &slot[0];
+  slot[0].late     = 1U;
+  slot[0].deadline = 0xFFFFFF80U;
+  TEST_EQUAL(supPolicy(slot, 1U, 0x00000048U, grace), -1);
+  TEST_EQUAL(supPolicy(slot, 1U, 0x00000049U, grace),  0);
+}
+
+static void testLateMarking (void) {
+  osThreadId_t thread = osThreadGetId();
+  int32_t      id;
+
+  TEST_EQUAL(supInit(), 0);
+  TEST_ASSERT(stubThreadFunc[0] != NULL);
+  TEST_EQUAL(LPC_WDT->WDMOD, 0x03U);
+
+  // Registration
+  TEST_EQUAL(supRegister(0U), -1);
+  id = supRegister(500U);
+  TEST_EQUAL(id, 0);
+
+  // Missed deadline recovered within the grace period: feeding goes on
+  stubTick = 1000U;
+  osWatchdogAlarm_Handler(thread);
+  TEST_EQUAL(simRun(1U), 1);
+  TEST_EQUAL(supStalled, -1);
+  stubTick = 1150U;
+  supCheckIn(id);
+
+  // Recovered thread does not count against the next check
+  stubTick = 2000U;
+  TEST_EQUAL(simRun(3U), 1);
+  TEST_EQUAL(supStalled, -1);
+
+  // Missed deadline beyond the grace period: stop feeding, log the thread
+  stubTick = 3000U;
+  osWatchdogAlarm_Handler(thread);
+  TEST_EQUAL(simRun(SUP_GRACE_MS / SUP_FEED_MS), 1);
+  TEST_EQUAL(supStalled, -1);
+  TEST_EQUAL(simRun(10U), 2);
+  TEST_EQUAL(supStalled, id);
+  TEST_EQUAL(strcmp(retBlock.wdt_thread, "stub"), 0);
+  TEST_ASSERT(retBlock.wdt_late_ms > SUP_GRACE_MS);
+  TEST_ASSERT(retBlock.wdt_late_ms <= (SUP_GRACE_MS + SUP_FEED_MS));
+  TEST_EQUAL(retCommits, 1U);
+}
+
+static void testLateWake (void) {
+  // Woken late (deep sleep): resume the period from now, no catch-up burst
+  supCheckIn(0);
+  stubThreadNum = 0U;
+  stubTick      = 0U;
+  supStalled    = -1;
+  TEST_EQUAL(supInit(), 0);
+  simLate = 5000U;
+  TEST_EQUAL(simRun(2U), 1);
+  TEST_EQUAL(simWake[0], SUP_FEED_MS);
+  TEST_EQUAL(simWake[1], SUP_FEED_MS + 5000U + SUP_FEED_MS);
+  TEST_EQUAL(simWake[2], SUP_FEED_MS + 5000U + (2U * SUP_FEED_MS));
+  TEST_EQUAL(supStalled, -1);
+}
+
+int main (void) {
+  testPolicy();
+  testLateMarking();
+  testLateWake();
+  return testReport("test_supervisor");
+}
@@ -0,0 +1,228 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_telemetry.c
+ * Purpose: Round trip test of the telemetry encoder and the host decoder
+ *----------------------------------------------------------------------------*/
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "telemetry.h"
+#include "tm_decode.h"
+
+/*
+  The encoder thread runs pass by pass: osDelayUntil changes the sampled
+  variables and records what the encoder will see at that tick. The byte
+  stream goes straight into the decoder, which must reproduce the sampled
+  values exactly.
+*/
+#define SIM_PASSES              1500U   // 15 s: three key periods
+#define SIM_CH                  7U
+
+static uint8_t  vU8;
+static int8_t   vI8;
+static uint16_t vU16;
+static int16_t  vI16;
+static uint32_t vU32;
+static int32_t  vI32;
+static float    vF32;
+
+static TM_CHANNEL(tmU8,  "u8",  &vU8,  TM_U8,  10U);
+static TM_CHANNEL(tmI8,  "i8",  &vI8,  TM_I8,  10U);
+static TM_CHANNEL(tmU16, "u16", &vU16, TM_U16, 20U);
+static TM_CHANNEL(tmI16, "i16", &vI16, TM_I16, 30U);
+static TM_CHANNEL(tmU32, "u32", &vU32, TM_U32, 50U);
+static TM_CHANNEL(tmI32, "i32", &vI32, TM_I32, 10U);
+static TM_CHANNEL(tmF32, "a_float_channel_with_a_long_name", &vF32, TM_F32, 100U);
+
+static tmChannel_t *simCh[SIM_CH] = { &tmU8, &tmI8, &tmU16, &tmI16, &tmU32, &tmI32, &tmF32 };
+
+static jmp_buf      simStop;
+static uint32_t     simPass;
+static uint32_t     simStart;           // Tick of the first pass
+static uint32_t     simHist[SIM_PASSES + 1U][SIM_CH];
+static uint32_t     simRand = 12345U;
+
+static tmDecoder_t  decAll;             // Sees every byte
+static tmDecoder_t  decLate;            // Starts in the middle of the stream
+static uint32_t     simPackets;
+static uint32_t     simDrop;            // Packet number not delivered to decAll
+static uint32_t     simLateFrom;        // First packet delivered to decLate
+static uint32_t     simMismatch;
+
+static uint32_t simNext (void) {
+  simRand = (simRand * 1103515245U) + 12345U;
+  return simRand >> 8;
+}
+
+// Value as tmSample widens it
+static uint32_t simWiden (uint32_t ch) {
+  uint32_t bits;
+
+  switch (ch) {
+    case 0U: return vU8;
+    case 1U: return (uint32_t)(int32_t)vI8;
+    case 2U: return vU16;
+    case 3U: return (uint32_t)(int32_t)vI16;
+    case 4U: return vU32;
+    case 5U: return (uint32_t)vI32;
+    default: memcpy(&bits, &vF32, sizeof(bits)); return bits;
+  }
+}
+
+static void simChange (void) {
+  uint32_t r = simNext();
+
+  // Most values hold still, some move a little, a few jump to extremes
+  if ((r & 3U) == 0U) { vU8++; }
+  if ((r & 7U) == 1U) { vI8 = (int8_t)(vI8 - 3); }
+  if ((r & 15U) == 2U) { vU16 = (uint16_t)simNext(); }
+  if ((r & 3U) == 3U) { vI16 = (int16_t)(vI16 + (int16_t)((r >> 4) & 0xFFU) - 128); }
+  if ((r & 31U) == 4U) { vU32 = ((r >> 5) & 1U) ? 0xFFFFFFFFU : 0U; }
+  if ((r & 7U) == 5U) { vI32 = ((r >> 6) & 1U) ? INT32_MIN : (vI32 + 1000); }
+  if ((r & 7U) == 6U) { vF32 = (float)(int32_t)simNext() / 7.0f; }
+}
+
+osStatus_t osDelayUntil (uint32_t ticks) {
+  uint32_t n;
+
+  if (simPass == SIM_PASSES) {
+    longjmp(simStop, 1);
+  }
+  stubTick = ticks;
+  if (simPass == 0U) {
+    simStart = ticks;
+  }
+  simChange();
+  for (n = 0U; n < SIM_CH; n++) {
+    simHist[simPass][n] = simWiden(n);
+  }
+  simPass++;
+  return osOK;
+}
+
+static void simOut (const tmdSample_t *s, void *arg) {
+  uint32_t pass = (s->time - simStart) / TM_TICK_MS;
+  (void)arg;
+
+  if ((pass >= SIM_PASSES) || (s->id >= SIM_CH) || (simHist[pass][s->id] != s->raw)) {
+    simMismatch++;
+  }
+}
+
+static int32_t simSend (const uint8_t *data, uint32_t len) {
+  uint32_t n;
+
+  // Delivered in odd chunks to exercise frame reassembly
+  for (n = 0U; n < len; n += 7U) {
+    if (simPackets != simDrop) {
+      tmdPut(&decAll, &data[n], ((len - n) < 7U) ? (len - n) : 7U);
+    }
+    if (simPackets >= simLateFrom) {
+      tmdPut(&decLate, &data[n], ((len - n) < 7U) ? (len - n) : 7U);
+    }
+  }
+  simPackets++;
+  return 0;
+}
+
+static void testCobs (void) {
+  static uint8_t src[1200];
+  static uint8_t enc[1300];
+  static uint8_t dec[1300];
+  uint32_t       len;
+  uint32_t       enc_len;
+  uint32_t       n;
+  uint32_t       k;
+  uint32_t       bad = 0U;
+
+  for (n = 0U; n < 300U; n++) {
+    len = (n < 260U) ? n : (simNext() % sizeof(src));
+    for (k = 0U; k < len; k++) {
+      // Long zero-free runs (COBS 254 byte groups) and dense zeros
+      src[k] = (n & 1U) ? (uint8_t)((simNext() % 255U) + 1U) : (uint8_t)(simNext() & 3U);
+    }
+    enc_len = tmCobsEncode(src, len, enc);
+    if ((enc_len > (len + 1U + (len / 254U))) || (memchr(enc, 0, enc_len) != NULL) ||
+        (tmdCobsDecode(enc, enc_len, dec) != len) || (memcmp(src, dec, len) != 0)) {
+      bad++;
+    }
+  }
+  TEST_EQUAL(bad, 0U);
+
+  // Corrupt frames are rejected
+  enc[0] = 5U;
+  enc[1] = 1U;
+  TEST_EQUAL(tmdCobsDecode(enc, 2U, dec), 0U);
+  enc[0] = 3U;
+  enc[1] = 0U;
+  enc[2] = 1U;
+  TEST_EQUAL(tmdCobsDecode(enc, 3U, dec), 0U);
+}
+
+int main (void) {
+  uint32_t n;
+
+  testCobs();
+
+  for (n = 0U; n < SIM_CH; n++) {
+    TEST_EQUAL(tmRegister(simCh[n]), (int32_t)n);
+  }
+  tmdInit(&decAll,  simOut, NULL);
+  tmdInit(&decLate, simOut, NULL);
+  simDrop     = 400U;
+  simLateFrom = 250U;
+
+  stubTick = 1000U;
+  TEST_EQUAL(tmInit(simSend), 0);
+  if (setjmp(simStop) == 0) {
+    stubThreadFunc[0](NULL);
+  }
+  TEST_EQUAL(simPass, SIM_PASSES);
+  TEST_ASSERT(simPackets > simDrop);
+
+  // Every decoded value is the value sampled at its packet time
+  TEST_EQUAL(simMismatch, 0U);
+  TEST_EQUAL(decAll.stats.errors, 0U);
+  TEST_EQUAL(decAll.stats.lost, 1U);
+  TEST_ASSERT(decAll.stats.samples > (SIM_PASSES / 2U));
+
+  // Descriptions and final values of both decoders match the encoder
+  for (n = 0U; n < SIM_CH; n++) {
+    TEST_EQUAL(strcmp(decAll.ch[n].name, simCh[n]->name), 0);
+    TEST_EQUAL(decAll.ch[n].type, simCh[n]->type);
+    TEST_EQUAL(decAll.ch[n].period_ms, simCh[n]->period_ms);
+    TEST_EQUAL(decAll.ch[n].valid, 1U);
+    TEST_EQUAL(decAll.ch[n].value, simCh[n]->value);
+    TEST_EQUAL(decLate.ch[n].valid, 1U);
+    TEST_EQUAL(decLate.ch[n].value, simCh[n]->value);
+  }
+
+  // The late decoder skips deltas until the first key packet
+  TEST_ASSERT(decLate.stats.skipped > 0U);
+  TEST_EQUAL(decLate.stats.lost, 0U);
+
+  // Type conversion
+  TEST_ASSERT(tmdValue(TM_I8, 0xFFFFFFFEU) == -2.0);
+  TEST_ASSERT(tmdValue(TM_U32, 0xFFFFFFFEU) == 4294967294.0);
+  TEST_ASSERT(tmdValue(TM_F32, 0x3FC00000U) == 1.5);
+
+  return testReport("test_telemetry");
+}
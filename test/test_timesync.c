@@ -0,0 +1,246 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_timesync.c
+ * Purpose: Time synchronization of several nodes with skewed clocks
+ *----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "timesync.h"
+
+/*
+  Nodes run on local microsecond clocks derived from the true time (ns) with
+  their own frequency error and offset. The simulated bus carries one frame
+  at a time: a frame waits a random arbitration delay, and when it ends every
+  other node receives it, timestamped with its own clock plus a random
+  interrupt latency. The sender gets tsTxDone at the same moment.
+*/
+#define SIM_NODES               5U
+#define SIM_PERIOD_NS           100000000ULL    // SYNC every 100 ms
+#define SIM_FRAME_NS            120000ULL       // Frame on the bus at 1 Mbit/s
+#define SIM_QUEUE               8U
+
+typedef struct {
+  tsNode_t ts;
+  tsOps_t  ops;
+  int64_t  skew;                        // Frequency error (ppb)
+  int64_t  offset;                      // Local clock at true time 0 (ns)
+  int32_t  trim;                        // Last ops->trim value
+  uint32_t trims;
+} simNode_t;
+
+typedef struct {
+  simNode_t *from;
+  uint32_t   id;
+  uint8_t    data[8];
+  uint32_t   len;
+} simFrame_t;
+
+static simNode_t  simNode[SIM_NODES];
+static simFrame_t simQueue[SIM_QUEUE];
+static uint32_t   simQueued;
+static uint64_t   simNow;               // True time (ns)
+static uint32_t   simLatencyUs;         // Receive latency spread
+static uint32_t   simDrop;              // Node that misses the next SYNC
+
+static uint64_t simLocal (const simNode_t *node, uint64_t t) {
+  return (uint64_t)((int64_t)t + (((int64_t)t * node->skew) / 1000000000) + node->offset) / 1000U;
+}
+
+static int32_t simSend (void *ctx, uint32_t id, const uint8_t *data, uint32_t len) {
+  simFrame_t *frame;
+
+  if (simQueued >= SIM_QUEUE) {
+    return -1;
+  }
+  frame = &simQueue[simQueued++];
+  frame->from = ctx;
+  frame->id   = id;
+  frame->len  = len;
+  memcpy(frame->data, data, len);
+  return 0;
+}
+
+static void simTrim (void *ctx, int32_t ppb) {
+  simNode_t *node = ctx;
+
+  node->trim = ppb;
+  node->trims++;
+}
+
+// Transmit queued frames in order until the bus is idle
+static void simBus (void) {
+  simFrame_t frame;
+  simNode_t *node;
+  uint32_t   latency;
+  uint32_t   n;
+
+  while (simQueued != 0U) {
+    frame = simQueue[0];
+    memmove(&simQueue[0], &simQueue[1], --simQueued * sizeof(simFrame_t));
+    simNow += ((uint64_t)rand() % 500000U) + SIM_FRAME_NS;
+
+    tsTxDone(&frame.from->ts, frame.id, simLocal(frame.from, simNow));
+    for (n = 0U; n < SIM_NODES; n++) {
+      node = &simNode[n];
+      if ((node == frame.from) || ((simDrop == n) && (frame.id == TS_ID_SYNC))) {
+        continue;
+      }
+      latency = (simLatencyUs != 0U) ? ((uint32_t)rand() % simLatencyUs) : 0U;
+      (void)tsRxFrame(&node->ts, frame.id, frame.data, frame.len, simLocal(node, simNow) + latency);
+    }
+  }
+  simDrop = SIM_NODES;
+}
+
+// SYNC and FOLLOW_UP to one slave, bypassing the bus
+static void simExact (tsNode_t *node, uint64_t local, uint64_t master) {
+  uint8_t  data[8];
+  uint32_t n;
+
+  data[0] = (uint8_t)(node->seq + 1U);
+  (void)tsRxFrame(node, TS_ID_SYNC, data, 1U, local);
+  for (n = 1U; n < 8U; n++) {
+    data[n] = (uint8_t)master;
+    master >>= 8;
+  }
+  (void)tsRxFrame(node, TS_ID_FOLLOW_UP, data, 8U, local);
+}
+
+static void simRun (uint32_t periods) {
+  while (periods-- != 0U) {
+    simNow = ((simNow / SIM_PERIOD_NS) + 1U) * SIM_PERIOD_NS;
+    TEST_EQUAL(tsMasterSync(&simNode[0].ts), 0);
+    simBus();
+  }
+}
+
+// Largest difference of a slave clock to the master now (us)
+static uint64_t simSpread (void) {
+  uint64_t master = tsGetTime(&simNode[0].ts, simLocal(&simNode[0], simNow));
+  uint64_t spread = 0U;
+  uint64_t time;
+  uint32_t n;
+
+  for (n = 1U; n < SIM_NODES; n++) {
+    time = tsGetTime(&simNode[n].ts, simLocal(&simNode[n], simNow));
+    time = (time > master) ? (time - master) : (master - time);
+    spread = (time > spread) ? time : spread;
+  }
+  return spread;
+}
+
+int main (void) {
+  static const int64_t skew[SIM_NODES]   = { 20000, -150000, 90000, 250000, -60000 };
+  static const int64_t offset[SIM_NODES] = { 5000000000LL, 12345678LL, 777000000LL, 3000LL, 250000000000LL };
+  tsStats_t stats;
+  tsNode_t  exact;
+  uint64_t  local;
+  uint64_t  time;
+  int64_t   freq;
+  uint32_t  n;
+
+  srand(49);
+  for (n = 0U; n < SIM_NODES; n++) {
+    simNode[n].skew    = skew[n];
+    simNode[n].offset  = offset[n];
+    simNode[n].ops     = (tsOps_t){ simSend, simTrim, &simNode[n] };
+    tsInit(&simNode[n].ts, (n == 0U) ? TS_ROLE_MASTER : TS_ROLE_SLAVE, &simNode[n].ops);
+  }
+  simDrop = SIM_NODES;
+  TEST_EQUAL(tsMasterSync(&simNode[1].ts), -1);       // Slaves do not send SYNC
+
+  // First FOLLOW_UP steps the clocks, then the servo pulls the rates in
+  simLatencyUs = 3U;
+  simRun(1U);
+  for (n = 1U; n < SIM_NODES; n++) {
+    TEST_EQUAL(simNode[n].ts.stats.steps, 1U);
+    TEST_EQUAL(simNode[n].ts.state, TS_STATE_LOCKED);
+  }
+  TEST_ASSERT(simSpread() < 200U);
+  simRun(300U);
+  TEST_ASSERT(simSpread() <= 6U);
+  for (n = 1U; n < SIM_NODES; n++) {
+    stats = simNode[n].ts.stats;
+    freq  = skew[0] - skew[n];                        // Slave rate to master rate
+    TEST_EQUAL(stats.steps, 1U);
+    TEST_EQUAL(stats.updates, 300U);
+    TEST_EQUAL(stats.syncs, 301U);
+    TEST_ASSERT((stats.freq > (freq - 30000)) && (stats.freq < (freq + 30000)));
+    TEST_ASSERT(stats.offset_max < 100000U);
+    TEST_ASSERT((stats.offset < 8000) && (stats.offset > -8000));
+    TEST_ASSERT(stats.jitter < 8000U);
+    TEST_EQUAL(simNode[n].trim, stats.freq);
+    TEST_EQUAL(simNode[n].trims, 300U);
+  }
+
+  // The synchronized clocks stay together between SYNC frames
+  for (n = 0U; n < 99U; n++) {
+    simNow += 1000000U;
+    TEST_ASSERT(simSpread() <= 8U);
+  }
+
+  // tsToLocal is the inverse of tsGetTime (both truncate to us)
+  local = simLocal(&simNode[3], simNow);
+  time  = tsGetTime(&simNode[3].ts, local) + 250000U;
+  local = tsToLocal(&simNode[3].ts, time);
+  TEST_ASSERT((tsGetTime(&simNode[3].ts, local) + 2U) >= time);
+  TEST_ASSERT(tsGetTime(&simNode[3].ts, local) <= (time + 2U));
+
+  // A lost SYNC: FOLLOW_UP is not matched, the next interval works again
+  simDrop = 2U;
+  simRun(1U);
+  TEST_EQUAL(simNode[2].ts.stats.missed, 1U);
+  TEST_EQUAL(simNode[2].ts.stats.updates, 300U);
+  simRun(1U);
+  TEST_EQUAL(simNode[2].ts.stats.updates, 301U);
+
+  // A jump of the master clock beyond TS_STEP_US steps every slave
+  simNode[0].offset += (TS_STEP_US + 500U) * 1000LL;
+  simRun(1U);
+  for (n = 1U; n < SIM_NODES; n++) {
+    TEST_EQUAL(simNode[n].ts.stats.steps, 2U);
+  }
+  simRun(50U);
+  TEST_ASSERT(simSpread() <= 6U);
+
+  // Exact timestamps: the jitter estimate decays all the way to zero
+  tsInit(&exact, TS_ROLE_SLAVE, &simNode[1].ops);
+  for (n = 0U; n < 100U; n++) {
+    local = 1000000U + (n * 100000U);
+    simExact(&exact, local, local + 7U);
+    if (n == 0U) {
+      TEST_EQUAL(exact.stats.steps, 1U);
+      exact.jitter_sum   = 15U << 4;                // Stuck point of truncation
+      exact.stats.jitter = 15U;
+    }
+  }
+  TEST_EQUAL(exact.stats.offset, 0);
+  TEST_EQUAL(exact.stats.freq, 0);
+  TEST_EQUAL(exact.stats.jitter, 0U);
+
+  // A constant offset change is reported as such
+  for (n = 0U; n < 200U; n++) {
+    local = 20000000U + (n * 100000U);
+    simExact(&exact, local, local + 7U + (n & 1U));
+  }
+  TEST_ASSERT((exact.stats.jitter > 900U) && (exact.stats.jitter < 2100U));
+
+  return testReport("test_timesync");
+}
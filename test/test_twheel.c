@@ -0,0 +1,177 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_twheel.c
+ * Purpose: Host test of the hierarchical timer wheel
+ *----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "twheel.h"
+#include "irq_prio.h"
+
+extern void RIT_IRQHandler (void);
+
+#define TIMER_NUM               1000U
+
+typedef struct {
+  twTimer_t timer;
+  uint32_t  due;                        // Expected expiry (wheel time)
+  uint32_t  fired;                      // Callback count
+  uint32_t  late;                       // Callbacks not at the expected tick
+} testTimer_t;
+
+static testTimer_t tt[TIMER_NUM];
+
+static void testCallback (void *arg) {
+  testTimer_t *t = arg;
+
+  // Callback runs while the wheel processes tick t->due
+  if (twGetTime() != t->due) {
+    t->late++;
+  }
+  t->fired++;
+  if (t->timer.period != 0U) {
+    t->due += t->timer.period;
+  }
+}
+
+// BASEPRI seen by an ISR callback
+static uint32_t lockBasepri;
+
+static void lockCallback (void *arg) {
+  (void)arg;
+  lockBasepri = __get_BASEPRI();
+}
+
+static void testRun (uint32_t ticks) {
+  while (ticks-- != 0U) {
+    RIT_IRQHandler();
+  }
+}
+
+static void testArm (testTimer_t *t, uint32_t ticks, uint32_t period) {
+  twTimerInit(&t->timer, testCallback, t, TW_CONTEXT_ISR);
+  t->due   = twGetTime() + ticks;
+  t->fired = 0U;
+  t->late  = 0U;
+  TEST_EQUAL(twStart(&t->timer, ticks, period), 0);
+}
+
+int main (void) {
+  static const uint32_t delay[] = {
+    1U, 2U, 255U, 256U, 257U, 1000U, 16383U, 16384U, 16385U,
+    (1UL << 20) - 1U, 1UL << 20, (1UL << 20) + 7U
+  };
+  uint32_t n;
+  uint32_t fired;
+  uint32_t late;
+
+  // Slots are not linked before twInit
+  twTimerInit(&tt[0].timer, testCallback, &tt[0], TW_CONTEXT_ISR);
+  TEST_EQUAL(twIsRunning(), 0U);
+  TEST_EQUAL(twStart(&tt[0].timer, 10U, 0U), -1);
+
+  TEST_EQUAL(twInit(), 0);
+  TEST_EQUAL(twIsRunning(), 1U);
+  TEST_EQUAL(LPC_RIT->RICOMPVAL, (SystemCoreClock / 4U / TW_TICK_FREQ) - 1U);
+
+  // One-shot timers across every level boundary expire exactly on time
+  for (n = 0U; n < (sizeof(delay) / sizeof(delay[0])); n++) {
+    testArm(&tt[n], delay[n], 0U);
+  }
+  testRun((1UL << 20) + 8U);
+  for (n = 0U; n < (sizeof(delay) / sizeof(delay[0])); n++) {
+    TEST_EQUAL(tt[n].fired, 1U);
+    TEST_EQUAL(tt[n].late, 0U);
+    TEST_EQUAL(twIsActive(&tt[n].timer), 0U);
+  }
+
+  // Random delays, starts interleaved with ticks
+  srand(1U);
+  for (n = 0U; n < TIMER_NUM; n++) {
+    testArm(&tt[n], 1U + ((uint32_t)rand() % 100000U), 0U);
+    if ((n % 7U) == 0U) {
+      testRun(1U);
+    }
+  }
+  testRun(100001U);
+  fired = 0U;
+  late  = 0U;
+  for (n = 0U; n < TIMER_NUM; n++) {
+    fired += tt[n].fired;
+    late  += tt[n].late;
+  }
+  TEST_EQUAL(fired, TIMER_NUM);
+  TEST_EQUAL(late, 0U);
+
+  // Periodic timer and stop
+  testArm(&tt[0], 5U, 300U);
+  testRun(5U + (300U * 9U) + 1U);
+  TEST_EQUAL(tt[0].fired, 10U);
+  TEST_EQUAL(tt[0].late, 0U);
+  twStop(&tt[0].timer);
+  testRun(1000U);
+  TEST_EQUAL(tt[0].fired, 10U);
+  TEST_EQUAL(twIsActive(&tt[0].timer), 0U);
+
+  // Restart moves a running timer
+  testArm(&tt[1], 50U, 0U);
+  testRun(10U);
+  tt[1].due = twGetTime() + 500U;
+  TEST_EQUAL(twStart(&tt[1].timer, 500U, 0U), 0);
+  testRun(501U);
+  TEST_EQUAL(tt[1].fired, 1U);
+  TEST_EQUAL(tt[1].late, 0U);
+
+  // Delays of 2^31 ticks and more are rejected instead of firing at once
+  twTimerInit(&tt[2].timer, testCallback, &tt[2], TW_CONTEXT_ISR);
+  TEST_EQUAL(twStart(&tt[2].timer, 0x80000000U, 0U), -1);
+  TEST_EQUAL(twStart(&tt[2].timer, 0xFFFFFFFFU, 0U), -1);
+  TEST_EQUAL(twStart(&tt[2].timer, 10U, 0x80000000U), -1);
+  TEST_EQUAL(twIsActive(&tt[2].timer), 0U);
+
+  // Longest delay is parked beyond the wheel range and does not fire early
+  testArm(&tt[2], TW_TICKS_MAX, 0U);
+  testRun((1UL << 26) + 1000U);
+  TEST_EQUAL(tt[2].fired, 0U);
+  TEST_EQUAL(twIsActive(&tt[2].timer), 1U);
+  twStop(&tt[2].timer);
+
+  // Thread context timers are handed to the worker in one wake-up
+  tt[3].fired = 0U;
+  twTimerInit(&tt[3].timer, testCallback, &tt[3], TW_CONTEXT_THREAD);
+  TEST_EQUAL(twStart(&tt[3].timer, 3U, 0U), 0);
+  stubThreadFlags[0] = 0U;
+  testRun(4U);
+  TEST_EQUAL(tt[3].fired, 0U);
+  TEST_EQUAL(twIsActive(&tt[3].timer), 1U);
+  TEST_ASSERT(stubThreadFlags[0] != 0U);
+  twStop(&tt[3].timer);
+  TEST_EQUAL(twIsActive(&tt[3].timer), 0U);
+
+  // ISR callbacks run under the wheel lock, released again after the tick
+  twTimerInit(&tt[4].timer, lockCallback, NULL, TW_CONTEXT_ISR);
+  TEST_EQUAL(twStart(&tt[4].timer, 2U, 0U), 0);
+  testRun(3U);
+  TEST_EQUAL(lockBasepri, IRQ_PRIO_KERNEL_MAX << (8U - __NVIC_PRIO_BITS));
+  TEST_EQUAL(__get_BASEPRI(), 0U);
+
+  return testReport("test_twheel");
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_uart_baud.c
+ * Purpose: Unit test of the UART divisor and fractional divider search
+ *----------------------------------------------------------------------------*/
+
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "uart_baud.h"
+
+// Baud rate of a divisor setting
+static uint32_t baudOf (uint32_t pclk, const uartBaud_t *div) {
+  uint32_t mul = div->fdr >> 4;
+  uint32_t add = div->fdr & 0x0FU;
+
+  return (uint32_t)(((uint64_t)pclk * mul) / (16U * (uint64_t)div->dl * (mul + add)));
+}
+
+static uint32_t absDiff (uint32_t a, uint32_t b) {
+  return (a > b) ? (a - b) : (b - a);
+}
+
+// Smallest error of all legal settings (independent exhaustive search)
+static uint32_t bestErr (uint32_t pclk, uint32_t baudrate) {
+  uartBaud_t div;
+  uint32_t   best = 0xFFFFFFFFU;
+  uint32_t   mul;
+  uint32_t   add;
+  uint32_t   dl;
+  uint32_t   err;
+
+  for (mul = 1U; mul <= 15U; mul++) {
+    for (add = 0U; add < mul; add++) {
+      for (dl = (add != 0U) ? 3U : 1U; dl <= 0xFFFFU; dl++) {
+        div.dl  = (uint16_t)dl;
+        div.fdr = (uint8_t)((mul << 4) | add);
+        err = absDiff(baudOf(pclk, &div), baudrate);
+        if (err < best) {
+          best = err;
+        }
+      }
+    }
+  }
+  return best;
+}
+
+int main (void) {
+  static const uint32_t pclk[] = { 100000000U, 50000000U, 25000000U, 12500000U, 12000000U, 3000000U };
+  static const uint32_t baud[] = { 9600U, 19200U, 38400U, 57600U, 115200U, 230400U, 460800U, 921600U };
+  LPC_UART_TypeDef *uart = LPC_UART2;
+  uartBaud_t        div;
+  uint32_t          actual;
+  uint32_t          p;
+  uint32_t          b;
+
+  // 921600 at 100 MHz needs the fractional divider (dl 7 alone gives 892857)
+  actual = uartBaudCalc(100000000U, 921600U, &div);
+  TEST_ASSERT(absDiff(actual, 921600U) < (921600U / 100U));
+  TEST_ASSERT((div.fdr & 0x0FU) != 0U);
+
+  // Exact divisor: no fraction
+  actual = uartBaudCalc(24576000U, 9600U, &div);
+  TEST_EQUAL(actual, 9600U);
+  TEST_EQUAL(div.dl, 160U);
+  TEST_EQUAL(div.fdr, 0x10U);
+
+  // Search finds the best legal setting and reports what it programs
+  for (p = 0U; p < (sizeof(pclk) / sizeof(pclk[0])); p++) {
+    for (b = 0U; b < (sizeof(baud) / sizeof(baud[0])); b++) {
+      actual = uartBaudCalc(pclk[p], baud[b], &div);
+      if (actual == 0U) {
+        TEST_ASSERT((pclk[p] / 16U) < baud[b]);
+        continue;
+      }
+      TEST_EQUAL(actual, baudOf(pclk[p], &div));
+      TEST_EQUAL(absDiff(actual, baud[b]), bestErr(pclk[p], baud[b]));
+      TEST_ASSERT((div.fdr & 0x0FU) < (div.fdr >> 4));
+      TEST_ASSERT(((div.fdr & 0x0FU) == 0U) || (div.dl >= 3U));
+    }
+  }
+
+  // Unreachable rates
+  TEST_EQUAL(uartBaudCalc(100000000U, 0U, &div), 0U);
+  TEST_EQUAL(uartBaudCalc(1000000U, 1000000U, &div), 0U);
+
+  // Register programming keeps the frame format and clears DLAB
+  uart->LCR = 0x03U;
+  actual = uartBaudSet(uart, 25000000U, 115200U);
+  TEST_ASSERT(absDiff(actual, 115200U) < (115200U / 100U));
+  uartBaudCalc(25000000U, 115200U, &div);
+  TEST_EQUAL(uart->LCR, 0x03U);
+  TEST_EQUAL(uart->DLL, div.dl & 0xFFU);
+  TEST_EQUAL(uart->DLM, div.dl >> 8);
+  TEST_EQUAL(uart->FDR, div.fdr);
+
+  return testReport("test_uart_baud");
+}
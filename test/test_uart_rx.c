@@ -0,0 +1,252 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    test_uart_rx.c
+ * Purpose: Unit test of the DMA ring receiver (spans, frame ends, overruns)
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "test.h"
+#include "stubs.h"
+#include "LPC17xx.h"
+#include "gpdma.h"
+#include "pwr_periph.h"
+#include "uart_rx.h"
+
+/*
+  The GPDMA is modelled by the test: simRecv writes bytes into the ring at
+  the position the channel would, moves the destination address and raises
+  the half-ring interrupt (optionally late, as the real interrupt may lag).
+*/
+extern void UART2_IRQHandler (void);
+
+#define HALF                    (URX_BUF_SIZE / 2U)
+
+static dmaCallback_t   simCb;
+static const dmaLli_t *simLli;
+static uint8_t        *simBuf;          // Ring as seen by the test
+static uint32_t        simPos;          // Bytes written by the "GPDMA"
+static uint32_t        simIrqs;         // Half-ring interrupts raised
+static uint32_t        simLag;          // Hold back half-ring interrupts
+
+int32_t dmaAlloc (uint32_t prio, uint32_t req, dmaCallback_t cb, void *arg) {
+  (void)prio; (void)arg;
+  TEST_EQUAL(req, DMA_REQ_UART2_RX);
+  simCb = cb;
+  return 0;
+}
+
+int32_t dmaStart (int32_t ch, const dmaLli_t *lli, uint32_t type) {
+  (void)ch;
+  TEST_EQUAL(type, DMA_P2M);
+  TEST_EQUAL(dmaLliCheck(lli), 0);
+  simLli = lli;
+  // Items hold 32-bit addresses: the upper half comes from the (static) item
+  simBuf = (uint8_t *)((((uintptr_t)lli->next) & ~(uintptr_t)0xFFFFFFFFU) | lli->dst);
+  return 0;
+}
+
+void     dmaFree   (int32_t ch) { (void)ch; }
+void     dmaStop   (int32_t ch) { (void)ch; }
+int32_t  dmaLliCheck (const dmaLli_t *lli) {
+  return ((lli->next->next == lli) && (lli->next->dst == (lli->dst + HALF))) ? 0 : -1;
+}
+
+uint32_t dmaGetDst (int32_t ch) {
+  (void)ch;
+  return simLli->dst + (simPos % URX_BUF_SIZE);
+}
+
+// UART2 runs from PCLK = CCLK (pmUartPclkDiv picks the divider for 921600)
+uint32_t pmGetPclk (uint32_t id) {
+  (void)id;
+  return 100000000U;
+}
+
+static void simIrq (void) {
+  while ((simIrqs + simLag) < (simPos / HALF)) {
+    simIrqs++;
+    simCb(DMA_EVENT_DONE, NULL);
+  }
+}
+
+static void simRecv (uint32_t len, uint8_t first) {
+  uint32_t n;
+
+  for (n = 0U; n < len; n++) {
+    simBuf[simPos % URX_BUF_SIZE] = (uint8_t)(first + n);
+    simPos++;
+  }
+  simIrq();
+}
+
+static void simTimeout (void) {
+  *(volatile uint8_t *)&LPC_UART2->LSR = 0U;
+  *(volatile uint32_t *)&LPC_UART2->IIR = 0x0CU;      // Character timeout
+  UART2_IRQHandler();
+}
+
+static void testSpanLen (void) {
+  TEST_EQUAL(urxSpanLen(0U, 10U, 10U, 64U), 10U);
+  TEST_EQUAL(urxSpanLen(0U, 10U, 4U, 64U), 4U);          // Frame end first
+  TEST_EQUAL(urxSpanLen(60U, 70U, 70U, 64U), 4U);        // End of ring
+  TEST_EQUAL(urxSpanLen(64U, 70U, 70U, 64U), 6U);
+  TEST_EQUAL(urxSpanLen(5U, 5U, 5U, 64U), 0U);
+  TEST_EQUAL(urxSpanLen(0xFFFFFFF8U, 0x00000008U, 0x00000008U, 64U), 8U);   // Counter wrap
+  TEST_EQUAL(urxSpanLen(0xFFFFFFF8U, 0x00000008U, 0xFFFFFFFCU, 64U), 4U);
+}
+
+int main (void) {
+  urxSpan_t  span;
+  urxStats_t stats;
+  uint32_t   baud;
+  uint32_t   mul;
+  uint32_t   add;
+  uint32_t   dl;
+  uint32_t   n;
+
+  testSpanLen();
+
+  TEST_EQUAL(urxInit(), 0);
+  TEST_ASSERT(simBuf != NULL);
+
+  // Baud rate within 1 % (needs the fractional divider at 100 MHz)
+  dl   = LPC_UART2->DLL;                // DLM shares the stub register with IER (no DLAB)
+  mul  = LPC_UART2->FDR >> 4;
+  add  = LPC_UART2->FDR & 0x0FU;
+  baud = (uint32_t)((100000000ULL * mul) / (16U * (uint64_t)dl * (mul + add)));
+  TEST_ASSERT((baud > (URX_BAUDRATE - (URX_BAUDRATE / 100U))) && (baud < (URX_BAUDRATE + (URX_BAUDRATE / 100U))));
+
+  // Nothing received: timeout
+  TEST_EQUAL(urxGet(&span, 10U), -1);
+
+  // Data without frame end: everything available, no flags
+  simRecv(10U, 0U);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 10U);
+  TEST_EQUAL(span.flags, 0U);
+  TEST_EQUAL(span.data[0], 0U);
+  TEST_EQUAL(span.data[9], 9U);
+  TEST_EQUAL(urxRelease(4U), 0);
+
+  // Character timeout: span stops at the frame end
+  simTimeout();
+  simRecv(5U, 100U);                    // Next frame already arriving
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 6U);
+  TEST_EQUAL(span.flags, URX_SPAN_FRAME_END);
+  TEST_EQUAL(span.data[0], 4U);
+  TEST_EQUAL(urxRelease(span.len), 0);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 5U);
+  TEST_EQUAL(span.flags, 0U);
+  TEST_EQUAL(span.data[0], 100U);
+  TEST_EQUAL(urxRelease(span.len), 0);
+
+  // A second timeout without new data is not a new frame end
+  simTimeout();
+  simTimeout();
+  urxGetStats(&stats);
+  TEST_EQUAL(stats.frames, 2U);
+
+  // Span stops at the end of the ring, continues at the start
+  simRecv(URX_BUF_SIZE - simPos - 3U, 0U);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(urxRelease(span.len), 0);
+  simRecv(8U, 200U);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 3U);
+  TEST_EQUAL(span.data[0], 200U);
+  TEST_EQUAL(urxRelease(span.len), 0);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 5U);
+  TEST_EQUAL(span.data[0], 203U);
+  TEST_EQUAL(span.data, simBuf);
+  TEST_EQUAL(urxRelease(span.len), 0);
+
+  // Half-ring interrupt lags a wrap: position still counts the full lap
+  simRecv(HALF + 100U, 0U);
+  while (urxGet(&span, 0U) == 0) {
+    urxRelease(span.len);
+  }
+  simLag = 1U;
+  n      = simPos;                      // Consumer position in the second half
+  simRecv(HALF, 0U);
+  TEST_EQUAL(simIrqs + 1U, simPos / HALF);
+  TEST_EQUAL(simIrqs & 1U, 1U);
+  TEST_ASSERT((simPos % URX_BUF_SIZE) < HALF);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, URX_BUF_SIZE - (n % URX_BUF_SIZE));
+  TEST_EQUAL(span.flags, 0U);
+  n = span.len;
+  TEST_EQUAL(urxRelease(n), 0);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(n + span.len, HALF);
+  TEST_EQUAL(urxRelease(span.len), 0);
+  simLag = 0U;
+  simIrq();
+  TEST_EQUAL(urxGet(&span, 0U), -1);
+
+  // Consumer too slow: the ring is skipped, the next span is flagged
+  simRecv(URX_BUF_SIZE + 16U, 0U);
+  TEST_EQUAL(urxGet(&span, 0U), -1);
+  urxGetStats(&stats);
+  TEST_EQUAL(stats.overruns, 1U);
+  simRecv(4U, 50U);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 4U);
+  TEST_EQUAL(span.flags, URX_SPAN_OVERRUN);
+  TEST_EQUAL(span.data[0], 50U);
+  TEST_EQUAL(urxRelease(span.len), 0);
+
+  // Span overwritten while in use: reported by urxRelease and counted
+  simRecv(4U, 0U);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.flags, 0U);
+  simRecv(URX_BUF_SIZE + 8U, 0U);
+  TEST_EQUAL(urxRelease(span.len), -1);
+  TEST_EQUAL(urxGet(&span, 0U), -1);
+  simRecv(4U, 60U);
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.flags, URX_SPAN_OVERRUN);
+  TEST_EQUAL(urxRelease(span.len), 0);
+  urxGetStats(&stats);
+  TEST_EQUAL(stats.overruns, 2U);
+
+  // More frame ends than buffered: counted as drops, data is kept
+  for (n = 0U; n < (URX_FRAME_MAX + 2U); n++) {
+    simRecv(2U, (uint8_t)n);
+    simTimeout();
+  }
+  urxGetStats(&stats);
+  TEST_EQUAL(stats.frame_drops, 2U);
+  for (n = 0U; n < URX_FRAME_MAX; n++) {
+    TEST_EQUAL(urxGet(&span, 0U), 0);
+    TEST_EQUAL(span.len, 2U);
+    TEST_EQUAL(span.flags, URX_SPAN_FRAME_END);
+    TEST_EQUAL(urxRelease(span.len), 0);
+  }
+  TEST_EQUAL(urxGet(&span, 0U), 0);
+  TEST_EQUAL(span.len, 4U);
+  TEST_EQUAL(span.flags, 0U);
+  TEST_EQUAL(urxRelease(span.len), 0);
+
+  urxGetStats(&stats);
+  TEST_EQUAL(stats.bytes, simPos);
+
+  return testReport("test_uart_rx");
+}
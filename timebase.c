@@ -0,0 +1,167 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    timebase.c
+ * Purpose: Free-running microsecond timebase on TIMER1
+ *----------------------------------------------------------------------------*/
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "timebase.h"
+#include "clk_profile.h"
+#include "pwr_periph.h"
+
+/*
+  TIMER1 counts microseconds (prescaled PCLK) over the full 32-bit range.
+  Match register 0 fires on the last count before the wrap; its interrupt
+  extends the counter to 64 bits. Readers that race with the wrap check the
+  pending match flag, so tbGetUs64() is safe from threads and from ISRs at
+  any priority.
+*/
+#define TB_TIMER                LPC_TIM1
+#define TB_IRQn                 TIMER1_IRQn
+
+static volatile uint32_t tbHigh;        // Upper 32 bits of the timebase
+
+uint32_t tbCyclesPerUs = 1U;
+
+/*-----------------------------------------------------------------------------
+  TIMER1 interrupt: counter wrap
+ *----------------------------------------------------------------------------*/
+void TIMER1_IRQHandler (void) {
+  TB_TIMER->IR = 0x01U;                 // Clear MR0 interrupt
+  tbHigh++;
+}
+
+/*-----------------------------------------------------------------------------
+  Clock change: keep 1 MHz count rate (called with kernel interrupts masked)
+ *----------------------------------------------------------------------------*/
+static void tbClockNotify (uint32_t event, uint32_t cclk) {
+  if (event == CLK_EVENT_POST) {
+    TB_TIMER->PR  = ((cclk / 4U) / 1000000U) - 1U;
+    tbCyclesPerUs = cclk / 1000000U;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  tbInit: start the microsecond counter and the core cycle counter
+  Returns -1 if the clock change callback cannot be registered.
+ *----------------------------------------------------------------------------*/
+int32_t tbInit (void) {
+  uint32_t pclk;
+
+  pmAcquire(PM_TIMER1, PM_PCLK_DIV4);   // Power on TIMER1, PCLK = CCLK / 4
+  pclk = pmGetPclk(PM_TIMER1);
+
+  tbCyclesPerUs = SystemCoreClock / 1000000U;
+  if (clkNotifyRegister(tbClockNotify) != 0) {
+    pmRelease(PM_TIMER1);
+    return -1;
+  }
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  TB_TIMER->TCR  = 0x02U;               // Reset and hold counter
+  TB_TIMER->CTCR = 0U;                  // Timer mode
+  TB_TIMER->PR   = (pclk / 1000000U) - 1U;
+  TB_TIMER->MR0  = 0xFFFFFFFFU;
+  TB_TIMER->MCR  = 0x01U;               // Interrupt on MR0, keep counting
+  TB_TIMER->IR   = 0x3FU;
+  tbHigh = 0U;
+  TB_TIMER->TCR  = 0x01U;               // Start counter
+
+  NVIC_ClearPendingIRQ(TB_IRQn);
+  NVIC_EnableIRQ(TB_IRQn);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  tbGetUs: 32-bit microsecond count (wraps after 71.6 minutes)
+ *----------------------------------------------------------------------------*/
+uint32_t tbGetUs (void) {
+  return TB_TIMER->TC;
+}
+
+/*-----------------------------------------------------------------------------
+  tbGetUs64: 64-bit microsecond count
+ *----------------------------------------------------------------------------*/
+uint64_t tbGetUs64 (void) {
+  uint32_t primask;
+  uint32_t hi;
+  uint32_t lo;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  hi = tbHigh;
+  lo = TB_TIMER->TC;
+  if (((TB_TIMER->IR & 0x01U) != 0U) && (lo < 0x80000000U)) {
+    hi++;                               // Wrapped, interrupt not yet serviced
+  }
+  __set_PRIMASK(primask);
+
+  return (((uint64_t)hi << 32) | lo);
+}
+
+/*-----------------------------------------------------------------------------
+  tbAdvance: add time the counter did not see (TIMER1 stopped in deep sleep
+  and power-down). Any wrap is carried into the upper 32 bits here, the
+  wrap interrupt is cleared so it is not counted twice.
+ *----------------------------------------------------------------------------*/
+void tbAdvance (uint32_t us) {
+  uint32_t primask;
+  uint64_t t;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  TB_TIMER->TCR = 0x00U;                // Hold counter
+  t = tbGetUs64() + us;
+  TB_TIMER->IR  = 0x01U;
+  NVIC_ClearPendingIRQ(TB_IRQn);
+  tbHigh        = (uint32_t)(t >> 32);
+  TB_TIMER->TC  = (uint32_t)t;
+  TB_TIMER->TCR = 0x01U;                // Continue counting
+  __set_PRIMASK(primask);
+}
+
+/*-----------------------------------------------------------------------------
+  tbDelayUs: busy-wait for us microseconds (any context)
+ *----------------------------------------------------------------------------*/
+void tbDelayUs (uint32_t us) {
+  uint32_t start = TB_TIMER->TC;
+
+  while ((TB_TIMER->TC - start) < us) {
+    __NOP();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  tbSleepUs: thread delay with microsecond resolution
+  Whole kernel ticks are slept with osDelay, the remainder is busy-waited.
+ *----------------------------------------------------------------------------*/
+void tbSleepUs (uint32_t us) {
+  uint32_t start   = TB_TIMER->TC;
+  uint32_t tick_us = 1000000U / osKernelGetTickFreq();
+  uint32_t ticks   = us / tick_us;
+
+  // osDelay(n) waits between n-1 and n ticks: never overshoot the deadline
+  if (ticks > 1U) {
+    osDelay(ticks - 1U);
+  }
+  while ((TB_TIMER->TC - start) < us) {
+    __NOP();
+  }
+}
@@ -0,0 +1,56 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    timebase.h
+ * Purpose: Free-running microsecond timebase on TIMER1
+ *----------------------------------------------------------------------------*/
+
+#ifndef TIMEBASE_H__
+#define TIMEBASE_H__
+
+#include <stdint.h>
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+// Cycles per microsecond at the current core clock (updated by tbInit)
+extern uint32_t tbCyclesPerUs;
+
+/* Prototypes */
+extern int32_t  tbInit     (void);
+extern uint32_t tbGetUs    (void);
+extern uint64_t tbGetUs64  (void);
+extern void     tbDelayUs  (uint32_t us);
+extern void     tbSleepUs  (uint32_t us);
+extern void     tbAdvance  (uint32_t us);
+
+/*-----------------------------------------------------------------------------
+  Core cycle counter (DWT CYCCNT, enabled by tbInit)
+ *----------------------------------------------------------------------------*/
+__STATIC_INLINE uint32_t tbGetCycles (void) {
+  return DWT->CYCCNT;
+}
+
+__STATIC_INLINE uint32_t tbCyclesToUs (uint32_t cycles) {
+  return cycles / tbCyclesPerUs;
+}
+
+__STATIC_INLINE uint32_t tbUsToCycles (uint32_t us) {
+  return us * tbCyclesPerUs;
+}
+
+#endif
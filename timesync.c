@@ -0,0 +1,202 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    timesync.c
+ * Purpose: Two-step clock synchronization with PI servo
+ *----------------------------------------------------------------------------*/
+
+
+#include <stddef.h>
+
+#include "timesync.h"
+
+#define TS_JITTER_SHIFT         4U      // Jitter smoothing (1/16 per update)
+
+/*-----------------------------------------------------------------------------
+  Synchronized time in ns at local time (us)
+ *----------------------------------------------------------------------------*/
+static int64_t tsClockNs (const tsNode_t *node, uint64_t local) {
+  int64_t dt = (int64_t)(local - node->base_local);
+
+  return node->base_ns + (dt * 1000) + ((dt * node->stats.freq) / 1000000);
+}
+
+static int64_t tsClamp (int64_t val, int64_t max) {
+  if (val > max) {
+    return max;
+  }
+  if (val < -max) {
+    return -max;
+  }
+  return val;
+}
+
+/*-----------------------------------------------------------------------------
+  Servo update from one offset measurement (slave)
+ *----------------------------------------------------------------------------*/
+static void tsUpdate (tsNode_t *node, uint64_t master, uint64_t local) {
+  int64_t  now    = tsClockNs(node, local);
+  int64_t  offset = ((int64_t)master * 1000) - now;
+  int64_t  rate;
+  int64_t  diff;
+  uint64_t interval;
+
+  // Rebase so that a new frequency applies from this point on
+  node->base_ns    = now;
+  node->base_local = local;
+  interval         = local - node->prev_local;
+  node->prev_local = local;
+
+  if ((node->state == TS_STATE_UNLOCKED) ||
+      (offset > ((int64_t)TS_STEP_US * 1000)) || (offset < -((int64_t)TS_STEP_US * 1000))) {
+    node->base_ns          += offset;   // Step, keep the frequency estimate
+    node->state             = TS_STATE_LOCKED;
+    node->stats.offset      = 0;
+    node->stats.offset_max  = 0U;
+    node->stats.steps++;
+    return;
+  }
+  if (interval == 0U) {
+    return;
+  }
+
+  // Frequency that removes the offset within one interval (ppb)
+  rate           = (offset * 1000000) / (int64_t)interval;
+  node->integral = tsClamp(node->integral + ((rate * TS_KI) / 256), TS_FREQ_MAX);
+  node->stats.freq = (int32_t)tsClamp(((rate * TS_KP) / 256) + node->integral, TS_FREQ_MAX);
+
+  // Jitter filter on a scaled sum: the decrement rounds up, so it decays to 0
+  diff = offset - node->stats.offset;
+  diff = (diff < 0) ? -diff : diff;
+  node->jitter_sum  -= (node->jitter_sum + (1U << TS_JITTER_SHIFT) - 1U) >> TS_JITTER_SHIFT;
+  node->jitter_sum  += (uint32_t)diff;
+  node->stats.jitter = (node->jitter_sum + (1U << (TS_JITTER_SHIFT - 1U))) >> TS_JITTER_SHIFT;
+  node->stats.offset = (int32_t)offset;
+  diff = (offset < 0) ? -offset : offset;
+  if ((uint64_t)diff > node->stats.offset_max) {
+    node->stats.offset_max = (uint32_t)diff;
+  }
+  node->stats.updates++;
+
+  if (node->ops->trim != NULL) {
+    node->ops->trim(node->ops->ctx, node->stats.freq);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  tsInit: reset a node (synchronized time starts equal to local time)
+ *----------------------------------------------------------------------------*/
+void tsInit (tsNode_t *node, uint32_t role, const tsOps_t *ops) {
+  const tsStats_t zero = { 0U };
+
+  node->ops        = ops;
+  node->role       = (uint8_t)role;
+  node->state      = TS_STATE_UNLOCKED;
+  node->seq        = 0U;
+  node->sync_valid = 0U;
+  node->sync_local = 0U;
+  node->prev_local = 0U;
+  node->base_local = 0U;
+  node->base_ns    = 0;
+  node->integral   = 0;
+  node->jitter_sum = 0U;
+  node->stats      = zero;
+}
+
+/*-----------------------------------------------------------------------------
+  tsMasterSync: send a SYNC frame (master, called every sync interval)
+ *----------------------------------------------------------------------------*/
+int32_t tsMasterSync (tsNode_t *node) {
+  uint8_t data[1];
+
+  if (node->role != TS_ROLE_MASTER) {
+    return -1;
+  }
+  data[0] = ++node->seq;
+  node->stats.syncs++;
+  return node->ops->send(node->ops->ctx, TS_ID_SYNC, data, 1U);
+}
+
+/*-----------------------------------------------------------------------------
+  tsTxDone: a frame has been sent at local time (master: send FOLLOW_UP)
+ *----------------------------------------------------------------------------*/
+void tsTxDone (tsNode_t *node, uint32_t id, uint64_t local) {
+  uint8_t  data[8];
+  uint64_t time;
+  uint32_t n;
+
+  if ((node->role != TS_ROLE_MASTER) || (id != TS_ID_SYNC)) {
+    return;
+  }
+  time    = tsGetTime(node, local);
+  data[0] = node->seq;
+  for (n = 1U; n < 8U; n++) {
+    data[n] = (uint8_t)time;
+    time  >>= 8;
+  }
+  (void)node->ops->send(node->ops->ctx, TS_ID_FOLLOW_UP, data, 8U);
+}
+
+/*-----------------------------------------------------------------------------
+  tsRxFrame: handle a received frame (returns 1 if it is a sync frame)
+ *----------------------------------------------------------------------------*/
+uint32_t tsRxFrame (tsNode_t *node, uint32_t id, const uint8_t *data, uint32_t len, uint64_t local) {
+  uint64_t master = 0U;
+  uint32_t n;
+
+  if (node->role != TS_ROLE_SLAVE) {
+    return 0U;
+  }
+  if ((id == TS_ID_SYNC) && (len >= 1U)) {
+    node->seq        = data[0];
+    node->sync_local = local;
+    node->sync_valid = 1U;
+    node->stats.syncs++;
+    return 1U;
+  }
+  if ((id == TS_ID_FOLLOW_UP) && (len >= 8U)) {
+    if ((node->sync_valid == 0U) || (data[0] != node->seq)) {
+      node->stats.missed++;
+    } else {
+      for (n = 7U; n > 0U; n--) {
+        master = (master << 8) | data[n];
+      }
+      tsUpdate(node, master, node->sync_local);
+    }
+    node->sync_valid = 0U;
+    return 1U;
+  }
+  return 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  tsGetTime: synchronized time in us at local time (us)
+ *----------------------------------------------------------------------------*/
+uint64_t tsGetTime (const tsNode_t *node, uint64_t local) {
+  int64_t ns = tsClockNs(node, local);
+
+  return (ns < 0) ? 0U : (uint64_t)(ns / 1000);
+}
+
+/*-----------------------------------------------------------------------------
+  tsToLocal: local time (us) at which the synchronized clock reaches time
+ *----------------------------------------------------------------------------*/
+uint64_t tsToLocal (const tsNode_t *node, uint64_t time) {
+  int64_t dt = (((int64_t)time * 1000) - node->base_ns) / 1000;
+
+  return node->base_local + (uint64_t)(dt - ((dt * node->stats.freq) / 1000000000));
+}
@@ -0,0 +1,125 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    timesync.h
+ * Purpose: Two-step clock synchronization with PI servo
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef TIMESYNC_H__
+#define TIMESYNC_H__
+
+#include <stdint.h>
+
+/*
+  The master sends a SYNC frame and takes its local time when transmission
+  completes; a FOLLOW_UP frame then carries that time. Each slave takes its
+  local time when the SYNC frame is received, so arbitration and queueing
+  delays do not matter: both times mark the end of the same frame on the bus.
+
+    SYNC       byte 0: sequence number
+    FOLLOW_UP  byte 0: sequence number, bytes 1..7: master time in us (LE)
+
+  A slave keeps a synchronized clock as a linear function of its local
+  microsecond time (offset and frequency correction in ppb). A PI servo
+  updates the frequency from every offset measurement, so the phase error
+  is removed without jumps; offsets above TS_STEP_US step the clock. The
+  frequency correction is also handed to ops->trim, for example to adjust
+  the kernel tick.
+
+  The engine does not depend on the RTOS, the device or the bus: frames go
+  out through tsOps_t and local times are passed in by the caller, so any
+  number of nodes with skewed clocks can run against a simulated bus on a
+  host. On the target see timesync_can.h.
+*/
+
+// Frame identifiers
+#ifndef TS_ID_SYNC
+#define TS_ID_SYNC              0x010U
+#endif
+#ifndef TS_ID_FOLLOW_UP
+#define TS_ID_FOLLOW_UP         0x011U
+#endif
+
+// Offset above which the clock is stepped (us)
+#ifndef TS_STEP_US
+#define TS_STEP_US              1000U
+#endif
+
+// Servo gains (1/256 units) and frequency correction limit (ppb)
+#ifndef TS_KP
+#define TS_KP                   179     // 0.7
+#endif
+#ifndef TS_KI
+#define TS_KI                   77      // 0.3
+#endif
+#ifndef TS_FREQ_MAX
+#define TS_FREQ_MAX             500000  // 500 ppm
+#endif
+
+// Roles
+#define TS_ROLE_MASTER          0U
+#define TS_ROLE_SLAVE           1U
+
+// Slave states
+#define TS_STATE_UNLOCKED       0U      // No offset measured yet
+#define TS_STATE_LOCKED         1U      // Servo running
+
+// Node interface (trim may be NULL)
+typedef struct {
+  int32_t (*send) (void *ctx, uint32_t id, const uint8_t *data, uint32_t len);
+  void    (*trim) (void *ctx, int32_t ppb);
+  void     *ctx;
+} tsOps_t;
+
+// Statistics (offset = master - slave, after the previous correction)
+typedef struct {
+  uint32_t syncs;                       // SYNC frames sent or received
+  uint32_t updates;                     // Servo updates
+  uint32_t steps;                       // Clock steps
+  uint32_t missed;                      // FOLLOW_UP without matching SYNC
+  int32_t  offset;                      // Last offset (ns)
+  uint32_t offset_max;                  // Largest offset since the last step (ns)
+  uint32_t jitter;                      // Smoothed offset change (ns)
+  int32_t  freq;                        // Frequency correction (ppb)
+} tsStats_t;
+
+// Node state (owned by the caller)
+typedef struct {
+  const tsOps_t *ops;
+  uint8_t   role;                       // TS_ROLE_xxx
+  uint8_t   state;                      // TS_STATE_xxx
+  uint8_t   seq;                        // Last SYNC sequence number
+  uint8_t   sync_valid;                 // Slave: SYNC waiting for FOLLOW_UP
+  uint64_t  sync_local;                 // Slave: local time of that SYNC (us)
+  uint64_t  prev_local;                 // Slave: local time of the last update
+  uint64_t  base_local;                 // Local time of the clock base (us)
+  int64_t   base_ns;                    // Synchronized time at base_local (ns)
+  int64_t   integral;                   // Servo integrator (ppb)
+  uint32_t  jitter_sum;                 // Jitter filter state (16 * jitter)
+  tsStats_t stats;
+} tsNode_t;
+
+/* Prototypes */
+extern void     tsInit       (tsNode_t *node, uint32_t role, const tsOps_t *ops);
+extern int32_t  tsMasterSync (tsNode_t *node);
+extern void     tsTxDone     (tsNode_t *node, uint32_t id, uint64_t local);
+extern uint32_t tsRxFrame    (tsNode_t *node, uint32_t id, const uint8_t *data, uint32_t len, uint64_t local);
+extern uint64_t tsGetTime    (const tsNode_t *node, uint64_t local);
+extern uint64_t tsToLocal    (const tsNode_t *node, uint64_t time);
+
+#endif
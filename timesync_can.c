@@ -0,0 +1,171 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    timesync_can.c
+ * Purpose: Clock synchronization service over CAN
+ *----------------------------------------------------------------------------*/
+
+
+#include <string.h>
+
+#include "timesync_can.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+
+#include "can.h"
+#include "clk_profile.h"
+#include "irq_prio.h"
+#include "timebase.h"
+#include "twheel.h"
+
+static tsNode_t  tscNode;
+static twTimer_t tscTimer;
+static uint32_t  tscTickFreq;
+static uint32_t  tscTickLoad;           // Untrimmed SysTick reload + 1
+static int32_t   tscTrimPpb;
+
+/*-----------------------------------------------------------------------------
+  Extend a 32-bit timestamp taken shortly before to 64 bits
+ *----------------------------------------------------------------------------*/
+static uint64_t tscExtend (uint32_t ts) {
+  uint64_t now = tbGetUs64();
+
+  return now - (uint32_t)((uint32_t)now - ts);
+}
+
+/*-----------------------------------------------------------------------------
+  RTX tick trim (CAN interrupt or clock change, applies at the next reload)
+ *----------------------------------------------------------------------------*/
+static void tscTickApply (void) {
+  int32_t adj = (int32_t)(((int64_t)tscTickLoad * tscTrimPpb) / 1000000000);
+
+  SysTick->LOAD = (uint32_t)((int32_t)tscTickLoad - adj) - 1U;
+}
+
+static void tscTrim (void *ctx, int32_t ppb) {
+  (void)ctx;
+  tscTrimPpb = ppb;
+  tscTickApply();
+}
+
+static void tscClockNotify (uint32_t event, uint32_t cclk) {
+  if (event == CLK_EVENT_POST) {
+    tscTickLoad = cclk / tscTickFreq;
+    tscTickApply();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Bus access
+ *----------------------------------------------------------------------------*/
+static void tscTxDone (uint32_t ts, void *arg) {
+  tsTxDone(&tscNode, (uint32_t)arg, tscExtend(ts));
+}
+
+static int32_t tscSend (void *ctx, uint32_t id, const uint8_t *data, uint32_t len) {
+  canFrame_t frame;
+  (void)ctx;
+
+  memset(&frame, 0, sizeof(frame));
+  frame.id  = id;
+  frame.dlc = (uint8_t)len;
+  memcpy(frame.data.b, data, len);
+  return canSend(&frame, tscTxDone, (void *)id);
+}
+
+static uint32_t tscRxHook (const canFrame_t *frame) {
+  if ((frame->id & (CAN_ID_EXT | CAN_ID_RTR)) != 0U) {
+    return 0U;
+  }
+  return tsRxFrame(&tscNode, frame->id, frame->data.b, frame->dlc, tscExtend(frame->ts));
+}
+
+static void tscSyncTimer (void *arg) {
+  (void)arg;
+  (void)tsMasterSync(&tscNode);         // Transmit buffers busy: skip one interval
+}
+
+static const tsOps_t tscOps = { tscSend, tscTrim, NULL };
+
+/*-----------------------------------------------------------------------------
+  tscInit: start the service (canInit must have been called, and twInit
+  for the master)
+ *----------------------------------------------------------------------------*/
+int32_t tscInit (uint32_t role) {
+  if ((role == TS_ROLE_MASTER) && (twIsRunning() == 0U)) {
+    return -1;                          // SYNC interval runs on the wheel
+  }
+  tsInit(&tscNode, role, &tscOps);
+
+  if (role == TS_ROLE_MASTER) {
+    twTimerInit(&tscTimer, tscSyncTimer, NULL, TW_CONTEXT_ISR);
+    return twStart(&tscTimer, TSC_SYNC_PERIOD, TSC_SYNC_PERIOD);
+  }
+
+  tscTickFreq = osKernelGetTickFreq();
+  tscTickLoad = SysTick->LOAD + 1U;
+  if (clkNotifyRegister(tscClockNotify) != 0) {
+    return -1;
+  }
+  canSetRxHook(tscRxHook);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  tscGetTime: synchronized time in us
+ *----------------------------------------------------------------------------*/
+uint64_t tscGetTime (void) {
+  uint64_t time;
+  uint32_t basepri;
+
+  basepri = irqKernelLock();
+  time    = tsGetTime(&tscNode, tbGetUs64());
+  irqKernelUnlock(basepri);
+  return time;
+}
+
+/*-----------------------------------------------------------------------------
+  tscSleepUntil: wait until the synchronized clock reaches time (us)
+ *----------------------------------------------------------------------------*/
+void tscSleepUntil (uint64_t time) {
+  uint64_t local;
+  uint64_t now;
+  uint32_t basepri;
+
+  basepri = irqKernelLock();
+  local   = tsToLocal(&tscNode, time);
+  irqKernelUnlock(basepri);
+
+  now = tbGetUs64();
+  while (local > now) {
+    tbSleepUs(((local - now) > 0x40000000U) ? 0x40000000U : (uint32_t)(local - now));
+    now = tbGetUs64();
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  tscGetStats: get offset, jitter and frequency statistics
+ *----------------------------------------------------------------------------*/
+void tscGetStats (tsStats_t *stats) {
+  uint32_t basepri;
+
+  basepri = irqKernelLock();
+  *stats  = tscNode.stats;
+  irqKernelUnlock(basepri);
+}
@@ -0,0 +1,66 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    timesync_can.h
+ * Purpose: Clock synchronization service over CAN
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef TIMESYNC_CAN_H__
+#define TIMESYNC_CAN_H__
+
+#include <stdint.h>
+
+#include "timesync.h"
+
+/*
+  Runs the timesync engine on the CAN driver. The master sends SYNC from the
+  timer wheel interrupt; FOLLOW_UP is sent from the transmit completion of
+  SYNC. Slaves handle both frames in the CAN receive hook, so the time of a
+  SYNC frame is the CAN interrupt entry on every node.
+
+  The slave disciplines two clocks:
+    - tscGetTime: synchronized microsecond time (timebase plus correction)
+    - the RTX tick: SysTick reload trimmed by the frequency correction, in
+      steps of one core clock cycle per tick (10 ppm at 100 MHz)
+
+  Actions that must line up across nodes wait for a synchronized time:
+
+    uint64_t t = (tscGetTime() / 500000U + 1U) * 500000U;
+    for (;;) {
+      tscSleepUntil(t);
+      vioSetSignal(vioLED0, vioLEDon);
+      t += 500000U;
+    }
+
+  The acceptance filter must pass TS_ID_SYNC and TS_ID_FOLLOW_UP. Call
+  canInit first, and on the master also twInit: tscInit fails while the
+  timer wheel is not running.
+*/
+
+// Master SYNC interval in timer wheel ticks
+#ifndef TSC_SYNC_PERIOD
+#define TSC_SYNC_PERIOD         100U
+#endif
+
+/* Prototypes */
+extern int32_t  tscInit       (uint32_t role);
+extern uint64_t tscGetTime    (void);
+extern void     tscSleepUntil (uint64_t time);
+extern void     tscGetStats   (tsStats_t *stats);
+
+#endif
@@ -0,0 +1,154 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    crash_decode.c
+ * Purpose: Host decoder of the crash record (symbolized backtrace)
+ *----------------------------------------------------------------------------*/
+
+/*
+  Usage: crash_decode <record> <elf> [addr2line]
+
+  <record> is a raw dump of crashLast (sizeof(crashRecord_t) bytes, target
+  byte order), e.g. from gdb:
+    dump binary value crash.bin crashLast
+  pc, lr and every stack word that looks like a Thumb return address into
+  flash or ER_RAMCODE are passed to addr2line (arm-none-eabi-addr2line by
+  default) together with <elf>.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crash.h"
+
+#define CRASH_MAGIC             0x43525348U     // "CRSH" (crash.c)
+
+// Code regions of the image: flash and local SRAM (ER_RAMCODE)
+static int isCode (uint32_t addr) {
+  return (addr < 0x00080000U) || ((addr >= 0x10000000U) && (addr < 0x10008000U));
+}
+
+static const char *excName (uint32_t exception) {
+  switch (exception) {
+    case 3U: return "HardFault";
+    case 4U: return "MemManage";
+    case 5U: return "BusFault";
+    case 6U: return "UsageFault";
+    default: return "unknown";
+  }
+}
+
+// CFSR bits: MMFSR [7:0], BFSR [15:8], UFSR [31:16]
+static const struct {
+  uint32_t    mask;
+  const char *name;
+} cfsrBit[] = {
+  { 1UL <<  0, "IACCVIOL"    }, { 1UL <<  1, "DACCVIOL"    }, { 1UL <<  3, "MUNSTKERR"   },
+  { 1UL <<  4, "MSTKERR"     }, { 1UL <<  7, "MMARVALID"   },
+  { 1UL <<  8, "IBUSERR"     }, { 1UL <<  9, "PRECISERR"   }, { 1UL << 10, "IMPRECISERR" },
+  { 1UL << 11, "UNSTKERR"    }, { 1UL << 12, "STKERR"      }, { 1UL << 15, "BFARVALID"   },
+  { 1UL << 16, "UNDEFINSTR"  }, { 1UL << 17, "INVSTATE"    }, { 1UL << 18, "INVPC"       },
+  { 1UL << 19, "NOCP"        }, { 1UL << 24, "UNALIGNED"   }, { 1UL << 25, "DIVBYZERO"   },
+};
+
+// Print "label  address  function at file:line" for one code address
+static void symbolize (const char *tool, const char *elf, const char *label, uint32_t addr) {
+  char  cmd[512];
+  char  func[256];
+  char  line[256];
+  FILE *pipe;
+
+  snprintf(cmd, sizeof(cmd), "%s -f -e \"%s\" 0x%08X", tool, elf, (unsigned int)addr);
+  pipe = popen(cmd, "r");
+  if ((pipe == NULL) || (fgets(func, sizeof(func), pipe) == NULL) ||
+      (fgets(line, sizeof(line), pipe) == NULL)) {
+    strcpy(func, "??\n");
+    strcpy(line, "??:0\n");
+  }
+  if (pipe != NULL) {
+    pclose(pipe);
+  }
+  func[strcspn(func, "\n")] = '\0';
+  line[strcspn(line, "\n")] = '\0';
+  printf("  %-10s 0x%08X  %s at %s\n", label, (unsigned int)addr, func, line);
+}
+
+int main (int argc, char *argv[]) {
+  crashRecord_t rec;
+  const char   *tool;
+  char          label[16];
+  FILE         *file;
+  uint32_t      n;
+
+  if ((argc < 3) || (argc > 4)) {
+    fprintf(stderr, "usage: %s <record> <elf> [addr2line]\n", argv[0]);
+    return 2;
+  }
+  tool = (argc == 4) ? argv[3] : "arm-none-eabi-addr2line";
+
+  file = fopen(argv[1], "rb");
+  if (file == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  n = (uint32_t)fread(&rec, 1U, sizeof(rec), file);
+  fclose(file);
+  if ((n != sizeof(rec)) || (rec.magic != CRASH_MAGIC)) {
+    fprintf(stderr, "%s: no valid crash record (%u bytes, magic 0x%08X)\n",
+            argv[1], (unsigned int)n, (unsigned int)rec.magic);
+    return 1;
+  }
+  if (rec.stack_words > CRASH_STACK_WORDS) {
+    rec.stack_words = CRASH_STACK_WORDS;
+  }
+  rec.thread_name[sizeof(rec.thread_name) - 1U] = '\0';
+
+  printf("%s (crash %u) in thread \"%s\" (0x%08X), %s stack\n",
+         excName(rec.exception), (unsigned int)rec.count, rec.thread_name,
+         (unsigned int)rec.thread, ((rec.exc_return & 4U) != 0U) ? "process" : "main");
+  printf("  r0 %08X  r1 %08X  r2 %08X  r3 %08X  r12 %08X\n",
+         (unsigned int)rec.r0, (unsigned int)rec.r1, (unsigned int)rec.r2,
+         (unsigned int)rec.r3, (unsigned int)rec.r12);
+  printf("  sp %08X  xpsr %08X  hfsr %08X  cfsr %08X",
+         (unsigned int)rec.sp, (unsigned int)rec.xpsr, (unsigned int)rec.hfsr, (unsigned int)rec.cfsr);
+  for (n = 0U; n < (sizeof(cfsrBit) / sizeof(cfsrBit[0])); n++) {
+    if ((rec.cfsr & cfsrBit[n].mask) != 0U) {
+      printf(" %s", cfsrBit[n].name);
+    }
+  }
+  printf("\n");
+  if ((rec.cfsr & (1UL << 7)) != 0U) {
+    printf("  mmfar %08X\n", (unsigned int)rec.mmfar);
+  }
+  if ((rec.cfsr & (1UL << 15)) != 0U) {
+    printf("  bfar %08X\n", (unsigned int)rec.bfar);
+  }
+
+  // Return addresses point behind the call: step back into the call itself
+  printf("backtrace:\n");
+  symbolize(tool, argv[2], "pc", rec.pc);
+  if (((rec.lr & 1U) != 0U) && isCode(rec.lr)) {
+    symbolize(tool, argv[2], "lr", (rec.lr & ~1U) - 2U);
+  }
+  for (n = 0U; n < rec.stack_words; n++) {
+    if (((rec.stack[n] & 1U) != 0U) && isCode(rec.stack[n] & ~1U)) {
+      snprintf(label, sizeof(label), "sp+%u", (unsigned int)(n * 4U));
+      symbolize(tool, argv[2], label, (rec.stack[n] & ~1U) - 2U);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,350 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    lg_decode.c
+ * Purpose: Host decoder of the binary logger stream (logger.h)
+ *----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lg_decode.h"
+
+#define LGD_SHT_NOBITS          8U      // Section without file data
+
+/*-----------------------------------------------------------------------------
+  Little-endian fields
+ *----------------------------------------------------------------------------*/
+static uint32_t lgdGet16 (const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t lgdGet32 (const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t lgdGet64 (const uint8_t *p) {
+  return (uint64_t)lgdGet32(p) | ((uint64_t)lgdGet32(&p[4]) << 32);
+}
+
+/*-----------------------------------------------------------------------------
+  lgdLoadElf: read section .logstr of an ELF file
+  Returns 0, or -1 if the file cannot be read or has no such section.
+ *----------------------------------------------------------------------------*/
+int32_t lgdLoadElf (lgdStrings_t *str, const char *path) {
+  const uint8_t *sh;
+  uint8_t       *img;
+  FILE          *f;
+  long           size;
+  uint64_t       shoff;
+  uint64_t       off;
+  uint64_t       len;
+  uint64_t       names;
+  uint32_t       shentsize;
+  uint32_t       shnum;
+  uint32_t       shstrndx;
+  uint32_t       elf64;
+  uint32_t       n;
+  int32_t        status = -1;
+
+  memset(str, 0, sizeof(lgdStrings_t));
+  f = fopen(path, "rb");
+  if (f == NULL) {
+    return -1;
+  }
+  if ((fseek(f, 0L, SEEK_END) != 0) || ((size = ftell(f)) < 64L) || (fseek(f, 0L, SEEK_SET) != 0)) {
+    fclose(f);
+    return -1;
+  }
+  img = malloc((size_t)size);
+  if ((img == NULL) || (fread(img, 1U, (size_t)size, f) != (size_t)size)) {
+    free(img);
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+
+  // Identification: ELF, 32 or 64 bit, little-endian
+  if ((memcmp(img, "\177ELF", 4U) != 0) || ((img[4] != 1U) && (img[4] != 2U)) || (img[5] != 1U)) {
+    free(img);
+    return -1;
+  }
+  elf64     = (img[4] == 2U) ? 1U : 0U;
+  shoff     = elf64 ? lgdGet64(&img[0x28]) : lgdGet32(&img[0x20]);
+  shentsize = lgdGet16(&img[elf64 ? 0x3AU : 0x2EU]);
+  shnum     = lgdGet16(&img[elf64 ? 0x3CU : 0x30U]);
+  shstrndx  = lgdGet16(&img[elf64 ? 0x3EU : 0x32U]);
+  if ((shentsize < (elf64 ? 64U : 40U)) || (shstrndx >= shnum) ||
+      ((shoff + ((uint64_t)shnum * shentsize)) > (uint64_t)size)) {
+    free(img);
+    return -1;
+  }
+
+  sh    = &img[shoff + ((uint64_t)shstrndx * shentsize)];
+  names = elf64 ? lgdGet64(&sh[24]) : lgdGet32(&sh[16]);
+
+  for (n = 0U; n < shnum; n++) {
+    sh  = &img[shoff + ((uint64_t)n * shentsize)];
+    off = names + lgdGet32(&sh[0]);
+    if ((off + sizeof(".logstr")) > (uint64_t)size) {
+      continue;
+    }
+    if ((memcmp(&img[off], ".logstr", sizeof(".logstr")) != 0) || (lgdGet32(&sh[4]) == LGD_SHT_NOBITS)) {
+      continue;
+    }
+    off = elf64 ? lgdGet64(&sh[24]) : lgdGet32(&sh[16]);
+    len = elf64 ? lgdGet64(&sh[32]) : lgdGet32(&sh[20]);
+    if (((off + len) > (uint64_t)size) || (len == 0U) || (len > 0xFFFFFFFFU)) {
+      break;
+    }
+    str->data = malloc((size_t)len);
+    if (str->data != NULL) {
+      memcpy(str->data, &img[off], (size_t)len);
+      str->addr = (uint32_t)(elf64 ? lgdGet64(&sh[16]) : lgdGet32(&sh[12]));
+      str->size = (uint32_t)len;
+      status    = 0;
+    }
+    break;
+  }
+  free(img);
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  lgdFree: release the strings of lgdLoadElf
+ *----------------------------------------------------------------------------*/
+void lgdFree (lgdStrings_t *str) {
+  free(str->data);
+  memset(str, 0, sizeof(lgdStrings_t));
+}
+
+/*-----------------------------------------------------------------------------
+  lgdLookup: format string at target address fmt (NULL if not in .logstr)
+ *----------------------------------------------------------------------------*/
+const char *lgdLookup (const lgdStrings_t *str, uint32_t fmt) {
+  const char *s;
+
+  if ((str->data == NULL) || (fmt < str->addr) || ((fmt - str->addr) >= str->size)) {
+    return NULL;
+  }
+  s = &str->data[fmt - str->addr];
+  if (memchr(s, '\0', str->size - (fmt - str->addr)) == NULL) {
+    return NULL;                        // Not terminated inside the section
+  }
+  return s;
+}
+
+/*-----------------------------------------------------------------------------
+  lgdFormat: printf with the 32-bit record arguments
+  Length modifiers are ignored, %s and %p print the address (the target
+  cannot send strings), floating point conversions print the integer the
+  call site converted the value to. Returns the length of out.
+ *----------------------------------------------------------------------------*/
+uint32_t lgdFormat (char *out, size_t size, const char *fmt, const uint32_t *args, uint32_t nargs) {
+  char     spec[32];
+  char     conv;
+  size_t   len = 0U;
+  size_t   s;
+  uint32_t arg = 0U;
+  uint32_t val;
+  int      n;
+
+  if (size == 0U) {
+    return 0U;
+  }
+  out[0] = '\0';
+
+  while ((*fmt != '\0') && (len < (size - 1U))) {
+    if (*fmt != '%') {
+      out[len++] = *fmt++;
+      continue;
+    }
+    if (fmt[1] == '%') {
+      out[len++] = '%';
+      fmt += 2;
+      continue;
+    }
+
+    // Flags, width and precision are kept, '*' takes the next argument
+    s = 0U;
+    spec[s++] = *fmt++;
+    while ((*fmt != '\0') && (strchr("-+ #0123456789.*", *fmt) != NULL) && (s < (sizeof(spec) - 16U))) {
+      if (*fmt == '*') {
+        val = (arg < nargs) ? args[arg] : 0U;
+        arg++;
+        s += (size_t)snprintf(&spec[s], sizeof(spec) - s, "%d", (int)(int32_t)val);
+      } else {
+        spec[s++] = *fmt;
+      }
+      fmt++;
+    }
+    while ((*fmt != '\0') && (strchr("hljztLq", *fmt) != NULL)) {
+      fmt++;
+    }
+    conv = *fmt;
+    if (conv == '\0') {
+      break;
+    }
+    fmt++;
+
+    if (arg >= nargs) {
+      n = snprintf(&out[len], size - len, "<missing>");
+    } else {
+      val = args[arg++];
+      switch (conv) {
+        case 'd': case 'i':
+          spec[s++] = 'd'; spec[s] = '\0';
+          n = snprintf(&out[len], size - len, spec, (int)(int32_t)val);
+          break;
+        case 'u': case 'o': case 'x': case 'X':
+          spec[s++] = conv; spec[s] = '\0';
+          n = snprintf(&out[len], size - len, spec, (unsigned int)val);
+          break;
+        case 'c':
+          spec[s++] = 'c'; spec[s] = '\0';
+          n = snprintf(&out[len], size - len, spec, (int)(uint8_t)val);
+          break;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+          spec[s++] = conv; spec[s] = '\0';
+          n = snprintf(&out[len], size - len, spec, (double)(int32_t)val);
+          break;
+        case 's':
+        case 'p':
+          n = snprintf(&out[len], size - len, "0x%08X", (unsigned int)val);
+          break;
+        default:
+          spec[s++] = conv; spec[s] = '\0';
+          n = snprintf(&out[len], size - len, "%s", spec);
+          arg--;                        // Not a conversion: argument unused
+          break;
+      }
+    }
+    if (n > 0) {
+      len += (size_t)n;
+      if (len > (size - 1U)) {
+        len = size - 1U;                // Truncated
+      }
+    }
+  }
+  out[len] = '\0';
+  return (uint32_t)len;
+}
+
+/*-----------------------------------------------------------------------------
+  lgdText: message text of a record (without time stamp and level)
+ *----------------------------------------------------------------------------*/
+uint32_t lgdText (const lgdStrings_t *str, const lgdRecord_t *rec, char *out, size_t size) {
+  const char *fmt;
+  size_t      len;
+  uint32_t    n;
+
+  if (size == 0U) {
+    return 0U;
+  }
+  if (rec->fmt == 0U) {
+    snprintf(out, size, "%u records dropped", (unsigned int)((rec->nargs != 0U) ? rec->args[0] : 0U));
+    return (uint32_t)strlen(out);
+  }
+  fmt = lgdLookup(str, rec->fmt);
+  if (fmt != NULL) {
+    return lgdFormat(out, size, fmt, rec->args, rec->nargs);
+  }
+
+  // Image does not match the stream: show the raw record
+  snprintf(out, size, "<unknown format 0x%08X>", (unsigned int)rec->fmt);
+  for (n = 0U; n < rec->nargs; n++) {
+    len = strlen(out);
+    snprintf(&out[len], size - len, " 0x%08X", (unsigned int)rec->args[n]);
+  }
+  return (uint32_t)strlen(out);
+}
+
+/*-----------------------------------------------------------------------------
+  lgdInit: reset decoder state
+ *----------------------------------------------------------------------------*/
+void lgdInit (lgDecoder_t *dec, lgdOutput_t out, void *arg) {
+  memset(dec, 0, sizeof(lgDecoder_t));
+  dec->out = out;
+  dec->arg = arg;
+}
+
+/*-----------------------------------------------------------------------------
+  Header byte: level 0..3, bits 2 and 3 clear, at most four arguments
+ *----------------------------------------------------------------------------*/
+static uint32_t lgdHeaderValid (uint32_t header) {
+  return (((header & 0x8CU) == 0U) && ((header >> 4) <= 4U)) ? 1U : 0U;
+}
+
+static void lgdFrame (lgDecoder_t *dec) {
+  lgdRecord_t rec;
+  uint32_t    n;
+
+  rec.level = dec->frame[1] & 0x03U;
+  rec.nargs = dec->frame[1] >> 4;
+  rec.seq   = dec->frame[2];
+  rec.ts    = lgdGet32(&dec->frame[3]);
+  rec.fmt   = lgdGet32(&dec->frame[7]);
+  for (n = 0U; n < 4U; n++) {
+    rec.args[n] = (n < rec.nargs) ? lgdGet32(&dec->frame[11U + (4U * n)]) : 0U;
+  }
+  rec.gap = (dec->seq_valid != 0U) ? (uint8_t)(rec.seq - dec->seq) : 0U;
+
+  dec->seq       = (uint8_t)(rec.seq + 1U);
+  dec->seq_valid = 1U;
+  dec->stats.records++;
+  dec->stats.lost += rec.gap;
+  if ((rec.fmt == 0U) && (rec.nargs != 0U)) {
+    dec->stats.dropped += rec.args[0];
+  }
+  if (dec->out != NULL) {
+    dec->out(&rec, dec->arg);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  lgdPut: decode received bytes (any chunk size)
+ *----------------------------------------------------------------------------*/
+void lgdPut (lgDecoder_t *dec, const uint8_t *data, uint32_t len) {
+  uint32_t b;
+  uint32_t n;
+
+  for (n = 0U; n < len; n++) {
+    b = data[n];
+
+    if (dec->frame_len == 1U) {
+      if (lgdHeaderValid(b) == 0U) {
+        dec->stats.errors++;            // Not a frame start: skip the sync byte
+        dec->frame_len = 0U;
+      }
+    }
+    if (dec->frame_len == 0U) {
+      if (b == LGD_SYNC) {
+        dec->frame[dec->frame_len++] = (uint8_t)b;
+      } else {
+        dec->stats.errors++;
+      }
+      continue;
+    }
+
+    dec->frame[dec->frame_len++] = (uint8_t)b;
+    if (dec->frame_len == (11U + (4U * (dec->frame[1] >> 4)))) {
+      lgdFrame(dec);
+      dec->frame_len = 0U;
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    lg_decode.h
+ * Purpose: Host decoder of the binary logger stream (logger.h)
+ *----------------------------------------------------------------------------*/
+
+#ifndef LG_DECODE_H__
+#define LG_DECODE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Decodes the wire format documented in logger.h. Records carry the
+  address of their format string only. lgdLoadElf reads the strings from
+  section .logstr of the image that produced the stream (ELF32 or ELF64,
+  little-endian), lgdText formats a record with them:
+
+    lgdLoadElf(&str, "app.elf");
+    lgdInit(&dec, print, NULL);
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+      lgdPut(&dec, buf, n);
+    }
+
+    static void print (const lgdRecord_t *rec, void *arg) {
+      lgdText(&str, rec, text, sizeof(text));
+      ...
+    }
+
+  The decoder synchronizes on the 0xA5 byte followed by a valid header, so
+  it can be started in the middle of a stream. Frames missing between two
+  records (sequence gap) are reported in lgdRecord_t.gap; records the
+  target dropped itself arrive as a record with fmt = 0.
+*/
+
+#define LGD_SYNC                0xA5U
+#define LGD_FRAME_MAX           (11U + (4U * 4U))   // Sync, header, seq, ts, fmt, args
+
+// Decoded record
+typedef struct {
+  uint32_t level;                       // LG_LEVEL_xxx (0 debug .. 3 error)
+  uint32_t nargs;
+  uint32_t seq;
+  uint32_t ts;                          // Target time stamp in us
+  uint32_t fmt;                         // Format string address (0: drop report)
+  uint32_t args[4];
+  uint32_t gap;                         // Frames lost before this one
+} lgdRecord_t;
+
+typedef void (*lgdOutput_t) (const lgdRecord_t *rec, void *arg);
+
+// Decoder statistics
+typedef struct {
+  uint32_t records;                     // Frames decoded
+  uint32_t lost;                        // Frames lost in transmission (sequence gaps)
+  uint32_t dropped;                     // Records dropped by the target (fmt = 0)
+  uint32_t errors;                      // Bytes skipped while searching for a frame
+} lgdStats_t;
+
+// Decoder state
+typedef struct {
+  uint8_t      frame[LGD_FRAME_MAX];
+  uint32_t     frame_len;
+  uint32_t     seq_valid;
+  uint8_t      seq;                     // Expected sequence number
+  lgdOutput_t  out;
+  void        *arg;
+  lgdStats_t   stats;
+} lgDecoder_t;
+
+// Format strings of an image (section .logstr)
+typedef struct {
+  uint32_t  addr;                       // Section address
+  uint32_t  size;
+  char     *data;
+} lgdStrings_t;
+
+/* Prototypes */
+extern int32_t     lgdLoadElf (lgdStrings_t *str, const char *path);
+extern void        lgdFree    (lgdStrings_t *str);
+extern const char *lgdLookup  (const lgdStrings_t *str, uint32_t fmt);
+extern void        lgdInit    (lgDecoder_t *dec, lgdOutput_t out, void *arg);
+extern void        lgdPut     (lgDecoder_t *dec, const uint8_t *data, uint32_t len);
+extern uint32_t    lgdFormat  (char *out, size_t size, const char *fmt, const uint32_t *args, uint32_t nargs);
+extern uint32_t    lgdText    (const lgdStrings_t *str, const lgdRecord_t *rec, char *out, size_t size);
+
+#endif
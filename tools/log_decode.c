@@ -0,0 +1,90 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    log_decode.c
+ * Purpose: Binary log stream to text (command line)
+ *----------------------------------------------------------------------------*/
+
+/*
+  Usage: log_decode <elf> [file]
+
+  Reads the logger byte stream from file (or stdin, e.g. a serial port set
+  up with stty) and writes one line per record to stdout, with the format
+  strings taken from section .logstr of the image that sent it:
+    [   12.345678] WARN  adc 3 out of range: -17
+  Frames lost in transmission are reported before the next record, records
+  the target dropped as "N records dropped". Decoder statistics are printed
+  to stderr at the end of the stream.
+*/
+
+#include <stdio.h>
+
+#include "lg_decode.h"
+
+static const char *const levelName[4] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+static void outText (const lgdRecord_t *rec, void *arg) {
+  const lgdStrings_t *str = arg;
+  char                text[512];
+
+  if (rec->gap != 0U) {
+    printf("-- %u frames lost --\n", (unsigned int)rec->gap);
+  }
+  lgdText(str, rec, text, sizeof(text));
+  printf("[%5u.%06u] %s %s\n", (unsigned int)(rec->ts / 1000000U),
+         (unsigned int)(rec->ts % 1000000U), levelName[rec->level & 3U], text);
+}
+
+int main (int argc, char *argv[]) {
+  static lgDecoder_t dec;
+  lgdStrings_t       str;
+  uint8_t            buf[4096];
+  FILE              *in = stdin;
+  size_t             n;
+
+  if ((argc < 2) || (argc > 3) || (argv[1][0] == '-')) {
+    fprintf(stderr, "usage: %s <elf> [file]\n", argv[0]);
+    return 2;
+  }
+  if (lgdLoadElf(&str, argv[1]) != 0) {
+    fprintf(stderr, "%s: no section .logstr\n", argv[1]);
+    return 1;
+  }
+  if (argc == 3) {
+    in = fopen(argv[2], "rb");
+    if (in == NULL) {
+      perror(argv[2]);
+      lgdFree(&str);
+      return 1;
+    }
+  }
+
+  lgdInit(&dec, outText, &str);
+  while ((n = fread(buf, 1U, sizeof(buf), in)) != 0U) {
+    lgdPut(&dec, buf, (uint32_t)n);
+    fflush(stdout);
+  }
+  if (in != stdin) {
+    fclose(in);
+  }
+  lgdFree(&str);
+
+  fprintf(stderr, "%u records, %u lost, %u dropped, %u errors\n",
+          (unsigned int)dec.stats.records, (unsigned int)dec.stats.lost,
+          (unsigned int)dec.stats.dropped, (unsigned int)dec.stats.errors);
+  return 0;
+}
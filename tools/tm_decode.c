@@ -0,0 +1,244 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    tm_decode.c
+ * Purpose: Host decoder of the telemetry stream (telemetry.h)
+ *----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "tm_decode.h"
+
+/*-----------------------------------------------------------------------------
+  tmdCobsDecode: reverse tmCobsEncode (src without the delimiter)
+  Returns the decoded length or 0 if src is not a valid COBS frame.
+ *----------------------------------------------------------------------------*/
+uint32_t tmdCobsDecode (const uint8_t *src, uint32_t len, uint8_t *dst) {
+  uint32_t in  = 0U;
+  uint32_t out = 0U;
+  uint32_t code;
+  uint32_t n;
+
+  while (in < len) {
+    code = src[in++];
+    if ((code == 0U) || ((in + code - 1U) > len)) {
+      return 0U;
+    }
+    for (n = 1U; n < code; n++) {
+      if (src[in] == 0U) {
+        return 0U;
+      }
+      dst[out++] = src[in++];
+    }
+    if ((code != 0xFFU) && (in < len)) {
+      dst[out++] = 0U;
+    }
+  }
+  return out;
+}
+
+/*-----------------------------------------------------------------------------
+  tmdValue: value widened to 32 bits converted by channel type
+ *----------------------------------------------------------------------------*/
+double tmdValue (uint32_t type, uint32_t raw) {
+  float f;
+
+  switch (type) {
+    case TM_I8:
+    case TM_I16:
+    case TM_I32:
+      return (double)(int32_t)raw;
+    case TM_F32:
+      memcpy(&f, &raw, sizeof(f));
+      return (double)f;
+    default:
+      return (double)raw;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Read a varint, returns the new position or 0 if truncated
+ *----------------------------------------------------------------------------*/
+static uint32_t tmdVarint (const uint8_t *pkt, uint32_t len, uint32_t pos, uint32_t *val) {
+  uint32_t shift = 0U;
+
+  *val = 0U;
+  while ((pos < len) && (shift < 35U)) {
+    *val  |= (uint32_t)(pkt[pos] & 0x7FU) << shift;
+    shift += 7U;
+    if ((pkt[pos++] & 0x80U) == 0U) {
+      return pos;
+    }
+  }
+  return 0U;
+}
+
+static void tmdInvalidate (tmDecoder_t *dec) {
+  uint32_t n;
+
+  for (n = 0U; n < TM_CHANNEL_MAX; n++) {
+    dec->ch[n].valid = 0U;
+  }
+}
+
+static void tmdOutput (tmDecoder_t *dec, uint32_t time, uint32_t id) {
+  tmdSample_t sample;
+
+  dec->stats.samples++;
+  if (dec->out == NULL) {
+    return;
+  }
+  sample.time  = time;
+  sample.id    = id;
+  sample.ch    = &dec->ch[id];
+  sample.raw   = dec->ch[id].value;
+  sample.value = tmdValue(dec->ch[id].type, sample.raw);
+  dec->out(&sample, dec->arg);
+}
+
+/*-----------------------------------------------------------------------------
+  tmdPacket: decode one packet (after COBS decoding)
+  Returns 0 or -1 if the packet is malformed.
+ *----------------------------------------------------------------------------*/
+int32_t tmdPacket (tmDecoder_t *dec, const uint8_t *pkt, uint32_t len) {
+  tmdChannel_t *ch;
+  uint32_t      type;
+  uint32_t      time;
+  uint32_t      pos;
+  uint32_t      id;
+  uint32_t      val;
+  uint32_t      name_len;
+
+  if (len < 3U) {
+    dec->stats.errors++;
+    return -1;
+  }
+  type = pkt[0];
+  pos  = tmdVarint(pkt, len, 2U, &time);
+  if ((pos == 0U) || (type < TM_PKT_DATA) || (type > TM_PKT_DESC)) {
+    dec->stats.errors++;
+    tmdInvalidate(dec);
+    return -1;
+  }
+
+  // Deltas after a lost packet are relative to unknown values
+  if ((dec->seq_valid != 0U) && (pkt[1] != (uint8_t)(dec->seq + 1U))) {
+    dec->stats.lost += (uint8_t)(pkt[1] - dec->seq - 1U);
+    tmdInvalidate(dec);
+  }
+  dec->seq       = pkt[1];
+  dec->seq_valid = 1U;
+  dec->stats.packets++;
+
+  while (pos < len) {
+    pos = tmdVarint(pkt, len, pos, &id);
+    if ((pos == 0U) || (id >= TM_CHANNEL_MAX)) {
+      break;
+    }
+    ch = &dec->ch[id];
+
+    if (type == TM_PKT_DESC) {
+      if ((pos + 1U) >= len) {
+        break;
+      }
+      ch->type = pkt[pos++];
+      pos = tmdVarint(pkt, len, pos, &val);
+      if ((pos == 0U) || (pos >= len)) {
+        break;
+      }
+      ch->period_ms = (uint16_t)val;
+      name_len      = pkt[pos++];
+      if ((pos + name_len) > len) {
+        break;
+      }
+      val = (name_len > TMD_NAME_MAX) ? TMD_NAME_MAX : name_len;
+      memcpy(ch->name, &pkt[pos], val);
+      ch->name[val] = '\0';
+      ch->known     = 1U;
+      pos += name_len;
+      continue;
+    }
+
+    pos = tmdVarint(pkt, len, pos, &val);
+    if (pos == 0U) {
+      break;
+    }
+    val = (val >> 1) ^ (0U - (val & 1U));           // Zigzag
+    if (type == TM_PKT_KEY) {
+      ch->value = val;
+      ch->valid = 1U;
+    } else if (ch->valid != 0U) {
+      ch->value += val;
+    } else {
+      dec->stats.skipped++;
+      continue;
+    }
+    tmdOutput(dec, time, id);
+  }
+
+  if (pos != len) {
+    dec->stats.errors++;
+    tmdInvalidate(dec);
+    return -1;
+  }
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  tmdInit: reset the decoder
+  out: called for every decoded value (may be NULL)
+ *----------------------------------------------------------------------------*/
+void tmdInit (tmDecoder_t *dec, tmdOutput_t out, void *arg) {
+  memset(dec, 0, sizeof(*dec));
+  dec->out = out;
+  dec->arg = arg;
+}
+
+/*-----------------------------------------------------------------------------
+  tmdPut: decode stream bytes (0x00 terminates a COBS frame)
+ *----------------------------------------------------------------------------*/
+void tmdPut (tmDecoder_t *dec, const uint8_t *data, uint32_t len) {
+  uint8_t  pkt[sizeof(dec->frame)];
+  uint32_t pkt_len;
+  uint32_t n;
+
+  for (n = 0U; n < len; n++) {
+    if (data[n] != 0U) {
+      if (dec->frame_len < sizeof(dec->frame)) {
+        dec->frame[dec->frame_len++] = data[n];
+      } else {
+        dec->overflow = 1U;
+      }
+      continue;
+    }
+
+    if (dec->overflow != 0U) {
+      dec->stats.errors++;
+      tmdInvalidate(dec);
+    } else if (dec->frame_len != 0U) {
+      pkt_len = tmdCobsDecode(dec->frame, dec->frame_len, pkt);
+      if (pkt_len == 0U) {
+        dec->stats.errors++;
+        tmdInvalidate(dec);
+      } else {
+        (void)tmdPacket(dec, pkt, pkt_len);
+      }
+    }
+    dec->frame_len = 0U;
+    dec->overflow  = 0U;
+  }
+}
@@ -0,0 +1,98 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    tm_decode.h
+ * Purpose: Host decoder of the telemetry stream (telemetry.h)
+ *----------------------------------------------------------------------------*/
+
+#ifndef TM_DECODE_H__
+#define TM_DECODE_H__
+
+#include <stdint.h>
+
+#include "telemetry.h"
+
+/*
+  Feed the received bytes in any chunk size to tmdPut. Every decoded value
+  is passed to the output callback with its absolute value:
+
+    static void print (const tmdSample_t *s, void *arg) { ... }
+
+    tmdInit(&dec, print, NULL);
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+      tmdPut(&dec, buf, n);
+    }
+
+  A decoder started in the middle of a stream, or one that detected a lost
+  packet (sequence gap), knows no absolute values: data packets are skipped
+  until the next key packet. Values of channels without a description yet
+  are reported with an empty name.
+*/
+
+#define TMD_NAME_MAX            32U     // Longest stored channel name
+
+// Channel as learned from TM_PKT_DESC and TM_PKT_KEY
+typedef struct {
+  char     name[TMD_NAME_MAX + 1U];
+  uint8_t  type;                        // TM_xxx
+  uint8_t  known;                       // Description received
+  uint8_t  valid;                       // Absolute value known
+  uint16_t period_ms;
+  uint32_t value;                       // Value widened to 32 bits
+} tmdChannel_t;
+
+// Decoded value
+typedef struct {
+  uint32_t            time;             // Kernel ticks of the packet
+  uint32_t            id;               // Channel id
+  const tmdChannel_t *ch;               // Channel (name, type)
+  uint32_t            raw;              // Value widened to 32 bits
+  double              value;            // Value converted by type
+} tmdSample_t;
+
+typedef void (*tmdOutput_t) (const tmdSample_t *sample, void *arg);
+
+// Decoder statistics
+typedef struct {
+  uint32_t packets;                     // Packets decoded
+  uint32_t lost;                        // Packets lost (sequence gaps)
+  uint32_t errors;                      // Malformed frames
+  uint32_t skipped;                     // Deltas of channels without absolute value
+  uint32_t samples;                     // Values output
+} tmdStats_t;
+
+// Decoder state
+typedef struct {
+  tmdChannel_t ch[TM_CHANNEL_MAX];
+  uint8_t      frame[TM_PACKET_MAX + (TM_PACKET_MAX / 254U) + 2U];
+  uint32_t     frame_len;
+  uint32_t     overflow;                // Frame too long: skip to delimiter
+  uint32_t     seq_valid;
+  uint8_t      seq;
+  tmdOutput_t  out;
+  void        *arg;
+  tmdStats_t   stats;
+} tmDecoder_t;
+
+/* Prototypes */
+extern void     tmdInit       (tmDecoder_t *dec, tmdOutput_t out, void *arg);
+extern void     tmdPut        (tmDecoder_t *dec, const uint8_t *data, uint32_t len);
+extern int32_t  tmdPacket     (tmDecoder_t *dec, const uint8_t *pkt, uint32_t len);
+extern uint32_t tmdCobsDecode (const uint8_t *src, uint32_t len, uint8_t *dst);
+extern double   tmdValue      (uint32_t type, uint32_t raw);
+
+#endif
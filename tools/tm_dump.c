@@ -0,0 +1,133 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    tm_dump.c
+ * Purpose: Telemetry stream to CSV or JSON (command line)
+ *----------------------------------------------------------------------------*/
+
+/*
+  Usage: tm_dump [-j] [file]
+
+  Reads the telemetry byte stream from file (or stdin, e.g. a serial port
+  set up with stty) and writes one line per decoded value to stdout:
+    CSV (default):  time,id,name,value
+    JSON (-j):      {"time":1234,"id":0,"name":"g_ledSet","value":3}
+  Decoder statistics are printed to stderr at the end of the stream.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tm_decode.h"
+
+static void printValue (const tmdSample_t *s, int json) {
+  if (s->ch->type == TM_F32) {
+    if (isfinite(s->value)) {
+      printf("%.9g", s->value);
+    } else {
+      printf("%s", json ? "null" : "");
+    }
+  } else if ((s->ch->type == TM_I8) || (s->ch->type == TM_I16) || (s->ch->type == TM_I32)) {
+    printf("%d", (int)(int32_t)s->raw);
+  } else {
+    printf("%u", (unsigned int)s->raw);
+  }
+}
+
+static void outCsv (const tmdSample_t *s, void *arg) {
+  (void)arg;
+  // Names are C identifiers in practice; quote anything else
+  if (strpbrk(s->ch->name, ",\"\n") != NULL) {
+    printf("%u,%u,\"", (unsigned int)s->time, (unsigned int)s->id);
+    for (const char *c = s->ch->name; *c != '\0'; c++) {
+      if (*c == '"') {
+        printf("\"\"");
+      } else {
+        printf("%c", *c);
+      }
+    }
+    printf("\",");
+  } else {
+    printf("%u,%u,%s,", (unsigned int)s->time, (unsigned int)s->id, s->ch->name);
+  }
+  printValue(s, 0);
+  printf("\n");
+}
+
+static void outJson (const tmdSample_t *s, void *arg) {
+  (void)arg;
+  printf("{\"time\":%u,\"id\":%u,\"name\":\"", (unsigned int)s->time, (unsigned int)s->id);
+  for (const char *c = s->ch->name; *c != '\0'; c++) {
+    if ((*c == '"') || (*c == '\\')) {
+      printf("\\%c", *c);
+    } else if ((unsigned char)*c < 0x20U) {
+      printf("\\u%04x", (unsigned int)(unsigned char)*c);
+    } else {
+      printf("%c", *c);
+    }
+  }
+  printf("\",\"value\":");
+  printValue(s, 1);
+  printf("}\n");
+}
+
+int main (int argc, char *argv[]) {
+  static tmDecoder_t dec;
+  uint8_t            buf[4096];
+  const char        *path = NULL;
+  FILE              *in   = stdin;
+  size_t             n;
+  int                json = 0;
+  int                i;
+
+  for (i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-j") == 0) {
+      json = 1;
+    } else if ((argv[i][0] == '-') || (path != NULL)) {
+      fprintf(stderr, "usage: %s [-j] [file]\n", argv[0]);
+      return 2;
+    } else {
+      path = argv[i];
+    }
+  }
+  if (path != NULL) {
+    in = fopen(path, "rb");
+    if (in == NULL) {
+      perror(path);
+      return 1;
+    }
+  }
+
+  tmdInit(&dec, json ? outJson : outCsv, NULL);
+  if (!json) {
+    printf("time,id,name,value\n");
+  }
+  while ((n = fread(buf, 1U, sizeof(buf), in)) != 0U) {
+    tmdPut(&dec, buf, (uint32_t)n);
+    fflush(stdout);
+  }
+  if (in != stdin) {
+    fclose(in);
+  }
+
+  fprintf(stderr, "%u packets, %u values, %u lost, %u errors, %u skipped\n",
+          (unsigned int)dec.stats.packets, (unsigned int)dec.stats.samples,
+          (unsigned int)dec.stats.lost, (unsigned int)dec.stats.errors,
+          (unsigned int)dec.stats.skipped);
+  return 0;
+}
@@ -0,0 +1,414 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    twheel.c
+ * Purpose: Hierarchical timer wheel driven by the Repetitive Interrupt Timer
+ *----------------------------------------------------------------------------*/
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "twheel.h"
+
+#include "timebase.h"
+#include "irq_prio.h"
+#include "clk_profile.h"
+#include "pwr_periph.h"
+#include "mem_sections.h"
+
+/*
+  Four levels cover 2^26 ticks (18.6 hours at 1 kHz). Level 0 holds timers
+  expiring within the next 256 ticks, each further level covers 64 times the
+  range of the one below. Timers are moved one level down ("cascaded") when
+  the lower level wraps, so start and stop are O(1) and each tick only
+  touches the slots that are due.
+*/
+#define TW_L0_BITS              8U
+#define TW_LN_BITS              6U
+#define TW_L0_SIZE              (1UL << TW_L0_BITS)
+#define TW_LN_SIZE              (1UL << TW_LN_BITS)
+#define TW_L0_MASK              (TW_L0_SIZE - 1U)
+#define TW_LN_MASK              (TW_LN_SIZE - 1U)
+#define TW_LEVELS               4U
+#define TW_RANGE                (1UL << (TW_L0_BITS + ((TW_LEVELS - 1U) * TW_LN_BITS)))
+
+#define TW_SHIFT(level)         (TW_L0_BITS + (((level) - 1U) * TW_LN_BITS))
+
+#define TW_FLAG_EXPIRED         0x0001U // Worker thread flag: expired list not empty
+
+// Timer states
+#define TW_STATE_IDLE           0U
+#define TW_STATE_WHEEL          1U      // Linked into a wheel slot
+#define TW_STATE_EXPIRED        2U      // Linked into the expired list
+
+// Slot heads are linked by twInit: no zero-init needed at startup
+static twNode_t     twLevel0[TW_L0_SIZE]                    __NOINIT;
+static twNode_t     twLevelN[TW_LEVELS - 1U][TW_LN_SIZE]    __NOINIT;
+static twNode_t     twExpired;                  // Thread context callbacks due
+static uint32_t     twTime;                     // Next tick to be processed
+static osThreadId_t twThreadId;
+static uint8_t      twRunning;                  // Slots linked and RIT started
+
+__USED twStats_t    twStats;
+
+const osThreadAttr_t twheel_attr = {.name = "TimerWheel", .priority = osPriorityHigh};
+
+/*-----------------------------------------------------------------------------
+  Critical section (RIT interrupt and callers in threads or kernel-aware ISRs)
+ *----------------------------------------------------------------------------*/
+static inline uint32_t twLock (void) {
+  return irqKernelLock();
+}
+
+static inline void twUnlock (uint32_t basepri) {
+  irqKernelUnlock(basepri);
+}
+
+/*-----------------------------------------------------------------------------
+  Doubly linked list with sentinel head
+ *----------------------------------------------------------------------------*/
+static inline void twListInit (twNode_t *head) {
+  head->next = head;
+  head->prev = head;
+}
+
+static inline void twListAppend (twNode_t *head, twNode_t *node) {
+  node->prev       = head->prev;
+  node->next       = head;
+  head->prev->next = node;
+  head->prev       = node;
+}
+
+static inline void twListRemove (twNode_t *node) {
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  node->next = NULL;
+  node->prev = NULL;
+}
+
+/*-----------------------------------------------------------------------------
+  Insert timer into the slot matching its expiration time
+ *----------------------------------------------------------------------------*/
+static void twInsert (twTimer_t *timer) {
+  uint32_t  expire = timer->expire;
+  uint32_t  delta  = expire - twTime;
+  twNode_t *slot;
+
+  if ((int32_t)delta < 0) {
+    // Already due: handle with the next tick
+    slot = &twLevel0[twTime & TW_L0_MASK];
+  } else if (delta < TW_L0_SIZE) {
+    slot = &twLevel0[expire & TW_L0_MASK];
+  } else {
+    if (delta >= TW_RANGE) {
+      // Beyond the wheel range: park in the last slot, re-sorted on cascade
+      expire = twTime + (TW_RANGE - 1U);
+      delta  = TW_RANGE - 1U;
+    }
+    if (delta < (1UL << TW_SHIFT(2U))) {
+      slot = &twLevelN[0][(expire >> TW_SHIFT(1U)) & TW_LN_MASK];
+    } else if (delta < (1UL << TW_SHIFT(3U))) {
+      slot = &twLevelN[1][(expire >> TW_SHIFT(2U)) & TW_LN_MASK];
+    } else {
+      slot = &twLevelN[2][(expire >> TW_SHIFT(3U)) & TW_LN_MASK];
+    }
+  }
+
+  timer->state = TW_STATE_WHEEL;
+  twListAppend(slot, &timer->node);
+}
+
+/*-----------------------------------------------------------------------------
+  Move all timers of a higher level slot down the wheel (twLock held)
+  Returns slot index (0 means the next level has to cascade as well)
+ *----------------------------------------------------------------------------*/
+static uint32_t twCascade (uint32_t level) {
+  uint32_t  index = (twTime >> TW_SHIFT(level)) & TW_LN_MASK;
+  twNode_t *head  = &twLevelN[level - 1U][index];
+  twNode_t  list;
+  twNode_t *node;
+
+  if (head->next != head) {
+    // Detach slot first, re-insertion may target the same slot
+    list.next       = head->next;
+    list.prev       = head->prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    twListInit(head);
+
+    while ((node = list.next) != &list) {
+      twListRemove(node);
+      twInsert((twTimer_t *)node);
+    }
+  }
+  return index;
+}
+
+/*-----------------------------------------------------------------------------
+  Process one wheel tick (called with RIT interrupt context)
+  Kernel-aware interrupts above RIT (I2C engine) call twStart and twStop:
+  the lists are only touched with twLock held, which is released between
+  timers. An ISR callback runs with the lock still held, so a restart from
+  such an interrupt cannot slip in between expiry and callback and have
+  the stale callback act on the new run.
+ *----------------------------------------------------------------------------*/
+static void twTick (void) {
+  twNode_t  *slot;
+  twNode_t  *node;
+  twTimer_t *timer;
+  uint32_t   level;
+  uint32_t   lock;
+  uint32_t   batch  = 0U;
+  uint32_t   defer  = 0U;
+
+  lock = twLock();
+  slot = &twLevel0[twTime & TW_L0_MASK];
+  if ((twTime & TW_L0_MASK) == 0U) {
+    for (level = 1U; level < TW_LEVELS; level++) {
+      if (twCascade(level) != 0U) {
+        break;
+      }
+    }
+  }
+
+  while ((node = slot->next) != slot) {
+    timer = (twTimer_t *)node;
+    twListRemove(node);
+    batch++;
+
+    if ((timer->flags & TW_CONTEXT_ISR) != 0U) {
+      timer->state = TW_STATE_IDLE;
+      if (timer->period != 0U) {
+        timer->expire += timer->period;
+        twInsert(timer);
+      }
+      timer->func(timer->arg);
+      twUnlock(lock);                   // Higher priority interrupts run here
+      lock = twLock();
+    } else {
+      timer->state = TW_STATE_EXPIRED;
+      twListAppend(&twExpired, node);
+      defer = 1U;
+    }
+  }
+
+  twTime++;
+  twUnlock(lock);
+
+  twStats.ticks++;
+  twStats.expired += batch;
+  if (batch > twStats.batch_max) {
+    twStats.batch_max = batch;
+  }
+
+  // One wake-up per tick for the whole batch of thread context callbacks
+  if ((defer != 0U) && (twThreadId != NULL)) {
+    osThreadFlagsSet(twThreadId, TW_FLAG_EXPIRED);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  RIT interrupt: wheel tick
+ *----------------------------------------------------------------------------*/
+void RIT_IRQHandler (void) {
+  uint32_t cycles = tbGetCycles();
+
+  LPC_RIT->RICTRL |= 0x01U;             // Clear RITINT
+
+  twTick();
+
+  cycles = tbGetCycles() - cycles;
+  if (cycles > twStats.isr_cycles_max) {
+    twStats.isr_cycles_max = cycles;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  twThread: runs thread context callbacks in batches
+ *----------------------------------------------------------------------------*/
+static __NO_RETURN void twThread (void *argument) {
+  twNode_t  *node;
+  twTimer_t *timer;
+  uint32_t   lock;
+  (void)argument;
+
+  for (;;) {
+    osThreadFlagsWait(TW_FLAG_EXPIRED, osFlagsWaitAny, osWaitForever);
+
+    for (;;) {
+      lock = twLock();
+      node = twExpired.next;
+      if (node == &twExpired) {
+        twUnlock(lock);
+        break;
+      }
+      timer = (twTimer_t *)node;
+      twListRemove(node);
+      timer->state = TW_STATE_IDLE;
+      if (timer->period != 0U) {
+        timer->expire += timer->period;
+        twInsert(timer);
+      }
+      twUnlock(lock);
+
+      timer->func(timer->arg);
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Clock change: keep the tick rate (called with kernel interrupts masked)
+ *----------------------------------------------------------------------------*/
+static void twClockNotify (uint32_t event, uint32_t cclk) {
+  if (event == CLK_EVENT_POST) {
+    LPC_RIT->RICOMPVAL = ((cclk / 4U) / TW_TICK_FREQ) - 1U;
+    if (LPC_RIT->RICOUNTER > LPC_RIT->RICOMPVAL) {
+      LPC_RIT->RICOUNTER = 0U;          // Avoid a full 32-bit wrap
+    }
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  twInit: initialize the wheel and start the RIT
+ *----------------------------------------------------------------------------*/
+int32_t twInit (void) {
+  uint32_t n;
+  uint32_t level;
+
+  for (n = 0U; n < TW_L0_SIZE; n++) {
+    twListInit(&twLevel0[n]);
+  }
+  for (level = 0U; level < (TW_LEVELS - 1U); level++) {
+    for (n = 0U; n < TW_LN_SIZE; n++) {
+      twListInit(&twLevelN[level][n]);
+    }
+  }
+  twListInit(&twExpired);
+  twTime = 0U;
+
+  twThreadId = osThreadNew(twThread, NULL, &twheel_attr);
+  if (twThreadId == NULL) {
+    return -1;
+  }
+  if (clkNotifyRegister(twClockNotify) != 0) {
+    (void)osThreadTerminate(twThreadId);
+    twThreadId = NULL;
+    return -1;
+  }
+
+  // RIT runs from PCLK_RIT = CCLK / 4 and clears on match
+  pmAcquire(PM_RIT, PM_PCLK_DIV4);
+  LPC_RIT->RICTRL    = 0U;
+  LPC_RIT->RICOUNTER = 0U;
+  LPC_RIT->RIMASK    = 0U;
+  LPC_RIT->RICOMPVAL = (pmGetPclk(PM_RIT) / TW_TICK_FREQ) - 1U;
+  LPC_RIT->RICTRL    = 0x01U |          // RITINT:   clear pending interrupt
+                       0x02U |          // RITENCLR: clear counter on match
+                       0x04U |          // RITENBR:  halt on debug break
+                       0x08U;           // RITEN:    enable timer
+
+  NVIC_ClearPendingIRQ(RIT_IRQn);
+  NVIC_EnableIRQ(RIT_IRQn);
+
+  twRunning = 1U;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  twTimerInit: set up a timer control block
+ *----------------------------------------------------------------------------*/
+void twTimerInit (twTimer_t *timer, twFunc_t func, void *arg, uint8_t flags) {
+  timer->node.next = NULL;
+  timer->node.prev = NULL;
+  timer->func      = func;
+  timer->arg       = arg;
+  timer->expire    = 0U;
+  timer->period    = 0U;
+  timer->flags     = flags;
+  timer->state     = TW_STATE_IDLE;
+}
+
+/*-----------------------------------------------------------------------------
+  twStart: (re)start timer, expiring after ticks and then every period ticks
+  Delays beyond TW_TICKS_MAX would compare as already due and are rejected,
+  as is any start before twInit linked the slots.
+ *----------------------------------------------------------------------------*/
+int32_t twStart (twTimer_t *timer, uint32_t ticks, uint32_t period) {
+  uint32_t lock;
+
+  if ((timer == NULL) || (timer->func == NULL) || (twRunning == 0U)) {
+    return -1;
+  }
+  if ((ticks > TW_TICKS_MAX) || (period > TW_TICKS_MAX)) {
+    return -1;
+  }
+
+  if (ticks == 0U) {
+    ticks = 1U;                         // Never expire within the current tick
+  }
+
+  lock = twLock();
+  if (timer->state != TW_STATE_IDLE) {
+    twListRemove(&timer->node);
+  }
+  timer->expire = twTime + ticks;
+  timer->period = period;
+  twInsert(timer);
+  twUnlock(lock);
+
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  twStop: stop timer (also cancels a callback not yet run by the worker)
+ *----------------------------------------------------------------------------*/
+void twStop (twTimer_t *timer) {
+  uint32_t lock;
+
+  lock = twLock();
+  if (timer->state != TW_STATE_IDLE) {
+    twListRemove(&timer->node);
+    timer->state = TW_STATE_IDLE;
+  }
+  twUnlock(lock);
+}
+
+/*-----------------------------------------------------------------------------
+  twIsActive: check if timer is running or its callback is pending
+ *----------------------------------------------------------------------------*/
+uint32_t twIsActive (const twTimer_t *timer) {
+  return (timer->state != TW_STATE_IDLE) ? 1U : 0U;
+}
+
+/*-----------------------------------------------------------------------------
+  twIsRunning: check if twInit has completed (timers can be started)
+ *----------------------------------------------------------------------------*/
+uint32_t twIsRunning (void) {
+  return twRunning;
+}
+
+/*-----------------------------------------------------------------------------
+  twGetTime: current wheel time in ticks
+ *----------------------------------------------------------------------------*/
+uint32_t twGetTime (void) {
+  return twTime;
+}
+
+/*-----------------------------------------------------------------------------
+  twGetStats: get wheel statistics
+ *----------------------------------------------------------------------------*/
+void twGetStats (twStats_t *stats) {
+  *stats = twStats;
+}
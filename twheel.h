@@ -0,0 +1,90 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    twheel.h
+ * Purpose: Hierarchical timer wheel driven by the Repetitive Interrupt Timer
+ *----------------------------------------------------------------------------*/
+
+#ifndef TWHEEL_H__
+#define TWHEEL_H__
+
+#include <stdint.h>
+
+// Wheel tick frequency in Hz (RIT interrupt rate)
+#ifndef TW_TICK_FREQ
+#define TW_TICK_FREQ            1000U
+#endif
+
+/*
+  Delays count whole ticks: twStart(timer, n, period) fires on the n+1-th
+  RIT interrupt after the call, since the tick in progress when it is
+  called has already partly elapsed. The delay is therefore between n and
+  n+1 tick periods, never shorter. An RTX osTimer fires on the n-th tick
+  instead, after n-1 to n periods. Reloads then follow every period ticks.
+*/
+
+// Longest delay and period accepted by twStart (24.8 days at 1 kHz)
+#define TW_TICKS_MAX            0x7FFFFFFFU
+
+/*
+  TW_CONTEXT_ISR callbacks run in the RIT interrupt with kernel-aware
+  interrupts masked (irqKernelLock): keep them short. twStart and twStop
+  may be called from any kernel-aware interrupt, also above RIT priority.
+*/
+
+// Timer flags
+#define TW_CONTEXT_ISR          0x01U   // Run callback in RIT interrupt
+#define TW_CONTEXT_THREAD       0x00U   // Run callback in timer worker thread
+
+typedef void (*twFunc_t) (void *arg);
+
+// List node (first member of twTimer_t)
+typedef struct twNode_s {
+  struct twNode_s *next;
+  struct twNode_s *prev;
+} twNode_t;
+
+// Timer control block (owned by the caller, no dynamic allocation)
+typedef struct {
+  twNode_t  node;                       // Link in wheel slot or expired list
+  twFunc_t  func;                       // Callback function
+  void     *arg;                        // Callback argument
+  uint32_t  expire;                     // Expiration time in wheel ticks
+  uint32_t  period;                     // Reload period (0 = one-shot)
+  uint8_t   flags;                      // TW_CONTEXT_xxx
+  uint8_t   state;                      // Timer state (internal)
+} twTimer_t;
+
+// Wheel statistics
+typedef struct {
+  uint32_t ticks;                       // Processed wheel ticks
+  uint32_t expired;                     // Total expired timers
+  uint32_t batch_max;                   // Most timers expired in one tick
+  uint32_t isr_cycles_max;              // Worst case tick processing time
+} twStats_t;
+
+/* Prototypes */
+extern int32_t  twInit     (void);
+extern void     twTimerInit(twTimer_t *timer, twFunc_t func, void *arg, uint8_t flags);
+extern int32_t  twStart    (twTimer_t *timer, uint32_t ticks, uint32_t period);
+extern void     twStop     (twTimer_t *timer);
+extern uint32_t twIsActive (const twTimer_t *timer);
+extern uint32_t twIsRunning(void);
+extern uint32_t twGetTime  (void);
+extern void     twGetStats (twStats_t *stats);
+
+#endif
@@ -0,0 +1,86 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    uart_baud.c
+ * Purpose: UART divisor calculation with fractional divider
+ *----------------------------------------------------------------------------*/
+
+
+#include "uart_baud.h"
+
+/*-----------------------------------------------------------------------------
+  uartBaudCalc: divisor latch and fractional divider closest to baudrate
+  baud = pclk / (16 * dl * (1 + DIVADDVAL / MULVAL))
+  Returns the resulting baud rate (0 if baudrate cannot be reached).
+ *----------------------------------------------------------------------------*/
+uint32_t uartBaudCalc (uint32_t pclk, uint32_t baudrate, uartBaud_t *div) {
+  uint32_t best_err = 0xFFFFFFFFU;
+  uint32_t best     = 0U;
+  uint32_t mul;
+  uint32_t add;
+  uint32_t dl;
+  uint32_t actual;
+  uint32_t err;
+
+  if (baudrate == 0U) {
+    return 0U;
+  }
+  for (mul = 1U; mul <= 15U; mul++) {
+    for (add = 0U; add < mul; add++) {
+      if ((add == 0U) && (mul > 1U)) {
+        continue;                       // Without fraction mul has no effect
+      }
+      // dl = pclk * mul / (16 * baudrate * (mul + add)), rounded
+      dl = (uint32_t)((((uint64_t)pclk * mul) + (8U * (uint64_t)baudrate * (mul + add))) /
+                      (16U * (uint64_t)baudrate * (mul + add)));
+      if ((dl == 0U) || (dl > 0xFFFFU) || ((add != 0U) && (dl < 3U))) {
+        continue;                       // Fractional divider needs dl >= 3
+      }
+      actual = (uint32_t)(((uint64_t)pclk * mul) / (16U * (uint64_t)dl * (mul + add)));
+      err    = (actual > baudrate) ? (actual - baudrate) : (baudrate - actual);
+      if (err < best_err) {
+        best_err = err;
+        best     = actual;
+        div->dl  = (uint16_t)dl;
+        div->fdr = (uint8_t)((mul << 4) | add);
+      }
+    }
+  }
+  return best;
+}
+
+/*-----------------------------------------------------------------------------
+  uartBaudSet: program the divisors of a UART (frame format is kept)
+  Returns the resulting baud rate (0 if baudrate cannot be reached).
+ *----------------------------------------------------------------------------*/
+uint32_t uartBaudSet (LPC_UART_TypeDef *uart, uint32_t pclk, uint32_t baudrate) {
+  uartBaud_t div;
+  uint32_t   actual;
+  uint8_t    lcr;
+
+  actual = uartBaudCalc(pclk, baudrate, &div);
+  if (actual == 0U) {
+    return 0U;
+  }
+  lcr       = uart->LCR & 0x7FU;
+  uart->LCR = lcr | 0x80U;              // DLAB: access divisor latch
+  uart->DLL = (uint8_t)(div.dl & 0xFFU);
+  uart->DLM = (uint8_t)(div.dl >> 8);
+  uart->LCR = lcr;
+  uart->FDR = div.fdr;
+  return actual;
+}
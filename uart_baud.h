@@ -0,0 +1,41 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    uart_baud.h
+ * Purpose: UART divisor calculation with fractional divider
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef UART_BAUD_H__
+#define UART_BAUD_H__
+
+#include <stdint.h>
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+// Divisor setting for one baud rate
+typedef struct {
+  uint16_t dl;                          // Divisor latch (DLM:DLL)
+  uint8_t  fdr;                         // Fractional divider (MULVAL << 4 | DIVADDVAL)
+} uartBaud_t;
+
+/* Prototypes */
+extern uint32_t uartBaudCalc (uint32_t pclk, uint32_t baudrate, uartBaud_t *div);
+extern uint32_t uartBaudSet  (LPC_UART_TypeDef *uart, uint32_t pclk, uint32_t baudrate);
+
+#endif
@@ -0,0 +1,331 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    uart_rx.c
+ * Purpose: Circular DMA UART receiver with character timeout framing
+ *----------------------------------------------------------------------------*/
+
+
+#include "cmsis_os2.h"                  // ::CMSIS:RTOS2
+#include "uart_rx.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#include "PIN_LPC17xx.h"
+
+#include "clk_profile.h"
+#include "gpdma.h"
+#include "irq_prio.h"
+#include "mem_sections.h"
+#include "pwr_periph.h"
+#include "uart_baud.h"
+
+#if   (URX_UART == 0)
+#define URX_REG                 ((LPC_UART_TypeDef *)LPC_UART0)
+#define URX_PM                  PM_UART0
+#define URX_DMA_REQ             DMA_REQ_UART0_RX
+#define URX_IRQn                UART0_IRQn
+#define URX_IRQHandler          UART0_IRQHandler
+#define URX_PIN_PORT            0U      // P0.3 RXD0
+#define URX_PIN_BIT             3U
+#define URX_PIN_FUNC            PIN_FUNC_1
+#elif (URX_UART == 2)
+#define URX_REG                 LPC_UART2
+#define URX_PM                  PM_UART2
+#define URX_DMA_REQ             DMA_REQ_UART2_RX
+#define URX_IRQn                UART2_IRQn
+#define URX_IRQHandler          UART2_IRQHandler
+#define URX_PIN_PORT            0U      // P0.11 RXD2 (mbed p27)
+#define URX_PIN_BIT             11U
+#define URX_PIN_FUNC            PIN_FUNC_1
+#elif (URX_UART == 3)
+#define URX_REG                 LPC_UART3
+#define URX_PM                  PM_UART3
+#define URX_DMA_REQ             DMA_REQ_UART3_RX
+#define URX_IRQn                UART3_IRQn
+#define URX_IRQHandler          UART3_IRQHandler
+#define URX_PIN_PORT            0U      // P0.1 RXD3 (mbed p10)
+#define URX_PIN_BIT             1U
+#define URX_PIN_FUNC            PIN_FUNC_2
+#else
+#error "URX_UART must be 0, 2 or 3"
+#endif
+
+#if ((URX_BUF_SIZE & (URX_BUF_SIZE - 1U)) != 0U) || ((URX_BUF_SIZE / 2U) > DMA_SIZE_MAX)
+#error "URX_BUF_SIZE must be a power of 2 of at most 4096 bytes"
+#endif
+#if ((URX_FRAME_MAX & (URX_FRAME_MAX - 1U)) != 0U)
+#error "URX_FRAME_MAX must be a power of 2"
+#endif
+
+#define URX_HALF                (URX_BUF_SIZE / 2U)
+#define URX_EVENT_DATA          0x0001U // Event flag: half ring or frame end
+
+// UART registers
+#define URX_LSR_RDR             0x01U   // Receive data ready
+#define URX_LSR_ERRORS          0x1EU   // Overrun, parity, framing, break
+#define URX_IIR_NONE            0x01U
+#define URX_IIR_ID              0x0EU
+#define URX_IIR_RLS             0x06U   // Receive line status
+#define URX_IIR_CTI             0x0CU   // Character timeout
+
+// Ring written by the GPDMA (two halves, linked into a loop)
+static uint8_t           urxBuf[URX_BUF_SIZE] __DMA_RAM;
+static dmaLli_t          urxLli[2] __DMA_RAM;
+
+static int32_t           urxDmaCh = -1;
+static volatile uint32_t urxHalves;     // Completed ring halves
+static uint32_t          urxTail;       // Consumer position (bytes)
+static uint32_t          urxPending;    // URX_SPAN_OVERRUN for next span
+
+// Frame end positions (SPSC ring: UART ISR to consumer)
+static volatile uint32_t urxFrame[URX_FRAME_MAX];
+static volatile uint32_t urxFrameHead;
+static uint32_t          urxFrameTail;
+static uint32_t          urxFrameLast;
+
+static osEventFlagsId_t  urxEvents;
+
+__USED urxStats_t        urxStats;      // Receiver statistics
+
+/*-----------------------------------------------------------------------------
+  Producer position: total bytes written by the GPDMA
+  The half counter may lag the hardware by one DMA interrupt. A wrap that is
+  not counted yet shows as an odd counter with the address in the first half.
+ *----------------------------------------------------------------------------*/
+static uint32_t urxHead (void) {
+  uint32_t halves = urxHalves;
+  uint32_t offset = dmaGetDst(urxDmaCh) - (uint32_t)urxBuf;
+  uint32_t pos;
+
+  pos = ((halves >> 1) * URX_BUF_SIZE) + offset;
+  if (((halves & 1U) != 0U) && (offset < URX_HALF)) {
+    pos += URX_BUF_SIZE;
+  }
+  return pos;
+}
+
+/*-----------------------------------------------------------------------------
+  urxSpanLen: contiguous bytes from tail, bounded by head, the next frame
+  end (frame_end = head if none) and the end of the ring
+ *----------------------------------------------------------------------------*/
+uint32_t urxSpanLen (uint32_t tail, uint32_t head, uint32_t frame_end, uint32_t size) {
+  uint32_t len  = head - tail;
+  uint32_t room = size - (tail & (size - 1U));
+
+  if ((frame_end - tail) < len) {
+    len = frame_end - tail;
+  }
+  if (len > room) {
+    len = room;
+  }
+  return len;
+}
+
+/*-----------------------------------------------------------------------------
+  DMA half ring completed (DMA interrupt context)
+ *----------------------------------------------------------------------------*/
+static void urxDmaEvent (uint32_t event, void *arg) {
+  (void)arg;
+  if ((event & DMA_EVENT_DONE) != 0U) {
+    urxHalves++;
+    osEventFlagsSet(urxEvents, URX_EVENT_DATA);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  UART interrupt: line errors and character timeout (frame end)
+  Data is moved by the GPDMA; receive data available needs no action.
+ *----------------------------------------------------------------------------*/
+void URX_IRQHandler (void) {
+  uint32_t iir;
+  uint32_t pos;
+  uint32_t n;
+
+  for (;;) {
+    iir = URX_REG->IIR;
+    if ((iir & URX_IIR_NONE) != 0U) {
+      return;
+    }
+    if ((iir & URX_IIR_ID) == URX_IIR_RLS) {
+      if ((URX_REG->LSR & URX_LSR_ERRORS) != 0U) {
+        urxStats.line_errors++;
+      }
+      continue;
+    }
+    if ((iir & URX_IIR_ID) != URX_IIR_CTI) {
+      return;                           // Trigger level: served by the GPDMA
+    }
+
+    // Let the GPDMA drain the remaining characters
+    for (n = 0U; (n < 64U) && ((URX_REG->LSR & URX_LSR_RDR) != 0U); n++) {
+      __NOP();
+    }
+    pos = urxHead();
+    if (pos != urxFrameLast) {
+      urxFrameLast = pos;
+      if ((urxFrameHead - urxFrameTail) < URX_FRAME_MAX) {
+        urxFrame[urxFrameHead & (URX_FRAME_MAX - 1U)] = pos;
+        urxFrameHead++;
+        urxStats.frames++;
+      } else {
+        urxStats.frame_drops++;
+      }
+      osEventFlagsSet(urxEvents, URX_EVENT_DATA);
+    }
+    return;
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  Keep the baud rate across clock profile changes
+ *----------------------------------------------------------------------------*/
+static void urxClockNotify (uint32_t event, uint32_t cclk) {
+  (void)cclk;
+  if (event == CLK_EVENT_POST) {
+    uartBaudSet(URX_REG, pmGetPclk(URX_PM), URX_BAUDRATE);
+  }
+}
+
+/*-----------------------------------------------------------------------------
+  urxInit: set up the UART (8N1, DMA mode) and start circular reception
+ *----------------------------------------------------------------------------*/
+int32_t urxInit (void) {
+  uint32_t ctrl;
+
+  urxEvents = osEventFlagsNew(NULL);
+  if (urxEvents == NULL) {
+    return -1;
+  }
+  if (pmAcquire(URX_PM, pmUartPclkDiv(URX_BAUDRATE)) != 0) {
+    return -1;
+  }
+  PIN_Configure(URX_PIN_PORT, URX_PIN_BIT, URX_PIN_FUNC, PIN_PINMODE_PULLUP, PIN_PINMODE_NORMAL);
+
+  URX_REG->LCR = 0x03U;                 // 8 data bits, no parity, 1 stop bit
+  if (uartBaudSet(URX_REG, pmGetPclk(URX_PM), URX_BAUDRATE) == 0U) {
+    pmRelease(URX_PM);
+    return -1;
+  }
+  // FIFO enable and RX reset, DMA mode, trigger level 8 characters. The UART
+  // requests DMA at the trigger level and on character timeout.
+  URX_REG->FCR = 0x8BU;
+
+  urxDmaCh = dmaAlloc(DMA_PRIO_HIGH, URX_DMA_REQ, urxDmaEvent, NULL);
+  if (urxDmaCh < 0) {
+    pmRelease(URX_PM);
+    return -1;
+  }
+
+  ctrl = DMA_CTRL_SIZE(URX_HALF) | DMA_CTRL_SBSIZE(DMA_BURST_1) | DMA_CTRL_DBSIZE(DMA_BURST_1) |
+         DMA_CTRL_SWIDTH(DMA_WIDTH_8) | DMA_CTRL_DWIDTH(DMA_WIDTH_8) |
+         DMA_CTRL_DI | DMA_CTRL_I;
+  urxLli[0].src  = (uint32_t)&URX_REG->RBR;
+  urxLli[0].dst  = (uint32_t)&urxBuf[0];
+  urxLli[0].next = &urxLli[1];
+  urxLli[0].ctrl = ctrl;
+  urxLli[1].src  = (uint32_t)&URX_REG->RBR;
+  urxLli[1].dst  = (uint32_t)&urxBuf[URX_HALF];
+  urxLli[1].next = &urxLli[0];
+  urxLli[1].ctrl = ctrl;
+  if (dmaStart(urxDmaCh, &urxLli[0], DMA_P2M) != 0) {
+    dmaFree(urxDmaCh);
+    urxDmaCh = -1;
+    pmRelease(URX_PM);
+    return -1;
+  }
+
+  if (clkNotifyRegister(urxClockNotify) != 0) {
+    dmaStop(urxDmaCh);
+    dmaFree(urxDmaCh);
+    urxDmaCh = -1;
+    pmRelease(URX_PM);
+    return -1;
+  }
+
+  URX_REG->IER = 0x05U;                 // RBR (character timeout) and line status
+  NVIC_ClearPendingIRQ(URX_IRQn);
+  NVIC_EnableIRQ(URX_IRQn);
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  urxGet: wait for received data and return it in place (consumer thread)
+  Returns 0 or -1 (timeout).
+ *----------------------------------------------------------------------------*/
+int32_t urxGet (urxSpan_t *span, uint32_t timeout) {
+  uint32_t head;
+  uint32_t frame_end;
+  uint32_t flags;
+
+  for (;;) {
+    head = urxHead();
+    if ((head - urxTail) > URX_BUF_SIZE) {
+      urxTail     = head;               // Overwritten: continue with new data
+      urxPending |= URX_SPAN_OVERRUN;
+      urxStats.overruns++;
+    }
+    // Drop frame ends that were consumed or overwritten
+    while ((urxFrameTail != urxFrameHead) &&
+           ((int32_t)(urxFrame[urxFrameTail & (URX_FRAME_MAX - 1U)] - urxTail) <= 0)) {
+      urxFrameTail++;
+    }
+    if (head != urxTail) {
+      break;
+    }
+    flags = osEventFlagsWait(urxEvents, URX_EVENT_DATA, osFlagsWaitAny, timeout);
+    if ((flags & osFlagsError) != 0U) {
+      return -1;
+    }
+  }
+
+  frame_end = head;
+  flags     = urxPending;
+  if (urxFrameTail != urxFrameHead) {
+    frame_end = urxFrame[urxFrameTail & (URX_FRAME_MAX - 1U)];
+  }
+  span->len  = urxSpanLen(urxTail, head, frame_end, URX_BUF_SIZE);
+  span->data = &urxBuf[urxTail & (URX_BUF_SIZE - 1U)];
+  if ((urxFrameTail != urxFrameHead) && ((urxTail + span->len) == frame_end)) {
+    flags |= URX_SPAN_FRAME_END;
+  }
+  span->flags = flags;
+  urxPending  = 0U;
+  return 0;
+}
+
+/*-----------------------------------------------------------------------------
+  urxRelease: hand consumed bytes back to the receiver
+  Returns -1 if the data was overwritten while it was in use.
+ *----------------------------------------------------------------------------*/
+int32_t urxRelease (uint32_t len) {
+  int32_t status = 0;
+
+  if ((urxHead() - urxTail) > URX_BUF_SIZE) {
+    status = -1;                        // Counted by the next urxGet
+  }
+  urxTail += len;
+  return status;
+}
+
+/*-----------------------------------------------------------------------------
+  urxGetStats: get receiver statistics
+ *----------------------------------------------------------------------------*/
+void urxGetStats (urxStats_t *stats) {
+  *stats       = urxStats;
+  stats->bytes = (urxDmaCh < 0) ? 0U : urxHead();
+}
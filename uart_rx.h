@@ -0,0 +1,97 @@
+/*---------------------------------------------------------------------------
+ * Copyright (c) 2025 Arm Limited (or its affiliates). All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *---------------------------------------------------------------------------
+ * Name:    uart_rx.h
+ * Purpose: Circular DMA UART receiver with character timeout framing
+ *----------------------------------------------------------------------------*/
+
+
+#ifndef UART_RX_H__
+#define UART_RX_H__
+
+#include <stdint.h>
+
+/*
+  The GPDMA writes received bytes into a ring in AHB SRAM through two linked
+  list items that point to each other, so reception never stops and there
+  is no interrupt per byte. The UART character timeout (line idle for 3.5
+  to 4.5 characters) marks the end of a frame.
+
+  One consumer thread reads the data in place:
+
+    urxSpan_t span;
+    while (urxGet(&span, osWaitForever) == 0) {
+      parse(span.data, span.len);
+      urxRelease(span.len);
+    }
+
+  A span never crosses the end of the ring or a frame end. The ring must be
+  drained faster than it is filled: older data is overwritten, counted as
+  overrun and skipped by the next urxGet. urxRelease reports a span that
+  was overwritten while the consumer was still reading it.
+
+  The UART interrupt priority is set in IRQ_PRIO_TABLE (irq_prio.h) and must
+  follow URX_UART.
+*/
+
+// UART used for reception (0, 2 or 3)
+#ifndef URX_UART
+#define URX_UART                2
+#endif
+
+#ifndef URX_BAUDRATE
+#define URX_BAUDRATE            921600U
+#endif
+
+// Ring size in bytes (power of 2, two halves of at most 4095 bytes)
+#ifndef URX_BUF_SIZE
+#define URX_BUF_SIZE            2048U
+#endif
+
+// Frame ends buffered between ISR and consumer (power of 2)
+#ifndef URX_FRAME_MAX
+#define URX_FRAME_MAX           16U
+#endif
+
+// Span flags
+#define URX_SPAN_FRAME_END      0x01U   // Span ends at a character timeout
+#define URX_SPAN_OVERRUN        0x02U   // Data before this span was lost
+
+// Received data (valid until urxRelease)
+typedef struct {
+  const uint8_t *data;
+  uint32_t       len;
+  uint32_t       flags;                 // URX_SPAN_xxx
+} urxSpan_t;
+
+// Statistics
+typedef struct {
+  uint32_t bytes;                       // Bytes received
+  uint32_t frames;                      // Frame ends detected
+  uint32_t frame_drops;                 // Frame ends lost (URX_FRAME_MAX)
+  uint32_t overruns;                    // Ring overruns (data lost)
+  uint32_t line_errors;                 // UART overrun, parity, framing, break
+} urxStats_t;
+
+/* Prototypes */
+extern int32_t  urxInit     (void);
+extern int32_t  urxGet      (urxSpan_t *span, uint32_t timeout);
+extern int32_t  urxRelease  (uint32_t len);
+extern void     urxGetStats (urxStats_t *stats);
+extern uint32_t urxSpanLen  (uint32_t tail, uint32_t head, uint32_t frame_end, uint32_t size);
+
+#endif
@@ -49,6 +49,8 @@ vioLED3           | vioSignalOut.3 | P1.23: LED4 (GPIO1[23])           |
 #include "PIN_LPC17xx.h"
 #include "GPIO_LPC17xx.h"
 
+#include "mem_sections.h"
+
 // VIO input, output definitions
 #define VIO_VALUE_NUM           1U          // Number of values
 
@@ -95,7 +97,7 @@ void vioInit (void) {
 }
 
 // Set signal output.
-void vioSetSignal (uint32_t mask, uint32_t signal) {
+__RAMFUNC void vioSetSignal (uint32_t mask, uint32_t signal) {
   vioSignalOut &= ~mask;
   vioSignalOut |=  mask & signal;
 